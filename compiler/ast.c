@@ -3,157 +3,257 @@
 #include <stdlib.h>
 #include <string.h>
 
+// 初始容量（节点数），之后按两倍增长
+#define AST_INITIAL_CAPACITY 256
+#define AST_INITIAL_LIST_CAPACITY 64
+
+AST* init_ast(void) {
+    AST *ast = (AST*)calloc(1, sizeof(AST));
+    if (!ast) return NULL;
+
+    ast->capacity = AST_INITIAL_CAPACITY;
+    ast->kinds = (uint8_t*)malloc(ast->capacity * sizeof(uint8_t));
+    ast->lefts = (NodeId*)malloc(ast->capacity * sizeof(NodeId));
+    ast->rights = (NodeId*)malloc(ast->capacity * sizeof(NodeId));
+    ast->payloads = (ASTPayload*)malloc(ast->capacity * sizeof(ASTPayload));
+    ast->locations = (ASTLocation*)malloc(ast->capacity * sizeof(ASTLocation));
+    ast->list_capacity = AST_INITIAL_LIST_CAPACITY;
+    ast->lists = (NodeId*)malloc(ast->list_capacity * sizeof(NodeId));
+    if (!ast->kinds || !ast->lefts || !ast->rights || !ast->payloads || !ast->locations || !ast->lists) {
+        free_ast(ast);
+        return NULL;
+    }
+
+    // 0号节点表示空节点，子节点为AST_NONE时不需要特殊处理越界
+    ast->kinds[0] = STMT_COMPOUND;
+    ast->lefts[0] = AST_NONE;
+    ast->rights[0] = AST_NONE;
+    memset(&ast->payloads[0], 0, sizeof(ASTPayload));
+    ast->locations[0].line = 0;
+    ast->locations[0].column = 0;
+    ast->count = 1;
+    return ast;
+}
+
+// 整棵树只有这几次释放，与节点数无关
+void free_ast(AST *ast) {
+    if (!ast) return;
+    free(ast->kinds);
+    free(ast->lefts);
+    free(ast->rights);
+    free(ast->payloads);
+    free(ast->locations);
+    free(ast->lists);
+    free(ast->pending);
+    free(ast->types);
+    free(ast->symbols);
+    free(ast);
+}
+
+// 语法分析结束后节点数不再变化，按当前节点数分配
+int alloc_ast_annotations(AST *ast) {
+    free(ast->types);
+    free(ast->symbols);
+    ast->types = (uint8_t*)calloc(ast->count, sizeof(uint8_t));
+    ast->symbols = (uint32_t*)calloc(ast->count, sizeof(uint32_t));
+    return ast->types && ast->symbols;
+}
+
+// 各数组一起扩容；失败时已扩容的数组保持有效，容量不变
+static int grow_nodes(AST *ast) {
+    uint32_t capacity = ast->capacity * 2;
+    uint8_t *kinds = (uint8_t*)realloc(ast->kinds, capacity * sizeof(uint8_t));
+    if (kinds) ast->kinds = kinds;
+    NodeId *lefts = (NodeId*)realloc(ast->lefts, capacity * sizeof(NodeId));
+    if (lefts) ast->lefts = lefts;
+    NodeId *rights = (NodeId*)realloc(ast->rights, capacity * sizeof(NodeId));
+    if (rights) ast->rights = rights;
+    ASTPayload *payloads = (ASTPayload*)realloc(ast->payloads, capacity * sizeof(ASTPayload));
+    if (payloads) ast->payloads = payloads;
+    ASTLocation *locations = (ASTLocation*)realloc(ast->locations, capacity * sizeof(ASTLocation));
+    if (locations) ast->locations = locations;
+    if (!kinds || !lefts || !rights || !payloads || !locations) return 0;
+    ast->capacity = capacity;
+    return 1;
+}
+
+// Allocate a node; it inherits the location of the first child and the parser
+// then sets the exact location of the rule's first token with set_ast_location
+static NodeId new_node(AST *ast, NodeType type, NodeId left, NodeId right, NodeId first_child) {
+    if (ast->count == ast->capacity && !grow_nodes(ast)) {
+        return AST_NONE;
+    }
+    NodeId node = ast->count++;
+    ast->kinds[node] = (uint8_t)type;
+    ast->lefts[node] = left;
+    ast->rights[node] = right;
+    ast->locations[node] = ast->locations[first_child];
+    return node;
+}
+
 // Set AST node location information
-void set_ast_location(ASTNode *node, int line, int column) {
-    if (node) {
-        node->line_number = line;
-        node->column = column;
+void set_ast_location(AST *ast, NodeId node, int line, int column) {
+    if (node != AST_NONE) {
+        ast->locations[node].line = line;
+        ast->locations[node].column = column;
     }
 }
 
-// Create compound statement node
-ASTNode *create_compound_stmt(ASTNode *left, ASTNode *right) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_COMPOUND;
-    node->left = left;
-    node->right = right;
+uint32_t begin_node_list(AST *ast) {
+    return ast->pending_count;
+}
+
+int push_node_list(AST *ast, NodeId node) {
+    if (ast->pending_count == ast->pending_capacity) {
+        uint32_t capacity = ast->pending_capacity ? ast->pending_capacity * 2 : AST_INITIAL_LIST_CAPACITY;
+        NodeId *pending = (NodeId*)realloc(ast->pending, capacity * sizeof(NodeId));
+        if (!pending) return 0;
+        ast->pending = pending;
+        ast->pending_capacity = capacity;
+    }
+    ast->pending[ast->pending_count++] = node;
+    return 1;
+}
+
+// 把pending中从list_start开始的元素移入lists，返回它们在lists中的起始下标；失败时返回UINT32_MAX
+static uint32_t close_node_list(AST *ast, uint32_t list_start) {
+    uint32_t count = ast->pending_count - list_start;
+    if (ast->list_count + count > ast->list_capacity) {
+        uint32_t capacity = ast->list_capacity * 2;
+        while (capacity < ast->list_count + count) capacity *= 2;
+        NodeId *lists = (NodeId*)realloc(ast->lists, capacity * sizeof(NodeId));
+        if (!lists) return UINT32_MAX;
+        ast->lists = lists;
+        ast->list_capacity = capacity;
+    }
+
+    uint32_t first = ast->list_count;
+    if (count > 0) {
+        memcpy(ast->lists + first, ast->pending + list_start, (size_t)count * sizeof(NodeId));
+    }
+    ast->list_count += count;
+    ast->pending_count = list_start;
+    return first;
+}
+
+// Create a statement block from the statements pushed since list_start
+NodeId create_block(AST *ast, uint32_t list_start) {
+    NodeId first_stmt = ast->pending_count > list_start ? ast->pending[list_start] : AST_NONE;
+    uint32_t count = ast->pending_count - list_start;
+    uint32_t first = close_node_list(ast, list_start);
+    if (first == UINT32_MAX) return AST_NONE;
+
+    NodeId node = new_node(ast, STMT_COMPOUND, AST_NONE, AST_NONE, first_stmt);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].block.first_stmt = first;
+    ast->payloads[node].block.stmt_count = count;
     return node;
 }
 
-// Modified variable declaration node creation to include location information
-ASTNode *create_decl(char *type, char *name) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_DECL;
-    node->decl.name = _strdup(name);  // Use _strdup
-    node->decl.var_type = _strdup(type); // Store type information
-    node->left = NULL;
-    node->right = NULL;
+// Create variable declaration node
+NodeId create_decl(AST *ast, const char *type, const char *name) {
+    NodeId node = new_node(ast, STMT_DECL, AST_NONE, AST_NONE, AST_NONE);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].decl.name = name;  // Interned, not copied
+    ast->payloads[node].decl.var_type = type; // Store type information
     return node;
 }
 
-// Modified variable declaration with initialization to include location information
-ASTNode *create_decl_assign(char *type, char *name, ASTNode *expr) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_DECL_ASSIGN;
-    node->decl.name = _strdup(name);  // Use _strdup
-    node->decl.var_type = _strdup(type); // Store type information
-    node->left = expr;
-    node->right = NULL;
+// Create variable declaration with initialization
+NodeId create_decl_assign(AST *ast, const char *type, const char *name, NodeId expr) {
+    NodeId node = new_node(ast, STMT_DECL_ASSIGN, expr, AST_NONE, expr);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].decl.name = name;  // Interned, not copied
+    ast->payloads[node].decl.var_type = type; // Store type information
     return node;
 }
 
 // Create assignment node
-ASTNode *create_assign(char *name, ASTNode *expr) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_ASSIGN;
-    node->assign.name = _strdup(name);  // Use _strdup
-    node->left = expr;
-    node->right = NULL;
+NodeId create_assign(AST *ast, const char *name, NodeId expr) {
+    NodeId node = new_node(ast, STMT_ASSIGN, expr, AST_NONE, expr);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].assign.name = name;  // Interned, not copied
     return node;
 }
 
 // Create return statement node
-ASTNode *create_return_stmt(ASTNode *expr) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_RETURN;
-    node->left = expr;
-    node->right = NULL;
-    return node;
+NodeId create_return_stmt(AST *ast, NodeId expr) {
+    return new_node(ast, STMT_RETURN, expr, AST_NONE, expr);
 }
 
 // Create if statement node
-ASTNode *create_if(ASTNode *cond, ASTNode *then_stmt, ASTNode *else_stmt) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_IF;
-    node->if_stmt.cond = cond;
-    node->left = then_stmt;
-    node->right = else_stmt;
+NodeId create_if(AST *ast, NodeId cond, NodeId then_stmt, NodeId else_stmt) {
+    NodeId node = new_node(ast, STMT_IF, then_stmt, else_stmt, cond);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].if_stmt.cond = cond;
     return node;
 }
 
 // Create while statement node
-ASTNode *create_while(ASTNode *cond, ASTNode *body) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = STMT_WHILE;
-    node->while_stmt.cond = cond;
-    node->left = body;
-    node->right = NULL;
+NodeId create_while(AST *ast, NodeId cond, NodeId body) {
+    NodeId node = new_node(ast, STMT_WHILE, body, AST_NONE, cond);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].while_stmt.cond = cond;
     return node;
 }
 
 // Create binary operation node
-ASTNode *create_binop(BinOpType op, ASTNode *left, ASTNode *right) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = EXPR_BINOP;
-    node->binop.op = op;
-    node->left = left;
-    node->right = right;
+NodeId create_binop(AST *ast, BinOpType op, NodeId left, NodeId right) {
+    NodeId node = new_node(ast, EXPR_BINOP, left, right, left);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].binop.op = op;
     return node;
 }
 
 // Create variable node
-ASTNode *create_var(char *name) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = EXPR_VAR;
-    node->var.name = _strdup(name);  // ʹ�� _strdup
-    node->left = NULL;
-    node->right = NULL;
+NodeId create_var(AST *ast, const char *name) {
+    NodeId node = new_node(ast, EXPR_VAR, AST_NONE, AST_NONE, AST_NONE);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].var.name = name;  // Interned, not copied
     return node;
 }
 
 // Create integer constant node
-ASTNode *create_int(int value) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = EXPR_INT;
-    node->integer.value = value;
-    node->left = NULL;
-    node->right = NULL;
+NodeId create_int(AST *ast, int value) {
+    NodeId node = new_node(ast, EXPR_INT, AST_NONE, AST_NONE, AST_NONE);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].integer.value = value;
     return node;
 }
 
 // Create floating point constant node
-ASTNode *create_float(float value) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = EXPR_FLOAT;
-    node->floating.value = value;
-    node->left = NULL;
-    node->right = NULL;
+NodeId create_float(AST *ast, float value) {
+    NodeId node = new_node(ast, EXPR_FLOAT, AST_NONE, AST_NONE, AST_NONE);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].floating.value = value;
     return node;
 }
 
 // Create function definition node
-ASTNode *create_func_def(char *ret_type, char *name, ASTNode *body) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = FUNC_DEF;
-    node->func_def.name = _strdup(name);
-    node->func_def.ret_type = _strdup(ret_type);
-    node->left = body;
-    node->right = NULL;
+NodeId create_func_def(AST *ast, const char *ret_type, const char *name, NodeId body) {
+    NodeId node = new_node(ast, FUNC_DEF, body, AST_NONE, body);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].func_def.name = name;
+    ast->payloads[node].func_def.ret_type = ret_type;
     return node;
 }
 
-// 创建函数调用节点
-ASTNode *create_call(char *name, ASTNode **args, int arg_count) {
-    ASTNode *node = malloc(sizeof(ASTNode));
-    node->type = EXPR_CALL;
-    node->call.name = _strdup(name);
-    node->call.arg_count = arg_count;
-    
-    if (arg_count > 0 && args) {
-        node->call.args = malloc(sizeof(ASTNode*) * arg_count);
-        for (int i = 0; i < arg_count; i++) {
-            node->call.args[i] = args[i];
-        }
-    } else {
-        node->call.args = NULL;
-    }
-    
-    node->left = NULL;
-    node->right = NULL;
+// 创建函数调用节点，参数由list_start之后压入的元素移入lists中连续存放
+NodeId create_call(AST *ast, const char *name, uint32_t list_start) {
+    NodeId first_arg = ast->pending_count > list_start ? ast->pending[list_start] : AST_NONE;
+    uint32_t count = ast->pending_count - list_start;
+    uint32_t first = close_node_list(ast, list_start);
+    if (first == UINT32_MAX) return AST_NONE;
+
+    NodeId node = new_node(ast, EXPR_CALL, AST_NONE, AST_NONE, first_arg);
+    if (node == AST_NONE) return AST_NONE;
+    ast->payloads[node].call.name = name;
+    ast->payloads[node].call.first_arg = first;
+    ast->payloads[node].call.arg_count = count;
     return node;
 }
 
-// ��ӡAST�ĸ�������
+// 打印AST的辅助函数
 static const char *binop_to_str(BinOpType op) {
     switch(op) {
         case OP_ADD: return "+";
@@ -170,136 +270,263 @@ static const char *binop_to_str(BinOpType op) {
     }
 }
 
-// Recursively print AST
-void print_ast(ASTNode *node, int indent) {
-    if (!node) return;
-    
-    // Print indentation
+// 子节点的个数和顺序：语句块的语句、if的条件/then/else、while的条件/循环体、
+// 调用的参数、二元运算的左右操作数，其余节点只有left
+uint32_t ast_child_count(const AST *ast, NodeId node) {
+    switch ((NodeType)ast->kinds[node]) {
+        case STMT_COMPOUND: return ast->payloads[node].block.stmt_count;
+        case STMT_IF: return 3;
+        case STMT_WHILE:
+        case EXPR_BINOP: return 2;
+        case STMT_CALL:
+        case EXPR_CALL: return ast->payloads[node].call.arg_count;
+        case STMT_DECL_ASSIGN:
+        case STMT_ASSIGN:
+        case STMT_RETURN:
+        case FUNC_DEF: return 1;
+        default: return 0;
+    }
+}
+
+NodeId ast_child(const AST *ast, NodeId node, uint32_t index) {
+    switch ((NodeType)ast->kinds[node]) {
+        case STMT_COMPOUND: return AST_BLOCK_STMT(ast, node, index);
+        case STMT_IF:
+            if (index == 0) return ast->payloads[node].if_stmt.cond;
+            return index == 1 ? ast->lefts[node] : ast->rights[node];
+        case STMT_WHILE:
+            return index == 0 ? ast->payloads[node].while_stmt.cond : ast->lefts[node];
+        case STMT_CALL:
+        case EXPR_CALL: return AST_CALL_ARG(ast, node, index);
+        case EXPR_BINOP: return index == 0 ? ast->lefts[node] : ast->rights[node];
+        default: return ast->lefts[node];
+    }
+}
+
+// 遍历栈的一项：访问记录加上待访问的子节点。语句块和调用的子节点直接指向lists，
+// 其余节点把至多3个子节点复制到fixed中（顺序与ast_child相同，children为NULL，
+// 栈搬移后仍然有效），取下一个子节点时不再按节点类型分支
+typedef struct {
+    ASTVisit visit;
+    const NodeId *children;
+    uint32_t child_count;       // pre返回0时为0，跳过子节点
+    uint32_t next_child;
+    NodeId fixed[3];
+} VisitFrame;
+
+// 栈较浅时（绝大多数语句和表达式）不分配内存
+#define VISIT_INLINE_FRAMES 64
+
+static void load_children(const AST *ast, VisitFrame *frame) {
+    NodeId node = frame->visit.node;
+    const ASTPayload *p = &ast->payloads[node];
+    frame->next_child = 0;
+    switch ((NodeType)ast->kinds[node]) {
+        case STMT_COMPOUND:
+            frame->children = ast->lists + p->block.first_stmt;
+            frame->child_count = p->block.stmt_count;
+            return;
+        case STMT_CALL:
+        case EXPR_CALL:
+            frame->children = ast->lists + p->call.first_arg;
+            frame->child_count = p->call.arg_count;
+            return;
+        case STMT_IF:
+            frame->fixed[0] = p->if_stmt.cond;
+            frame->fixed[1] = ast->lefts[node];
+            frame->fixed[2] = ast->rights[node];
+            frame->child_count = 3;
+            break;
+        case STMT_WHILE:
+            frame->fixed[0] = p->while_stmt.cond;
+            frame->fixed[1] = ast->lefts[node];
+            frame->child_count = 2;
+            break;
+        case EXPR_BINOP:
+            frame->fixed[0] = ast->lefts[node];
+            frame->fixed[1] = ast->rights[node];
+            frame->child_count = 2;
+            break;
+        case STMT_DECL_ASSIGN:
+        case STMT_ASSIGN:
+        case STMT_RETURN:
+        case FUNC_DEF:
+            frame->fixed[0] = ast->lefts[node];
+            frame->child_count = 1;
+            break;
+        default:
+            frame->child_count = 0;
+            break;
+    }
+    frame->children = NULL;
+}
+
+// 显式栈上的深度优先遍历，栈按两倍增长；原生栈的用量与树的深度无关。
+// 没有子节点的节点不入栈，pre之后直接调用post
+int visit_ast(const AST *ast, NodeId root, const ASTVisitor *visitor, void *data) {
+    if (root == AST_NONE) return 1;
+
+    VisitFrame inline_frames[VISIT_INLINE_FRAMES];
+    VisitFrame *frames = inline_frames;
+    uint32_t capacity = VISIT_INLINE_FRAMES;
+    uint32_t depth = 0;         // frames[0..depth)是已进入、子节点未访问完的节点
+    int ok = 1;
+
+    NodeId node = root;
+    uint32_t index = 0;
+    for (;;) {
+        // 进入node：它的访问记录先放在frames[depth]，有子节点时才占用这一项
+        if (depth == capacity) {
+            VisitFrame *grown;
+            if (frames == inline_frames) {
+                grown = (VisitFrame*)malloc(capacity * 2 * sizeof(VisitFrame));
+                if (grown) memcpy(grown, inline_frames, sizeof(inline_frames));
+            } else {
+                grown = (VisitFrame*)realloc(frames, capacity * 2 * sizeof(VisitFrame));
+            }
+            if (!grown) {
+                ok = 0;
+                break;
+            }
+            frames = grown;
+            capacity *= 2;
+        }
+        VisitFrame *frame = &frames[depth];
+        frame->visit.node = node;
+        frame->visit.index = index;
+        frame->visit.depth = depth;
+        frame->visit.value = 0;
+        frame->visit.up = depth > 0 ? &frames[depth - 1].visit : NULL;
+        if (!visitor->pre || visitor->pre(ast, &frame->visit, data)) {
+            load_children(ast, frame);
+        } else {
+            frame->child_count = 0;
+        }
+        if (frame->child_count > 0) {
+            depth++;
+        } else {
+            if (visitor->post) visitor->post(ast, &frame->visit, data);
+        }
+
+        // 找到下一个要进入的节点；子节点都访问完的节点出栈并调用post
+        node = AST_NONE;
+        while (depth > 0) {
+            frame = &frames[depth - 1];
+            while (frame->next_child < frame->child_count) {
+                index = frame->next_child++;
+                node = frame->children ? frame->children[index] : frame->fixed[index];
+                if (node != AST_NONE) break;
+            }
+            if (node != AST_NONE) break;
+            frame->visit.up = depth > 1 ? &frames[depth - 2].visit : NULL;
+            if (visitor->post) visitor->post(ast, &frame->visit, data);
+            depth--;
+        }
+        if (node == AST_NONE) break;
+    }
+
+    if (frames != inline_frames) free(frames);
+    return ok;
+}
+
+static void print_indent(int indent) {
     for (int i = 0; i < indent; i++) printf("  ");
-    
-    switch(node->type) {
+}
+
+// if、while的子节点前带一个说明（Condition、Then等），其他子节点返回NULL
+static const char *child_label(const AST *ast, const ASTVisit *visit) {
+    if (!visit->up) return NULL;
+    switch ((NodeType)ast->kinds[visit->up->node]) {
+        case STMT_IF:
+            return visit->index == 0 ? "Condition" : (visit->index == 1 ? "Then" : "Else");
+        case STMT_WHILE:
+            return visit->index == 0 ? "Condition" : "Body";
+        default:
+            return NULL;
+    }
+}
+
+static int is_call_arg(const AST *ast, const ASTVisit *visit) {
+    if (!visit->up) return 0;
+    NodeType parent = (NodeType)ast->kinds[visit->up->node];
+    return parent == STMT_CALL || parent == EXPR_CALL;
+}
+
+// 打印一个节点；visit->value记录该节点的缩进
+static int print_ast_pre(const AST *ast, ASTVisit *visit, void *data) {
+    NodeId node = visit->node;
+    const ASTPayload *p = &ast->payloads[node];
+    int indent = visit->up ? visit->up->value + 1 : *(int*)data;
+
+    const char *label = child_label(ast, visit);
+    if (label) {
+        print_indent(indent);
+        printf("%s:\n", label);
+        indent++;
+    } else if (is_call_arg(ast, visit)) {
+        print_indent(indent);
+        printf("Argument %u:\n", visit->index);
+        indent++;
+    }
+    visit->value = indent;
+    print_indent(indent);
+
+    switch((NodeType)ast->kinds[node]) {
         case STMT_COMPOUND:
             printf("Compound Statement\n");
-            print_ast(node->left, indent + 1);
-            print_ast(node->right, indent + 1);
             break;
         case STMT_DECL:
-            printf("Variable Declaration: %s (%s)\n", node->decl.name, node->decl.var_type);
+            printf("Variable Declaration: %s (%s)\n", p->decl.name, p->decl.var_type);
             break;
         case STMT_DECL_ASSIGN:
-            printf("Variable Declaration with Assignment: %s (%s) =\n", node->decl.name, node->decl.var_type);
-            print_ast(node->left, indent + 1);
+            printf("Variable Declaration with Assignment: %s (%s) =\n", p->decl.name, p->decl.var_type);
             break;
         case STMT_ASSIGN:
-            printf("Assignment: %s =\n", node->assign.name);
-            print_ast(node->left, indent + 1);
+            printf("Assignment: %s =\n", p->assign.name);
             break;
         case STMT_RETURN:
             printf("Return Statement\n");
-            print_ast(node->left, indent + 1);
             break;
         case STMT_IF:
             printf("If Statement:\n");
-            for (int i = 0; i < indent + 1; i++) printf("  ");
-            printf("Condition:\n");
-            print_ast(node->if_stmt.cond, indent + 2);
-            for (int i = 0; i < indent + 1; i++) printf("  ");
-            printf("Then:\n");
-            print_ast(node->left, indent + 2);
-            if (node->right) {
-                for (int i = 0; i < indent + 1; i++) printf("  ");
-                printf("Else:\n");
-                print_ast(node->right, indent + 2);
-            }
             break;
         case STMT_WHILE:
             printf("While Statement:\n");
-            for (int i = 0; i < indent + 1; i++) printf("  ");
-            printf("Condition:\n");
-            print_ast(node->while_stmt.cond, indent + 2);
-            for (int i = 0; i < indent + 1; i++) printf("  ");
-            printf("Body:\n");
-            print_ast(node->left, indent + 2);
             break;
         case STMT_CALL:
-            printf("Function Call Statement: %s\n", node->call.name);
-            for (int i = 0; i < node->call.arg_count; i++) {
-                for (int j = 0; j < indent + 1; j++) printf("  ");
-                printf("Argument %d:\n", i);
-                print_ast(node->call.args[i], indent + 2);
-            }
+            printf("Function Call Statement: %s\n", p->call.name);
             break;
         case EXPR_BINOP:
-            printf("Binary Operation: %s\n", binop_to_str(node->binop.op));
-            print_ast(node->left, indent + 1);
-            print_ast(node->right, indent + 1);
+            printf("Binary Operation: %s\n", binop_to_str(p->binop.op));
             break;
         case EXPR_VAR:
-            printf("Variable: %s\n", node->var.name);
+            printf("Variable: %s\n", p->var.name);
             break;
         case EXPR_INT:
-            printf("Integer: %d\n", node->integer.value);
+            printf("Integer: %d\n", p->integer.value);
             break;
         case EXPR_FLOAT:
-            printf("Float: %f\n", node->floating.value);
+            printf("Float: %f\n", p->floating.value);
             break;
         case EXPR_CALL:
-            printf("Function Call: %s(", node->call.name);
-            for (int i = 0; i < node->call.arg_count; i++) {
+            printf("Function Call: %s(", p->call.name);
+            for (uint32_t i = 0; i < p->call.arg_count; i++) {
                 if (i > 0) printf(", ");
-                printf("arg%d", i);
+                printf("arg%u", i);
             }
             printf(")\n");
-            for (int i = 0; i < node->call.arg_count; i++) {
-                for (int j = 0; j < indent + 1; j++) printf("  ");
-                printf("Argument %d:\n", i);
-                print_ast(node->call.args[i], indent + 2);
-            }
             break;
         case FUNC_DEF:
-            printf("Function Definition: %s %s()\n", node->func_def.ret_type, node->func_def.name);
-            print_ast(node->left, indent + 1);
+            printf("Function Definition: %s %s()\n", p->func_def.ret_type, p->func_def.name);
             break;
     }
+    return 1;
 }
 
-// Modified free_ast function to fix memory release errors
-void free_ast(ASTNode *node) {
-    if (!node) return;
-    
-    switch(node->type) {
-        case STMT_DECL:
-        case STMT_DECL_ASSIGN:
-            free(node->decl.name);
-            free(node->decl.var_type);
-            break;
-        case STMT_ASSIGN:
-            free(node->assign.name);  // Should use assign.name, not decl.name
-            break;
-        case STMT_CALL:
-        case EXPR_CALL:
-            free(node->call.name);
-            if (node->call.args) {
-                for (int i = 0; i < node->call.arg_count; i++) {
-                    free_ast(node->call.args[i]);
-                }
-                free(node->call.args);
-            }
-            break;
-        case EXPR_VAR:
-            free(node->var.name);     // 这里应该使用var.name，不是decl.name
-            break;
-        case FUNC_DEF:
-            free(node->func_def.name);
-            free(node->func_def.ret_type);
-            break;
-        default:
-            break;
-    }
-    
-    free_ast(node->left);
-    free_ast(node->right);
-    free(node);
+// Print AST
+void print_ast(const AST *ast, NodeId node, int indent) {
+    ASTVisitor visitor = { print_ast_pre, NULL };
+    visit_ast(ast, node, &visitor, &indent);
 }
 
 // 辅助函数：转义DOT标签中的特殊字符
@@ -337,37 +564,56 @@ static char* escape_dot_label(const char* str) {
     return escaped;
 }
 
-// Recursively export DOT file content
-static void export_ast_to_dot_recursive(ASTNode *node, FILE *fp, int *counter) {
-    if (!node) return;
-    
-    int my_id = (*counter)++;
-    
+typedef struct {
+    FILE *fp;
+    int counter;
+} ASTDotWriter;
+
+// 先序输出节点（if/while的子节点前先输出Condition、Then等中间节点），后序输出指向它的边；
+// visit->value记录节点在DOT文件中的编号，中间节点的编号总是比子节点小1
+static int export_dot_pre(const AST *ast, ASTVisit *visit, void *data) {
+    ASTDotWriter *writer = (ASTDotWriter*)data;
+    FILE *fp = writer->fp;
+    NodeId node = visit->node;
+    const ASTPayload *p = &ast->payloads[node];
+
+    const char *label = child_label(ast, visit);
+    if (label) {
+        int label_id = writer->counter++;
+        fprintf(fp, "  node%d [label=\"%s\"];\n", label_id, label);
+        fprintf(fp, "  node%d -> node%d;\n", visit->up->value, label_id);
+    } else if (is_call_arg(ast, visit)) {
+        fprintf(fp, "  node%d -> node%d;\n", visit->up->value, writer->counter);
+    }
+
+    int my_id = writer->counter++;
+    visit->value = my_id;
+
     // Node content generates labels
-    switch(node->type) {
+    switch((NodeType)ast->kinds[node]) {
         case STMT_COMPOUND:
             fprintf(fp, "  node%d [label=\"Compound Statement\"];\n", my_id);
             break;
         case STMT_DECL: {
-            char* escaped_name = escape_dot_label(node->decl.name);
-            char* escaped_type = escape_dot_label(node->decl.var_type);
-            fprintf(fp, "  node%d [label=\"Variable Declaration: %s (%s)\"];\n", my_id, 
+            char* escaped_name = escape_dot_label(p->decl.name);
+            char* escaped_type = escape_dot_label(p->decl.var_type);
+            fprintf(fp, "  node%d [label=\"Variable Declaration: %s (%s)\"];\n", my_id,
                     escaped_name, escaped_type);
             free(escaped_name);
             free(escaped_type);
             break;
         }
         case STMT_DECL_ASSIGN: {
-            char* escaped_name = escape_dot_label(node->decl.name);
-            char* escaped_type = escape_dot_label(node->decl.var_type);
-            fprintf(fp, "  node%d [label=\"Variable Declaration with Init: %s (%s)\"];\n", my_id, 
+            char* escaped_name = escape_dot_label(p->decl.name);
+            char* escaped_type = escape_dot_label(p->decl.var_type);
+            fprintf(fp, "  node%d [label=\"Variable Declaration with Init: %s (%s)\"];\n", my_id,
                     escaped_name, escaped_type);
             free(escaped_name);
             free(escaped_type);
             break;
         }
         case STMT_ASSIGN: {
-            char* escaped_name = escape_dot_label(node->assign.name);
+            char* escaped_name = escape_dot_label(p->assign.name);
             fprintf(fp, "  node%d [label=\"Assignment: %s\"];\n", my_id, escaped_name);
             free(escaped_name);
             break;
@@ -377,87 +623,28 @@ static void export_ast_to_dot_recursive(ASTNode *node, FILE *fp, int *counter) {
             break;
         case STMT_IF:
             fprintf(fp, "  node%d [label=\"If Statement\"];\n", my_id);
-            
-            // Create an intermediate node for the condition
-            int cond_id = (*counter)++;
-            fprintf(fp, "  node%d [label=\"Condition\"];\n", cond_id);
-            fprintf(fp, "  node%d -> node%d;\n", my_id, cond_id);
-            
-            // Export condition expression
-            if (node->if_stmt.cond) {
-                int expr_id = *counter;
-                export_ast_to_dot_recursive(node->if_stmt.cond, fp, counter);
-                fprintf(fp, "  node%d -> node%d;\n", cond_id, expr_id);
-            }
-            
-            // Create intermediate node for then branch
-            if (node->left) {
-                int then_id = (*counter)++;
-                fprintf(fp, "  node%d [label=\"Then\"];\n", then_id);
-                fprintf(fp, "  node%d -> node%d;\n", my_id, then_id);
-                
-                int stmt_id = *counter;
-                export_ast_to_dot_recursive(node->left, fp, counter);
-                fprintf(fp, "  node%d -> node%d;\n", then_id, stmt_id);
-            }
-            
-            // Ϊelse��֧�����м�ڵ�
-            if (node->right) {
-                int else_id = (*counter)++;
-                fprintf(fp, "  node%d [label=\"Else\"];\n", else_id);
-                fprintf(fp, "  node%d -> node%d;\n", my_id, else_id);
-                
-                int stmt_id = *counter;
-                export_ast_to_dot_recursive(node->right, fp, counter);
-                fprintf(fp, "  node%d -> node%d;\n", else_id, stmt_id);
-            }
-            return; // ���⴦������ɣ���������ͨ���߼�
-            
+            break;
         case STMT_WHILE:
             fprintf(fp, "  node%d [label=\"While Statement\"];\n", my_id);
-            
-            // Ϊ��������һ���м�ڵ�
-            int while_cond_id = (*counter)++;
-            fprintf(fp, "  node%d [label=\"Condition\"];\n", while_cond_id);
-            fprintf(fp, "  node%d -> node%d;\n", my_id, while_cond_id);
-            
-            // ������������ʽ
-            if (node->while_stmt.cond) {
-                int expr_id = *counter;
-                export_ast_to_dot_recursive(node->while_stmt.cond, fp, counter);
-                fprintf(fp, "  node%d -> node%d;\n", while_cond_id, expr_id);
-            }
-            
-            // Ϊѭ���崴���м�ڵ�
-            if (node->left) {
-                int body_id = (*counter)++;
-                fprintf(fp, "  node%d [label=\"Body\"];\n", body_id);
-                fprintf(fp, "  node%d -> node%d;\n", my_id, body_id);
-                
-                int stmt_id = *counter;
-                export_ast_to_dot_recursive(node->left, fp, counter);
-                fprintf(fp, "  node%d -> node%d;\n", body_id, stmt_id);
-            }
-            return; // ���⴦������ɣ���������ͨ���߼�
-            
+            break;
         case EXPR_BINOP:
-            fprintf(fp, "  node%d [label=\"Binary Op: %s\"];\n", my_id, binop_to_str(node->binop.op));
+            fprintf(fp, "  node%d [label=\"Binary Op: %s\"];\n", my_id, binop_to_str(p->binop.op));
             break;
         case EXPR_VAR: {
-            char* escaped_name = escape_dot_label(node->var.name);
+            char* escaped_name = escape_dot_label(p->var.name);
             fprintf(fp, "  node%d [label=\"Variable: %s\"];\n", my_id, escaped_name);
             free(escaped_name);
             break;
         }
         case EXPR_INT:
-            fprintf(fp, "  node%d [label=\"Integer: %d\"];\n", my_id, node->integer.value);
+            fprintf(fp, "  node%d [label=\"Integer: %d\"];\n", my_id, p->integer.value);
             break;
         case EXPR_FLOAT:
-            fprintf(fp, "  node%d [label=\"Float: %.2f\"];\n", my_id, node->floating.value);
+            fprintf(fp, "  node%d [label=\"Float: %.2f\"];\n", my_id, p->floating.value);
             break;
         case FUNC_DEF: {
-            char* escaped_ret_type = escape_dot_label(node->func_def.ret_type);
-            char* escaped_name = escape_dot_label(node->func_def.name);
+            char* escaped_ret_type = escape_dot_label(p->func_def.ret_type);
+            char* escaped_name = escape_dot_label(p->func_def.name);
             fprintf(fp, "  node%d [label=\"Function Definition: %s %s()\"];\n", my_id, escaped_ret_type, escaped_name);
             free(escaped_ret_type);
             free(escaped_name);
@@ -465,55 +652,53 @@ static void export_ast_to_dot_recursive(ASTNode *node, FILE *fp, int *counter) {
         }
         case STMT_CALL:
         case EXPR_CALL: {
-            char* escaped_name = escape_dot_label(node->call.name);
+            char* escaped_name = escape_dot_label(p->call.name);
             fprintf(fp, "  node%d [label=\"Function Call: %s\"];\n", my_id, escaped_name);
             free(escaped_name);
-            if (node->call.arg_count > 0) {
-                for (int i = 0; i < node->call.arg_count; i++) {
-                    fprintf(fp, "  node%d -> node%d;\n", my_id, (*counter));
-                    export_ast_to_dot_recursive(node->call.args[i], fp, counter);
-                }
-            }
-            return; // 特殊处理完成，不走通用逻辑
+            break;
         }
     }
-    
-    // �ݹ鴦����������
-    if (node->left) {
-        int left_id = *counter;
-        export_ast_to_dot_recursive(node->left, fp, counter);
-        fprintf(fp, "  node%d -> node%d;\n", my_id, left_id);
-    }
-    
-    if (node->right) {
-        int right_id = *counter;
-        export_ast_to_dot_recursive(node->right, fp, counter);
-        fprintf(fp, "  node%d -> node%d;\n", my_id, right_id);
-    }
+    return 1;
+}
+
+// 子树输出完后再输出指向它的边（函数调用的参数边已在先序时输出）
+static void export_dot_post(const AST *ast, ASTVisit *visit, void *data) {
+    ASTDotWriter *writer = (ASTDotWriter*)data;
+    if (!visit->up || is_call_arg(ast, visit)) return;
+    int from = child_label(ast, visit) ? visit->value - 1 : visit->up->value;
+    fprintf(writer->fp, "  node%d -> node%d;\n", from, visit->value);
 }
 
-// ���AST��DOT�ļ�
-void export_ast_to_dot(ASTNode *node, const char *filename) {
+// 只写出AST的DOT文件
+int write_ast_dot(const AST *ast, NodeId node, const char *filename) {
     FILE *fp = fopen(filename, "w");
     if (!fp) {
         perror("Cannot create DOT file");
-        return;
+        return 0;
     }
-    
+
     // DOT file header
     fprintf(fp, "digraph AST {\n");
-    fprintf(fp, "  node [shape=box, fontname=\"Arial\", fontsize=10];\n"); 
+    fprintf(fp, "  node [shape=box, fontname=\"Arial\", fontsize=10];\n");
     fprintf(fp, "  edge [fontname=\"Arial\", fontsize=9];\n");
-    fprintf(fp, "  rankdir=TB;\n"); 
-    
-    // Recursively generate nodes and edges
-    int node_counter = 0;
-    export_ast_to_dot_recursive(node, fp, &node_counter);
-    
+    fprintf(fp, "  rankdir=TB;\n");
+
+    // Generate nodes and edges
+    ASTDotWriter writer = { fp, 0 };
+    ASTVisitor visitor = { export_dot_pre, export_dot_post };
+    visit_ast(ast, node, &visitor, &writer);
+
     // DOT file footer
     fprintf(fp, "}\n");
-    
+
     fclose(fp);
+    return 1;
+}
+
+void export_ast_to_dot(const AST *ast, NodeId node, const char *filename) {
+    if (!write_ast_dot(ast, node, filename)) {
+        return;
+    }
     printf("AST exported to file: %s\n", filename);
     
     // 自动生成PNG图像
@@ -1,8 +1,10 @@
 #ifndef AST_H
 #define AST_H
 
+#include <stdint.h>
+
 typedef enum {
-    STMT_COMPOUND,
+    STMT_COMPOUND,      // 语句块：语句按顺序连续存放在lists中
     STMT_DECL,
     STMT_DECL_ASSIGN,
     STMT_ASSIGN,
@@ -16,70 +18,125 @@ typedef enum {
     EXPR_FLOAT,
     EXPR_CALL,          // 函数调用表达式
     FUNC_DEF            // 函数定义
-} NodeType; 
+} NodeType;
 
-// ��Ԫ���������
+// 二元运算符类型
 typedef enum {
     OP_ADD, OP_SUB, OP_MUL, OP_DIV,
     OP_EQ, OP_NE, OP_LT, OP_GT, OP_LE, OP_GE
 } BinOpType;
 
-typedef struct ASTNode {
-    NodeType type;
-    int line_number;        // 行号
-    int column;            // 列号
-    struct ASTNode *left;
-    struct ASTNode *right;
-    union {
-        // ��������
-        struct { 
-            char *name;
-            char *var_type;  // ���������ֶ�
-        } decl;
-        // ��ֵ���
-        struct { char *name; } assign;
-        // ��Ԫ����
-        struct { BinOpType op; } binop;
-        // ����
-        struct { char *name; } var;
-        // ��������
-        struct { int value; } integer;
-        // ����������
-        struct { float value; } floating;
-        // if���
-        struct { struct ASTNode *cond; } if_stmt;
-        // while语句
-        struct { struct ASTNode *cond; } while_stmt;
-        // 函数定义
-        struct { char *name; char *ret_type; } func_def;
-        // 函数调用
-        struct { 
-            char *name; 
-            struct ASTNode **args;  // 参数列表
-            int arg_count;          // 参数个数
-        } call;
-    };
-} ASTNode;
-
-// AST�ڵ㴴������
-ASTNode *create_compound_stmt(ASTNode *left, ASTNode *right);
-ASTNode *create_decl(char *type, char *name);
-ASTNode *create_decl_assign(char *type, char *name, ASTNode *expr);
-ASTNode *create_assign(char *name, ASTNode *expr);
-ASTNode *create_return_stmt(ASTNode *expr);
-ASTNode *create_if(ASTNode *cond, ASTNode *then_stmt, ASTNode *else_stmt);
-ASTNode *create_while(ASTNode *cond, ASTNode *body);
-ASTNode *create_binop(BinOpType op, ASTNode *left, ASTNode *right);
-ASTNode *create_var(char *name);
-ASTNode *create_int(int value);
-ASTNode *create_float(float value); 
-ASTNode *create_func_def(char *ret_type, char *name, ASTNode *body);
-ASTNode *create_call(char *name, ASTNode **args, int arg_count);  // 函数调用创建
-void set_ast_location(ASTNode *node, int line, int column);   // 设置位置信息
-
-// AST��������
-void print_ast(ASTNode *node, int indent);
-void free_ast(ASTNode *node);
-void export_ast_to_dot(ASTNode *node, const char *filename); // DOT�ļ�����
-
-#endif
\ No newline at end of file
+// 节点编号：节点在AST各数组中的下标，0号保留表示空节点
+typedef uint32_t NodeId;
+#define AST_NONE 0
+
+// 节点的附加数据，按节点类型使用其中一项（名称都来自驻留表，类型名是字符串常量）
+typedef union {
+    struct { const char *name; const char *var_type; } decl;
+    struct { const char *name; } assign;
+    struct { BinOpType op; } binop;
+    struct { const char *name; } var;
+    struct { int value; } integer;
+    struct { float value; } floating;
+    struct { NodeId cond; } if_stmt;        // left为then分支，right为else分支
+    struct { NodeId cond; } while_stmt;     // left为循环体
+    struct { const char *name; const char *ret_type; } func_def;   // left为函数体语句块
+    struct {
+        uint32_t first_stmt;    // 语句在lists中的起始下标
+        uint32_t stmt_count;
+    } block;
+    struct {
+        const char *name;
+        uint32_t first_arg;     // 参数在lists中的起始下标
+        uint32_t arg_count;
+    } call;
+} ASTPayload;
+
+// 源代码位置
+typedef struct {
+    int line;
+    int column;
+} ASTLocation;
+
+// 一个翻译单元的AST：节点类型、子节点、附加数据和位置分别存放在按节点编号索引的连续数组中，
+// 遍历时只读取需要的数组；整棵树随这几个数组一起释放
+typedef struct {
+    uint8_t *kinds;             // NodeType
+    NodeId *lefts;
+    NodeId *rights;
+    ASTPayload *payloads;
+    ASTLocation *locations;
+    uint32_t count;             // 已使用的节点数（含0号）
+    uint32_t capacity;
+
+    NodeId *lists;              // 变长子节点序列（语句块的语句、函数调用的参数）
+    uint32_t list_count;
+    uint32_t list_capacity;
+
+    // 语法分析中尚未结束的语句列表和参数列表：元素先压入这里，列表结束时整段移入lists。
+    // 内层列表总是先于外层结束，所以各列表的元素在栈中互不交错
+    NodeId *pending;
+    uint32_t pending_count;
+    uint32_t pending_capacity;
+
+    // 语义分析的结果，按节点编号索引（alloc_ast_annotations之前为NULL）：
+    // types为表达式的类型或声明、赋值的变量类型（DataType，0表示未知）；
+    // symbols为变量引用、声明和赋值解析到的符号编号（0表示未解析）
+    uint8_t *types;
+    uint32_t *symbols;
+} AST;
+
+// 函数调用的第i个参数、语句块的第i条语句
+#define AST_CALL_ARG(ast, node, i) ((ast)->lists[(ast)->payloads[node].call.first_arg + (i)])
+#define AST_BLOCK_STMT(ast, node, i) ((ast)->lists[(ast)->payloads[node].block.first_stmt + (i)])
+
+AST* init_ast(void);
+void free_ast(AST *ast);
+int alloc_ast_annotations(AST *ast);    // 分配并清零types和symbols，内存不足时返回0
+
+// 开始一个语句列表或参数列表，返回其在pending中的起点；push_node_list追加一个元素，内存不足时返回0
+uint32_t begin_node_list(AST *ast);
+int push_node_list(AST *ast, NodeId node);
+
+// AST节点创建函数，内存不足时返回AST_NONE
+// Names must come from the intern table; nodes keep the pointer and never copy or free it
+NodeId create_block(AST *ast, uint32_t list_start);    // 由begin_node_list之后压入的语句创建语句块
+NodeId create_decl(AST *ast, const char *type, const char *name);
+NodeId create_decl_assign(AST *ast, const char *type, const char *name, NodeId expr);
+NodeId create_assign(AST *ast, const char *name, NodeId expr);
+NodeId create_return_stmt(AST *ast, NodeId expr);
+NodeId create_if(AST *ast, NodeId cond, NodeId then_stmt, NodeId else_stmt);
+NodeId create_while(AST *ast, NodeId cond, NodeId body);
+NodeId create_binop(AST *ast, BinOpType op, NodeId left, NodeId right);
+NodeId create_var(AST *ast, const char *name);
+NodeId create_int(AST *ast, int value);
+NodeId create_float(AST *ast, float value);
+NodeId create_func_def(AST *ast, const char *ret_type, const char *name, NodeId body);
+NodeId create_call(AST *ast, const char *name, uint32_t list_start);  // 由begin_node_list之后压入的参数创建函数调用
+void set_ast_location(AST *ast, NodeId node, int line, int column);   // 设置位置信息
+
+// 非递归遍历：子节点按ast_child的顺序访问（空子节点跳过），遍历栈在堆上，
+// 任意深度的树都只占用固定的原生栈
+typedef struct ASTVisit {
+    NodeId node;
+    uint32_t index;             // 在父节点子节点中的序号（根节点为0）
+    uint32_t depth;             // 根节点为0
+    int value;                  // 供回调使用，子节点可通过up读取（如缩进、DOT编号）
+    struct ASTVisit *up;        // 父节点的访问记录，根节点为NULL；只在回调期间有效
+} ASTVisit;
+
+typedef struct {
+    int (*pre)(const AST *ast, ASTVisit *visit, void *data);    // 先序，返回0跳过子节点；可为NULL
+    void (*post)(const AST *ast, ASTVisit *visit, void *data);  // 后序，子节点都访问完后调用；可为NULL
+} ASTVisitor;
+
+uint32_t ast_child_count(const AST *ast, NodeId node);
+NodeId ast_child(const AST *ast, NodeId node, uint32_t index);   // 可能为AST_NONE
+int visit_ast(const AST *ast, NodeId root, const ASTVisitor *visitor, void *data);  // 内存不足时返回0
+
+// AST输出函数
+void print_ast(const AST *ast, NodeId node, int indent);
+int write_ast_dot(const AST *ast, NodeId node, const char *filename);       // Write the DOT file only, 0 on failure
+void export_ast_to_dot(const AST *ast, NodeId node, const char *filename); // 导出DOT文件并生成PNG
+
+#endif
@@ -0,0 +1,1210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "interpreter.h"
+#include "superinstr.h"
+#include "jit.h"
+#include "driver.h"
+#include "threadpool.h"
+#include "symbol_table.h"
+#include "intern.h"
+#include "ssa.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// 每种分派方式至少运行的次数和时间
+#define BENCH_MIN_RUNS 5
+#define BENCH_MIN_NS   200000000LL
+
+// 并行编译基准测试：每轮至少编译的单元数（每个线程数量取最好的一轮）
+#define PARALLEL_BENCH_UNITS  1024
+#define PARALLEL_BENCH_ROUNDS 3
+
+// 单调时钟（纳秒）
+long long bench_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (long long)(counter.QuadPart * 1000000000.0 / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+// 反复执行直到达到最少次数和时间，返回单次执行的最短耗时
+static long long time_dispatch(Interpreter *interp, BytecodeProgram *prog, DispatchKind kind, int *runs) {
+    long long best = -1;
+    long long total = 0;
+    int count = 0;
+
+    // 预热一次
+    execute_bytecode_with(interp, prog, kind);
+
+    while (count < BENCH_MIN_RUNS || total < BENCH_MIN_NS) {
+        long long start = bench_now_ns();
+        execute_bytecode_with(interp, prog, kind);
+        long long elapsed = bench_now_ns() - start;
+
+        total += elapsed;
+        count++;
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    *runs = count;
+    return best;
+}
+
+// 分派方式基准测试
+void run_dispatch_benchmark(BytecodeProgram *prog) {
+    Interpreter *interp = init_interpreter();
+    if (!interp) return;
+
+    // 屏蔽程序输出，只测量分派和指令执行本身
+    interp->silent = true;
+
+    long long executed = execute_bytecode_with(interp, prog, DISPATCH_COUNTED);
+    if (executed <= 0) {
+        printf("Benchmark: program executed no instructions\n");
+        free_interpreter(interp);
+        return;
+    }
+
+    printf("\n=== DISPATCH BENCHMARK ===\n");
+    printf("Static instructions:  %d\n", prog->code_count);
+    printf("Dynamic instructions: %lld per run\n", executed);
+
+    static const struct {
+        DispatchKind kind;
+        const char *name;
+    } engines[] = {
+        { DISPATCH_SWITCH, "switch" },
+#if INTERP_HAVE_THREADED
+        { DISPATCH_THREADED, "threaded" },
+#endif
+    };
+
+    double switch_ns = 0.0;
+    for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); i++) {
+        int runs = 0;
+        long long best = time_dispatch(interp, prog, engines[i].kind, &runs);
+        double per_instr = (double)best / executed;
+
+        printf("%-9s %8.3f ms/run  %6.3f ns/instruction  (%d runs)",
+               engines[i].name, best / 1e6, per_instr, runs);
+        if (engines[i].kind == DISPATCH_SWITCH) {
+            switch_ns = per_instr;
+        } else if (per_instr > 0.0) {
+            printf("  speedup %.2fx", switch_ns / per_instr);
+        }
+        printf("\n");
+    }
+#if !INTERP_HAVE_THREADED
+    printf("threaded  unavailable (compiler lacks labels-as-values)\n");
+#endif
+    printf("Default dispatch: %s\n", DISPATCH_DEFAULT == DISPATCH_THREADED ? "threaded" : "switch");
+    printf("==========================\n");
+
+    free_interpreter(interp);
+}
+
+// 超级指令基准测试
+void run_fusion_benchmark(BytecodeProgram *prog) {
+    Interpreter *interp = init_interpreter();
+    if (!interp) return;
+
+    interp->silent = true;
+
+    BytecodeProgram *fused = copy_bytecode(prog);
+    FusionStats stats;
+    fuse_superinstructions(fused, &stats);
+
+    printf("\n=== FUSION BENCHMARK ===\n");
+    print_fusion_stats(&stats);
+
+    long long plain_count = execute_bytecode_with(interp, prog, DISPATCH_COUNTED);
+    long long fused_count = execute_bytecode_with(interp, fused, DISPATCH_COUNTED);
+    printf("Dynamic dispatches: %lld -> %lld per run", plain_count, fused_count);
+    if (plain_count > 0) {
+        printf("  (saved %lld, %.1f%%)", plain_count - fused_count,
+               100.0 * (plain_count - fused_count) / plain_count);
+    }
+    printf("\n");
+
+    int plain_runs = 0, fused_runs = 0;
+    long long plain_ns = time_dispatch(interp, prog, DISPATCH_DEFAULT, &plain_runs);
+    long long fused_ns = time_dispatch(interp, fused, DISPATCH_DEFAULT, &fused_runs);
+    printf("unfused   %8.3f ms/run  (%d runs)\n", plain_ns / 1e6, plain_runs);
+    printf("fused     %8.3f ms/run  (%d runs)", fused_ns / 1e6, fused_runs);
+    if (fused_ns > 0) {
+        printf("  speedup %.2fx", (double)plain_ns / fused_ns);
+    }
+    printf("\n========================\n");
+
+    free_bytecode(fused);
+    free_interpreter(interp);
+}
+
+// JIT基准测试
+void run_jit_benchmark(BytecodeProgram *prog) {
+    Interpreter *interp = init_interpreter();
+    if (!interp) return;
+
+    interp->silent = true;
+
+    long long compile_start = bench_now_ns();
+    JitCode *jit = jit_compile(prog);
+    long long compile_ns = bench_now_ns() - compile_start;
+    if (!jit) {
+        printf("Benchmark: JIT unavailable on this platform\n");
+        free_interpreter(interp);
+        return;
+    }
+
+    printf("\n=== JIT BENCHMARK ===\n");
+    printf("Bytecode instructions: %d -> %d bytes of machine code (compiled in %.3f ms)\n",
+           prog->code_count, (int)jit->code_size, compile_ns / 1e6);
+
+    int interp_runs = 0;
+    long long interp_ns = time_dispatch(interp, prog, DISPATCH_DEFAULT, &interp_runs);
+
+    // 与time_dispatch相同的计时方式：预热一次后取最短耗时
+    long long best = -1, total = 0;
+    int jit_runs = 0;
+    jit_execute(jit, interp, prog);
+    while (jit_runs < BENCH_MIN_RUNS || total < BENCH_MIN_NS) {
+        long long start = bench_now_ns();
+        jit_execute(jit, interp, prog);
+        long long elapsed = bench_now_ns() - start;
+        total += elapsed;
+        jit_runs++;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+
+    printf("interpreter %8.3f ms/run  (%d runs)\n", interp_ns / 1e6, interp_runs);
+    printf("jit         %8.3f ms/run  (%d runs)", best / 1e6, jit_runs);
+    if (best > 0) {
+        printf("  speedup %.2fx", (double)interp_ns / best);
+    }
+    printf("\n=====================\n");
+
+    free_jit_code(jit);
+    free_interpreter(interp);
+}
+
+// 并行编译基准测试的一个任务：完整编译一个单元（不执行、不写文件）并释放
+typedef struct {
+    const char *path;
+    const CompilerOptions *options;
+    bool ok;
+} ParallelBenchTask;
+
+static void parallel_bench_task(void *arg) {
+    ParallelBenchTask *task = (ParallelBenchTask*)arg;
+    CompilerContext *ctx = init_compiler_context(task->path, task->options);
+    task->ok = ctx && compile_translation_unit(ctx);
+    free_compiler_context(ctx);
+}
+
+// 用threads个线程编译全部任务，返回耗时
+static long long time_parallel_round(ParallelBenchTask *tasks, int count, int threads, bool *all_ok) {
+    ThreadPool *pool = init_thread_pool(threads);
+    if (!pool) return -1;
+
+    long long start = bench_now_ns();
+    for (int i = 0; i < count; i++) {
+        thread_pool_submit(pool, parallel_bench_task, &tasks[i]);
+    }
+    thread_pool_wait(pool);
+    long long elapsed = bench_now_ns() - start;
+
+    free_thread_pool(pool);
+    for (int i = 0; i < count; i++) {
+        if (!tasks[i].ok) *all_ok = false;
+    }
+    return elapsed;
+}
+
+// 并行编译基准测试
+void run_parallel_benchmark(const char **paths, int path_count, int max_threads) {
+    if (max_threads <= 0) {
+        max_threads = cpu_count();
+    }
+
+    CompilerOptions options = { NULL, NULL, false, false, false };
+    int count = PARALLEL_BENCH_UNITS;
+    if (count < max_threads * 16) count = max_threads * 16;
+    ParallelBenchTask *tasks = (ParallelBenchTask*)malloc(sizeof(ParallelBenchTask) * count);
+    if (!tasks) return;
+    for (int i = 0; i < count; i++) {
+        tasks[i].path = paths[i % path_count];
+        tasks[i].options = &options;
+        tasks[i].ok = false;
+    }
+
+    printf("\n=== PARALLEL COMPILATION BENCHMARK ===\n");
+    printf("Translation units: %d per round (%d source file%s), %d cores\n",
+           count, path_count, path_count == 1 ? "" : "s", cpu_count());
+
+    // 线程数按1, 2, 4, ...翻倍，最后一项为max_threads
+    double base_ns = 0.0;
+    for (int threads = 1; ; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        bool all_ok = true;
+        long long best = -1;
+        for (int round = 0; round < PARALLEL_BENCH_ROUNDS; round++) {
+            long long elapsed = time_parallel_round(tasks, count, threads, &all_ok);
+            if (elapsed > 0 && (best < 0 || elapsed < best)) best = elapsed;
+        }
+        if (!all_ok) {
+            printf("Benchmark: compilation failed\n");
+            break;
+        }
+        if (threads == 1) base_ns = (double)best;
+
+        double speedup = best > 0 ? base_ns / best : 0.0;
+        printf("%3d thread%s %9.3f ms  %9.1f units/s  speedup %5.2fx  efficiency %5.1f%%\n",
+               threads, threads == 1 ? " " : "s", best / 1e6, count * 1e9 / best,
+               speedup, 100.0 * speedup / threads);
+        if (threads == max_threads) break;
+    }
+    printf("======================================\n");
+
+    free(tasks);
+}
+
+// 阶段选择基准测试的一种配置
+typedef struct {
+    const char *name;
+    unsigned emit;
+    bool syntax_only;
+    bool no_optimization;
+} StageBenchConfig;
+
+// 用给定选项反复编译（写出所选产物，不执行），返回单次编译的最短耗时；
+// stage_ns非NULL时保存最快一次编译的各阶段耗时
+static long long time_stage_config(const char *path, const CompilerOptions *options, long long *stage_ns) {
+    long long best = -1, total = 0;
+    int runs = 0;
+    while (runs < BENCH_MIN_RUNS || total < BENCH_MIN_NS / 2) {
+        CompilerContext *ctx = init_compiler_context(path, options);
+        if (!ctx) return -1;
+        set_artifact_paths(ctx, NULL);
+        long long start = bench_now_ns();
+        bool ok = compile_translation_unit(ctx);
+        long long elapsed = bench_now_ns() - start;
+        if (stage_ns && ok && (best < 0 || elapsed < best)) {
+            for (int i = 0; i < STAGE_COUNT; i++) stage_ns[i] = ctx->stage_ns[i];
+        }
+        free_compiler_context(ctx);
+        if (!ok) return -1;
+
+        total += elapsed;
+        runs++;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+void run_stage_benchmark(const char *path, int opt_level) {
+    static const StageBenchConfig configs[] = {
+        { "full pipeline",            EMIT_ALL,                   false, false },
+        { "without --dump-ast=dot",   EMIT_ALL & ~EMIT_AST_DOT,   false, false },
+        { "without pseudo assembly",  EMIT_ALL & ~EMIT_PSEUDO,    false, false },
+        { "without C code",           EMIT_ALL & ~EMIT_C,         false, false },
+        { "without bytecode",         EMIT_ALL & ~EMIT_BYTECODE,  false, false },
+        { "-O0",                      EMIT_ALL,                   false, true  },
+        { "--emit=bytecode",          EMIT_BYTECODE,              false, false },
+        { "-fsyntax-only",            0,                          true,  false },
+    };
+    int config_count = (int)(sizeof(configs) / sizeof(configs[0]));
+
+    printf("\n=== STAGE SELECTION BENCHMARK ===\n");
+    printf("Source: %s, -O%d (artifacts written to the default file names)\n", path, opt_level);
+
+    long long full_stage_ns[STAGE_COUNT];
+    long long full_ns = 0;
+    for (int i = 0; i < config_count; i++) {
+        CompilerOptions options;
+        init_compiler_options(&options);
+        options.verbose = false;
+        options.execute = false;
+        options.emit = configs[i].emit;
+        options.syntax_only = configs[i].syntax_only;
+        options.opt_level = configs[i].no_optimization ? 0 : opt_level;
+
+        long long ns = time_stage_config(path, &options, i == 0 ? full_stage_ns : NULL);
+        if (ns < 0) {
+            printf("Benchmark: compilation failed\n");
+            return;
+        }
+        if (i == 0) {
+            full_ns = ns;
+            printf("%-26s %9.3f ms/compile\n", configs[i].name, ns / 1e6);
+        } else {
+            long long saved = full_ns - ns;
+            printf("%-26s %9.3f ms/compile  saves %8.3f ms (%5.1f%%)\n", configs[i].name, ns / 1e6,
+                   saved / 1e6, full_ns > 0 ? 100.0 * saved / full_ns : 0.0);
+        }
+    }
+    printf("Stage times of the full pipeline:");
+    print_stage_times(full_stage_ns);
+}
+
+// 原来的AST布局：每个节点单独malloc，子节点用指针相连（只用于AST布局基准测试的对照）
+typedef struct PointerNode {
+    NodeType type;
+    int line_number;
+    int column;
+    struct PointerNode *left;
+    struct PointerNode *right;
+    union {
+        struct { const char *name; char *var_type; } decl;
+        struct { BinOpType op; } binop;
+        struct { int value; } integer;
+        struct { float value; } floating;
+        struct { struct PointerNode *cond; } if_stmt;
+        struct { const char *name; struct PointerNode **args; int arg_count; } call;   // 语句块的语句也存放在args中
+    };
+} PointerNode;
+
+// 按节点编号顺序（即语法分析器创建节点的顺序）逐个分配，再连接子节点
+static PointerNode* build_pointer_tree(const AST *ast, NodeId root, long *allocations) {
+    PointerNode **nodes = (PointerNode**)calloc(ast->count, sizeof(PointerNode*));
+    if (!nodes) return NULL;
+    for (NodeId id = 1; id < ast->count; id++) {
+        nodes[id] = (PointerNode*)malloc(sizeof(PointerNode));
+        (*allocations)++;
+    }
+    for (NodeId id = 1; id < ast->count; id++) {
+        PointerNode *node = nodes[id];
+        const ASTPayload *p = &ast->payloads[id];
+        node->type = (NodeType)ast->kinds[id];
+        node->line_number = ast->locations[id].line;
+        node->column = ast->locations[id].column;
+        node->left = nodes[ast->lefts[id]];
+        node->right = nodes[ast->rights[id]];
+        switch (node->type) {
+            case STMT_DECL:
+            case STMT_DECL_ASSIGN:
+                node->decl.name = p->decl.name;
+                node->decl.var_type = NULL;
+                break;
+            case EXPR_BINOP: node->binop.op = p->binop.op; break;
+            case EXPR_INT: node->integer.value = p->integer.value; break;
+            case EXPR_FLOAT: node->floating.value = p->floating.value; break;
+            case STMT_IF: node->if_stmt.cond = nodes[p->if_stmt.cond]; break;
+            case STMT_WHILE: node->if_stmt.cond = nodes[p->while_stmt.cond]; break;
+            case STMT_CALL:
+            case EXPR_CALL:
+                node->call.name = p->call.name;
+                node->call.arg_count = (int)p->call.arg_count;
+                node->call.args = (PointerNode**)malloc(sizeof(PointerNode*) * (p->call.arg_count + 1));
+                (*allocations)++;
+                for (uint32_t i = 0; i < p->call.arg_count; i++) {
+                    node->call.args[i] = nodes[AST_CALL_ARG(ast, id, i)];
+                }
+                break;
+            case STMT_COMPOUND:
+                node->call.name = NULL;
+                node->call.arg_count = (int)p->block.stmt_count;
+                node->call.args = (PointerNode**)malloc(sizeof(PointerNode*) * (p->block.stmt_count + 1));
+                (*allocations)++;
+                for (uint32_t i = 0; i < p->block.stmt_count; i++) {
+                    node->call.args[i] = nodes[AST_BLOCK_STMT(ast, id, i)];
+                }
+                break;
+            default:
+                node->decl.name = p->decl.name;
+                node->decl.var_type = NULL;
+                break;
+        }
+    }
+    PointerNode *tree = nodes[root];
+    free(nodes);
+    return tree;
+}
+
+static void free_pointer_tree(PointerNode *node) {
+    if (!node) return;
+    if (node->type == STMT_IF || node->type == STMT_WHILE) {
+        free_pointer_tree(node->if_stmt.cond);
+    } else if (node->type == STMT_CALL || node->type == EXPR_CALL || node->type == STMT_COMPOUND) {
+        for (int i = 0; i < node->call.arg_count; i++) {
+            free_pointer_tree(node->call.args[i]);
+        }
+        free(node->call.args);
+    }
+    free_pointer_tree(node->left);
+    free_pointer_tree(node->right);
+    free(node);
+}
+
+// 两种布局上做同样的遍历：访问每个节点的类型和常量值
+static unsigned long walk_pointer_tree(const PointerNode *node) {
+    if (!node) return 0;
+    unsigned long sum = (unsigned long)node->type;
+    switch (node->type) {
+        case EXPR_INT: sum += (unsigned long)node->integer.value; break;
+        case EXPR_BINOP: sum += (unsigned long)node->binop.op; break;
+        case STMT_IF:
+        case STMT_WHILE: sum += walk_pointer_tree(node->if_stmt.cond); break;
+        case STMT_CALL:
+        case EXPR_CALL:
+        case STMT_COMPOUND:
+            for (int i = 0; i < node->call.arg_count; i++) {
+                sum += walk_pointer_tree(node->call.args[i]);
+            }
+            break;
+        default: break;
+    }
+    return sum + walk_pointer_tree(node->left) + walk_pointer_tree(node->right);
+}
+
+static unsigned long walk_ast(const AST *ast, NodeId node) {
+    if (node == AST_NONE) return 0;
+    unsigned long sum = ast->kinds[node];
+    const ASTPayload *p = &ast->payloads[node];
+    switch ((NodeType)ast->kinds[node]) {
+        case EXPR_INT: sum += (unsigned long)p->integer.value; break;
+        case EXPR_BINOP: sum += (unsigned long)p->binop.op; break;
+        case STMT_IF: sum += walk_ast(ast, p->if_stmt.cond); break;
+        case STMT_WHILE: sum += walk_ast(ast, p->while_stmt.cond); break;
+        case STMT_CALL:
+        case EXPR_CALL:
+            for (uint32_t i = 0; i < p->call.arg_count; i++) {
+                sum += walk_ast(ast, AST_CALL_ARG(ast, node, i));
+            }
+            break;
+        case STMT_COMPOUND:
+            for (uint32_t i = 0; i < p->block.stmt_count; i++) {
+                sum += walk_ast(ast, AST_BLOCK_STMT(ast, node, i));
+            }
+            break;
+        default: break;
+    }
+    return sum + walk_ast(ast, ast->lefts[node]) + walk_ast(ast, ast->rights[node]);
+}
+
+// 同样的遍历用visit_ast完成，与上面的递归版本比较
+static int sum_visit_pre(const AST *ast, ASTVisit *visit, void *data) {
+    unsigned long *sum = (unsigned long*)data;
+    NodeId node = visit->node;
+    *sum += ast->kinds[node];
+    if (ast->kinds[node] == EXPR_INT) *sum += (unsigned long)ast->payloads[node].integer.value;
+    else if (ast->kinds[node] == EXPR_BINOP) *sum += (unsigned long)ast->payloads[node].binop.op;
+    return 1;
+}
+
+// visit_ast的递归写法（回调和访问记录相同），用来单独衡量显式栈的开销
+static void visit_ast_recursive(const AST *ast, NodeId node, ASTVisit *up, uint32_t index,
+                                const ASTVisitor *visitor, void *data) {
+    ASTVisit visit = { node, index, up ? up->depth + 1 : 0, 0, up };
+    if (!visitor->pre || visitor->pre(ast, &visit, data)) {
+        uint32_t count = ast_child_count(ast, node);
+        for (uint32_t i = 0; i < count; i++) {
+            NodeId child = ast_child(ast, node, i);
+            if (child != AST_NONE) visit_ast_recursive(ast, child, &visit, i, visitor, data);
+        }
+    }
+    if (visitor->post) visitor->post(ast, &visit, data);
+}
+
+// 复制节点池（只复制已使用的部分），用于反复测量释放耗时
+static AST* copy_ast(const AST *ast) {
+    AST *copy = (AST*)calloc(1, sizeof(AST));
+    if (!copy) return NULL;
+    copy->count = copy->capacity = ast->count;
+    copy->list_count = copy->list_capacity = ast->list_count;
+    copy->kinds = (uint8_t*)malloc(ast->count * sizeof(uint8_t));
+    copy->lefts = (NodeId*)malloc(ast->count * sizeof(NodeId));
+    copy->rights = (NodeId*)malloc(ast->count * sizeof(NodeId));
+    copy->payloads = (ASTPayload*)malloc(ast->count * sizeof(ASTPayload));
+    copy->locations = (ASTLocation*)malloc(ast->count * sizeof(ASTLocation));
+    copy->lists = (NodeId*)malloc((ast->list_count + 1) * sizeof(NodeId));
+    if (!copy->kinds || !copy->lefts || !copy->rights || !copy->payloads || !copy->locations || !copy->lists) {
+        free_ast(copy);
+        return NULL;
+    }
+    memcpy(copy->kinds, ast->kinds, ast->count * sizeof(uint8_t));
+    memcpy(copy->lefts, ast->lefts, ast->count * sizeof(NodeId));
+    memcpy(copy->rights, ast->rights, ast->count * sizeof(NodeId));
+    memcpy(copy->payloads, ast->payloads, ast->count * sizeof(ASTPayload));
+    memcpy(copy->locations, ast->locations, ast->count * sizeof(ASTLocation));
+    memcpy(copy->lists, ast->lists, ast->list_count * sizeof(NodeId));
+    return copy;
+}
+
+void run_ast_benchmark(const char *path) {
+    CompilerOptions options;
+    init_compiler_options(&options);
+    options.verbose = false;
+    CompilerContext *ctx = init_compiler_context(path, &options);
+    if (!ctx || !parse_translation_unit(ctx)) {
+        printf("Benchmark: parsing failed\n");
+        free_compiler_context(ctx);
+        return;
+    }
+    const AST *ast = ctx->ast;
+    long node_count = (long)ast->count - 1;
+
+    long allocations = 0;
+    PointerNode *tree = build_pointer_tree(ast, ctx->root, &allocations);
+    if (!tree) {
+        printf("Benchmark: out of memory\n");
+        free_compiler_context(ctx);
+        return;
+    }
+
+    // 节点池每个节点占用的字节数（各数组一项），语句块的语句和函数调用参数另存于lists
+    size_t pool_bytes = sizeof(uint8_t) + 2 * sizeof(NodeId) + sizeof(ASTPayload) + sizeof(ASTLocation);
+    printf("\n=== AST LAYOUT BENCHMARK ===\n");
+    printf("Source: %s, %ld nodes, %u list entries (block statements and call arguments)\n", path, node_count, ast->list_count);
+    printf("pointer nodes  %3zu bytes/node + malloc header, %ld allocations\n", sizeof(PointerNode), allocations);
+    printf("index pools    %3zu bytes/node, 7 growable arrays (%.1f%% of pointer node size)\n",
+           pool_bytes, 100.0 * pool_bytes / sizeof(PointerNode));
+
+    // 遍历：指针树递归、节点池递归、节点池显式栈（visit_ast），各自重复到最少次数和时间，取最短一次
+    ASTVisitor sum_visitor = { sum_visit_pre, NULL };
+    unsigned long pointer_sum = 0, pool_sum = 0, visit_sum = 0, recursive_sum = 0;
+    long long pointer_ns = -1, pool_ns = -1, visit_ns = -1, recursive_ns = -1;
+    for (int layout = 0; layout < 4; layout++) {
+        long long best = -1, total = 0;
+        int runs = 0;
+        while (runs < BENCH_MIN_RUNS || total < BENCH_MIN_NS / 2) {
+            long long start = bench_now_ns();
+            if (layout == 0) pointer_sum = walk_pointer_tree(tree);
+            else if (layout == 1) pool_sum = walk_ast(ast, ctx->root);
+            else if (layout == 2) {
+                visit_sum = 0;
+                visit_ast(ast, ctx->root, &sum_visitor, &visit_sum);
+            } else {
+                recursive_sum = 0;
+                visit_ast_recursive(ast, ctx->root, NULL, 0, &sum_visitor, &recursive_sum);
+            }
+            long long elapsed = bench_now_ns() - start;
+            total += elapsed;
+            runs++;
+            if (best < 0 || elapsed < best) best = elapsed;
+        }
+        if (layout == 0) pointer_ns = best;
+        else if (layout == 1) pool_ns = best;
+        else if (layout == 2) visit_ns = best;
+        else recursive_ns = best;
+    }
+    if (pointer_sum != pool_sum || visit_sum != pool_sum || recursive_sum != pool_sum) {
+        printf("Benchmark: traversal results differ (%lu, %lu, %lu, %lu)\n",
+               pointer_sum, pool_sum, visit_sum, recursive_sum);
+    }
+    printf("traversal      pointer %8.3f ms (%5.2f ns/node)  pools %8.3f ms (%5.2f ns/node)",
+           pointer_ns / 1e6, (double)pointer_ns / node_count, pool_ns / 1e6, (double)pool_ns / node_count);
+    if (pool_ns > 0) printf("  speedup %.2fx", (double)pointer_ns / pool_ns);
+    printf("\n");
+    printf("visitor        recursive %8.3f ms (%5.2f ns/node)  explicit stack %8.3f ms (%5.2f ns/node)",
+           recursive_ns / 1e6, (double)recursive_ns / node_count, visit_ns / 1e6, (double)visit_ns / node_count);
+    if (visit_ns > 0) printf("  speedup %.2fx", (double)recursive_ns / visit_ns);
+    printf("\n");
+
+    // 释放：指针树逐个节点释放，节点池整体释放（每轮重新构建，构建时间不计入）
+    long long pointer_free_ns = -1, pool_free_ns = -1;
+    for (int round = 0; round < BENCH_MIN_RUNS; round++) {
+        long long start = bench_now_ns();
+        free_pointer_tree(tree);
+        long long elapsed = bench_now_ns() - start;
+        if (pointer_free_ns < 0 || elapsed < pointer_free_ns) pointer_free_ns = elapsed;
+        tree = round + 1 < BENCH_MIN_RUNS ? build_pointer_tree(ast, ctx->root, &allocations) : NULL;
+
+        AST *copy = copy_ast(ast);
+        if (!copy) break;
+        start = bench_now_ns();
+        free_ast(copy);
+        elapsed = bench_now_ns() - start;
+        if (pool_free_ns < 0 || elapsed < pool_free_ns) pool_free_ns = elapsed;
+    }
+    free_pointer_tree(tree);
+    printf("free           pointer %8.3f ms                    pools %8.3f ms\n",
+           pointer_free_ns / 1e6, pool_free_ns / 1e6);
+    printf("============================\n");
+
+    free_compiler_context(ctx);
+}
+
+// 原来的符号表：单链表，新符号插在表头，查找和离开作用域都要扫描整个链表（只用于符号表基准测试的对照）
+typedef struct ListSymbol {
+    const char *name;
+    DataType type;
+    int scope_level;
+    struct ListSymbol *next;
+} ListSymbol;
+
+typedef struct {
+    ListSymbol *head;
+    int current_scope;
+} ListSymbolTable;
+
+static void* list_table_create(void) {
+    return calloc(1, sizeof(ListSymbolTable));
+}
+
+static void list_table_destroy(void *table) {
+    ListSymbol *current = ((ListSymbolTable*)table)->head;
+    while (current) {
+        ListSymbol *next = current->next;
+        free(current);
+        current = next;
+    }
+    free(table);
+}
+
+static void list_table_enter(void *table) {
+    ((ListSymbolTable*)table)->current_scope++;
+}
+
+static void list_table_leave(void *table) {
+    ListSymbolTable *list = (ListSymbolTable*)table;
+    ListSymbol **link = &list->head;
+    while (*link) {
+        if ((*link)->scope_level == list->current_scope) {
+            ListSymbol *to_delete = *link;
+            *link = to_delete->next;
+            free(to_delete);
+        } else {
+            link = &(*link)->next;
+        }
+    }
+    list->current_scope--;
+}
+
+static bool list_table_lookup(void *table, const char *name) {
+    for (ListSymbol *current = ((ListSymbolTable*)table)->head; current; current = current->next) {
+        if (current->name == name) return true;
+    }
+    return false;
+}
+
+// 与语义分析相同：先检查当前作用域中是否重复声明，再加入
+static bool list_table_declare(void *table, const char *name, DataType type) {
+    ListSymbolTable *list = (ListSymbolTable*)table;
+    for (ListSymbol *current = list->head; current; current = current->next) {
+        if (current->scope_level == list->current_scope && current->name == name) return false;
+    }
+    ListSymbol *entry = (ListSymbol*)malloc(sizeof(ListSymbol));
+    if (!entry) return false;
+    entry->name = name;
+    entry->type = type;
+    entry->scope_level = list->current_scope;
+    entry->next = list->head;
+    list->head = entry;
+    return true;
+}
+
+static void* hash_table_create(void) { return init_symbol_table(); }
+static void hash_table_destroy(void *table) { free_symbol_table((SymbolTable*)table); }
+static void hash_table_enter(void *table) { enter_scope((SymbolTable*)table); }
+static void hash_table_leave(void *table) { leave_scope((SymbolTable*)table); }
+
+static bool hash_table_lookup(void *table, const char *name) {
+    return lookup_symbol((SymbolTable*)table, name) != NULL;
+}
+
+static bool hash_table_declare(void *table, const char *name, DataType type) {
+    if (lookup_symbol_current_scope((SymbolTable*)table, name)) return false;
+    return add_symbol((SymbolTable*)table, name, SYM_VARIABLE, type);
+}
+
+typedef struct {
+    void* (*create)(void);
+    void (*destroy)(void *table);
+    void (*enter)(void *table);
+    void (*leave)(void *table);
+    bool (*declare)(void *table, const char *name, DataType type);
+    bool (*lookup)(void *table, const char *name);
+} SymtabOps;
+
+static const SymtabOps list_symtab_ops = {
+    list_table_create, list_table_destroy, list_table_enter, list_table_leave, list_table_declare, list_table_lookup
+};
+static const SymtabOps hash_symtab_ops = {
+    hash_table_create, hash_table_destroy, hash_table_enter, hash_table_leave, hash_table_declare, hash_table_lookup
+};
+
+#define SYMTAB_BENCH_GLOBALS 100
+
+// 一个函数中声明count个变量，每个变量再被使用4次（使用顺序与声明顺序错开）
+static long symtab_flat_workload(const SymtabOps *ops, const char **names, int count) {
+    void *table = ops->create();
+    long found = 0;
+    ops->enter(table);
+    for (int i = 0; i < count; i++) {
+        found += ops->declare(table, names[i], TYPE_INT);
+    }
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < count; i++) {
+            found += ops->lookup(table, names[(i * 7 + round) % count]);
+        }
+    }
+    ops->leave(table);
+    ops->destroy(table);
+    return found;
+}
+
+// 外层声明100个变量，之后嵌套depth层作用域，每层声明两个变量（其中x遮蔽外层的x），
+// 使用本层、上一层和最外层的变量各一次，最后逐层退出
+static long symtab_nested_workload(const SymtabOps *ops, const char **names, int depth) {
+    const char **globals = names;
+    const char **locals = names + SYMTAB_BENCH_GLOBALS;
+    const char *shadowed = names[SYMTAB_BENCH_GLOBALS + depth];
+    void *table = ops->create();
+    long found = 0;
+    ops->enter(table);
+    for (int i = 0; i < SYMTAB_BENCH_GLOBALS; i++) {
+        found += ops->declare(table, globals[i], TYPE_INT);
+    }
+    for (int level = 0; level < depth; level++) {
+        ops->enter(table);
+        found += ops->declare(table, shadowed, TYPE_FLOAT);
+        found += ops->declare(table, locals[level], TYPE_INT);
+        found += ops->lookup(table, shadowed);
+        found += ops->lookup(table, locals[level > 0 ? level - 1 : 0]);
+        found += ops->lookup(table, globals[level % SYMTAB_BENCH_GLOBALS]);
+    }
+    for (int level = 0; level <= depth; level++) {
+        ops->leave(table);
+    }
+    ops->destroy(table);
+    return found;
+}
+
+// 至少运行3次或达到最少时间，返回最短一次
+static long long time_symtab_workload(const SymtabOps *ops, bool nested, const char **names, int size, long *found) {
+    long long best = -1, total = 0;
+    int runs = 0;
+    while (runs < 3 || total < BENCH_MIN_NS / 4) {
+        long long start = bench_now_ns();
+        *found = nested ? symtab_nested_workload(ops, names, size) : symtab_flat_workload(ops, names, size);
+        long long elapsed = bench_now_ns() - start;
+        total += elapsed;
+        runs++;
+        if (best < 0 || elapsed < best) best = elapsed;
+        if (elapsed > BENCH_MIN_NS) break;  // 链表版本的大规模用例只运行一次
+    }
+    return best;
+}
+
+void run_symtab_benchmark(void) {
+    static const int flat_sizes[] = { 1000, 10000, 20000 };
+    static const int nested_depths[] = { 100, 1000, 5000 };
+    const int max_names = 20000 + SYMTAB_BENCH_GLOBALS + 1;
+
+    InternTable *interned = init_intern_table();
+    const char **names = (const char**)malloc(max_names * sizeof(const char*));
+    if (!interned || !names) {
+        printf("Benchmark: out of memory\n");
+        free_intern_table(interned);
+        free(names);
+        return;
+    }
+    for (int i = 0; i < max_names; i++) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "v%d", i);
+        names[i] = intern_cstr(interned, buffer);
+    }
+
+    printf("\n=== SYMBOL TABLE BENCHMARK ===\n");
+    printf("%-28s %12s %12s %9s\n", "workload", "list (ms)", "hash (ms)", "speedup");
+    for (int pass = 0; pass < 2; pass++) {
+        bool nested = pass == 1;
+        const int *sizes = nested ? nested_depths : flat_sizes;
+        for (int i = 0; i < 3; i++) {
+            long list_found = 0, hash_found = 0;
+            long long list_ns = time_symtab_workload(&list_symtab_ops, nested, names, sizes[i], &list_found);
+            long long hash_ns = time_symtab_workload(&hash_symtab_ops, nested, names, sizes[i], &hash_found);
+            char label[64];
+            if (nested) snprintf(label, sizeof(label), "nested scopes, depth %d", sizes[i]);
+            else snprintf(label, sizeof(label), "one scope, %d variables", sizes[i]);
+            printf("%-28s %12.3f %12.3f %8.1fx\n", label, list_ns / 1e6, hash_ns / 1e6,
+                   hash_ns > 0 ? (double)list_ns / hash_ns : 0.0);
+            if (list_found != hash_found) {
+                printf("Benchmark: results differ (%ld vs %ld)\n", list_found, hash_found);
+            }
+        }
+    }
+    printf("==============================\n");
+
+    free(names);
+    free_intern_table(interned);
+}
+
+// IR基准测试中比较删除指令的范围（原来的删除是O(N)，整个大函数上要运行很久）
+#define IR_BENCH_REMOVE_LIMIT 10000
+
+// 原来的IR布局：每条指令和每个操作数各自malloc，标签名复制一份（只用于IR布局基准测试的对照）
+typedef struct PointerOperand {
+    OperandType type;
+    DataType data_type;
+    union {
+        int temp_id;
+        const char *var_name;
+        int int_val;
+        float float_val;
+        char *label_name;
+    };
+} PointerOperand;
+
+typedef struct PointerInstr {
+    IROpcode opcode;
+    PointerOperand *result;
+    PointerOperand *operand1;
+    PointerOperand *operand2;
+    BinOpType binop;
+    int line;
+    int column;
+    struct PointerInstr *next;
+} PointerInstr;
+
+static PointerOperand* copy_to_pointer_operand(const Operand *operand, long *allocations) {
+    if (operand->type == OPERAND_NONE) return NULL;
+    PointerOperand *copy = (PointerOperand*)malloc(sizeof(PointerOperand));
+    (*allocations)++;
+    copy->type = operand->type;
+    copy->data_type = operand->data_type;
+    if (operand->type == OPERAND_LABEL) {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "L%d", operand->label_id);
+        copy->label_name = strdup(buffer);
+        (*allocations)++;
+    } else if (operand->type == OPERAND_CONST) {
+        copy->int_val = operand->const_val.int_val;
+    } else {
+        copy->var_name = operand->var_name;
+    }
+    return copy;
+}
+
+static void free_pointer_operand(PointerOperand *operand) {
+    if (!operand) return;
+    if (operand->type == OPERAND_LABEL) free(operand->label_name);
+    free(operand);
+}
+
+// 按原来的方式逐条复制指令链表
+static PointerInstr* build_pointer_ir(const IRGenerator *source, long *allocations) {
+    PointerInstr *head = NULL, **tail = &head;
+    for (const IRInstruction *instr = source->instructions; instr; instr = instr->next) {
+        PointerInstr *copy = (PointerInstr*)malloc(sizeof(PointerInstr));
+        (*allocations)++;
+        copy->opcode = instr->opcode;
+        copy->result = copy_to_pointer_operand(&instr->result, allocations);
+        copy->operand1 = copy_to_pointer_operand(&instr->operand1, allocations);
+        copy->operand2 = copy_to_pointer_operand(&instr->operand2, allocations);
+        copy->binop = instr->binop;
+        copy->line = instr->line;
+        copy->column = instr->column;
+        copy->next = NULL;
+        *tail = copy;
+        tail = &copy->next;
+    }
+    return head;
+}
+
+// 改写：与常量传播替换操作数的方式相同，每个常量操作数换成一个新的常量操作数
+static long rewrite_pointer_ir(PointerInstr *head) {
+    long rewritten = 0;
+    for (PointerInstr *instr = head; instr; instr = instr->next) {
+        PointerOperand **slots[2] = { &instr->operand1, &instr->operand2 };
+        for (int i = 0; i < 2; i++) {
+            PointerOperand *old = *slots[i];
+            if (!old || old->type != OPERAND_CONST) continue;
+            PointerOperand *replacement = (PointerOperand*)malloc(sizeof(PointerOperand));
+            *replacement = *old;
+            free_pointer_operand(old);
+            *slots[i] = replacement;
+            rewritten++;
+        }
+    }
+    return rewritten;
+}
+
+static void free_pointer_ir(PointerInstr *head) {
+    while (head) {
+        PointerInstr *next = head->next;
+        free_pointer_operand(head->result);
+        free_pointer_operand(head->operand1);
+        free_pointer_operand(head->operand2);
+        free(head);
+        head = next;
+    }
+}
+
+// 同样的复制和改写在区域分配的IR上完成
+static IRGenerator* build_arena_ir(const IRGenerator *source, long *allocations) {
+    IRGenerator *gen = init_ir_generator(source->symbol_table);
+    if (!gen) return NULL;
+    for (const IRInstruction *instr = source->instructions; instr; instr = instr->next) {
+        IRInstruction *copy = create_ir_instruction(gen, instr->opcode);
+        if (!copy) break;
+        *copy = *instr;
+        copy->next = NULL;
+        append_instruction(gen, copy);
+    }
+    *allocations = 1;
+    for (IRArenaBlock *block = gen->arena; block; block = block->next) (*allocations)++;
+    return gen;
+}
+
+static long rewrite_arena_ir(IRGenerator *gen) {
+    long rewritten = 0;
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        Operand *slots[2] = { &instr->operand1, &instr->operand2 };
+        for (int i = 0; i < 2; i++) {
+            if (slots[i]->type != OPERAND_CONST) continue;
+            Operand replacement = *slots[i];
+            *slots[i] = replacement;
+            rewritten++;
+        }
+    }
+    return rewritten;
+}
+
+// 原来的remove_instruction：从表头扫描找前驱，摘下表尾时再扫描整个链表求新的表尾
+static void remove_pointer_instr(PointerInstr **head, PointerInstr **tail, PointerInstr *instr) {
+    if (*head == instr) {
+        *head = instr->next;
+    } else {
+        PointerInstr *prev = *head;
+        while (prev && prev->next != instr) prev = prev->next;
+        if (prev) prev->next = instr->next;
+    }
+    if (*tail == instr) {
+        *tail = *head;
+        while (*tail && (*tail)->next) *tail = (*tail)->next;
+    }
+    free_pointer_operand(instr->result);
+    free_pointer_operand(instr->operand1);
+    free_pointer_operand(instr->operand2);
+    free(instr);
+}
+
+// 删除前limit条中的每隔一条（与死代码消除一样边遍历边删除），返回删除的条数
+static long remove_pointer_every_other(PointerInstr **head, long limit) {
+    PointerInstr *tail = *head;
+    while (tail && tail->next) tail = tail->next;
+    long removed = 0, index = 0;
+    for (PointerInstr *instr = *head; instr && index < limit; index++) {
+        PointerInstr *next = instr->next;
+        if (index % 2 == 1) {
+            remove_pointer_instr(head, &tail, instr);
+            removed++;
+        }
+        instr = next;
+    }
+    return removed;
+}
+
+static long remove_arena_every_other(IRGenerator *gen, long limit) {
+    long removed = 0, index = 0;
+    for (IRInstruction *instr = gen->instructions; instr && index < limit; index++) {
+        IRInstruction *next = instr->next;
+        if (index % 2 == 1) {
+            remove_instruction(gen, instr);
+            removed++;
+        }
+        instr = next;
+    }
+    return removed;
+}
+
+void run_ir_benchmark(const char *path) {
+    CompilerOptions options;
+    init_compiler_options(&options);
+    options.verbose = false;
+    options.execute = false;    // 只做语法和语义分析，IR由下面生成
+    CompilerContext *ctx = init_compiler_context(path, &options);
+    if (!ctx || !compile_translation_unit(ctx)) {
+        printf("Benchmark: compilation failed\n");
+        free_compiler_context(ctx);
+        return;
+    }
+
+    // 先生成一份参照IR，两种布局都从它复制，只比较分配方式
+    IRGenerator *source = init_ir_generator(ctx->semantic_context->symbol_table);
+    if (!source) {
+        printf("Benchmark: out of memory\n");
+        free_compiler_context(ctx);
+        return;
+    }
+    long long start = bench_now_ns();
+    generate_ir(ctx->ast, ctx->root, source);
+    long long generate_ns = bench_now_ns() - start;
+    long instr_count = 0;
+    for (IRInstruction *instr = source->instructions; instr; instr = instr->next) instr_count++;
+
+    // 第一轮两种布局都使用新分配的页（缺页中断计入），之后各轮复用已释放的内存，取最短一次
+    long long first[2][3], best[2][3] = { { -1, -1, -1 }, { -1, -1, -1 } };   // [布局][构建、改写、释放]
+    long allocations[2] = { 0, 0 };
+    long rewritten[2] = { 0, 0 };
+    long long total = 0;
+    int runs = 0;
+    while (runs < BENCH_MIN_RUNS || total < BENCH_MIN_NS) {
+        for (int i = 0; i < 2; i++) {
+            // 第一轮先测区域：它的大块释放后还给系统，不会留给另一种布局复用
+            int layout = runs == 0 ? 1 - i : i;
+            long long times[3];
+            allocations[layout] = 0;
+            if (layout == 0) {
+                long long t0 = bench_now_ns();
+                PointerInstr *head = build_pointer_ir(source, &allocations[0]);
+                long long t1 = bench_now_ns();
+                rewritten[0] = rewrite_pointer_ir(head);
+                long long t2 = bench_now_ns();
+                free_pointer_ir(head);
+                long long t3 = bench_now_ns();
+                times[0] = t1 - t0; times[1] = t2 - t1; times[2] = t3 - t2;
+            } else {
+                long long t0 = bench_now_ns();
+                IRGenerator *gen = build_arena_ir(source, &allocations[1]);
+                long long t1 = bench_now_ns();
+                rewritten[1] = gen ? rewrite_arena_ir(gen) : 0;
+                long long t2 = bench_now_ns();
+                if (gen) free_ir_generator(gen);
+                long long t3 = bench_now_ns();
+                times[0] = t1 - t0; times[1] = t2 - t1; times[2] = t3 - t2;
+            }
+            for (int phase = 0; phase < 3; phase++) {
+                total += times[phase];
+                if (runs == 0) first[layout][phase] = times[phase];
+                if (best[layout][phase] < 0 || times[phase] < best[layout][phase]) best[layout][phase] = times[phase];
+            }
+        }
+        runs++;
+    }
+    if (rewritten[0] != rewritten[1]) {
+        printf("Benchmark: rewrite counts differ (%ld vs %ld)\n", rewritten[0], rewritten[1]);
+    }
+
+    printf("\n=== IR ALLOCATION BENCHMARK ===\n");
+    printf("Source: %s, %ld instructions, generated in %.3f ms\n", path, instr_count, generate_ns / 1e6);
+    printf("%-24s %14s %14s\n", "", "malloc each", "arena");
+    printf("%-24s %14zu %14zu\n", "bytes/instruction", sizeof(PointerInstr) + 3 * sizeof(PointerOperand),
+           sizeof(IRInstruction));
+    printf("%-24s %14ld %14ld\n", "allocations", allocations[0], allocations[1]);
+    static const char *phase_names[] = { "build (ms)", "rewrite (ms)", "free (ms)" };
+    for (int pass = 0; pass < 2; pass++) {
+        long long (*times)[3] = pass == 0 ? first : best;
+        printf(pass == 0 ? "first run:\n" : "best of %d runs:\n", runs);
+        for (int phase = 0; phase < 3; phase++) {
+            printf("  %-22s %14.3f %14.3f", phase_names[phase], times[0][phase] / 1e6, times[1][phase] / 1e6);
+            if (times[1][phase] > 0) printf("  %6.1fx", (double)times[0][phase] / times[1][phase]);
+            printf("\n");
+        }
+    }
+    printf("(%ld constant operands rewritten per run)\n", rewritten[1]);
+
+    // 删除：原来的单向链表每次删除都要扫描，只在前IR_BENCH_REMOVE_LIMIT条上比较
+    long limit = instr_count < IR_BENCH_REMOVE_LIMIT ? instr_count : IR_BENCH_REMOVE_LIMIT;
+    long pointer_allocations = 0, arena_allocations = 0;
+    PointerInstr *head = build_pointer_ir(source, &pointer_allocations);
+    IRGenerator *gen = build_arena_ir(source, &arena_allocations);
+    if (gen) {
+        long long t0 = bench_now_ns();
+        long pointer_removed = remove_pointer_every_other(&head, limit);
+        long long t1 = bench_now_ns();
+        long arena_removed = remove_arena_every_other(gen, limit);
+        long long t2 = bench_now_ns();
+        if (pointer_removed != arena_removed) {
+            printf("Benchmark: removal counts differ (%ld vs %ld)\n", pointer_removed, arena_removed);
+        }
+        printf("remove every other of the first %ld instructions (%ld removals):\n", limit, arena_removed);
+        printf("  %-22s %14.3f %14.3f", "singly / doubly linked", (t1 - t0) / 1e6, (t2 - t1) / 1e6);
+        if (t2 > t1) printf("  %6.1fx", (double)(t1 - t0) / (t2 - t1));
+        printf("\n");
+        free_ir_generator(gen);
+    }
+    free_pointer_ir(head);
+    printf("===============================\n");
+
+    free_ir_generator(source);
+    free_compiler_context(ctx);
+}
+
+// SSA基准测试：每轮重新生成IR，分别计时建立控制流图、构造SSA和退出SSA，取最短一次
+void run_ssa_benchmark(const char *path) {
+    CompilerOptions options;
+    init_compiler_options(&options);
+    options.verbose = false;
+    options.execute = false;    // 只做语法和语义分析，IR由下面生成
+    CompilerContext *ctx = init_compiler_context(path, &options);
+    if (!ctx || !compile_translation_unit(ctx)) {
+        printf("Benchmark: compilation failed\n");
+        free_compiler_context(ctx);
+        return;
+    }
+
+    long long best[3] = { -1, -1, -1 };    // 控制流图、构造、退出
+    long long total = 0;
+    int runs = 0;
+    int instr_count = 0, final_count = 0, block_count = 0;
+    SSAForm stats;
+    memset(&stats, 0, sizeof(stats));
+    while (runs < BENCH_MIN_RUNS || total < BENCH_MIN_NS) {
+        IRGenerator *gen = init_ir_generator(ctx->semantic_context->symbol_table);
+        if (!gen) break;
+        generate_ir(ctx->ast, ctx->root, gen);
+        instr_count = gen->instruction_count;
+
+        long long t0 = bench_now_ns();
+        CFG *cfg = build_cfg(gen);
+        long long t1 = bench_now_ns();
+        if (cfg) block_count = cfg->block_count;
+        free_cfg(cfg);
+        long long t2 = bench_now_ns();
+        SSAForm *ssa = construct_ssa(gen);
+        long long t3 = bench_now_ns();
+        bool destructed = ssa && destruct_ssa(gen, ssa);
+        long long t4 = bench_now_ns();
+        if (!destructed) {
+            printf("Benchmark: out of memory\n");
+            free_ssa(ssa);
+            free_ir_generator(gen);
+            break;
+        }
+        stats = *ssa;
+        final_count = gen->instruction_count;
+        free_ssa(ssa);
+        free_ir_generator(gen);
+
+        long long times[3] = { t1 - t0, t3 - t2, t4 - t3 };
+        for (int phase = 0; phase < 3; phase++) {
+            total += times[phase];
+            if (best[phase] < 0 || times[phase] < best[phase]) best[phase] = times[phase];
+        }
+        runs++;
+    }
+
+    if (runs > 0) {
+        printf("\n=== SSA BENCHMARK ===\n");
+        printf("Source: %s, %d instructions, %d blocks\n", path, instr_count, block_count);
+        printf("%d variables (%d live across blocks), %d phis with %d arguments\n",
+               stats.var_count, stats.global_count, stats.phi_count, stats.phi_arg_count);
+        printf("%d instructions after leaving SSA\n", final_count);
+        static const char *phase_names[] = { "build CFG", "construct SSA", "destruct SSA" };
+        printf("best of %d runs:%14s %14s\n", runs, "ms", "ns/instr");
+        for (int phase = 0; phase < 3; phase++) {
+            printf("  %-22s %14.3f %14.1f\n", phase_names[phase], best[phase] / 1e6,
+                   instr_count > 0 ? (double)best[phase] / instr_count : 0.0);
+        }
+        printf("=====================\n");
+    }
+    free_compiler_context(ctx);
+}
@@ -0,0 +1,36 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "bytecode.h"
+
+// 单调时钟（纳秒）
+long long bench_now_ns(void);
+
+// 分派方式基准测试：分别用switch和直接线程化引擎执行字节码，报告每条指令的平均耗时
+void run_dispatch_benchmark(BytecodeProgram *prog);
+
+// 超级指令基准测试：比较融合前后的动态分派次数和执行时间
+void run_fusion_benchmark(BytecodeProgram *prog);
+
+// JIT基准测试：比较直接线程化解释器和x86-64本机代码的执行时间
+void run_jit_benchmark(BytecodeProgram *prog);
+
+// 并行编译基准测试：用1, 2, 4, ...个线程反复完整编译给定的源文件，报告吞吐量和加速比
+void run_parallel_benchmark(const char **paths, int path_count, int max_threads);
+
+// 阶段选择基准测试：分别跳过各个阶段或产物反复编译同一个源文件，报告每项节省的编译时间
+void run_stage_benchmark(const char *path, int opt_level);
+
+// AST布局基准测试：比较原来的指针节点和节点池两种布局的每节点内存、遍历和释放耗时
+void run_ast_benchmark(const char *path);
+
+// 符号表基准测试：在大量变量和深层嵌套作用域下比较原来的链表符号表和哈希符号表
+void run_symtab_benchmark(void);
+
+// IR分配基准测试：比较每条指令和操作数单独malloc与区域分配两种方式的构建、改写和释放耗时
+void run_ir_benchmark(const char *path);
+
+// SSA基准测试：建立控制流图、构造SSA和退出SSA的耗时及每条指令的耗时
+void run_ssa_benchmark(const char *path);
+
+#endif
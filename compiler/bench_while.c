@@ -0,0 +1,20 @@
+int main() {
+    int i = 0;
+    int t = 0;
+    int sum = 0;
+    float acc = 0.5;
+
+    while (i < 1000000) {
+        t = i * 2 - i;
+        sum = sum + t - i + 7;
+        acc = acc * 0.5 + 1.25;
+        if (sum > 1000) {
+            sum = sum - 1000;
+        }
+        i = i + 1;
+    }
+
+    printf("sum=%d\n", sum);
+    printf("acc=%f\n", acc);
+    return 0;
+}
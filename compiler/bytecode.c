@@ -0,0 +1,914 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bytecode.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// 字节码文件头（32字节）
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t code_count;
+    uint32_t slot_count;
+    uint32_t const_count;
+    uint32_t string_count;
+    uint32_t strings_size;
+    uint32_t reserved;
+} CBCHeader;
+
+// 常量引用在降级过程中暂时编码为负数，结束时重定位到常量池槽
+#define CONST_REF(index) (-2 - (index))
+#define IS_CONST_REF(value) ((value) <= -2)
+#define CONST_REF_INDEX(value) (-2 - (value))
+
+// 待回填的跳转
+typedef struct {
+    int pc;
+    int label_id;               // 0表示没有标签操作数
+} JumpFixup;
+
+// 降级上下文
+typedef struct {
+    BytecodeProgram *prog;
+    int code_capacity;
+    int const_capacity;
+    int string_capacity;
+    int strings_capacity;
+    int slot_capacity;
+    NameIndex vars;             // 变量名 -> 槽
+    int *temp_slots;            // 临时变量ID -> 槽
+    int temp_capacity;
+    int *label_pcs;             // 标签编号 -> 字节码下标，未定义为-1
+    int label_capacity;
+    NameIndex interned;         // 字符串内容 -> 字符串下标（键为副本）
+    JumpFixup *fixups;
+    int fixup_count;
+    int fixup_capacity;
+    uint16_t line;              // 当前IR指令的源代码行号，新指令继承
+} Lowering;
+
+// 字符串散列（FNV-1a）
+static unsigned int hash_name(const char *name) {
+    unsigned int h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*)name; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// 初始化名称索引
+void init_name_index(NameIndex *index) {
+    index->capacity = 64;
+    index->count = 0;
+    index->keys = (const char**)calloc(index->capacity, sizeof(char*));
+    index->values = (int*)malloc(index->capacity * sizeof(int));
+}
+
+// 释放名称索引（键由调用方持有）
+void free_name_index(NameIndex *index) {
+    free(index->keys);
+    free(index->values);
+    index->keys = NULL;
+    index->values = NULL;
+    index->capacity = index->count = 0;
+}
+
+// 查找名称，未找到返回-1
+int name_index_find(NameIndex *index, const char *name) {
+    unsigned int mask = index->capacity - 1;
+    unsigned int i = hash_name(name) & mask;
+    while (index->keys[i]) {
+        if (strcmp(index->keys[i], name) == 0) {
+            return index->values[i];
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// 插入名称（键指针不复制）
+void name_index_insert(NameIndex *index, const char *name, int value) {
+    // 负载因子超过1/2时扩容
+    if ((index->count + 1) * 2 > index->capacity) {
+        NameIndex grown;
+        grown.capacity = index->capacity * 2;
+        grown.count = 0;
+        grown.keys = (const char**)calloc(grown.capacity, sizeof(char*));
+        grown.values = (int*)malloc(grown.capacity * sizeof(int));
+        for (int i = 0; i < index->capacity; i++) {
+            if (index->keys[i]) {
+                name_index_insert(&grown, index->keys[i], index->values[i]);
+            }
+        }
+        free_name_index(index);
+        *index = grown;
+    }
+
+    unsigned int mask = index->capacity - 1;
+    unsigned int i = hash_name(name) & mask;
+    while (index->keys[i]) {
+        i = (i + 1) & mask;
+    }
+    index->keys[i] = name;
+    index->values[i] = value;
+    index->count++;
+}
+
+// 向字符串池追加字符串，返回字符串下标；相同内容只存一份
+static int add_string(Lowering *lw, const char *str) {
+    int existing = name_index_find(&lw->interned, str);
+    if (existing >= 0) return existing;
+
+    BytecodeProgram *prog = lw->prog;
+    uint32_t len = (uint32_t)strlen(str) + 1;
+
+    while (prog->strings_size + len > (uint32_t)lw->strings_capacity) {
+        lw->strings_capacity = lw->strings_capacity ? lw->strings_capacity * 2 : 256;
+        prog->strings = (char*)realloc(prog->strings, lw->strings_capacity);
+    }
+    if (prog->string_count >= lw->string_capacity) {
+        lw->string_capacity = lw->string_capacity ? lw->string_capacity * 2 : 16;
+        prog->string_offsets = (uint32_t*)realloc(prog->string_offsets, lw->string_capacity * sizeof(uint32_t));
+    }
+
+    memcpy(prog->strings + prog->strings_size, str, len);
+    prog->string_offsets[prog->string_count] = prog->strings_size;
+    prog->strings_size += len;
+
+    // 池会随realloc移动，索引的键使用独立副本
+    name_index_insert(&lw->interned, strdup(str), prog->string_count);
+    return prog->string_count++;
+}
+
+// 解码字符串字面量：去掉首尾引号并处理转义字符，结果需由调用方释放
+static char* decode_string_literal(const char *literal) {
+    int len = strlen(literal);
+    if (len < 2 || literal[0] != '"' || literal[len-1] != '"') {
+        return strdup(literal);
+    }
+
+    char *processed = malloc(len - 1);
+    int j = 0;
+    for (int i = 1; i < len - 1; i++) {
+        if (literal[i] == '\\' && literal[i+1] == 'n' && i + 1 < len - 1) {
+            processed[j++] = '\n';
+            i++;
+        } else if (literal[i] == '\\' && literal[i+1] == 't' && i + 1 < len - 1) {
+            processed[j++] = '\t';
+            i++;
+        } else {
+            processed[j++] = literal[i];
+        }
+    }
+    processed[j] = '\0';
+    return processed;
+}
+
+// 中间代码数据类型对应的槽类型
+static SlotType slot_type_of(DataType type) {
+    return type == TYPE_FLOAT ? SLOT_FLOAT : SLOT_INT;
+}
+
+// 分配一个新槽，name为NULL表示匿名（临时变量）
+static int add_slot(Lowering *lw, const char *name, SlotType type) {
+    BytecodeProgram *prog = lw->prog;
+    if (prog->slot_count >= lw->slot_capacity) {
+        lw->slot_capacity = lw->slot_capacity ? lw->slot_capacity * 2 : 32;
+        prog->slot_name_offsets = (uint32_t*)realloc(prog->slot_name_offsets, lw->slot_capacity * sizeof(uint32_t));
+        prog->slot_types = (uint8_t*)realloc(prog->slot_types, lw->slot_capacity * sizeof(uint8_t));
+    }
+
+    uint32_t name_offset = CBC_NO_NAME;
+    if (name) {
+        int string_index = add_string(lw, name);
+        name_offset = prog->string_offsets[string_index];
+    }
+    prog->slot_name_offsets[prog->slot_count] = name_offset;
+    prog->slot_types[prog->slot_count] = (uint8_t)type;
+    return prog->slot_count++;
+}
+
+// 变量槽，类型取首次出现时的声明类型
+static int var_slot(Lowering *lw, Operand *operand) {
+    int slot = name_index_find(&lw->vars, operand->var_name);
+    if (slot < 0) {
+        slot = add_slot(lw, operand->var_name, slot_type_of(operand->data_type));
+        name_index_insert(&lw->vars, operand->var_name, slot);
+    }
+    return slot;
+}
+
+// 临时变量槽
+static int temp_slot(Lowering *lw, Operand *operand) {
+    int temp_id = operand->temp_id;
+    if (temp_id >= lw->temp_capacity) {
+        int new_capacity = lw->temp_capacity ? lw->temp_capacity : 64;
+        while (new_capacity <= temp_id) new_capacity *= 2;
+        lw->temp_slots = (int*)realloc(lw->temp_slots, new_capacity * sizeof(int));
+        for (int i = lw->temp_capacity; i < new_capacity; i++) {
+            lw->temp_slots[i] = -1;
+        }
+        lw->temp_capacity = new_capacity;
+    }
+    if (lw->temp_slots[temp_id] < 0) {
+        lw->temp_slots[temp_id] = add_slot(lw, NULL, slot_type_of(operand->data_type));
+    }
+    return lw->temp_slots[temp_id];
+}
+
+// 向常量池追加常量，返回常量引用
+static int add_const(Lowering *lw, SlotType type, int int_val, float float_val) {
+    BytecodeProgram *prog = lw->prog;
+    if (prog->const_count >= lw->const_capacity) {
+        lw->const_capacity = lw->const_capacity ? lw->const_capacity * 2 : 16;
+        prog->consts = (BCConst*)realloc(prog->consts, lw->const_capacity * sizeof(BCConst));
+    }
+
+    BCConst *c = &prog->consts[prog->const_count];
+    if (type == SLOT_FLOAT) {
+        c->type = TYPE_FLOAT;
+        c->float_val = float_val;
+    } else {
+        c->type = TYPE_INT;
+        c->int_val = int_val;
+    }
+    return CONST_REF(prog->const_count++);
+}
+
+// 槽或常量引用的静态类型
+static SlotType ref_type(Lowering *lw, int ref) {
+    if (IS_CONST_REF(ref)) {
+        return lw->prog->consts[CONST_REF_INDEX(ref)].type == TYPE_FLOAT ? SLOT_FLOAT : SLOT_INT;
+    }
+    return (SlotType)lw->prog->slot_types[ref];
+}
+
+// 追加一条字节码指令
+static BCInstr* emit(Lowering *lw, BCOpcode opcode, int dst, int src1, int src2) {
+    BytecodeProgram *prog = lw->prog;
+    if (prog->code_count >= lw->code_capacity) {
+        lw->code_capacity = lw->code_capacity ? lw->code_capacity * 2 : 64;
+        prog->code = (BCInstr*)realloc(prog->code, lw->code_capacity * sizeof(BCInstr));
+    }
+
+    BCInstr *instr = &prog->code[prog->code_count++];
+    instr->opcode = (uint8_t)opcode;
+    instr->aux = 0;
+    instr->line = lw->line;
+    instr->dst = dst;
+    instr->src1 = src1;
+    instr->src2 = src2;
+    return instr;
+}
+
+// 把值转换为指定类型：常量在编译期直接转换，其余插入转换指令
+static int coerce(Lowering *lw, int ref, SlotType want) {
+    if (ref == -1) return ref;
+    SlotType have = ref_type(lw, ref);
+    if (have == want || have == SLOT_STRING || want == SLOT_STRING) return ref;
+
+    if (IS_CONST_REF(ref)) {
+        BCConst *c = &lw->prog->consts[CONST_REF_INDEX(ref)];
+        return want == SLOT_FLOAT ? add_const(lw, SLOT_FLOAT, 0, (float)c->int_val)
+                                  : add_const(lw, SLOT_INT, (int)c->float_val, 0.0f);
+    }
+
+    int slot = add_slot(lw, NULL, want);
+    emit(lw, want == SLOT_FLOAT ? BC_CONVERT_FLOAT : BC_CONVERT_INT, slot, ref, -1);
+    return slot;
+}
+
+// 结果类型与目标槽不一致时先写入匿名槽，再由finish_result转换到目标槽
+static int begin_result(Lowering *lw, int dst, SlotType produced) {
+    if (dst < 0 || lw->prog->slot_types[dst] == produced) return dst;
+    return add_slot(lw, NULL, produced);
+}
+
+static void finish_result(Lowering *lw, int dst, int slot) {
+    if (slot != dst) {
+        emit(lw, lw->prog->slot_types[dst] == SLOT_FLOAT ? BC_CONVERT_FLOAT : BC_CONVERT_INT, dst, slot, -1);
+    }
+}
+
+// 记录标签位置，按编号直接索引
+static void define_label(Lowering *lw, int label_id, int pc) {
+    if (label_id >= lw->label_capacity) {
+        int new_capacity = lw->label_capacity ? lw->label_capacity : 16;
+        while (new_capacity <= label_id) new_capacity *= 2;
+        lw->label_pcs = (int*)realloc(lw->label_pcs, new_capacity * sizeof(int));
+        for (int i = lw->label_capacity; i < new_capacity; i++) {
+            lw->label_pcs[i] = -1;
+        }
+        lw->label_capacity = new_capacity;
+    }
+    lw->label_pcs[label_id] = pc;
+}
+
+// 记录一个待回填的跳转
+static void add_fixup(Lowering *lw, int pc, const Operand *label) {
+    if (lw->fixup_count >= lw->fixup_capacity) {
+        lw->fixup_capacity = lw->fixup_capacity ? lw->fixup_capacity * 2 : 16;
+        lw->fixups = (JumpFixup*)realloc(lw->fixups, lw->fixup_capacity * sizeof(JumpFixup));
+    }
+    lw->fixups[lw->fixup_count].pc = pc;
+    lw->fixups[lw->fixup_count].label_id = label->type == OPERAND_LABEL ? label->label_id : 0;
+    lw->fixup_count++;
+}
+
+// 字符串字面量以引号开头
+static bool is_string_literal(Operand *operand) {
+    return operand && operand->type == OPERAND_VAR && operand->var_name && operand->var_name[0] == '"';
+}
+
+// 降级结果操作数
+static int lower_dest(Lowering *lw, Operand *operand) {
+    if (!operand) return -1;
+    if (operand->type == OPERAND_TEMP) return temp_slot(lw, operand);
+    if (operand->type == OPERAND_VAR && !is_string_literal(operand)) return var_slot(lw, operand);
+    return -1;
+}
+
+// 装入字符串字面量，结果槽固定为字符串类型
+static void emit_load_string(Lowering *lw, int dst, Operand *literal) {
+    if (dst < 0) return;
+    lw->prog->slot_types[dst] = SLOT_STRING;
+
+    // 字面量在降级时解码并驻留，运行时直接引用字符串池
+    char *decoded = decode_string_literal(literal->var_name);
+    emit(lw, BC_LOAD_STR, dst, add_string(lw, decoded), -1);
+    free(decoded);
+}
+
+// 降级源操作数：字符串字面量先装入一个匿名槽
+static int lower_source(Lowering *lw, Operand *operand) {
+    if (!operand) return -1;
+
+    switch (operand->type) {
+        case OPERAND_TEMP:
+            return temp_slot(lw, operand);
+        case OPERAND_CONST:
+            return operand->data_type == TYPE_FLOAT ?
+                   add_const(lw, SLOT_FLOAT, 0, operand->const_val.float_val) :
+                   add_const(lw, SLOT_INT, operand->const_val.int_val, 0.0f);
+        case OPERAND_VAR:
+            if (is_string_literal(operand)) {
+                int slot = add_slot(lw, NULL, SLOT_STRING);
+                emit_load_string(lw, slot, operand);
+                return slot;
+            }
+            return var_slot(lw, operand);
+        default:
+            return -1;
+    }
+}
+
+// 条件转换为int：float条件改写为 cond != 0.0
+static int lower_condition(Lowering *lw, Operand *operand) {
+    int cond = lower_source(lw, operand);
+    if (cond != -1 && ref_type(lw, cond) == SLOT_FLOAT) {
+        int slot = add_slot(lw, NULL, SLOT_INT);
+        emit(lw, BC_NE_F32, slot, cond, add_const(lw, SLOT_FLOAT, 0, 0.0f));
+        return slot;
+    }
+    return cond;
+}
+
+// 类型特化：按操作数类型选择整数或浮点运算指令
+static void lower_binop(Lowering *lw, IRInstruction *instr) {
+    int left = lower_source(lw, &instr->operand1);
+    int right = lower_source(lw, &instr->operand2);
+
+    SlotType operand_type = (ref_type(lw, left) == SLOT_FLOAT || ref_type(lw, right) == SLOT_FLOAT) ?
+                            SLOT_FLOAT : SLOT_INT;
+    left = coerce(lw, left, operand_type);
+    right = coerce(lw, right, operand_type);
+
+    BCOpcode opcode = (BCOpcode)((operand_type == SLOT_FLOAT ? BC_ADD_F32 : BC_ADD_I32) + instr->binop);
+    SlotType produced = is_comparison_op(instr->binop) ? SLOT_INT : operand_type;
+
+    int dst = lower_dest(lw, &instr->result);
+    int slot = begin_result(lw, dst, produced);
+    emit(lw, opcode, slot, left, right);
+    finish_result(lw, dst, slot);
+}
+
+// 降级一条中间代码指令
+static void lower_instruction(Lowering *lw, IRInstruction *instr) {
+    lw->line = (uint16_t)(instr->line > BC_MAX_LINE ? BC_MAX_LINE : (instr->line < 0 ? 0 : instr->line));
+    switch (instr->opcode) {
+        case IR_LOAD:
+            // 字符串字面量直接装入结果槽
+            if (is_string_literal(&instr->operand1)) {
+                emit_load_string(lw, lower_dest(lw, &instr->result), &instr->operand1);
+                break;
+            }
+            // fallthrough
+        case IR_LOAD_CONST:
+        case IR_STORE:
+        case IR_ASSIGN: {
+            int src = lower_source(lw, &instr->operand1);
+            int dst = lower_dest(lw, &instr->result);
+            if (dst >= 0) {
+                emit(lw, BC_MOVE, dst, coerce(lw, src, (SlotType)lw->prog->slot_types[dst]), -1);
+            }
+            break;
+        }
+
+        case IR_BINOP:
+            lower_binop(lw, instr);
+            break;
+
+        case IR_CONVERT: {
+            int src = lower_source(lw, &instr->operand1);
+            int dst = lower_dest(lw, &instr->result);
+            if (dst >= 0) {
+                emit(lw, BC_MOVE, dst, coerce(lw, src, (SlotType)lw->prog->slot_types[dst]), -1);
+            }
+            break;
+        }
+
+        case IR_GOTO:
+            add_fixup(lw, lw->prog->code_count, &instr->operand1);
+            emit(lw, BC_GOTO, -1, -1, -1);
+            break;
+
+        case IR_IF_GOTO:
+        case IR_IF_FALSE_GOTO: {
+            int cond = lower_condition(lw, &instr->operand1);
+            add_fixup(lw, lw->prog->code_count, &instr->operand2);
+            emit(lw, instr->opcode == IR_IF_GOTO ? BC_IF_TRUE : BC_IF_FALSE, -1, cond, -1);
+            break;
+        }
+
+        case IR_LABEL:
+            // 标签不生成指令，只记录下一条指令的位置
+            if (instr->operand1.type == OPERAND_LABEL) {
+                define_label(lw, instr->operand1.label_id, lw->prog->code_count);
+                TRACE(TRACE_INTERP, TRACE_DEBUG, "label 'L%d' at position %d", instr->operand1.label_id, lw->prog->code_count);
+            }
+            break;
+
+        case IR_PARAM: {
+            int src = lower_source(lw, &instr->operand1);
+            if (src == -1) break;
+            static const BCOpcode param_ops[] = { BC_PARAM_I32, BC_PARAM_F32, BC_PARAM_STR };
+            emit(lw, param_ops[ref_type(lw, src)], -1, src, -1);
+            break;
+        }
+
+        case IR_CALL: {
+            BCInstr *bc = emit(lw, BC_CALL, lower_dest(lw, &instr->result), -1, -1);
+            if (instr->operand1.type == OPERAND_FUNC &&
+                strcmp(instr->operand1.func_name, "printf") == 0) {
+                bc->aux = BUILTIN_PRINTF;
+            } else {
+                bc->aux = BUILTIN_UNKNOWN;
+            }
+            break;
+        }
+
+        case IR_RETURN: {
+            int src = lower_source(lw, &instr->operand1);
+            BCInstr *bc = emit(lw, BC_RETURN, -1, src, -1);
+            bc->aux = (src == -1) ? SLOT_INT : (uint8_t)ref_type(lw, src);
+            break;
+        }
+
+        case IR_FUNC_BEGIN:
+        case IR_FUNC_END:
+            // 函数边界标记不需要执行
+            break;
+
+        default:
+            fprintf(stderr, "Unsupported IR instruction in bytecode lowering: %d\n", instr->opcode);
+            break;
+    }
+}
+
+// 从中间代码降级为字节码
+BytecodeProgram* lower_ir_to_bytecode(IRGenerator *ir_gen) {
+    if (!ir_gen) return NULL;
+
+    BytecodeProgram *prog = (BytecodeProgram*)calloc(1, sizeof(BytecodeProgram));
+    if (!prog) return NULL;
+
+    Lowering lw;
+    memset(&lw, 0, sizeof(lw));
+    lw.prog = prog;
+    init_name_index(&lw.vars);
+    init_name_index(&lw.interned);
+
+    for (IRInstruction *instr = ir_gen->instructions; instr; instr = instr->next) {
+        lower_instruction(&lw, instr);
+    }
+
+    // 回填跳转目标
+    for (int i = 0; i < lw.fixup_count; i++) {
+        int label_id = lw.fixups[i].label_id;
+        int target = label_id > 0 && label_id < lw.label_capacity ? lw.label_pcs[label_id] : -1;
+        if (target < 0) {
+            fprintf(stderr, "Label 'L%d' not found\n", label_id);
+        }
+        prog->code[lw.fixups[i].pc].dst = target;
+    }
+
+    // 常量引用重定位到变量槽之后
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *bc = &prog->code[pc];
+        if (bc->opcode == BC_LOAD_STR) continue;  // src1为字符串下标
+        if (IS_CONST_REF(bc->src1)) bc->src1 = prog->slot_count + CONST_REF_INDEX(bc->src1);
+        if (IS_CONST_REF(bc->src2)) bc->src2 = prog->slot_count + CONST_REF_INDEX(bc->src2);
+    }
+
+    free_name_index(&lw.vars);
+    for (int i = 0; i < lw.interned.capacity; i++) {
+        free((char*)lw.interned.keys[i]);
+    }
+    free_name_index(&lw.interned);
+    free(lw.temp_slots);
+    free(lw.label_pcs);
+    free(lw.fixups);
+
+    return prog;
+}
+
+// 释放字节码程序
+void free_bytecode(BytecodeProgram *prog) {
+    if (!prog) return;
+
+    if (prog->mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(prog->mapping);
+#else
+        munmap(prog->mapping, prog->mapping_size);
+#endif
+    } else {
+        free(prog->code);
+        free(prog->consts);
+        free(prog->string_offsets);
+        free(prog->slot_name_offsets);
+        free(prog->slot_types);
+        free(prog->strings);
+    }
+    free(prog);
+}
+
+// 复制字节码程序（结果总在堆上，可独立修改和释放）
+BytecodeProgram* copy_bytecode(BytecodeProgram *prog) {
+    if (!prog) return NULL;
+
+    BytecodeProgram *copy = (BytecodeProgram*)calloc(1, sizeof(BytecodeProgram));
+    if (!copy) return NULL;
+
+    *copy = *prog;
+    copy->mapping = NULL;
+    copy->mapping_size = 0;
+    copy->code = (BCInstr*)malloc((prog->code_count + 1) * sizeof(BCInstr));
+    memcpy(copy->code, prog->code, prog->code_count * sizeof(BCInstr));
+    copy->consts = (BCConst*)malloc((prog->const_count + 1) * sizeof(BCConst));
+    memcpy(copy->consts, prog->consts, prog->const_count * sizeof(BCConst));
+    copy->string_offsets = (uint32_t*)malloc((prog->string_count + 1) * sizeof(uint32_t));
+    memcpy(copy->string_offsets, prog->string_offsets, prog->string_count * sizeof(uint32_t));
+    copy->slot_name_offsets = (uint32_t*)malloc((prog->slot_count + 1) * sizeof(uint32_t));
+    memcpy(copy->slot_name_offsets, prog->slot_name_offsets, prog->slot_count * sizeof(uint32_t));
+    copy->slot_types = (uint8_t*)malloc(prog->slot_count + 1);
+    memcpy(copy->slot_types, prog->slot_types, prog->slot_count);
+    copy->strings = (char*)malloc(prog->strings_size + 1);
+    memcpy(copy->strings, prog->strings, prog->strings_size);
+    return copy;
+}
+
+// 访问字符串池
+const char* get_bytecode_string(BytecodeProgram *prog, int index) {
+    if (!prog || index < 0 || index >= prog->string_count) return NULL;
+    return prog->strings + prog->string_offsets[index];
+}
+
+// 获取槽对应的变量名（临时变量返回NULL）
+const char* get_bytecode_slot_name(BytecodeProgram *prog, int slot) {
+    if (!prog || slot < 0 || slot >= prog->slot_count) return NULL;
+    if (prog->slot_name_offsets[slot] == CBC_NO_NAME) return NULL;
+    return prog->strings + prog->slot_name_offsets[slot];
+}
+
+// 写出字节码文件
+bool save_bytecode_file(BytecodeProgram *prog, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        fprintf(stderr, "Failed to create bytecode file: %s\n", filename);
+        return false;
+    }
+
+    CBCHeader header;
+    memcpy(header.magic, CBC_MAGIC, 4);
+    header.version = CBC_VERSION;
+    header.code_count = prog->code_count;
+    header.slot_count = prog->slot_count;
+    header.const_count = prog->const_count;
+    header.string_count = prog->string_count;
+    header.strings_size = prog->strings_size;
+    header.reserved = 0;
+
+    // 各段依次存放，均为4字节对齐，加载时可直接指向映射内存
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && fwrite(prog->code, sizeof(BCInstr), prog->code_count, fp) == (size_t)prog->code_count;
+    ok = ok && fwrite(prog->consts, sizeof(BCConst), prog->const_count, fp) == (size_t)prog->const_count;
+    ok = ok && fwrite(prog->string_offsets, sizeof(uint32_t), prog->string_count, fp) == (size_t)prog->string_count;
+    ok = ok && fwrite(prog->slot_name_offsets, sizeof(uint32_t), prog->slot_count, fp) == (size_t)prog->slot_count;
+    ok = ok && fwrite(prog->strings, 1, prog->strings_size, fp) == prog->strings_size;
+    ok = ok && fwrite(prog->slot_types, sizeof(uint8_t), prog->slot_count, fp) == (size_t)prog->slot_count;
+
+    fclose(fp);
+    if (!ok) {
+        fprintf(stderr, "Failed to write bytecode file: %s\n", filename);
+    }
+    return ok;
+}
+
+// 映射整个文件（写时复制，便于加载后对指令做原地改写）
+static void* map_file(const char *filename, size_t *size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return NULL;
+
+    void *base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    *size = (size_t)file_size.QuadPart;
+    return base;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    *size = (size_t)st.st_size;
+    return base;
+#endif
+}
+
+// 槽或常量池项的类型，越界返回-1
+static int frame_type(BytecodeProgram *prog, int ref) {
+    if (ref < 0) return -1;
+    if (ref < prog->slot_count) return prog->slot_types[ref];
+    if (ref < prog->slot_count + prog->const_count) {
+        return prog->consts[ref - prog->slot_count].type == TYPE_FLOAT ? SLOT_FLOAT : SLOT_INT;
+    }
+    return -1;
+}
+
+// 可写的槽（常量池只读）
+static bool is_writable(BytecodeProgram *prog, int slot) {
+    return slot >= 0 && slot < prog->slot_count;
+}
+
+// 校验单条指令的操作数下标与类型
+static bool verify_instruction(BytecodeProgram *prog, BCInstr *bc) {
+    if (bc->opcode >= BC_I32_FIRST && bc->opcode <= BC_F32_LAST) {
+        int type = bc->opcode <= BC_I32_LAST ? SLOT_INT : SLOT_FLOAT;
+        int op = (bc->opcode - BC_I32_FIRST) % (BC_I32_LAST - BC_I32_FIRST + 1);
+        int produced = op >= OP_EQ ? SLOT_INT : type;
+        return is_writable(prog, bc->dst) && prog->slot_types[bc->dst] == produced &&
+               frame_type(prog, bc->src1) == type && frame_type(prog, bc->src2) == type;
+    }
+
+    switch (bc->opcode) {
+        case BC_NOP:
+            return true;
+        case BC_MOVE:
+            return is_writable(prog, bc->dst) && frame_type(prog, bc->src1) == prog->slot_types[bc->dst];
+        case BC_LOAD_STR:
+            return is_writable(prog, bc->dst) && prog->slot_types[bc->dst] == SLOT_STRING &&
+                   bc->src1 >= 0 && bc->src1 < prog->string_count;
+        case BC_CONVERT_INT:
+            return is_writable(prog, bc->dst) && prog->slot_types[bc->dst] == SLOT_INT &&
+                   frame_type(prog, bc->src1) == SLOT_FLOAT;
+        case BC_CONVERT_FLOAT:
+            return is_writable(prog, bc->dst) && prog->slot_types[bc->dst] == SLOT_FLOAT &&
+                   frame_type(prog, bc->src1) == SLOT_INT;
+        case BC_GOTO:
+            return bc->dst >= 0 && bc->dst <= prog->code_count;
+        case BC_IF_TRUE:
+        case BC_IF_FALSE:
+            return bc->dst >= 0 && bc->dst <= prog->code_count && frame_type(prog, bc->src1) == SLOT_INT;
+        case BC_PARAM_I32:
+            return frame_type(prog, bc->src1) == SLOT_INT;
+        case BC_PARAM_F32:
+            return frame_type(prog, bc->src1) == SLOT_FLOAT;
+        case BC_PARAM_STR:
+            return frame_type(prog, bc->src1) == SLOT_STRING;
+        case BC_CALL:
+            return bc->aux <= BUILTIN_PRINTF && (bc->dst == -1 || is_writable(prog, bc->dst));
+        case BC_RETURN:
+            return bc->src1 == -1 || frame_type(prog, bc->src1) == bc->aux;
+        case BC_IFNOT_EQ_I32: case BC_IFNOT_NE_I32: case BC_IFNOT_LT_I32:
+        case BC_IFNOT_GT_I32: case BC_IFNOT_LE_I32: case BC_IFNOT_GE_I32:
+            return bc->dst >= 0 && bc->dst <= prog->code_count &&
+                   frame_type(prog, bc->src1) == SLOT_INT && frame_type(prog, bc->src2) == SLOT_INT;
+        case BC_IFNOT_EQ_F32: case BC_IFNOT_NE_F32: case BC_IFNOT_LT_F32:
+        case BC_IFNOT_GT_F32: case BC_IFNOT_LE_F32: case BC_IFNOT_GE_F32:
+            return bc->dst >= 0 && bc->dst <= prog->code_count &&
+                   frame_type(prog, bc->src1) == SLOT_FLOAT && frame_type(prog, bc->src2) == SLOT_FLOAT;
+        default:
+            return false;
+    }
+}
+
+// 加载字节码文件：各段直接指向映射内存，不做拷贝
+BytecodeProgram* load_bytecode_file(const char *filename) {
+    size_t size = 0;
+    char *base = (char*)map_file(filename, &size);
+    if (!base) {
+        fprintf(stderr, "Cannot map bytecode file: %s\n", filename);
+        return NULL;
+    }
+
+    BytecodeProgram *prog = (BytecodeProgram*)calloc(1, sizeof(BytecodeProgram));
+    prog->mapping = base;
+    prog->mapping_size = size;
+
+    CBCHeader *header = (CBCHeader*)base;
+    if (size < sizeof(CBCHeader) || memcmp(header->magic, CBC_MAGIC, 4) != 0 ||
+        header->version != CBC_VERSION) {
+        fprintf(stderr, "Invalid bytecode file: %s\n", filename);
+        free_bytecode(prog);
+        return NULL;
+    }
+
+    // 校验各段长度不超出文件
+    uint64_t expected = sizeof(CBCHeader)
+                      + (uint64_t)header->code_count * sizeof(BCInstr)
+                      + (uint64_t)header->const_count * sizeof(BCConst)
+                      + (uint64_t)header->string_count * sizeof(uint32_t)
+                      + (uint64_t)header->slot_count * sizeof(uint32_t)
+                      + header->strings_size
+                      + (uint64_t)header->slot_count * sizeof(uint8_t);
+    uint64_t strings_end = expected - header->slot_count;
+    if (expected > size || (header->strings_size > 0 && base[strings_end - 1] != '\0')) {
+        fprintf(stderr, "Truncated bytecode file: %s\n", filename);
+        free_bytecode(prog);
+        return NULL;
+    }
+
+    char *cursor = base + sizeof(CBCHeader);
+    prog->code = (BCInstr*)cursor;
+    prog->code_count = (int)header->code_count;
+    cursor += header->code_count * sizeof(BCInstr);
+    prog->consts = (BCConst*)cursor;
+    prog->const_count = (int)header->const_count;
+    cursor += header->const_count * sizeof(BCConst);
+    prog->string_offsets = (uint32_t*)cursor;
+    prog->string_count = (int)header->string_count;
+    cursor += header->string_count * sizeof(uint32_t);
+    prog->slot_name_offsets = (uint32_t*)cursor;
+    prog->slot_count = (int)header->slot_count;
+    cursor += header->slot_count * sizeof(uint32_t);
+    prog->strings = cursor;
+    prog->strings_size = header->strings_size;
+    cursor += header->strings_size;
+    prog->slot_types = (uint8_t*)cursor;
+
+    // 校验字符串偏移与槽下标
+    for (int i = 0; i < prog->string_count; i++) {
+        if (prog->string_offsets[i] >= prog->strings_size) {
+            fprintf(stderr, "Corrupted string table in bytecode file: %s\n", filename);
+            free_bytecode(prog);
+            return NULL;
+        }
+    }
+    for (int i = 0; i < prog->slot_count; i++) {
+        if (prog->slot_name_offsets[i] != CBC_NO_NAME && prog->slot_name_offsets[i] >= prog->strings_size) {
+            fprintf(stderr, "Corrupted slot table in bytecode file: %s\n", filename);
+            free_bytecode(prog);
+            return NULL;
+        }
+    }
+    for (int i = 0; i < prog->slot_count; i++) {
+        if (prog->slot_types[i] > SLOT_STRING) {
+            fprintf(stderr, "Corrupted slot types in bytecode file: %s\n", filename);
+            free_bytecode(prog);
+            return NULL;
+        }
+    }
+    for (int i = 0; i < prog->const_count; i++) {
+        if (prog->consts[i].type != TYPE_INT && prog->consts[i].type != TYPE_FLOAT) {
+            fprintf(stderr, "Corrupted constant pool in bytecode file: %s\n", filename);
+            free_bytecode(prog);
+            return NULL;
+        }
+    }
+    // 值不带类型标记，必须保证每条指令的操作数类型正确
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        if (!verify_instruction(prog, &prog->code[pc])) {
+            fprintf(stderr, "Corrupted instruction %d in bytecode file: %s\n", pc, filename);
+            free_bytecode(prog);
+            return NULL;
+        }
+    }
+
+    return prog;
+}
+
+// 打印操作数槽
+static void print_bytecode_slot(BytecodeProgram *prog, int slot) {
+    if (slot < 0) {
+        printf("_");
+    } else if (slot >= prog->slot_count) {
+        BCConst *c = &prog->consts[slot - prog->slot_count];
+        if (c->type == TYPE_FLOAT) {
+            printf("%.2f", c->float_val);
+        } else {
+            printf("%d", c->int_val);
+        }
+    } else if (get_bytecode_slot_name(prog, slot)) {
+        printf("%s", get_bytecode_slot_name(prog, slot));
+    } else {
+        printf("s%d", slot);
+    }
+}
+
+// 操作码助记符
+const char* bytecode_opcode_name(int opcode) {
+    static const char *names[BC_OPCODE_COUNT] = {
+        "nop", "move", "load_str",
+        "add.i32", "sub.i32", "mul.i32", "div.i32", "eq.i32", "ne.i32", "lt.i32", "gt.i32", "le.i32", "ge.i32",
+        "add.f32", "sub.f32", "mul.f32", "div.f32", "eq.f32", "ne.f32", "lt.f32", "gt.f32", "le.f32", "ge.f32",
+        "cvt_int", "cvt_float", "goto", "if_true", "if_false",
+        "param.i32", "param.f32", "param.str", "call", "return",
+        "ifnot.eq.i32", "ifnot.ne.i32", "ifnot.lt.i32", "ifnot.gt.i32", "ifnot.le.i32", "ifnot.ge.i32",
+        "ifnot.eq.f32", "ifnot.ne.f32", "ifnot.lt.f32", "ifnot.gt.f32", "ifnot.le.f32", "ifnot.ge.f32"
+    };
+    return opcode >= 0 && opcode < BC_OPCODE_COUNT ? names[opcode] : "?";
+}
+
+// 打印字节码
+void print_bytecode(BytecodeProgram *prog) {
+    printf("\n=== Bytecode (%d instructions, %d slots, %d constants) ===\n",
+           prog->code_count, prog->slot_count, prog->const_count);
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *bc = &prog->code[pc];
+        printf("%4d: %-12s ", pc, bytecode_opcode_name(bc->opcode));
+        if (bc->opcode >= BC_IFNOT_FIRST && bc->opcode <= BC_IFNOT_LAST) {
+            print_bytecode_slot(prog, bc->src1);
+            printf(", ");
+            print_bytecode_slot(prog, bc->src2);
+            printf(" -> %d", bc->dst);
+        } else switch (bc->opcode) {
+            case BC_GOTO:
+                printf("-> %d", bc->dst);
+                break;
+            case BC_IF_TRUE:
+            case BC_IF_FALSE:
+                print_bytecode_slot(prog, bc->src1);
+                printf(" -> %d", bc->dst);
+                break;
+            case BC_LOAD_STR:
+                print_bytecode_slot(prog, bc->dst);
+                printf(", \"");
+                for (const char *p = get_bytecode_string(prog, bc->src1); *p; p++) {
+                    if (*p == '\n') printf("\\n");
+                    else if (*p == '\t') printf("\\t");
+                    else putchar(*p);
+                }
+                printf("\"");
+                break;
+            default:
+                print_bytecode_slot(prog, bc->dst);
+                printf(", ");
+                print_bytecode_slot(prog, bc->src1);
+                printf(", ");
+                print_bytecode_slot(prog, bc->src2);
+                break;
+        }
+        if (bc->line) printf("    ; line %d", bc->line);
+        printf("\n");
+    }
+    printf("=========================\n");
+}
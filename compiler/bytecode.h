@@ -0,0 +1,136 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ir.h"
+
+// 字节码文件魔数与版本
+#define CBC_MAGIC   "CBC1"
+#define CBC_VERSION 5
+#define CBC_NO_NAME 0xFFFFFFFFu
+
+// 字节码操作码
+// 算术和比较指令按操作数类型特化，执行时不再检查值的类型标记；
+// 每组的顺序与BinOpType一致，降级时按 BC_ADD_I32 + op 选取
+typedef enum {
+    BC_NOP,             // 空操作
+    BC_MOVE,            // dst = src1（同类型复制）
+    BC_LOAD_STR,        // dst = 字符串池[src1]（已解码的字面量）
+
+    BC_ADD_I32, BC_SUB_I32, BC_MUL_I32, BC_DIV_I32,             // dst = src1 op src2（int）
+    BC_EQ_I32, BC_NE_I32, BC_LT_I32, BC_GT_I32, BC_LE_I32, BC_GE_I32,
+    BC_ADD_F32, BC_SUB_F32, BC_MUL_F32, BC_DIV_F32,             // dst = src1 op src2（float）
+    BC_EQ_F32, BC_NE_F32, BC_LT_F32, BC_GT_F32, BC_LE_F32, BC_GE_F32,
+
+    BC_CONVERT_INT,     // dst = (int) src1，src1为float
+    BC_CONVERT_FLOAT,   // dst = (float) src1，src1为int
+    BC_GOTO,            // pc = dst
+    BC_IF_TRUE,         // if src1 goto dst（src1为int）
+    BC_IF_FALSE,        // if !src1 goto dst（src1为int）
+    BC_PARAM_I32,       // param src1
+    BC_PARAM_F32,
+    BC_PARAM_STR,
+    BC_CALL,            // dst = call 内置函数（aux为BuiltinFunction）
+    BC_RETURN,          // return src1（src1为-1表示无返回值，aux为值类型）
+
+    // 超级指令：比较并跳转，if !(src1 op src2) goto dst，由融合阶段生成
+    BC_IFNOT_EQ_I32, BC_IFNOT_NE_I32, BC_IFNOT_LT_I32, BC_IFNOT_GT_I32, BC_IFNOT_LE_I32, BC_IFNOT_GE_I32,
+    BC_IFNOT_EQ_F32, BC_IFNOT_NE_F32, BC_IFNOT_LT_F32, BC_IFNOT_GT_F32, BC_IFNOT_LE_F32, BC_IFNOT_GE_F32,
+    BC_OPCODE_COUNT
+} BCOpcode;
+
+#define BC_I32_FIRST BC_ADD_I32
+#define BC_I32_LAST  BC_GE_I32
+#define BC_F32_LAST  BC_GE_F32
+#define BC_IFNOT_FIRST BC_IFNOT_EQ_I32
+#define BC_IFNOT_LAST  BC_IFNOT_GE_F32
+#define BC_MAX_LINE    65535
+
+// 是否为跳转指令（dst为跳转目标）
+#define BC_IS_BRANCH(op) ((op) == BC_GOTO || (op) == BC_IF_TRUE || (op) == BC_IF_FALSE || \
+                          ((op) >= BC_IFNOT_FIRST && (op) <= BC_IFNOT_LAST))
+
+// 槽的静态类型
+typedef enum {
+    SLOT_INT,
+    SLOT_FLOAT,
+    SLOT_STRING
+} SlotType;
+
+// 内置函数编号
+typedef enum {
+    BUILTIN_UNKNOWN,
+    BUILTIN_PRINTF
+} BuiltinFunction;
+
+// 定长字节码指令（16字节）
+// 操作数均为槽下标：[0, slot_count) 为变量和临时变量，
+// [slot_count, slot_count + const_count) 为常量池
+typedef struct {
+    uint8_t opcode;     // BCOpcode
+    uint8_t aux;        // 内置函数编号/返回值类型
+    uint16_t line;      // 源代码行号（0表示未知，超过65535时取65535）
+    int32_t dst;        // 结果槽或跳转目标
+    int32_t src1;
+    int32_t src2;
+} BCInstr;
+
+// 常量池项（8字节）
+typedef struct {
+    int32_t type;       // TYPE_INT / TYPE_FLOAT
+    union {
+        int32_t int_val;
+        float float_val;
+    };
+} BCConst;
+
+// 字节码程序
+typedef struct {
+    BCInstr *code;              // 指令数组
+    int code_count;
+    int slot_count;             // 变量和临时变量槽数量
+    BCConst *consts;            // 常量池
+    int const_count;
+    uint32_t *string_offsets;   // 字符串池中各字符串的偏移
+    int string_count;
+    uint32_t *slot_name_offsets; // 各槽的变量名在字符串池中的偏移（临时变量为CBC_NO_NAME）
+    uint8_t *slot_types;        // 各槽的静态类型（SlotType）
+    char *strings;              // 字符串池（以'\0'分隔，字面量已解码且去重，运行时只读）
+    uint32_t strings_size;
+
+    void *mapping;              // 文件映射基址（NULL表示堆上构建）
+    size_t mapping_size;
+} BytecodeProgram;
+
+// 名称到下标的散列索引
+typedef struct {
+    const char **keys;          // 名称（NULL表示空位，键不复制）
+    int *values;                // 对应下标
+    int capacity;               // 容量（2的幂）
+    int count;                  // 已用项数
+} NameIndex;
+
+void init_name_index(NameIndex *index);
+void free_name_index(NameIndex *index);
+int name_index_find(NameIndex *index, const char *name);
+void name_index_insert(NameIndex *index, const char *name, int value);
+
+// 从中间代码降级为字节码
+BytecodeProgram* lower_ir_to_bytecode(IRGenerator *ir_gen);
+BytecodeProgram* copy_bytecode(BytecodeProgram *prog);
+void free_bytecode(BytecodeProgram *prog);
+
+// 字节码文件读写（.cbc）
+bool save_bytecode_file(BytecodeProgram *prog, const char *filename);
+BytecodeProgram* load_bytecode_file(const char *filename);
+
+// 访问字符串池
+const char* get_bytecode_string(BytecodeProgram *prog, int index);
+const char* get_bytecode_slot_name(BytecodeProgram *prog, int slot);
+
+// 打印字节码
+const char* bytecode_opcode_name(int opcode);
+void print_bytecode(BytecodeProgram *prog);
+
+#endif
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cfg.h"
+
+// 跳转和返回结束一个基本块
+static bool ends_block(const IRInstruction *instr) {
+    switch (instr->opcode) {
+        case IR_GOTO:
+        case IR_IF_GOTO:
+        case IR_IF_FALSE_GOTO:
+        case IR_RETURN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool starts_block(const IRInstruction *instr) {
+    return !instr->prev || instr->opcode == IR_LABEL || ends_block(instr->prev);
+}
+
+static void add_succ(BasicBlock *block, int succ) {
+    if (succ < 0) return;
+    if (block->succ_count == 1 && block->succs[0] == succ) return;   // 条件跳转到下一块
+    block->succs[block->succ_count++] = succ;
+}
+
+// 标签编号 -> 以该标签开头的块
+static int* map_labels(const CFG *cfg, int label_count) {
+    int *label_block = (int*)malloc((size_t)(label_count + 1) * sizeof(int));
+    if (!label_block) return NULL;
+    for (int i = 0; i <= label_count; i++) label_block[i] = -1;
+    for (int b = 0; b < cfg->block_count; b++) {
+        const IRInstruction *first = cfg->blocks[b].first;
+        if (first->opcode == IR_LABEL && first->operand1.type == OPERAND_LABEL &&
+            first->operand1.label_id >= 0 && first->operand1.label_id <= label_count) {
+            label_block[first->operand1.label_id] = b;
+        }
+    }
+    return label_block;
+}
+
+static int jump_target(const Operand *label, const int *label_block, int label_count) {
+    if (label->type != OPERAND_LABEL || label->label_id < 0 || label->label_id > label_count) return -1;
+    return label_block[label->label_id];
+}
+
+// 后继由每块的最后一条指令决定，前驱按块编号顺序连续存放
+static bool link_blocks(CFG *cfg, int label_count) {
+    int *label_block = map_labels(cfg, label_count);
+    if (!label_block) return false;
+
+    for (int b = 0; b < cfg->block_count; b++) {
+        BasicBlock *block = &cfg->blocks[b];
+        const IRInstruction *last = block->last;
+        int fallthrough = b + 1 < cfg->block_count ? b + 1 : -1;
+        switch (last->opcode) {
+            case IR_GOTO:
+                add_succ(block, jump_target(&last->operand1, label_block, label_count));
+                break;
+            case IR_IF_GOTO:
+            case IR_IF_FALSE_GOTO:
+                add_succ(block, jump_target(&last->operand2, label_block, label_count));
+                add_succ(block, fallthrough);
+                break;
+            case IR_RETURN:
+            case IR_FUNC_END:
+                break;
+            default:
+                add_succ(block, fallthrough);
+                break;
+        }
+        cfg->edge_count += block->succ_count;
+    }
+    free(label_block);
+
+    cfg->pred_storage = (int*)malloc((size_t)(cfg->edge_count + 1) * sizeof(int));
+    if (!cfg->pred_storage) return false;
+    for (int b = 0; b < cfg->block_count; b++) {
+        for (int i = 0; i < cfg->blocks[b].succ_count; i++) {
+            cfg->blocks[cfg->blocks[b].succs[i]].pred_count++;
+        }
+    }
+    int offset = 0;
+    for (int b = 0; b < cfg->block_count; b++) {
+        cfg->blocks[b].preds = cfg->pred_storage + offset;
+        offset += cfg->blocks[b].pred_count;
+        cfg->blocks[b].pred_count = 0;
+    }
+    for (int b = 0; b < cfg->block_count; b++) {
+        for (int i = 0; i < cfg->blocks[b].succ_count; i++) {
+            BasicBlock *succ = &cfg->blocks[cfg->blocks[b].succs[i]];
+            succ->preds[succ->pred_count++] = b;
+        }
+    }
+    return true;
+}
+
+// 从入口做非递归深度优先遍历，后序的逆序即逆后序；stack保存块编号和下一个要访问的后继
+static bool number_rpo(CFG *cfg) {
+    int count = cfg->block_count;
+    int *stack = (int*)malloc((size_t)count * 2 * sizeof(int));
+    int *postorder = (int*)malloc((size_t)count * sizeof(int));
+    bool *visited = (bool*)calloc((size_t)count, sizeof(bool));
+    cfg->rpo_order = (int*)malloc((size_t)count * sizeof(int));
+    if (!stack || !postorder || !visited || !cfg->rpo_order) {
+        free(stack);
+        free(postorder);
+        free(visited);
+        return false;
+    }
+
+    int depth = 0, post_count = 0;
+    stack[0] = 0;
+    stack[1] = 0;
+    visited[0] = true;
+    depth = 1;
+    while (depth > 0) {
+        int *frame = &stack[(depth - 1) * 2];
+        BasicBlock *block = &cfg->blocks[frame[0]];
+        if (frame[1] < block->succ_count) {
+            int succ = block->succs[frame[1]++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack[depth * 2] = succ;
+                stack[depth * 2 + 1] = 0;
+                depth++;
+            }
+        } else {
+            postorder[post_count++] = frame[0];
+            depth--;
+        }
+    }
+
+    cfg->reachable_count = post_count;
+    for (int i = 0; i < post_count; i++) {
+        int b = postorder[post_count - 1 - i];
+        cfg->rpo_order[i] = b;
+        cfg->blocks[b].rpo = i;
+    }
+    free(stack);
+    free(postorder);
+    free(visited);
+    return true;
+}
+
+// 沿支配树向上，直到两条路径相遇（Cooper, Harvey, Kennedy: A Simple, Fast Dominance Algorithm）
+static int intersect(const CFG *cfg, int a, int b) {
+    while (a != b) {
+        while (cfg->blocks[a].rpo > cfg->blocks[b].rpo) a = cfg->blocks[a].idom;
+        while (cfg->blocks[b].rpo > cfg->blocks[a].rpo) b = cfg->blocks[b].idom;
+    }
+    return a;
+}
+
+// 按逆后序反复求直接支配块直到不变；可归约的图（结构化的if/while）一两遍即收敛
+static void compute_dominators(CFG *cfg) {
+    cfg->blocks[0].idom = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 1; i < cfg->reachable_count; i++) {
+            BasicBlock *block = &cfg->blocks[cfg->rpo_order[i]];
+            int new_idom = -1;
+            for (int p = 0; p < block->pred_count; p++) {
+                int pred = block->preds[p];
+                if (cfg->blocks[pred].idom < 0) continue;   // 尚未处理或不可达
+                new_idom = new_idom < 0 ? pred : intersect(cfg, pred, new_idom);
+            }
+            if (block->idom != new_idom) {
+                block->idom = new_idom;
+                changed = true;
+            }
+        }
+    }
+    cfg->blocks[0].idom = -1;
+}
+
+// 建立支配树的子节点链表并做先序、后序编号
+static bool number_dominator_tree(CFG *cfg) {
+    for (int b = cfg->block_count - 1; b > 0; b--) {
+        int idom = cfg->blocks[b].idom;
+        if (idom < 0) continue;
+        cfg->blocks[b].dom_next_sibling = cfg->blocks[idom].dom_first_child;
+        cfg->blocks[idom].dom_first_child = b;
+    }
+
+    // 非递归遍历：stack保存块编号和下一个要访问的子节点
+    int *stack = (int*)malloc((size_t)cfg->block_count * 2 * sizeof(int));
+    if (!stack) return false;
+    int depth = 1, pre = 0, post = 0;
+    stack[0] = 0;
+    stack[1] = cfg->blocks[0].dom_first_child;
+    cfg->blocks[0].dom_pre = pre++;
+    while (depth > 0) {
+        int *frame = &stack[(depth - 1) * 2];
+        int child = frame[1];
+        if (child >= 0) {
+            frame[1] = cfg->blocks[child].dom_next_sibling;
+            cfg->blocks[child].dom_pre = pre++;
+            stack[depth * 2] = child;
+            stack[depth * 2 + 1] = cfg->blocks[child].dom_first_child;
+            depth++;
+        } else {
+            cfg->blocks[frame[0]].dom_post = post++;
+            depth--;
+        }
+    }
+    free(stack);
+    return true;
+}
+
+CFG* build_cfg(IRGenerator *gen) {
+    CFG *cfg = (CFG*)calloc(1, sizeof(CFG));
+    if (!cfg) return NULL;
+
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        if (starts_block(instr)) cfg->block_count++;
+    }
+    if (cfg->block_count == 0) return cfg;
+
+    cfg->blocks = (BasicBlock*)calloc((size_t)cfg->block_count, sizeof(BasicBlock));
+    if (!cfg->blocks) {
+        free_cfg(cfg);
+        return NULL;
+    }
+    int b = -1;
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        if (starts_block(instr)) {
+            BasicBlock *block = &cfg->blocks[++b];
+            block->first = instr;
+            block->rpo = -1;
+            block->idom = -1;
+            block->dom_first_child = -1;
+            block->dom_next_sibling = -1;
+            block->dom_pre = -1;
+            block->dom_post = -1;
+        }
+        cfg->blocks[b].last = instr;
+        cfg->blocks[b].instruction_count++;
+    }
+
+    if (!link_blocks(cfg, gen->label_counter) || !number_rpo(cfg)) {
+        free_cfg(cfg);
+        return NULL;
+    }
+    compute_dominators(cfg);
+    if (!number_dominator_tree(cfg)) {
+        free_cfg(cfg);
+        return NULL;
+    }
+    return cfg;
+}
+
+void free_cfg(CFG *cfg) {
+    if (!cfg) return;
+    free(cfg->blocks);
+    free(cfg->rpo_order);
+    free(cfg->pred_storage);
+    free(cfg);
+}
+
+bool cfg_dominates(const CFG *cfg, int a, int b) {
+    const BasicBlock *block_a = &cfg->blocks[a];
+    const BasicBlock *block_b = &cfg->blocks[b];
+    if (block_a->rpo < 0 || block_b->rpo < 0) return false;
+    return block_a->dom_pre <= block_b->dom_pre && block_b->dom_post <= block_a->dom_post;
+}
+
+static void print_block_list(const char *label, const int *blocks, int count) {
+    printf("  %s:", label);
+    for (int i = 0; i < count; i++) printf(" B%d", blocks[i]);
+    if (count == 0) printf(" -");
+    printf("\n");
+}
+
+void print_cfg(const CFG *cfg) {
+    printf("\n=== Control Flow Graph ===\n");
+    printf("%d blocks, %d edges, %d reachable\n", cfg->block_count, cfg->edge_count, cfg->reachable_count);
+    for (int b = 0; b < cfg->block_count; b++) {
+        const BasicBlock *block = &cfg->blocks[b];
+        printf("B%d (%d instructions", b, block->instruction_count);
+        if (block->rpo >= 0) printf(", rpo %d", block->rpo);
+        else printf(", unreachable");
+        if (block->idom >= 0) printf(", idom B%d", block->idom);
+        printf(")\n");
+        print_block_list("preds", block->preds, block->pred_count);
+        print_block_list("succs", block->succs, block->succ_count);
+        for (IRInstruction *instr = block->first; ; instr = instr->next) {
+            printf("    ");
+            print_instruction(instr);
+            printf("\n");
+            if (instr == block->last) break;
+        }
+    }
+    printf("==========================\n");
+}
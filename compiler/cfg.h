@@ -0,0 +1,45 @@
+#ifndef CFG_H
+#define CFG_H
+
+#include <stdbool.h>
+#include "ir.h"
+
+// 基本块：IR链表中从first到last（含）的一段连续指令，只有第一条可以是跳转目标，
+// 只有最后一条可以是跳转
+typedef struct {
+    IRInstruction *first;
+    IRInstruction *last;
+    int instruction_count;
+    int *preds;             // 前驱块编号，指向CFG的pred_storage
+    int pred_count;
+    int succs[2];           // 后继块编号：条件跳转为{跳转目标, 顺序执行}，其余最多一个
+    int succ_count;
+    int rpo;                // 逆后序编号，从入口不可达时为-1
+    int idom;               // 直接支配块，入口块和不可达块为-1
+    int dom_first_child;    // 支配树：第一个子节点和下一个兄弟节点，没有时为-1
+    int dom_next_sibling;
+    int dom_pre;            // 支配树的先序和后序编号，用于O(1)判断支配关系
+    int dom_post;
+} BasicBlock;
+
+// 控制流图：块按指令顺序编号，0号块为入口
+typedef struct {
+    BasicBlock *blocks;
+    int block_count;
+    int *rpo_order;         // 可达块按逆后序排列，rpo_order[0]为入口
+    int reachable_count;
+    int *pred_storage;      // 所有块的前驱连续存放
+    int edge_count;
+} CFG;
+
+// 在标签处和跳转、返回之后切分gen的指令链表并计算前驱后继、逆后序和支配树；
+// 指令仍属于gen，CFG只记录每块的首尾指令。内存不足时返回NULL
+CFG* build_cfg(IRGenerator *gen);
+void free_cfg(CFG *cfg);
+
+// 块a是否支配块b（每个块支配自身），不可达块互不支配
+bool cfg_dominates(const CFG *cfg, int a, int b);
+
+void print_cfg(const CFG *cfg);
+
+#endif
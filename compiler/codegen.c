@@ -3,13 +3,17 @@
 #include <string.h>
 #include <stdarg.h>
 #include "codegen.h"
+#include "trace.h"
+#include "bytecode.h"
+#include "superinstr.h"
+#include "jit.h"
 
 // 初始化代码生成器
 CodeGenerator* init_code_generator(TargetArch target_arch, const char *output_filename) {
     CodeGenerator *gen = (CodeGenerator*)malloc(sizeof(CodeGenerator));
     gen->target_arch = target_arch;
-    gen->output_file = fopen(output_filename, "w");
-    if (!gen->output_file) {
+    gen->output_file = output_filename ? fopen(output_filename, "w") : NULL;
+    if (!gen->output_file && target_arch != TARGET_JIT) {
         fprintf(stderr, "Failed to create output file: %s\n", output_filename);
         free(gen);
         return NULL;
@@ -19,6 +23,7 @@ CodeGenerator* init_code_generator(TargetArch target_arch, const char *output_fi
     gen->stack_offset = 0;
     gen->label_counter = 0;
     gen->optimization_enabled = true;
+    gen->verbose = true;
     gen->instructions_generated = 0;
     gen->registers_used = 0;
     gen->stack_space_used = 0;
@@ -85,18 +90,23 @@ void init_registers(CodeGenerator *gen) {
 
 // 主代码生成函数
 void generate_target_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
-    printf("\n=== Start Target Code Generation ===\n");
-    printf("Target architecture: %d\n", code_gen->target_arch);
+    TRACE(TRACE_CODEGEN, TRACE_INFO, "start target code generation, architecture %d", code_gen->target_arch);
+    
+    // JIT目标不输出文件，直接编译并执行
+    if (code_gen->target_arch == TARGET_JIT) {
+        generate_jit_code(ir_gen, code_gen);
+        return;
+    }
     
     emit_file_header(code_gen);
     
     switch (code_gen->target_arch) {
         case TARGET_C_CODE:
-            printf("Generating C code...\n");
+            TRACE(TRACE_CODEGEN, TRACE_DEBUG, "generating C code");
             generate_c_code(ir_gen, code_gen);
             break;
         case TARGET_PSEUDO:
-            printf("Generating pseudo code...\n");
+            TRACE(TRACE_CODEGEN, TRACE_DEBUG, "generating pseudo code");
             generate_pseudo_code(ir_gen, code_gen);
             break;
         default:
@@ -106,7 +116,7 @@ void generate_target_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
     
     emit_file_footer(code_gen);
     
-    print_codegen_stats(code_gen);
+    if (code_gen->verbose) print_codegen_stats(code_gen);
 }
 
 // 收集所有临时变量及其类型
@@ -122,13 +132,13 @@ void collect_temp_variable_types(IRGenerator *ir_gen,
     
     while (instr) {
         // 检查结果操作数
-        if (instr->result && instr->result->type == OPERAND_TEMP) {
-            int temp_id = instr->result->temp_id;
+        if (instr->result.type == OPERAND_TEMP) {
+            int temp_id = instr->result.temp_id;
             if (temp_id < 50 && !processed[temp_id]) {
                 processed[temp_id] = true;
                 
                 // 根据指令类型和操作数类型推断临时变量类型
-                DataType temp_type = instr->result->data_type;
+                DataType temp_type = instr->result.data_type;
                 
                 // 特殊处理：比较操作结果总是int类型
                 if (instr->opcode == IR_BINOP && 
@@ -139,16 +149,14 @@ void collect_temp_variable_types(IRGenerator *ir_gen,
                 
                 // 特殊处理：字符串常量赋值 - 通过检查值是否以引号开头
                 bool is_string = false;
-                if (instr->opcode == IR_LOAD_CONST && instr->operand1 && 
-                    instr->operand1->type == OPERAND_CONST && 
-                    instr->operand1->var_name && instr->operand1->var_name[0] == '"') {
+                if (instr->opcode == IR_LOAD_CONST && instr->operand1.type == OPERAND_CONST && 
+                    instr->operand1.var_name && instr->operand1.var_name[0] == '"') {
                     is_string = true;
                 }
                 
                 // 另一种检查方式：如果是ASSIGN指令且operand1是字符串常量
-                if (instr->opcode == IR_ASSIGN && instr->operand1 && 
-                    instr->operand1->type == OPERAND_CONST && 
-                    instr->operand1->var_name && instr->operand1->var_name[0] == '"') {
+                if (instr->opcode == IR_ASSIGN && instr->operand1.type == OPERAND_CONST && 
+                    instr->operand1.var_name && instr->operand1.var_name[0] == '"') {
                     is_string = true;
                 }
                 
@@ -184,11 +192,10 @@ void analyze_temp_variables_simple(IRGenerator *ir_gen,
     
     // 第一遍：检测字符串临时变量
     while (instr) {
-        if (instr->opcode == IR_LOAD && instr->result && 
-            instr->result->type == OPERAND_TEMP && instr->operand1 &&
-            instr->operand1->type == OPERAND_VAR && instr->operand1->var_name &&
-            instr->operand1->var_name[0] == '"') {
-            int temp_id = instr->result->temp_id;
+        if (instr->opcode == IR_LOAD && instr->result.type == OPERAND_TEMP && HAS_OPERAND(instr->operand1) &&
+            instr->operand1.type == OPERAND_VAR && instr->operand1.var_name &&
+            instr->operand1.var_name[0] == '"') {
+            int temp_id = instr->result.temp_id;
             if (temp_id < 50) {
                 is_string_temp[temp_id] = true;
             }
@@ -199,14 +206,14 @@ void analyze_temp_variables_simple(IRGenerator *ir_gen,
     // 第二遍：分类所有临时变量
     instr = ir_gen->instructions;
     while (instr) {
-        if (instr->result && instr->result->type == OPERAND_TEMP) {
-            int temp_id = instr->result->temp_id;
+        if (instr->result.type == OPERAND_TEMP) {
+            int temp_id = instr->result.temp_id;
             if (temp_id < 50 && !processed[temp_id]) {
                 processed[temp_id] = true;
                 
                 if (is_string_temp[temp_id]) {
                     string_temps[(*string_count)++] = temp_id;
-                } else if (instr->result->data_type == TYPE_FLOAT) {
+                } else if (instr->result.data_type == TYPE_FLOAT) {
                     float_temps[(*float_count)++] = temp_id;
                 } else {
                     // 默认为int（包括比较结果、函数调用结果等）
@@ -243,8 +250,8 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
     while (instr) {
         switch (instr->opcode) {
             case IR_FUNC_BEGIN:
-                if (instr->result && instr->result->type == OPERAND_FUNC) {
-                    emit_instruction(code_gen, "int %s() {", instr->result->func_name);
+                if (instr->result.type == OPERAND_FUNC) {
+                    emit_instruction(code_gen, "int %s() {", instr->result.func_name);
                 } else {
                     emit_instruction(code_gen, "int main() {");
                 }
@@ -303,56 +310,56 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
                 break;
                 
             case IR_LOAD_CONST:
-                if (instr->result && instr->operand1) {
+                if (HAS_OPERAND(instr->result) && HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     
-                    if (instr->result->type == OPERAND_TEMP) {
+                    if (instr->result.type == OPERAND_TEMP) {
                         emit_instruction(code_gen, "    t%d = %s;", 
-                            instr->result->temp_id, operand_str);
+                            instr->result.temp_id, operand_str);
                     } else {
                         emit_instruction(code_gen, "    %s = %s;", 
-                            instr->result->var_name, operand_str);
+                            instr->result.var_name, operand_str);
                     }
                 }
                 break;
                 
             case IR_LOAD:
-                if (instr->result && instr->operand1) {
+                if (HAS_OPERAND(instr->result) && HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     
-                    if (instr->result->type == OPERAND_TEMP) {
+                    if (instr->result.type == OPERAND_TEMP) {
                         emit_instruction(code_gen, "    t%d = %s;", 
-                            instr->result->temp_id, operand_str);
+                            instr->result.temp_id, operand_str);
                     } else {
                         emit_instruction(code_gen, "    %s = %s;", 
-                            instr->result->var_name, operand_str);
+                            instr->result.var_name, operand_str);
                     }
                 }
                 break;
                 
             case IR_STORE:
             case IR_ASSIGN:
-                if (instr->result && instr->operand1) {
+                if (HAS_OPERAND(instr->result) && HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     
-                    if (instr->result->type == OPERAND_TEMP) {
+                    if (instr->result.type == OPERAND_TEMP) {
                         emit_instruction(code_gen, "    t%d = %s;", 
-                            instr->result->temp_id, operand_str);
+                            instr->result.temp_id, operand_str);
                     } else {
                         emit_instruction(code_gen, "    %s = %s;", 
-                            instr->result->var_name, operand_str);
+                            instr->result.var_name, operand_str);
                     }
                 }
                 break;
                 
             case IR_BINOP: {
-                if (instr->result && instr->operand1 && instr->operand2) {
+                if (HAS_OPERAND(instr->result) && HAS_OPERAND(instr->operand1) && HAS_OPERAND(instr->operand2)) {
                     char left_str[64], right_str[64];
-                    generate_operand_code(code_gen, instr->operand1, left_str, sizeof(left_str));
-                    generate_operand_code(code_gen, instr->operand2, right_str, sizeof(right_str));
+                    generate_operand_code(code_gen, &instr->operand1, left_str, sizeof(left_str));
+                    generate_operand_code(code_gen, &instr->operand2, right_str, sizeof(right_str));
                     
                     const char *op_str = "";
                     switch (instr->binop) {
@@ -368,44 +375,44 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
                         case OP_GE: op_str = ">="; break;
                     }
                     
-                    if (instr->result->type == OPERAND_TEMP) {
+                    if (instr->result.type == OPERAND_TEMP) {
                         emit_instruction(code_gen, "    t%d = %s %s %s;", 
-                            instr->result->temp_id, left_str, op_str, right_str);
+                            instr->result.temp_id, left_str, op_str, right_str);
                     } else {
                         emit_instruction(code_gen, "    %s = %s %s %s;", 
-                            instr->result->var_name, left_str, op_str, right_str);
+                            instr->result.var_name, left_str, op_str, right_str);
                     }
                 }
                 break;
             }
             
             case IR_CONVERT:
-                if (instr->result && instr->operand1) {
+                if (HAS_OPERAND(instr->result) && HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     
                     const char *cast_type = "";
-                    if (instr->result->data_type == TYPE_FLOAT) {
+                    if (instr->result.data_type == TYPE_FLOAT) {
                         cast_type = "(float)";
-                    } else if (instr->result->data_type == TYPE_INT) {
+                    } else if (instr->result.data_type == TYPE_INT) {
                         cast_type = "(int)";
                     }
                     
-                    if (instr->result->type == OPERAND_TEMP) {
+                    if (instr->result.type == OPERAND_TEMP) {
                         emit_instruction(code_gen, "    t%d = %s%s;", 
-                            instr->result->temp_id, cast_type, operand_str);
+                            instr->result.temp_id, cast_type, operand_str);
                     } else {
                         emit_instruction(code_gen, "    %s = %s%s;", 
-                            instr->result->var_name, cast_type, operand_str);
+                            instr->result.var_name, cast_type, operand_str);
                     }
                 }
                 break;
                 
             case IR_PARAM:
                 // 收集printf参数
-                if (instr->operand1) {
+                if (HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     
                     if (param_count < 10) {
                         strcpy(printf_params[param_count], operand_str);
@@ -416,8 +423,8 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
                 break;
                 
             case IR_CALL:
-                if (instr->operand1 && instr->operand1->type == OPERAND_FUNC) {
-                    if (strcmp(instr->operand1->func_name, "printf") == 0) {
+                if (instr->operand1.type == OPERAND_FUNC) {
+                    if (strcmp(instr->operand1.func_name, "printf") == 0) {
                         // 生成printf调用
                         if (param_count == 1) {
                             // 只有格式字符串，添加换行符
@@ -463,9 +470,9 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
                 break;
                 
             case IR_RETURN:
-                if (instr->operand1) {
+                if (HAS_OPERAND(instr->operand1)) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
                     emit_instruction(code_gen, "    return %s;", operand_str);
                 } else {
                     emit_instruction(code_gen, "    return 0;");
@@ -473,32 +480,32 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
                 break;
                 
             case IR_LABEL:
-                if (instr->operand1 && instr->operand1->type == OPERAND_LABEL) {
-                    emit_instruction(code_gen, "%s:", instr->operand1->label_name);
+                if (instr->operand1.type == OPERAND_LABEL) {
+                    emit_instruction(code_gen, "L%d:", instr->operand1.label_id);
                 }
                 break;
                 
             case IR_GOTO:
-                if (instr->operand1 && instr->operand1->type == OPERAND_LABEL) {
-                    emit_instruction(code_gen, "    goto %s;", instr->operand1->label_name);
+                if (instr->operand1.type == OPERAND_LABEL) {
+                    emit_instruction(code_gen, "    goto L%d;", instr->operand1.label_id);
                 }
                 break;
                 
             case IR_IF_GOTO:
-                if (instr->operand1 && instr->operand2 && instr->operand2->type == OPERAND_LABEL) {
+                if (HAS_OPERAND(instr->operand1) && instr->operand2.type == OPERAND_LABEL) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
-                    emit_instruction(code_gen, "    if (%s) goto %s;", 
-                        operand_str, instr->operand2->label_name);
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
+                    emit_instruction(code_gen, "    if (%s) goto L%d;", 
+                        operand_str, instr->operand2.label_id);
                 }
                 break;
                 
             case IR_IF_FALSE_GOTO:
-                if (instr->operand1 && instr->operand2 && instr->operand2->type == OPERAND_LABEL) {
+                if (HAS_OPERAND(instr->operand1) && instr->operand2.type == OPERAND_LABEL) {
                     char operand_str[64];
-                    generate_operand_code(code_gen, instr->operand1, operand_str, sizeof(operand_str));
-                    emit_instruction(code_gen, "    if (!%s) goto %s;", 
-                        operand_str, instr->operand2->label_name);
+                    generate_operand_code(code_gen, &instr->operand1, operand_str, sizeof(operand_str));
+                    emit_instruction(code_gen, "    if (!%s) goto L%d;", 
+                        operand_str, instr->operand2.label_id);
                 }
                 break;
                 
@@ -510,6 +517,26 @@ void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
     }
 }
 
+// JIT目标：降级为字节码并融合后编译为x86-64机器码，在进程内执行
+void generate_jit_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
+    BytecodeProgram *prog = lower_ir_to_bytecode(ir_gen);
+    if (!prog) return;
+    
+    FusionStats stats;
+    fuse_superinstructions(prog, &stats);
+    code_gen->instructions_generated = prog->code_count;
+    
+    if (!jit_run_bytecode(prog)) {
+        printf("JIT unavailable, falling back to interpreter\n");
+        Interpreter *interp = init_interpreter();
+        if (interp) {
+            execute_bytecode(interp, prog);
+            free_interpreter(interp);
+        }
+    }
+    free_bytecode(prog);
+}
+
 // 生成伪汇编代码
 void generate_pseudo_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
     emit_instruction(code_gen, "; Pseudo assembly code");
@@ -528,7 +555,7 @@ void generate_pseudo_code(IRGenerator *ir_gen, CodeGenerator *code_gen) {
 void generate_pseudo_instruction(CodeGenerator *gen, IRInstruction *instr) {
     switch (instr->opcode) {
         case IR_FUNC_BEGIN:
-            emit_instruction(gen, "FUNC_BEGIN %s", instr->operand1->func_name);
+            emit_instruction(gen, "FUNC_BEGIN %s", instr->operand1.func_name);
             break;
             
         case IR_FUNC_END:
@@ -537,21 +564,21 @@ void generate_pseudo_instruction(CodeGenerator *gen, IRInstruction *instr) {
             
         case IR_LOAD: {
             emit_instruction(gen, "    LOAD temp_%d, %s", 
-                instr->result->temp_id, instr->operand1->var_name);
+                instr->result.temp_id, instr->operand1.var_name);
             break;
         }
         
         case IR_STORE: {
             char operand_str[64];
-            generate_operand_code(gen, instr->operand1, operand_str, sizeof(operand_str));
-            emit_instruction(gen, "    STORE %s, %s", instr->result->var_name, operand_str);
+            generate_operand_code(gen, &instr->operand1, operand_str, sizeof(operand_str));
+            emit_instruction(gen, "    STORE %s, %s", instr->result.var_name, operand_str);
             break;
         }
         
         case IR_BINOP: {
             char left_str[64], right_str[64];
-            generate_operand_code(gen, instr->operand1, left_str, sizeof(left_str));
-            generate_operand_code(gen, instr->operand2, right_str, sizeof(right_str));
+            generate_operand_code(gen, &instr->operand1, left_str, sizeof(left_str));
+            generate_operand_code(gen, &instr->operand2, right_str, sizeof(right_str));
             
             const char *op_str = "";
             switch (instr->binop) {
@@ -568,14 +595,14 @@ void generate_pseudo_instruction(CodeGenerator *gen, IRInstruction *instr) {
             }
             
             emit_instruction(gen, "    %s temp_%d, %s, %s", 
-                op_str, instr->result->temp_id, left_str, right_str);
+                op_str, instr->result.temp_id, left_str, right_str);
             break;
         }
         
         case IR_RETURN: {
-            if (instr->operand1) {
+            if (HAS_OPERAND(instr->operand1)) {
                 char operand_str[64];
-                generate_operand_code(gen, instr->operand1, operand_str, sizeof(operand_str));
+                generate_operand_code(gen, &instr->operand1, operand_str, sizeof(operand_str));
                 emit_instruction(gen, "    RETURN %s", operand_str);
             } else {
                 emit_instruction(gen, "    RETURN");
@@ -584,27 +611,27 @@ void generate_pseudo_instruction(CodeGenerator *gen, IRInstruction *instr) {
         }
         
         case IR_LABEL:
-            emit_instruction(gen, "%s:", instr->operand1->label_name);
+            emit_instruction(gen, "L%d:", instr->operand1.label_id);
             break;
             
         case IR_GOTO:
-            emit_instruction(gen, "    JUMP %s", instr->operand1->label_name);
+            emit_instruction(gen, "    JUMP L%d", instr->operand1.label_id);
             break;
             
         case IR_IF_FALSE_GOTO: {
             char operand_str[64];
-            generate_operand_code(gen, instr->operand1, operand_str, sizeof(operand_str));
-            emit_instruction(gen, "    JUMPZ %s, %s", operand_str, instr->operand2->label_name);
+            generate_operand_code(gen, &instr->operand1, operand_str, sizeof(operand_str));
+            emit_instruction(gen, "    JUMPZ %s, L%d", operand_str, instr->operand2.label_id);
             break;
         }
         
         case IR_CONVERT: {
             char operand_str[64];
-            generate_operand_code(gen, instr->operand1, operand_str, sizeof(operand_str));
+            generate_operand_code(gen, &instr->operand1, operand_str, sizeof(operand_str));
             
-            const char *type_str = (instr->result->data_type == TYPE_INT) ? "INT" : "FLOAT";
+            const char *type_str = (instr->result.data_type == TYPE_INT) ? "INT" : "FLOAT";
             emit_instruction(gen, "    CONVERT_%s temp_%d, %s", 
-                type_str, instr->result->temp_id, operand_str);
+                type_str, instr->result.temp_id, operand_str);
             break;
         }
         
@@ -690,7 +717,7 @@ RegisterType load_operand_to_register(CodeGenerator *gen, Operand *operand) {
 
 // 生成操作数代码
 void generate_operand_code(CodeGenerator *gen, Operand *operand, char *buffer, size_t buffer_size) {
-    if (!operand || !buffer) {
+    if (!operand || operand->type == OPERAND_NONE || !buffer) {
         if (buffer) snprintf(buffer, buffer_size, "null");
         return;
     }
@@ -719,11 +746,7 @@ void generate_operand_code(CodeGenerator *gen, Operand *operand, char *buffer, s
             break;
             
         case OPERAND_LABEL:
-            if (operand->label_name) {
-                snprintf(buffer, buffer_size, "%s", operand->label_name);
-            } else {
-                snprintf(buffer, buffer_size, "unknown_label");
-            }
+            snprintf(buffer, buffer_size, "L%d", operand->label_id);
             break;
             
         case OPERAND_FUNC:
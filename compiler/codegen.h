@@ -9,7 +9,8 @@
 // 目标架构类型
 typedef enum {
     TARGET_C_CODE,    // 生成C代码
-    TARGET_PSEUDO     // 伪汇编（教学用）
+    TARGET_PSEUDO,    // 伪汇编（教学用）
+    TARGET_JIT        // x86-64机器码，在进程内直接执行（不需要输出文件）
 } TargetArch;
 
 // 寄存器类型
@@ -72,6 +73,7 @@ typedef struct {
     int stack_offset;               // 当前栈偏移
     int label_counter;              // 标签计数器
     bool optimization_enabled;      // 是否启用优化
+    bool verbose;                   // 生成后打印统计信息
     
     // 统计信息
     int instructions_generated;     // 生成的指令数
@@ -95,6 +97,7 @@ void free_code_generator(CodeGenerator *gen);
 void generate_target_code(IRGenerator *ir_gen, CodeGenerator *code_gen);
 void generate_c_code(IRGenerator *ir_gen, CodeGenerator *code_gen);
 void generate_pseudo_code(IRGenerator *ir_gen, CodeGenerator *code_gen);
+void generate_jit_code(IRGenerator *ir_gen, CodeGenerator *code_gen);
 
 // 寄存器分配
 void init_registers(CodeGenerator *gen);
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "defuse.h"
+
+// 一种链：start按值编号，第一遍计数、求前缀和，第二遍按fill填入指令编号
+typedef struct {
+    int **start;
+    int **items;
+    int *fill;
+} ChainBuilder;
+
+enum { TEMP_DEFS, TEMP_USES, VAR_DEFS, VAR_USES, CHAIN_KINDS };
+
+static void add_ref(ChainBuilder *chain, int key, int id, bool counting) {
+    if (counting) (*chain->start)[key + 1]++;
+    else (*chain->items)[chain->fill[key]++] = id;
+}
+
+static void add_operand(DefUse *du, ChainBuilder *chains, const Operand *operand, bool is_def, int id, bool counting) {
+    if (operand->type == OPERAND_TEMP) {
+        if (operand->temp_id >= 0 && operand->temp_id < du->temp_count) {
+            add_ref(&chains[is_def ? TEMP_DEFS : TEMP_USES], operand->temp_id, id, counting);
+        }
+    } else if (is_ir_variable(operand)) {
+        add_ref(&chains[is_def ? VAR_DEFS : VAR_USES], ir_var_id(&du->vars, operand->var_name), id, counting);
+    }
+}
+
+static void add_instruction(DefUse *du, ChainBuilder *chains, const IRInstruction *instr, bool counting) {
+    add_operand(du, chains, &instr->result, true, instr->id, counting);
+    add_operand(du, chains, &instr->operand1, false, instr->id, counting);
+    add_operand(du, chains, &instr->operand2, false, instr->id, counting);
+    if (instr->opcode == IR_PHI) {
+        for (int i = 0; i < instr->phi_arg_count; i++) {
+            add_operand(du, chains, &instr->phi_args[i], false, instr->id, counting);
+        }
+    }
+}
+
+DefUse* build_def_use(IRGenerator *gen) {
+    DefUse *du = (DefUse*)calloc(1, sizeof(DefUse));
+    if (!du) return NULL;
+
+    size_t var_refs = 0;
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        du->instr_count++;
+        var_refs += is_ir_variable(&instr->result) + is_ir_variable(&instr->operand1) + is_ir_variable(&instr->operand2);
+        if (instr->opcode == IR_PHI) {
+            for (int i = 0; i < instr->phi_arg_count; i++) var_refs += is_ir_variable(&instr->phi_args[i]);
+        }
+    }
+    du->temp_count = gen->temp_counter + 1;
+    du->instrs = (IRInstruction**)malloc(((size_t)du->instr_count + 1) * sizeof(IRInstruction*));
+    if (!init_ir_var_map(&du->vars, var_refs) || !du->instrs) {
+        free_def_use(du);
+        return NULL;
+    }
+
+    // 编号指令，给变量分配编号
+    int id = 0;
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        instr->id = id;
+        du->instrs[id++] = instr;
+        if (is_ir_variable(&instr->result)) ir_var_intern(&du->vars, instr->result.var_name);
+        if (is_ir_variable(&instr->operand1)) ir_var_intern(&du->vars, instr->operand1.var_name);
+        if (is_ir_variable(&instr->operand2)) ir_var_intern(&du->vars, instr->operand2.var_name);
+        if (instr->opcode == IR_PHI) {
+            for (int i = 0; i < instr->phi_arg_count; i++) {
+                if (is_ir_variable(&instr->phi_args[i])) ir_var_intern(&du->vars, instr->phi_args[i].var_name);
+            }
+        }
+    }
+
+    int key_counts[CHAIN_KINDS] = { du->temp_count, du->temp_count, du->vars.count, du->vars.count };
+    ChainBuilder chains[CHAIN_KINDS] = {
+        { &du->temp_def_start, &du->temp_defs, NULL },
+        { &du->temp_use_start, &du->temp_uses, NULL },
+        { &du->var_def_start, &du->var_defs, NULL },
+        { &du->var_use_start, &du->var_uses, NULL },
+    };
+    bool ok = true;
+    for (int k = 0; k < CHAIN_KINDS; k++) {
+        *chains[k].start = (int*)calloc((size_t)key_counts[k] + 1, sizeof(int));
+        chains[k].fill = (int*)malloc(((size_t)key_counts[k] + 1) * sizeof(int));
+        ok = ok && *chains[k].start && chains[k].fill;
+    }
+    if (ok) {
+        for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+            add_instruction(du, chains, instr, true);
+        }
+        for (int k = 0; k < CHAIN_KINDS; k++) {
+            int *start = *chains[k].start;
+            for (int key = 0; key < key_counts[k]; key++) start[key + 1] += start[key];
+            memcpy(chains[k].fill, start, (size_t)key_counts[k] * sizeof(int));
+            *chains[k].items = (int*)malloc(((size_t)start[key_counts[k]] + 1) * sizeof(int));
+            ok = ok && *chains[k].items;
+        }
+    }
+    if (ok) {
+        for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+            add_instruction(du, chains, instr, false);
+        }
+    }
+    for (int k = 0; k < CHAIN_KINDS; k++) free(chains[k].fill);
+    if (!ok) {
+        free_def_use(du);
+        return NULL;
+    }
+    return du;
+}
+
+void free_def_use(DefUse *du) {
+    if (!du) return;
+    free(du->instrs);
+    free_ir_var_map(&du->vars);
+    free(du->temp_def_start);
+    free(du->temp_defs);
+    free(du->temp_use_start);
+    free(du->temp_uses);
+    free(du->var_def_start);
+    free(du->var_defs);
+    free(du->var_use_start);
+    free(du->var_uses);
+    free(du);
+}
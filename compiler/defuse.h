@@ -0,0 +1,31 @@
+#ifndef DEFUSE_H
+#define DEFUSE_H
+
+#include <stdbool.h>
+#include "ir.h"
+
+// def-use链：每个临时变量和变量的定义指令、使用指令，按值编号连续存放。
+// 指令按链表顺序编号（写入instr->id），链中保存的是编号；一条指令两次使用同一个值时记两次。
+// 链在建立时一次算好，之后修改IR不会更新，需要时重新建立
+typedef struct {
+    IRInstruction **instrs;     // 编号 -> 指令
+    int instr_count;
+
+    int temp_count;             // 临时变量编号为0..temp_count-1
+    int *temp_def_start;        // 临时变量t的定义为temp_defs[temp_def_start[t]]..temp_defs[temp_def_start[t + 1] - 1]
+    int *temp_defs;
+    int *temp_use_start;        // 使用（操作数和phi参数）同样存放
+    int *temp_uses;
+
+    IRVarMap vars;              // 变量名 -> 变量编号（字符串字面量不算变量）
+    int *var_def_start;         // 结果为该变量的指令（IR_STORE）
+    int *var_defs;
+    int *var_use_start;         // 读取该变量的指令（IR_LOAD）
+    int *var_uses;
+} DefUse;
+
+// 遍历gen的指令链表建立def-use链，O(N)；内存不足时返回NULL
+DefUse* build_def_use(IRGenerator *gen);
+void free_def_use(DefUse *du);
+
+#endif
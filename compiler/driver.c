@@ -0,0 +1,629 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "driver.h"
+#include "parser.tab.h"
+#include "codegen.h"
+#include "cfg.h"
+#include "ssa.h"
+#include "interpreter.h"
+#include "bench.h"
+#include "superinstr.h"
+#include "profile.h"
+#include "jit.h"
+#include "threadpool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+void init_compiler_options(CompilerOptions *options) {
+    memset(options, 0, sizeof(*options));
+    options->verbose = true;
+    options->execute = true;
+    options->emit = EMIT_ALL;
+    options->opt_level = 2;
+}
+
+CompilerContext* init_compiler_context(const char *source_path, const CompilerOptions *options) {
+    CompilerContext *ctx = (CompilerContext*)calloc(1, sizeof(CompilerContext));
+    if (ctx) {
+        ctx->source_path = source_path;
+        ctx->options = options;
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            ctx->stage_ns[i] = -1;
+        }
+        ctx->names = init_intern_table();
+        ctx->ast = init_ast();
+        if (!ctx->names || !ctx->ast) {
+            free_intern_table(ctx->names);
+            free_ast(ctx->ast);
+            free(ctx);
+            return NULL;
+        }
+    }
+    return ctx;
+}
+
+void free_compiler_context(CompilerContext *ctx) {
+    if (!ctx) return;
+    if (ctx->bytecode) free_bytecode(ctx->bytecode);
+    if (ctx->optimizer) free_optimizer(ctx->optimizer);
+    if (ctx->ir_generator) free_ir_generator(ctx->ir_generator);
+    if (ctx->semantic_context) free_semantic(ctx->semantic_context);
+    free_ast(ctx->ast);
+    free_source_buffer(ctx->source);
+    // 其他结构中的名称都指向驻留表，最后释放
+    free_intern_table(ctx->names);
+    free(ctx->ast_dot_path);
+    free(ctx->pseudo_path);
+    free(ctx->c_path);
+    free(ctx->bytecode_path);
+    free(ctx);
+}
+
+static char* concat_path(const char *stem, const char *suffix) {
+    size_t stem_len = strlen(stem);
+    size_t suffix_len = strlen(suffix);
+    char *path = (char*)malloc(stem_len + suffix_len + 1);
+    if (path) {
+        memcpy(path, stem, stem_len);
+        memcpy(path + stem_len, suffix, suffix_len + 1);
+    }
+    return path;
+}
+
+// 替换一个产物文件名，未选择该产物时置为NULL；内存不足时返回false
+static bool set_artifact_path(char **path, bool selected, const char *stem, const char *suffix, const char *default_name) {
+    free(*path);
+    *path = NULL;
+    if (!selected) return true;
+    *path = stem ? concat_path(stem, suffix) : _strdup(default_name);
+    return *path != NULL;
+}
+
+bool set_artifact_paths(CompilerContext *ctx, const char *stem) {
+    unsigned emit = ctx->options->emit;
+    bool ok = set_artifact_path(&ctx->ast_dot_path, emit & EMIT_AST_DOT, stem, ".ast.dot", "ast.dot");
+    ok = set_artifact_path(&ctx->pseudo_path, emit & EMIT_PSEUDO, stem, ".output.s", "output.s") && ok;
+    ok = set_artifact_path(&ctx->c_path, emit & EMIT_C, stem, ".output.c", "output.c") && ok;
+    ok = set_artifact_path(&ctx->bytecode_path, emit & EMIT_BYTECODE, stem, ".cbc", "output.cbc") && ok;
+    return ok;
+}
+
+// 把从start开始的耗时计入某个阶段
+static void add_stage_time(CompilerContext *ctx, CompileStage stage, long long start) {
+    if (ctx->stage_ns[stage] < 0) ctx->stage_ns[stage] = 0;
+    ctx->stage_ns[stage] += bench_now_ns() - start;
+}
+
+void print_stage_times(const long long *stage_ns) {
+    static const char *names[STAGE_COUNT] = {
+        "parse", "semantic", "ir generation", "optimization", "code generation", "bytecode"
+    };
+    long long total = 0;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (stage_ns[i] > 0) total += stage_ns[i];
+    }
+
+    printf("\n=== TIME REPORT ===\n");
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (stage_ns[i] < 0) {
+            printf("%-16s %9s\n", names[i], "skipped");
+        } else {
+            printf("%-16s %9.3f ms  %5.1f%%\n", names[i], stage_ns[i] / 1e6,
+                   total > 0 ? 100.0 * stage_ns[i] / total : 0.0);
+        }
+    }
+    printf("%-16s %9.3f ms\n", "total", total / 1e6);
+    printf("===================\n");
+}
+
+// 按目标生成一种目标代码文件
+static void write_target_code(CompilerContext *ctx, TargetArch target, const char *path, const char *what) {
+    CodeGenerator *code_generator = init_code_generator(target, path);
+    if (code_generator) {
+        code_generator->verbose = ctx->options->verbose;
+        generate_target_code(ctx->ir_generator, code_generator);
+        if (ctx->options->verbose) printf("%s generated: %s\n", what, path);
+        free_code_generator(code_generator);
+    }
+}
+
+// 语法分析之后的各个阶段：语义分析、中间代码、优化、目标代码、字节码；
+// 只运行选项和产物需要的阶段
+static bool run_pipeline(CompilerContext *ctx) {
+    const CompilerOptions *options = ctx->options;
+    long long start;
+
+    if (options->verbose) {
+        printf("Syntax analysis successful!\n");
+        print_ast(ctx->ast, ctx->root, 0);
+    }
+    if (ctx->ast_dot_path) {
+        start = bench_now_ns();
+        // 只有单文件编译时才调用Graphviz生成图片
+        if (options->verbose) {
+            export_ast_to_dot(ctx->ast, ctx->root, ctx->ast_dot_path);
+
+            // system("dot -Tpng -Gcharset=latin1 ast.dot -o ast.png");
+            printf("AST DOT file generated: %s\n", ctx->ast_dot_path);
+        } else {
+            write_ast_dot(ctx->ast, ctx->root, ctx->ast_dot_path);
+        }
+        add_stage_time(ctx, STAGE_CODEGEN, start);
+    }
+
+    start = bench_now_ns();
+    ctx->semantic_context = init_semantic();
+    if (!ctx->semantic_context) {
+        return false;
+    }
+    ctx->semantic_context->verbose = options->verbose;
+    bool semantic_ok = analyze_semantics(ctx->ast, ctx->root, ctx->semantic_context);
+    add_stage_time(ctx, STAGE_SEMANTIC, start);
+    if (!semantic_ok) {
+        if (options->verbose) printf("Semantic analysis failed!\n");
+        return false;
+    }
+    if (options->verbose) {
+        printf("Semantic analysis passed!\n");
+    }
+
+    // 后面的阶段都从中间代码开始，没有任何输出需要它时到此为止
+    bool need_ir = options->verbose || options->emit_ir || options->dump_cfg || options->dump_ssa || options->execute ||
+                   ctx->pseudo_path || ctx->c_path || ctx->bytecode_path;
+    if (options->syntax_only || !need_ir) {
+        return true;
+    }
+
+    if (options->verbose) {
+        printf("\n=== INTERMEDIATE CODE GENERATION ===\n");
+    }
+    start = bench_now_ns();
+    ctx->ir_generator = init_ir_generator(ctx->semantic_context->symbol_table);
+    if (!ctx->ir_generator) {
+        return false;
+    }
+    generate_ir(ctx->ast, ctx->root, ctx->ir_generator);
+    add_stage_time(ctx, STAGE_IR, start);
+    if (options->verbose) {
+        print_ir(ctx->ir_generator);
+        printf("\n=== CODE OPTIMIZATION ===\n");
+    }
+
+    // -O0时不创建优化器（详细模式仍然创建，以打印"Optimization disabled"）
+    if (options->opt_level > 0 || options->verbose) {
+        start = bench_now_ns();
+        ctx->optimizer = init_optimizer(ctx->ir_generator, options->opt_level);
+        if (!ctx->optimizer) {
+            return false;
+        }
+        ctx->optimizer->verbose = options->verbose;
+        optimize_ir(ctx->optimizer);
+        add_stage_time(ctx, STAGE_OPTIMIZE, start);
+    }
+
+    if (options->verbose) {
+        printf("Optimized intermediate code:\n");
+        print_ir(ctx->ir_generator);
+
+        printf("\n=== TARGET CODE GENERATION ===\n");
+    } else if (options->emit_ir) {
+        print_ir(ctx->ir_generator);
+    }
+    if (options->dump_cfg) {
+        CFG *cfg = build_cfg(ctx->ir_generator);
+        if (!cfg) {
+            return false;
+        }
+        print_cfg(cfg);
+        free_cfg(cfg);
+    }
+    if (options->dump_ssa) {
+        SSAForm *ssa = construct_ssa(ctx->ir_generator);
+        if (!ssa) {
+            return false;
+        }
+        printf("\n");
+        print_ssa_stats(ssa);
+        print_ir(ctx->ir_generator);
+        bool destructed = destruct_ssa(ctx->ir_generator, ssa);
+        free_ssa(ssa);
+        if (!destructed) {
+            return false;
+        }
+    }
+    if (ctx->pseudo_path || ctx->c_path) {
+        start = bench_now_ns();
+        if (ctx->pseudo_path) {
+            write_target_code(ctx, TARGET_PSEUDO, ctx->pseudo_path, "Pseudo assembly code");
+        }
+        if (ctx->c_path) {
+            write_target_code(ctx, TARGET_C_CODE, ctx->c_path, "C code");
+        }
+        add_stage_time(ctx, STAGE_CODEGEN, start);
+    }
+    if (options->verbose) {
+        printf("\n=== PROGRAM INTERPRETATION ===\n");
+    }
+
+    if (!ctx->bytecode_path && !options->execute) {
+        return true;
+    }
+    start = bench_now_ns();
+    ctx->bytecode = lower_ir_to_bytecode(ctx->ir_generator);
+    if (!ctx->bytecode) {
+        return false;
+    }
+
+    // 融合超级指令（融合基准测试需要未融合的程序作对照）
+    if (!options->bench_mode || strcmp(options->bench_mode, "fusion") != 0) {
+        FusionStats fusion_stats;
+        fuse_superinstructions(ctx->bytecode, &fusion_stats);
+        if (options->verbose) print_fusion_stats(&fusion_stats);
+    }
+    if (ctx->bytecode_path) {
+        if (!save_bytecode_file(ctx->bytecode, ctx->bytecode_path)) {
+            return false;
+        }
+        if (options->verbose) printf("Bytecode generated: %s\n", ctx->bytecode_path);
+    }
+    add_stage_time(ctx, STAGE_BYTECODE, start);
+
+    if (options->execute) {
+        run_bytecode(ctx->bytecode, options, ctx->source_path);
+    }
+    return true;
+}
+
+bool parse_translation_unit(CompilerContext *ctx) {
+    // 源文件整体映射到内存，扫描器在其中原地扫描，不经过stdio缓冲
+    long long start = bench_now_ns();
+    ctx->source = ctx->source_path ? open_source_file(ctx->source_path) : read_source_stream(stdin);
+    if (!ctx->source) {
+        return false;
+    }
+
+    // 每个编译单元使用独立的扫描器，yyextra指向编译上下文
+    yyscan_t scanner;
+    if (yylex_init_extra(ctx, &scanner) != 0) {
+        return false;
+    }
+    if (!yy_scan_buffer(ctx->source->data, (unsigned int)ctx->source->size + 2, scanner)) {
+        yylex_destroy(scanner);
+        return false;
+    }
+    int status = yyparse(scanner, ctx);
+    yylex_destroy(scanner);
+    add_stage_time(ctx, STAGE_PARSE, start);
+    return status == 0 && ctx->root != AST_NONE;
+}
+
+bool compile_translation_unit(CompilerContext *ctx) {
+    ctx->success = parse_translation_unit(ctx) && run_pipeline(ctx);
+    return ctx->success;
+}
+
+// 执行字节码，或按--bench选项运行基准测试
+void run_bytecode(BytecodeProgram *bytecode, const CompilerOptions *options, const char *source_path) {
+    if (options->bench_mode) {
+        if (strcmp(options->bench_mode, "fusion") == 0) {
+            run_fusion_benchmark(bytecode);
+        } else if (strcmp(options->bench_mode, "jit") == 0) {
+            run_jit_benchmark(bytecode);
+        } else {
+            run_dispatch_benchmark(bytecode);
+        }
+        return;
+    }
+
+    if (options->jit_mode && !options->profile_output) {
+        if (jit_run_bytecode(bytecode)) {
+            return;
+        }
+        printf("JIT unavailable, falling back to interpreter\n");
+    }
+
+    Interpreter *interpreter = init_interpreter();
+    if (interpreter) {
+        interpreter->profiling = options->profile_output != NULL;
+        execute_bytecode(interpreter, bytecode);
+        if (interpreter->profile) {
+            print_profile_report(interpreter->profile, source_path, stdout);
+            if (write_folded_stacks(interpreter->profile, source_path ? source_path : "program", options->profile_output)) {
+                printf("Folded stacks generated: %s\n", options->profile_output);
+            }
+        }
+        free_interpreter(interpreter);
+    }
+}
+
+int run_bytecode_file(const char *filename, const CompilerOptions *options) {
+    printf("=== BYTECODE EXECUTION ===\n");
+    BytecodeProgram *bytecode = load_bytecode_file(filename);
+    if (!bytecode) {
+        return 1;
+    }
+
+    run_bytecode(bytecode, options, NULL);
+    free_bytecode(bytecode);
+    return 0;
+}
+
+// 去掉源文件名的扩展名，作为产物文件名的前缀
+static char* artifact_stem(const char *source_path) {
+    size_t len = strlen(source_path);
+    const char *dot = strrchr(source_path, '.');
+    const char *slash = strrchr(source_path, '/');
+    const char *backslash = strrchr(source_path, '\\');
+    if (!dot || (slash && dot < slash) || (backslash && dot < backslash)) {
+        dot = source_path + len;
+    }
+
+    size_t stem = (size_t)(dot - source_path);
+    char *path = (char*)malloc(stem + 1);
+    if (path) {
+        memcpy(path, source_path, stem);
+        path[stem] = '\0';
+    }
+    return path;
+}
+
+// 批量编译的一个文件，由工作线程填写结果
+typedef struct {
+    char *path;
+    long size;
+    bool ok;
+    long tokens;
+    int instructions;
+    long long stage_ns[STAGE_COUNT];
+} BatchTask;
+
+typedef struct {
+    BatchTask *tasks;
+    int count;
+    int capacity;
+} BatchList;
+
+static bool add_batch_file(BatchList *list, const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        perror(path);
+        return false;
+    }
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 64;
+        BatchTask *tasks = (BatchTask*)realloc(list->tasks, sizeof(BatchTask) * capacity);
+        if (!tasks) return false;
+        list->tasks = tasks;
+        list->capacity = capacity;
+    }
+    BatchTask *task = &list->tasks[list->count];
+    task->path = _strdup(path);
+    if (!task->path) return false;
+    task->size = (long)st.st_size;
+    task->ok = false;
+    task->tokens = 0;
+    task->instructions = 0;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        task->stage_ns[i] = -1;
+    }
+    list->count++;
+    return true;
+}
+
+// 目录中的源文件：*.c，但不包括批量编译自己生成的*.output.c
+static bool is_batch_source(const char *name) {
+    size_t len = strlen(name);
+    if (len < 3 || strcmp(name + len - 2, ".c") != 0) return false;
+    return len < 9 || strcmp(name + len - 9, ".output.c") != 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// 目录中的源文件按文件名排序后加入，使结果与遍历顺序无关
+static bool add_batch_directory(BatchList *list, const char *dir) {
+    char **names = NULL;
+    int count = 0, capacity = 0;
+    bool ok = true;
+
+#ifdef _WIN32
+    char *pattern = concat_path(dir, "\\*.c");
+    WIN32_FIND_DATAA data;
+    HANDLE find = pattern ? FindFirstFileA(pattern, &data) : INVALID_HANDLE_VALUE;
+    free(pattern);
+    bool more = find != INVALID_HANDLE_VALUE;
+    while (more) {
+        const char *name = data.cFileName;
+#else
+    DIR *handle = opendir(dir);
+    if (!handle) {
+        perror(dir);
+        return false;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(handle)) != NULL) {
+        const char *name = entry->d_name;
+#endif
+        if (is_batch_source(name)) {
+            if (count == capacity) {
+                capacity = capacity ? capacity * 2 : 64;
+                char **grown = (char**)realloc(names, sizeof(char*) * capacity);
+                if (!grown) {
+                    ok = false;
+                    break;
+                }
+                names = grown;
+            }
+            names[count] = _strdup(name);
+            if (names[count]) count++;
+        }
+#ifdef _WIN32
+        more = FindNextFileA(find, &data);
+    }
+    if (find != INVALID_HANDLE_VALUE) FindClose(find);
+#else
+    }
+    closedir(handle);
+#endif
+
+    qsort(names, count, sizeof(char*), compare_names);
+    size_t dir_len = strlen(dir);
+    bool has_separator = dir_len > 0 && (dir[dir_len - 1] == '/' || dir[dir_len - 1] == '\\');
+    for (int i = 0; i < count; i++) {
+        char *prefix = has_separator ? _strdup(dir) : concat_path(dir, "/");
+        char *path = prefix ? concat_path(prefix, names[i]) : NULL;
+        if (!path || !add_batch_file(list, path)) ok = false;
+        free(path);
+        free(prefix);
+        free(names[i]);
+    }
+    free(names);
+    return ok;
+}
+
+// 列表文件每行一个路径，忽略空行
+static bool add_batch_list(BatchList *list, const char *list_path) {
+    FILE *file = NULL;
+    fopen_s(&file, list_path, "r");
+    if (!file) {
+        perror(list_path);
+        return false;
+    }
+
+    bool ok = true;
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        size_t len = strcspn(line, "\r\n");
+        line[len] = '\0';
+        if (len > 0 && !add_batch_file(list, line)) ok = false;
+    }
+    fclose(file);
+    return ok;
+}
+
+static bool add_batch_input(BatchList *list, const char *input) {
+    if (input[0] == '@') {
+        return add_batch_list(list, input + 1);
+    }
+    struct stat st;
+    if (stat(input, &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR) {
+        return add_batch_directory(list, input);
+    }
+    return add_batch_file(list, input);
+}
+
+// 大文件先提交，避免最后只剩一个大文件在单个线程上编译
+static int compare_batch_size(const void *a, const void *b) {
+    const BatchTask *x = (const BatchTask*)a;
+    const BatchTask *y = (const BatchTask*)b;
+    if (x->size != y->size) return x->size < y->size ? 1 : -1;
+    return strcmp(x->path, y->path);
+}
+
+typedef struct {
+    BatchTask *task;
+    const CompilerOptions *options;
+} BatchJob;
+
+// 每个文件编译完即释放上下文，批量编译的内存占用只与线程数有关
+static void batch_compile_task(void *arg) {
+    BatchJob *job = (BatchJob*)arg;
+    BatchTask *task = job->task;
+    CompilerContext *ctx = init_compiler_context(task->path, job->options);
+    if (!ctx) return;
+
+    char *stem = artifact_stem(task->path);
+    if (stem && set_artifact_paths(ctx, stem)) {
+        task->ok = compile_translation_unit(ctx);
+        task->tokens = ctx->token_count;
+        task->instructions = task->ok && ctx->bytecode ? ctx->bytecode->code_count : 0;
+        memcpy(task->stage_ns, ctx->stage_ns, sizeof(task->stage_ns));
+    }
+    free(stem);
+    free_compiler_context(ctx);
+}
+
+int compile_batch(const char **inputs, int count, const CompilerOptions *options, int threads) {
+    BatchList list = { NULL, 0, 0 };
+    bool inputs_ok = true;
+    for (int i = 0; i < count; i++) {
+        if (!add_batch_input(&list, inputs[i])) inputs_ok = false;
+    }
+    if (!inputs_ok || list.count == 0) {
+        if (inputs_ok) fprintf(stderr, "No source files to compile\n");
+        for (int i = 0; i < list.count; i++) free(list.tasks[i].path);
+        free(list.tasks);
+        return inputs_ok ? 0 : 1;
+    }
+    qsort(list.tasks, list.count, sizeof(BatchTask), compare_batch_size);
+
+    BatchJob *jobs = (BatchJob*)malloc(sizeof(BatchJob) * list.count);
+    ThreadPool *pool = init_thread_pool(threads);
+    if (!jobs || !pool) {
+        fprintf(stderr, "Cannot start parallel compilation\n");
+        free(jobs);
+        free_thread_pool(pool);
+        for (int i = 0; i < list.count; i++) free(list.tasks[i].path);
+        free(list.tasks);
+        return list.count;
+    }
+
+    long long start = bench_now_ns();
+    for (int i = 0; i < list.count; i++) {
+        jobs[i].task = &list.tasks[i];
+        jobs[i].options = options;
+        if (!thread_pool_submit(pool, batch_compile_task, &jobs[i])) {
+            batch_compile_task(&jobs[i]);
+        }
+    }
+    thread_pool_wait(pool);
+    long long elapsed = bench_now_ns() - start;
+    int thread_count = thread_pool_size(pool);
+    long steals = thread_pool_steals(pool);
+    free_thread_pool(pool);
+
+    // 只逐个报告失败的文件，最后输出汇总
+    int failed = 0;
+    long tokens = 0;
+    long instructions = 0;
+    long long stage_ns[STAGE_COUNT];
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        stage_ns[i] = -1;
+    }
+    for (int i = 0; i < list.count; i++) {
+        BatchTask *task = &list.tasks[i];
+        for (int j = 0; j < STAGE_COUNT; j++) {
+            if (task->stage_ns[j] >= 0) stage_ns[j] = (stage_ns[j] < 0 ? 0 : stage_ns[j]) + task->stage_ns[j];
+        }
+        if (!task->ok) {
+            printf("%s: compilation failed\n", task->path);
+            failed++;
+        }
+        tokens += task->tokens;
+        instructions += task->instructions;
+        free(task->path);
+    }
+    free(list.tasks);
+    free(jobs);
+
+    double seconds = elapsed > 0 ? elapsed / 1e9 : 1e-9;
+    printf("\n=== BATCH COMPILATION ===\n");
+    printf("Files: %d compiled, %d failed\n", list.count - failed, failed);
+    printf("Threads: %d (%ld tasks stolen)\n", thread_count, steals);
+    printf("Tokens: %ld, bytecode instructions: %ld\n", tokens, instructions);
+    printf("Time: %.3f ms  %.1f files/s  %.0f tokens/s\n",
+           elapsed / 1e6, list.count / seconds, tokens / seconds);
+    printf("=========================\n");
+    if (options->time_report) {
+        printf("Stage times summed over all files:");
+        print_stage_times(stage_ns);
+    }
+    return failed;
+}
@@ -0,0 +1,98 @@
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include <stdbool.h>
+#include "ast.h"
+#include "semantic.h"
+#include "ir.h"
+#include "optimize.h"
+#include "bytecode.h"
+#include "source.h"
+#include "intern.h"
+
+// 要生成的产物（--dump-ast=dot、--emit=c|pseudo|bytecode）
+typedef enum {
+    EMIT_AST_DOT  = 1 << 0,
+    EMIT_PSEUDO   = 1 << 1,
+    EMIT_C        = 1 << 2,
+    EMIT_BYTECODE = 1 << 3,
+    EMIT_ALL      = EMIT_AST_DOT | EMIT_PSEUDO | EMIT_C | EMIT_BYTECODE
+} EmitKind;
+
+// 编译阶段，用于-ftime-report
+typedef enum {
+    STAGE_PARSE,                // 词法和语法分析
+    STAGE_SEMANTIC,
+    STAGE_IR,
+    STAGE_OPTIMIZE,
+    STAGE_CODEGEN,              // 生成DOT、伪汇编和C代码文件
+    STAGE_BYTECODE,             // 降级、融合并保存字节码
+    STAGE_COUNT
+} CompileStage;
+
+// 编译选项，同一批编译单元共享且只读
+typedef struct {
+    const char *bench_mode;     // --bench=<name>，非NULL时用基准测试代替普通执行
+    const char *profile_output; // --profile[=<file>]，非NULL时剖析执行并输出folded stack到该文件
+    bool jit_mode;              // --jit：编译为本机代码执行，不支持时退回解释器
+    bool verbose;               // 打印各阶段结果
+    bool execute;               // 编译后执行字节码（--run）
+    bool syntax_only;           // -fsyntax-only：语义分析之后停止
+    bool emit_ir;               // --emit-ir：打印优化后的中间代码
+    bool dump_cfg;              // --dump-cfg：打印优化后中间代码的基本块、控制流图和支配树
+    bool dump_ssa;              // --dump-ssa：打印SSA形式，之后的阶段使用退出SSA后的中间代码
+    bool time_report;           // -ftime-report：输出各阶段耗时
+    unsigned emit;              // EmitKind的组合
+    int opt_level;              // -O0..-O3
+} CompilerOptions;
+
+// 默认选项：打印全部阶段的结果、生成全部产物、-O2、执行
+void init_compiler_options(CompilerOptions *options);
+
+// 一个翻译单元的全部编译状态，不同线程上的编译互不共享任何可变状态
+typedef struct CompilerContext {
+    const char *source_path;    // NULL表示从标准输入读取
+    const CompilerOptions *options;
+    char *ast_dot_path;         // 各产物的输出文件，NULL时不生成
+    char *pseudo_path;
+    char *c_path;
+    char *bytecode_path;
+
+    SourceBuffer *source;       // 扫描器原地扫描的源文件内容，记号切片指向其中
+    InternTable *names;         // 标识符驻留表：AST、符号表和IR中的名称都指向其中
+    AST *ast;                   // 节点池，语法分析器向其中添加节点
+    NodeId root;                // 函数定义节点，语法分析失败时为AST_NONE
+    SemanticContext *semantic_context;
+    IRGenerator *ir_generator;
+    Optimizer *optimizer;
+    BytecodeProgram *bytecode;
+
+    long token_count;           // 扫描器返回的记号数
+    long long stage_ns[STAGE_COUNT]; // 各阶段耗时，-1表示跳过
+    int syntax_errors;
+    bool success;
+} CompilerContext;
+
+CompilerContext* init_compiler_context(const char *source_path, const CompilerOptions *options);
+void free_compiler_context(CompilerContext *ctx);
+// 按options->emit设置产物文件名：stem为NULL时为ast.dot、output.s、output.c、output.cbc，
+// 否则为<stem>.ast.dot、<stem>.output.s、<stem>.output.c、<stem>.cbc
+bool set_artifact_paths(CompilerContext *ctx, const char *stem);
+// 输出各阶段耗时（-ftime-report）
+void print_stage_times(const long long *stage_ns);
+
+// 只做词法和语法分析，成功时ctx->root为函数定义节点
+bool parse_translation_unit(CompilerContext *ctx);
+// 分析源文件并执行完整流水线，成功时ctx->bytecode为融合后的字节码
+bool compile_translation_unit(CompilerContext *ctx);
+
+// 按选项执行字节码（解释器、JIT、剖析或基准测试）
+void run_bytecode(BytecodeProgram *bytecode, const CompilerOptions *options, const char *source_path);
+// 直接加载并执行字节码文件，跳过前端
+int run_bytecode_file(const char *filename, const CompilerOptions *options);
+
+// 批量编译：输入可以是源文件、目录（其中的.c文件）或@列表文件（每行一个路径），
+// 各文件在工作窃取线程池上独立编译，产物以源文件名为前缀，最后输出吞吐量；返回失败的文件数
+int compile_batch(const char **inputs, int count, const CompilerOptions *options, int threads);
+
+#endif
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <string.h>
+#include "intern.h"
+
+// 存储区按块分配，名称依次放在块中，不单独释放
+#define INTERN_CHUNK_SIZE 4096
+
+struct InternChunk {
+    InternChunk *next;
+    size_t used;
+    size_t size;
+    char data[];
+};
+
+InternTable* init_intern_table(void) {
+    InternTable *table = (InternTable*)malloc(sizeof(InternTable));
+    if (!table) return NULL;
+
+    table->capacity = 256;
+    table->count = 0;
+    table->chunks = NULL;
+    table->slots = (InternSlot*)calloc(table->capacity, sizeof(InternSlot));
+    if (!table->slots) {
+        free(table);
+        return NULL;
+    }
+    return table;
+}
+
+void free_intern_table(InternTable *table) {
+    if (!table) return;
+    InternChunk *chunk = table->chunks;
+    while (chunk) {
+        InternChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(table->slots);
+    free(table);
+}
+
+static unsigned int hash_text(const char *text, size_t length) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// 在存储区中复制一份名称
+static const char* store_name(InternTable *table, const char *text, size_t length) {
+    InternChunk *chunk = table->chunks;
+    if (!chunk || chunk->size - chunk->used < length + 1) {
+        size_t size = length + 1 > INTERN_CHUNK_SIZE ? length + 1 : INTERN_CHUNK_SIZE;
+        chunk = (InternChunk*)malloc(sizeof(InternChunk) + size);
+        if (!chunk) return NULL;
+        chunk->used = 0;
+        chunk->size = size;
+        chunk->next = table->chunks;
+        table->chunks = chunk;
+    }
+
+    char *name = chunk->data + chunk->used;
+    memcpy(name, text, length);
+    name[length] = '\0';
+    chunk->used += length + 1;
+    return name;
+}
+
+// 负载因子超过1/2时扩容，槽中保存了散列值，不需要重新计算
+static int grow_slots(InternTable *table) {
+    int capacity = table->capacity * 2;
+    InternSlot *slots = (InternSlot*)calloc(capacity, sizeof(InternSlot));
+    if (!slots) return 0;
+
+    unsigned int mask = (unsigned int)capacity - 1;
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->slots[i].name) {
+            unsigned int j = table->slots[i].hash & mask;
+            while (slots[j].name) {
+                j = (j + 1) & mask;
+            }
+            slots[j] = table->slots[i];
+        }
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    return 1;
+}
+
+const char* intern_name(InternTable *table, const char *text, size_t length) {
+    unsigned int hash = hash_text(text, length);
+    unsigned int mask = (unsigned int)table->capacity - 1;
+    unsigned int i = hash & mask;
+    while (table->slots[i].name) {
+        InternSlot *slot = &table->slots[i];
+        if (slot->hash == hash && (size_t)slot->length == length && memcmp(slot->name, text, length) == 0) {
+            return slot->name;
+        }
+        i = (i + 1) & mask;
+    }
+
+    const char *name = store_name(table, text, length);
+    if (!name) return NULL;
+    if ((table->count + 1) * 2 > table->capacity) {
+        if (!grow_slots(table)) return NULL;
+        mask = (unsigned int)table->capacity - 1;
+        i = hash & mask;
+        while (table->slots[i].name) {
+            i = (i + 1) & mask;
+        }
+    }
+    table->slots[i].name = name;
+    table->slots[i].hash = hash;
+    table->slots[i].length = (int)length;
+    table->count++;
+    return name;
+}
+
+const char* intern_cstr(InternTable *table, const char *text) {
+    return intern_name(table, text, strlen(text));
+}
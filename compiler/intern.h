@@ -0,0 +1,31 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+
+// 名称驻留表：每个不同的名称只保存一份，同一个表中相同的名称得到相同的指针，
+// 之后各阶段只需比较指针，也不再复制名称。返回的字符串以'\0'结尾，在表释放前有效
+typedef struct InternChunk InternChunk;
+
+typedef struct {
+    const char *name;
+    unsigned int hash;
+    int length;
+} InternSlot;
+
+typedef struct {
+    InternSlot *slots;          // 开放定址哈希表，容量为2的幂
+    int capacity;
+    int count;
+    InternChunk *chunks;        // 名称的存储区，随表一起释放
+} InternTable;
+
+InternTable* init_intern_table(void);
+void free_intern_table(InternTable *table);
+
+// 驻留text的前length个字节
+const char* intern_name(InternTable *table, const char *text, size_t length);
+// 驻留以'\0'结尾的字符串
+const char* intern_cstr(InternTable *table, const char *text);
+
+#endif
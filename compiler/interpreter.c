@@ -1,9 +1,31 @@
 #include "interpreter.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+// 分配一个新的变量槽
+static int allocate_slot(Interpreter *interp, const char *name, ValueType type) {
+    if (interp->slot_count >= interp->slot_capacity) {
+        interp->slot_capacity *= 2;
+        interp->slots = (SlotValue*)realloc(interp->slots, interp->slot_capacity * sizeof(SlotValue));
+        interp->slot_types = (uint8_t*)realloc(interp->slot_types, interp->slot_capacity * sizeof(uint8_t));
+        interp->slot_names = (const char**)realloc(interp->slot_names, interp->slot_capacity * sizeof(char*));
+    }
+    
+    int slot = interp->slot_count++;
+    interp->slots[slot].int_val = 0;
+    interp->slot_types[slot] = (uint8_t)type;
+    interp->slot_names[slot] = name;
+    return slot;
+}
+
+// 释放所有变量槽（名称不属于解释器）
+static void release_frame(Interpreter *interp) {
+    interp->slot_count = 0;
+}
+
 // 初始化解释器
 Interpreter* init_interpreter(void) {
     Interpreter *interp = (Interpreter*)malloc(sizeof(Interpreter));
@@ -12,9 +34,19 @@ Interpreter* init_interpreter(void) {
         return NULL;
     }
     
-    interp->variables = NULL;
+    // 初始化变量槽
+    interp->slot_count = 0;
+    interp->slot_capacity = 32;
+    interp->slots = (SlotValue*)malloc(interp->slot_capacity * sizeof(SlotValue));
+    interp->slot_types = (uint8_t*)malloc(interp->slot_capacity * sizeof(uint8_t));
+    interp->slot_names = (const char**)malloc(interp->slot_capacity * sizeof(char*));
+    init_name_index(&interp->var_index);
+    
     interp->pc = 0;
     interp->running = true;
+    interp->silent = false;
+    interp->profiling = false;
+    interp->profile = NULL;
     
     // 初始化参数栈
     interp->max_params = 10;
@@ -32,67 +64,76 @@ Interpreter* init_interpreter(void) {
 void free_interpreter(Interpreter *interp) {
     if (!interp) return;
     
-    // 释放变量表
-    VarEntry *current = interp->variables;
-    while (current) {
-        VarEntry *next = current->next;
-        free(current->name);
-        if (current->value.type == VAL_STRING && current->value.data.str_val) {
-            free(current->value.data.str_val);
-        }
-        free(current);
-        current = next;
-    }
+    // 释放变量槽
+    release_frame(interp);
+    free(interp->slots);
+    free(interp->slot_types);
+    free(interp->slot_names);
+    free_name_index(&interp->var_index);
     
-    // 释放参数栈
-    if (interp->param_stack) {
-        for (int i = 0; i < interp->param_count; i++) {
-            if (interp->param_stack[i].type == VAL_STRING && interp->param_stack[i].data.str_val) {
-                free(interp->param_stack[i].data.str_val);
-            }
-        }
-        free(interp->param_stack);
-    }
+    // 释放参数栈（字符串参数指向字节码的字符串池，不需要释放）
+    free(interp->param_stack);
     
+    free_profile(interp->profile);
     free(interp);
 }
 
+// 获取变量对应的槽，不存在时按int分配
+int get_var_slot(Interpreter *interp, const char *name) {
+    int slot = name_index_find(&interp->var_index, name);
+    if (slot < 0) {
+        slot = allocate_slot(interp, name, VAL_INT);
+        name_index_insert(&interp->var_index, interp->slot_names[slot], slot);
+    }
+    return slot;
+}
+
+// 写入变量槽，数值按槽的静态类型转换；字符串只保存指针，不复制
+void set_slot_value(Interpreter *interp, int slot, RuntimeValue value) {
+    SlotValue *target = &interp->slots[slot];
+    
+    switch (interp->slot_types[slot]) {
+        case VAL_INT:
+            target->int_val = (value.type == VAL_FLOAT) ? (int)value.data.float_val : value.data.int_val;
+            break;
+        case VAL_FLOAT:
+            target->float_val = (value.type == VAL_INT) ? (float)value.data.int_val : value.data.float_val;
+            break;
+        case VAL_STRING:
+            target->str_val = (value.type == VAL_STRING) ? value.data.str_val : NULL;
+            break;
+    }
+}
+
 // 设置变量值
 void set_variable(Interpreter *interp, const char *name, RuntimeValue value) {
     if (!interp || !name) return;
     
-    // 查找是否已存在该变量
-    VarEntry *entry = interp->variables;
-    while (entry) {
-        if (strcmp(entry->name, name) == 0) {
-            // 如果原来是字符串类型，先释放内存
-            if (entry->value.type == VAL_STRING && entry->value.data.str_val) {
-                free(entry->value.data.str_val);
-            }
-            entry->value = value;
-            // 如果新值是字符串，需要复制
-            if (value.type == VAL_STRING && value.data.str_val) {
-                entry->value.data.str_val = strdup(value.data.str_val);
-            }
-            return;
-        }
-        entry = entry->next;
-    }
-    
-    // 如果不存在，创建新的变量表项
-    entry = (VarEntry*)malloc(sizeof(VarEntry));
-    if (!entry) {
-        fprintf(stderr, "Memory allocation failed for variable entry\n");
-        return;
+    int slot = name_index_find(&interp->var_index, name);
+    if (slot < 0) {
+        // 新变量的类型取第一次写入的值的类型
+        slot = allocate_slot(interp, name, value.type);
+        name_index_insert(&interp->var_index, interp->slot_names[slot], slot);
     }
-    
-    entry->name = strdup(name);
-    entry->value = value;
-    if (value.type == VAL_STRING && value.data.str_val) {
-        entry->value.data.str_val = strdup(value.data.str_val);
+    set_slot_value(interp, slot, value);
+}
+
+// 读取变量槽，附上类型标记
+static RuntimeValue slot_to_value(Interpreter *interp, int slot) {
+    RuntimeValue value;
+    value.type = (ValueType)interp->slot_types[slot];
+    switch (value.type) {
+        case VAL_INT:
+            value.data.int_val = interp->slots[slot].int_val;
+            break;
+        case VAL_FLOAT:
+            value.data.float_val = interp->slots[slot].float_val;
+            break;
+        case VAL_STRING:
+            value.data.str_val = interp->slots[slot].str_val;
+            break;
     }
-    entry->next = interp->variables;
-    interp->variables = entry;
+    return value;
 }
 
 // 获取变量值
@@ -101,12 +142,9 @@ RuntimeValue get_variable(Interpreter *interp, const char *name) {
     
     if (!interp || !name) return error_val;
     
-    VarEntry *entry = interp->variables;
-    while (entry) {
-        if (strcmp(entry->name, name) == 0) {
-            return entry->value;
-        }
-        entry = entry->next;
+    int slot = name_index_find(&interp->var_index, name);
+    if (slot >= 0) {
+        return slot_to_value(interp, slot);
     }
     
     // 变量未找到
@@ -145,8 +183,11 @@ void execute_printf(Interpreter *interp) {
         printf("Error: printf format string is not valid\n");
         return;
     }
+    if (interp->silent) {
+        return;
+    }
     
-    char *fmt = format.data.str_val;
+    const char *fmt = format.data.str_val;
     int param_index = 1;
     
     printf("Output: ");
@@ -191,87 +232,6 @@ void execute_printf(Interpreter *interp) {
     printf("\n");
 }
 
-// 执行操作数，返回运行时值
-RuntimeValue execute_operand(Interpreter *interp, Operand *operand) {
-    RuntimeValue result = {VAL_INT, {.int_val = 0}};
-    
-    if (!operand) return result;
-    
-    switch (operand->type) {
-        case OPERAND_CONST:
-            if (operand->data_type == TYPE_INT) {
-                result.type = VAL_INT;
-                result.data.int_val = operand->const_val.int_val;
-            } else if (operand->data_type == TYPE_FLOAT) {
-                result.type = VAL_FLOAT;
-                result.data.float_val = operand->const_val.float_val;
-            }
-            break;
-            
-        case OPERAND_VAR:
-            // 检查是否是字符串字面量（以引号开始和结束）
-            if (operand->var_name && operand->var_name[0] == '"') {
-                result.type = VAL_STRING;
-                // 去掉首尾引号并复制字符串
-                int len = strlen(operand->var_name);
-                if (len >= 2 && operand->var_name[len-1] == '"') {
-                    char *str = malloc(len - 1);
-                    strncpy(str, operand->var_name + 1, len - 2);
-                    str[len - 2] = '\0';
-                    // 处理转义字符
-                    char *processed = malloc(len);
-                    int j = 0;
-                    for (int i = 0; str[i]; i++) {
-                        if (str[i] == '\\' && str[i+1] == 'n') {
-                            processed[j++] = '\n';
-                            i++;
-                        } else if (str[i] == '\\' && str[i+1] == 't') {
-                            processed[j++] = '\t';
-                            i++;
-                        } else {
-                            processed[j++] = str[i];
-                        }
-                    }
-                    processed[j] = '\0';
-                    free(str);
-                    result.data.str_val = processed;
-                } else {
-                    result.data.str_val = strdup(operand->var_name);
-                }
-            } else {
-                result = get_variable(interp, operand->var_name);
-            }
-            break;
-            
-        case OPERAND_TEMP:
-            {
-                // 临时变量名格式：t1, t2, ...
-                char temp_name[32];
-                snprintf(temp_name, sizeof(temp_name), "t%d", operand->temp_id);
-                result = get_variable(interp, temp_name);
-            }
-            break;
-            
-        case OPERAND_LABEL:
-            // 标签作为操作数时，返回标签名作为字符串
-            result.type = VAL_STRING;
-            result.data.str_val = strdup(operand->label_name);
-            break;
-            
-        case OPERAND_FUNC:
-            // 函数名作为操作数时，返回函数名作为字符串
-            result.type = VAL_STRING;
-            result.data.str_val = operand->func_name;
-            break;
-            
-        default:
-            fprintf(stderr, "Unsupported operand type in execution\n");
-            break;
-    }
-    
-    return result;
-}
-
 // 执行二元运算
 RuntimeValue execute_binop(RuntimeValue left, RuntimeValue right, BinOpType op) {
     RuntimeValue result = {VAL_INT, {.int_val = 0}};
@@ -373,318 +333,154 @@ RuntimeValue execute_binop(RuntimeValue left, RuntimeValue right, BinOpType op)
     return result;
 }
 
-// 将指令列表转换为数组以便跳转
-typedef struct {
-    IRInstruction **instructions;
-    int count;
-    int *label_positions;  // 标签位置映射
-    char **label_names;    // 标签名称列表
-    int label_count;
-} InstructionArray;
-
-// 构建指令数组
-InstructionArray* build_instruction_array(IRGenerator *ir_gen) {
-    InstructionArray *arr = (InstructionArray*)malloc(sizeof(InstructionArray));
-    if (!arr) return NULL;
-    
-    // 计算指令数量
-    int count = 0;
-    IRInstruction *instr = ir_gen->instructions;
-    while (instr) {
-        count++;
-        instr = instr->next;
+// 将解释器的变量槽绑定到字节码程序：变量和临时变量在前，常量池在后
+void bind_frame(Interpreter *interp, BytecodeProgram *prog) {
+    // 清空上一次执行留下的槽
+    release_frame(interp);
+    free_name_index(&interp->var_index);
+    init_name_index(&interp->var_index);
+    
+    int frame_size = prog->slot_count + prog->const_count;
+    if (frame_size > interp->slot_capacity) {
+        interp->slot_capacity = frame_size;
+        interp->slots = (SlotValue*)realloc(interp->slots, interp->slot_capacity * sizeof(SlotValue));
+        interp->slot_types = (uint8_t*)realloc(interp->slot_types, interp->slot_capacity * sizeof(uint8_t));
+        interp->slot_names = (const char**)realloc(interp->slot_names, interp->slot_capacity * sizeof(char*));
     }
     
-    arr->instructions = (IRInstruction**)malloc(count * sizeof(IRInstruction*));
-    arr->label_positions = (int*)malloc(100 * sizeof(int));  // 假设最多100个标签
-    arr->label_names = (char**)malloc(100 * sizeof(char*));
-    arr->count = count;
-    arr->label_count = 0;
-    
-    if (!arr->instructions || !arr->label_positions || !arr->label_names) {
-        free(arr->instructions);
-        free(arr->label_positions);
-        free(arr->label_names);
-        free(arr);
-        return NULL;
+    for (int i = 0; i < prog->slot_count; i++) {
+        const char *name = get_bytecode_slot_name(prog, i);
+        int slot = allocate_slot(interp, name, (ValueType)prog->slot_types[i]);
+        if (name) {
+            name_index_insert(&interp->var_index, interp->slot_names[slot], slot);
+        }
     }
-    
-    // 填充指令数组并记录标签位置
-    int index = 0;
-    instr = ir_gen->instructions;
-    while (instr && index < count) {
-        arr->instructions[index] = instr;
-        
-        // 如果是标签指令，记录位置
-        if (instr->opcode == IR_LABEL && instr->operand1 && instr->operand1->type == OPERAND_LABEL) {
-            if (arr->label_count < 100) {
-                arr->label_names[arr->label_count] = strdup(instr->operand1->label_name);
-                arr->label_positions[arr->label_count] = index;
-                arr->label_count++;
-                printf("Debug: Found label '%s' at position %d\n", instr->operand1->label_name, index);
-            }
+    for (int i = 0; i < prog->const_count; i++) {
+        if (prog->consts[i].type == TYPE_FLOAT) {
+            int slot = allocate_slot(interp, NULL, VAL_FLOAT);
+            interp->slots[slot].float_val = prog->consts[i].float_val;
+        } else {
+            int slot = allocate_slot(interp, NULL, VAL_INT);
+            interp->slots[slot].int_val = prog->consts[i].int_val;
         }
-        
-        index++;
-        instr = instr->next;
     }
-    
-    return arr;
 }
 
-// 释放指令数组
-void free_instruction_array(InstructionArray *arr) {
-    if (!arr) return;
-    
-    for (int i = 0; i < arr->label_count; i++) {
-        free(arr->label_names[i]);
+// 压入一个参数（字符串只传指针，不复制）
+static inline void push_param(Interpreter *interp, RuntimeValue param_value) {
+    if (interp->param_count < interp->max_params) {
+        interp->param_stack[interp->param_count++] = param_value;
+        if (TRACE_ON(TRACE_INTERP, TRACE_DEBUG)) {
+            switch (param_value.type) {
+                case VAL_INT:
+                    TRACE(TRACE_INTERP, TRACE_DEBUG, "param %d: %d", interp->param_count, param_value.data.int_val);
+                    break;
+                case VAL_FLOAT:
+                    TRACE(TRACE_INTERP, TRACE_DEBUG, "param %d: %f", interp->param_count, param_value.data.float_val);
+                    break;
+                case VAL_STRING:
+                    TRACE(TRACE_INTERP, TRACE_DEBUG, "param %d: \"%s\"", interp->param_count, param_value.data.str_val);
+                    break;
+            }
+        }
     }
-    
-    free(arr->instructions);
-    free(arr->label_positions);
-    free(arr->label_names);
-    free(arr);
 }
 
-// 查找标签位置
-int find_label_position(InstructionArray *arr, const char *label_name) {
-    for (int i = 0; i < arr->label_count; i++) {
-        if (strcmp(arr->label_names[i], label_name) == 0) {
-            return arr->label_positions[i];
-        }
-    }
-    return -1;  // 未找到
+// 清空参数栈
+static inline void clear_params(Interpreter *interp) {
+    interp->param_count = 0;
 }
 
-// 设置操作数变量值
-void set_operand_variable(Interpreter *interp, Operand *operand, RuntimeValue value) {
-    if (!operand) return;
+// 生成各分派方式的执行引擎
+// 每条算术/比较指令的操作数类型在降级时已确定，引擎直接读写未装箱的值
+#define ENGINE_NAME     run_switch
+#define ENGINE_THREADED 0
+#define ENGINE_COUNTED  0
+#define ENGINE_PROFILED 0
+#include "interpreter_dispatch.h"
+#undef ENGINE_NAME
+#undef ENGINE_THREADED
+#undef ENGINE_COUNTED
+#undef ENGINE_PROFILED
+
+#define ENGINE_NAME     run_counted
+#define ENGINE_THREADED 0
+#define ENGINE_COUNTED  1
+#define ENGINE_PROFILED 0
+#include "interpreter_dispatch.h"
+#undef ENGINE_NAME
+#undef ENGINE_THREADED
+#undef ENGINE_COUNTED
+#undef ENGINE_PROFILED
+
+#define ENGINE_NAME     run_profiled
+#define ENGINE_THREADED 0
+#define ENGINE_COUNTED  1
+#define ENGINE_PROFILED 1
+#include "interpreter_dispatch.h"
+#undef ENGINE_NAME
+#undef ENGINE_THREADED
+#undef ENGINE_COUNTED
+#undef ENGINE_PROFILED
+
+#if INTERP_HAVE_THREADED
+#define ENGINE_NAME     run_threaded
+#define ENGINE_THREADED 1
+#define ENGINE_COUNTED  0
+#define ENGINE_PROFILED 0
+#include "interpreter_dispatch.h"
+#undef ENGINE_NAME
+#undef ENGINE_THREADED
+#undef ENGINE_COUNTED
+#undef ENGINE_PROFILED
+#endif
+
+// 按指定分派方式执行字节码，返回执行的指令条数（仅DISPATCH_COUNTED/DISPATCH_PROFILED统计）
+long long execute_bytecode_with(Interpreter *interp, BytecodeProgram *prog, DispatchKind kind) {
+    if (!interp || !prog) {
+        return 0;
+    }
     
-    if (operand->type == OPERAND_VAR) {
-        set_variable(interp, operand->var_name, value);
-    } else if (operand->type == OPERAND_TEMP) {
-        // 临时变量名格式：t1, t2, ...
-        char temp_name[32];
-        snprintf(temp_name, sizeof(temp_name), "t%d", operand->temp_id);
-        set_variable(interp, temp_name, value);
+    bind_frame(interp, prog);
+    interp->pc = 0;
+    
+    switch (kind) {
+#if INTERP_HAVE_THREADED
+        case DISPATCH_THREADED:
+            return run_threaded(interp, prog);
+#endif
+        case DISPATCH_COUNTED:
+            return run_counted(interp, prog);
+        case DISPATCH_PROFILED:
+            // 剖析结果保留在解释器中，直到下一次剖析执行或释放解释器
+            free_profile(interp->profile);
+            interp->profile = init_profile(prog);
+            if (!interp->profile) return run_counted(interp, prog);
+            return run_profiled(interp, prog);
+        default:
+            return run_switch(interp, prog);
     }
 }
 
-// 执行中间代码
+// 执行字节码（分派方式在编译时选择，打开profiling时使用剖析引擎）
+void execute_bytecode(Interpreter *interp, BytecodeProgram *prog) {
+    execute_bytecode_with(interp, prog, interp->profiling ? DISPATCH_PROFILED : DISPATCH_DEFAULT);
+}
+
+// 执行中间代码：先降级为字节码再执行
 void execute_ir(Interpreter *interp, IRGenerator *ir_gen) {
     if (!interp || !ir_gen || !ir_gen->instructions) {
         return;
     }
     
-    // 构建指令数组
-    InstructionArray *arr = build_instruction_array(ir_gen);
-    if (!arr) {
-        fprintf(stderr, "Failed to build instruction array\n");
+    BytecodeProgram *prog = lower_ir_to_bytecode(ir_gen);
+    if (!prog) {
+        fprintf(stderr, "Failed to lower IR to bytecode\n");
         return;
     }
     
-    interp->pc = 0;
-    interp->running = true;
-    
-    while (interp->running && interp->pc < arr->count) {
-        IRInstruction *instr = arr->instructions[interp->pc];
-        
-        switch (instr->opcode) {
-            case IR_LOAD_CONST:
-                {
-                    RuntimeValue value;
-                    if (instr->operand1->data_type == TYPE_INT) {
-                        value.type = VAL_INT;
-                        value.data.int_val = instr->operand1->const_val.int_val;
-                    } else {
-                        value.type = VAL_FLOAT;
-                        value.data.float_val = instr->operand1->const_val.float_val;
-                    }
-                    set_operand_variable(interp, instr->result, value);
-                }
-                break;
-                
-            case IR_LOAD:
-                {
-                    RuntimeValue value = execute_operand(interp, instr->operand1);
-                    set_operand_variable(interp, instr->result, value);
-                }
-                break;
-                
-            case IR_STORE:
-                {
-                    RuntimeValue value = execute_operand(interp, instr->operand1);
-                    set_operand_variable(interp, instr->result, value);
-                }
-                break;
-                
-            case IR_ASSIGN:
-                {
-                    RuntimeValue value = execute_operand(interp, instr->operand1);
-                    set_operand_variable(interp, instr->result, value);
-                }
-                break;
-                
-            case IR_BINOP:
-                {
-                    RuntimeValue left = execute_operand(interp, instr->operand1);
-                    RuntimeValue right = execute_operand(interp, instr->operand2);
-                    RuntimeValue result = execute_binop(left, right, instr->binop);
-                    set_operand_variable(interp, instr->result, result);
-                }
-                break;
-                
-            case IR_GOTO:
-                {
-                    if (instr->operand1 && instr->operand1->type == OPERAND_LABEL) {
-                        int pos = find_label_position(arr, instr->operand1->label_name);
-                        if (pos >= 0) {
-                            interp->pc = pos;
-                            continue;  // 跳过pc自增
-                        } else {
-                            fprintf(stderr, "Label '%s' not found\n", instr->operand1->label_name);
-                        }
-                    }
-                }
-                break;
-                
-            case IR_IF_GOTO:
-                {
-                    RuntimeValue cond = execute_operand(interp, instr->operand1);
-                    int cond_value = 0;
-                    if (cond.type == VAL_INT) {
-                        cond_value = cond.data.int_val;
-                    } else if (cond.type == VAL_FLOAT) {
-                        cond_value = (cond.data.float_val != 0.0) ? 1 : 0;
-                    }
-                    
-                    if (cond_value && instr->operand2 && instr->operand2->type == OPERAND_LABEL) {
-                        int pos = find_label_position(arr, instr->operand2->label_name);
-                        if (pos >= 0) {
-                            interp->pc = pos;
-                            continue;  // 跳过pc自增
-                        } else {
-                            fprintf(stderr, "Label '%s' not found\n", instr->operand2->label_name);
-                        }
-                    }
-                }
-                break;
-                
-            case IR_IF_FALSE_GOTO:
-                {
-                    RuntimeValue cond = execute_operand(interp, instr->operand1);
-                    int cond_value = 0;
-                    if (cond.type == VAL_INT) {
-                        cond_value = cond.data.int_val;
-                    } else if (cond.type == VAL_FLOAT) {
-                        cond_value = (cond.data.float_val != 0.0) ? 1 : 0;
-                    }
-                    
-                    printf("Debug: IF_FALSE_GOTO condition value: %d\n", cond_value);
-                    
-                    if (!cond_value && instr->operand2 && instr->operand2->type == OPERAND_LABEL) {
-                        int pos = find_label_position(arr, instr->operand2->label_name);
-                        if (pos >= 0) {
-                            printf("Debug: Jumping to label '%s' at position %d\n", instr->operand2->label_name, pos);
-                            interp->pc = pos;
-                            continue;  // 跳过pc自增
-                        } else {
-                            fprintf(stderr, "Label '%s' not found\n", instr->operand2->label_name);
-                        }
-                    }
-                }
-                break;
-                
-            case IR_RETURN:
-                {
-                    if (instr->operand1) {
-                        interp->return_val = execute_operand(interp, instr->operand1);
-                    }
-                    interp->running = false;
-                }
-                break;
-                
-            case IR_LABEL:
-                // 标签指令不需要执行，只是占位
-                break;
-                
-            case IR_CONVERT:
-                {
-                    RuntimeValue value = execute_operand(interp, instr->operand1);
-                    RuntimeValue converted_value;
-                    
-                    // 根据结果操作数的数据类型进行转换
-                    if (instr->result && instr->result->data_type == TYPE_FLOAT) {
-                        converted_value.type = VAL_FLOAT;
-                        if (value.type == VAL_INT) {
-                            converted_value.data.float_val = (float)value.data.int_val;
-                        } else {
-                            converted_value.data.float_val = value.data.float_val;
-                        }
-                    } else {
-                        converted_value.type = VAL_INT;
-                        if (value.type == VAL_FLOAT) {
-                            converted_value.data.int_val = (int)value.data.float_val;
-                        } else {
-                            converted_value.data.int_val = value.data.int_val;
-                        }
-                    }
-                    
-                    set_operand_variable(interp, instr->result, converted_value);
-                }
-                break;
-                
-            case IR_PARAM:
-                // 参数指令 - 将参数压入栈
-                {
-                    RuntimeValue param_value = execute_operand(interp, instr->operand1);
-                    if (interp->param_count < interp->max_params) {
-                        // 复制字符串值
-                        if (param_value.type == VAL_STRING && param_value.data.str_val) {
-                            interp->param_stack[interp->param_count].type = VAL_STRING;
-                            interp->param_stack[interp->param_count].data.str_val = strdup(param_value.data.str_val);
-                        } else {
-                            interp->param_stack[interp->param_count] = param_value;
-                        }
-                        interp->param_count++;
-                        printf("Debug: Added parameter %d: ", interp->param_count);
-                        print_runtime_value(param_value);
-                        printf("\n");
-                    }
-                }
-                break;
-                
-            case IR_FUNC_BEGIN:
-            case IR_FUNC_END:
-                // 函数开始和结束标记，暂时不需要特殊处理
-                break;
-                
-            case IR_CALL:
-                // 函数调用处理
-                if (instr->operand1 && instr->operand1->type == OPERAND_FUNC) {
-                    if (strcmp(instr->operand1->func_name, "printf") == 0) {
-                        // 实现简单的printf功能
-                        execute_printf(interp);
-                    }
-                }
-                // 清空参数栈
-                for (int i = 0; i < interp->param_count; i++) {
-                    if (interp->param_stack[i].type == VAL_STRING && interp->param_stack[i].data.str_val) {
-                        free(interp->param_stack[i].data.str_val);
-                    }
-                }
-                interp->param_count = 0;
-                break;
-                
-            default:
-                fprintf(stderr, "Unsupported IR instruction: %d\n", instr->opcode);
-                break;
-        }
-        
-        interp->pc++;
-    }
-    
-    free_instruction_array(arr);
+    execute_bytecode(interp, prog);
+    free_bytecode(prog);
 }
 
 // 创建运行时值的辅助函数
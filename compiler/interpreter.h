@@ -2,6 +2,8 @@
 #define INTERPRETER_H
 
 #include "ir.h"
+#include "bytecode.h"
+#include "profile.h"
 #include <stdbool.h>
 
 // 变量值类型
@@ -17,22 +19,51 @@ typedef struct {
     union {
         int int_val;
         float float_val;
-        char *str_val;
+        const char *str_val;
     } data;
 } RuntimeValue;
 
-// 变量表项
-typedef struct VarEntry {
-    char *name;
-    RuntimeValue value;
-    struct VarEntry *next;
-} VarEntry;
+// 分派方式：GCC/Clang下默认使用computed goto直接线程化分派，
+// 编译时定义INTERP_SWITCH_DISPATCH可退回到switch分派
+#if defined(__GNUC__)
+#define INTERP_HAVE_THREADED 1
+#else
+#define INTERP_HAVE_THREADED 0
+#endif
+
+typedef enum {
+    DISPATCH_SWITCH,         // switch循环
+    DISPATCH_THREADED,       // computed goto直接线程化
+    DISPATCH_COUNTED,        // switch循环并统计执行的指令条数
+    DISPATCH_PROFILED        // switch循环并按指令统计执行次数和耗时
+} DispatchKind;
+
+#if INTERP_HAVE_THREADED && !defined(INTERP_SWITCH_DISPATCH)
+#define DISPATCH_DEFAULT DISPATCH_THREADED
+#else
+#define DISPATCH_DEFAULT DISPATCH_SWITCH
+#endif
+
+// 槽中的值：类型由字节码静态确定，不带类型标记
+typedef union {
+    int int_val;
+    float float_val;
+    const char *str_val;     // 指向字节码字符串池中的字符串（只读）
+} SlotValue;
 
 // 解释器上下文
 typedef struct {
-    VarEntry *variables;     // 变量表
+    SlotValue *slots;        // 变量槽：变量和临时变量按下标存放，常量池紧随其后
+    uint8_t *slot_types;     // 各槽的静态类型（与ValueType取值一致）
+    const char **slot_names; // 槽对应的名称（临时变量为NULL），指向字节码字符串池或调用者的驻留名称，不复制
+    int slot_count;          // 已分配槽数量
+    int slot_capacity;       // 槽数组容量
+    NameIndex var_index;     // 变量名 -> 槽下标
     int pc;                  // 程序计数器
     bool running;            // 是否继续执行
+    bool silent;             // 是否屏蔽程序自身的printf输出（基准测试用）
+    bool profiling;          // execute_bytecode/execute_ir是否使用剖析引擎
+    Profile *profile;        // 最近一次剖析执行的结果
     RuntimeValue return_val; // 返回值
     RuntimeValue *param_stack; // 参数栈
     int param_count;         // 参数数量
@@ -43,8 +74,15 @@ typedef struct {
 Interpreter* init_interpreter(void);
 void free_interpreter(Interpreter *interp);
 void execute_ir(Interpreter *interp, IRGenerator *ir_gen);
+void execute_bytecode(Interpreter *interp, BytecodeProgram *prog);
+long long execute_bytecode_with(Interpreter *interp, BytecodeProgram *prog, DispatchKind kind);
 void set_variable(Interpreter *interp, const char *name, RuntimeValue value);
 RuntimeValue get_variable(Interpreter *interp, const char *name);
+
+// 变量槽管理
+void bind_frame(Interpreter *interp, BytecodeProgram *prog);
+int get_var_slot(Interpreter *interp, const char *name);
+void set_slot_value(Interpreter *interp, int slot, RuntimeValue value);
 void print_runtime_value(RuntimeValue value);
 void execute_printf(Interpreter *interp);
 
@@ -53,8 +91,7 @@ RuntimeValue create_int_value(int value);
 RuntimeValue create_float_value(float value);
 RuntimeValue create_string_value(const char *str);
 
-// 操作数执行函数
-RuntimeValue execute_operand(Interpreter *interp, Operand *operand);
+// 运算执行函数
 RuntimeValue execute_binop(RuntimeValue left, RuntimeValue right, BinOpType op);
 
 #endif
@@ -0,0 +1,259 @@
+// 字节码执行引擎模板，由interpreter.c多次包含生成不同的分派方式
+// 包含前需定义：
+//   ENGINE_NAME      生成的函数名
+//   ENGINE_THREADED  1为computed goto直接线程化分派，0为switch分派
+//   ENGINE_COUNTED   1为统计实际执行的指令条数（用于基准测试）
+//   ENGINE_PROFILED  1为按指令累计执行次数和耗时到interp->profile（仅switch分派）
+// 函数签名：long long ENGINE_NAME(Interpreter *interp, BytecodeProgram *prog)
+// 返回执行的指令条数（ENGINE_COUNTED为0时返回0）
+
+#if ENGINE_THREADED
+#define TARGET(op)  L_##op:
+#define DISPATCH()  { COUNT(); instr = &code[pc]; goto *thread[pc]; }
+#else
+#define TARGET(op)  case op:
+#define DISPATCH()  continue
+#endif
+
+#if ENGINE_PROFILED
+// 每条指令开始时结算上一条指令的耗时，并计入本条指令的执行次数
+#define COUNT()     { \
+        unsigned long long now = profile_clock(); \
+        profile->ticks[profile_pc] += now - profile_last; \
+        profile->counts[pc]++; \
+        profile_pc = pc; \
+        profile_last = now; \
+        executed++; \
+    }
+#elif ENGINE_COUNTED
+#define COUNT()     executed++
+#else
+#define COUNT()     ((void)0)
+#endif
+
+// 不能用do/while(0)包裹：switch分派下DISPATCH()是continue，必须作用于外层循环
+#define NEXT()      { pc++; DISPATCH(); }
+#define JUMP(t)     { pc = (t); DISPATCH(); }
+// 比较并跳转超级指令：条件不成立时跳转
+#define BRANCH_UNLESS(cond) { \
+        int cond_value = (cond); \
+        TRACE(TRACE_INTERP, TRACE_DEBUG, "pc %d: branch condition %d", pc, cond_value); \
+        if (!cond_value) JUMP(instr->dst); \
+        NEXT(); \
+    }
+#define DST         (&slots[instr->dst])
+#define A           (&slots[instr->src1])
+#define B           (&slots[instr->src2])
+
+static long long ENGINE_NAME(Interpreter *interp, BytecodeProgram *prog) {
+    SlotValue *slots = interp->slots;
+    BCInstr *code = prog->code;
+    int code_count = prog->code_count;
+    const char *strings = prog->strings;
+    const uint32_t *string_offsets = prog->string_offsets;
+    BCInstr *instr;
+    int pc = 0;
+    long long executed = 0;
+#if ENGINE_PROFILED
+    Profile *profile = interp->profile;
+    int profile_pc = code_count;   // 哨兵项，吸收进入第一条指令前的耗时
+    unsigned long long profile_last = profile_clock();
+#endif
+
+    interp->running = true;
+
+#if ENGINE_THREADED
+    // 各操作码的处理程序地址
+    static const void *handlers[BC_OPCODE_COUNT] = {
+        [BC_NOP] = &&L_BC_NOP, [BC_MOVE] = &&L_BC_MOVE, [BC_LOAD_STR] = &&L_BC_LOAD_STR,
+        [BC_ADD_I32] = &&L_BC_ADD_I32, [BC_SUB_I32] = &&L_BC_SUB_I32,
+        [BC_MUL_I32] = &&L_BC_MUL_I32, [BC_DIV_I32] = &&L_BC_DIV_I32,
+        [BC_EQ_I32] = &&L_BC_EQ_I32, [BC_NE_I32] = &&L_BC_NE_I32, [BC_LT_I32] = &&L_BC_LT_I32,
+        [BC_GT_I32] = &&L_BC_GT_I32, [BC_LE_I32] = &&L_BC_LE_I32, [BC_GE_I32] = &&L_BC_GE_I32,
+        [BC_ADD_F32] = &&L_BC_ADD_F32, [BC_SUB_F32] = &&L_BC_SUB_F32,
+        [BC_MUL_F32] = &&L_BC_MUL_F32, [BC_DIV_F32] = &&L_BC_DIV_F32,
+        [BC_EQ_F32] = &&L_BC_EQ_F32, [BC_NE_F32] = &&L_BC_NE_F32, [BC_LT_F32] = &&L_BC_LT_F32,
+        [BC_GT_F32] = &&L_BC_GT_F32, [BC_LE_F32] = &&L_BC_LE_F32, [BC_GE_F32] = &&L_BC_GE_F32,
+        [BC_CONVERT_INT] = &&L_BC_CONVERT_INT, [BC_CONVERT_FLOAT] = &&L_BC_CONVERT_FLOAT,
+        [BC_GOTO] = &&L_BC_GOTO, [BC_IF_TRUE] = &&L_BC_IF_TRUE, [BC_IF_FALSE] = &&L_BC_IF_FALSE,
+        [BC_PARAM_I32] = &&L_BC_PARAM_I32, [BC_PARAM_F32] = &&L_BC_PARAM_F32,
+        [BC_PARAM_STR] = &&L_BC_PARAM_STR, [BC_CALL] = &&L_BC_CALL, [BC_RETURN] = &&L_BC_RETURN,
+        [BC_IFNOT_EQ_I32] = &&L_BC_IFNOT_EQ_I32, [BC_IFNOT_NE_I32] = &&L_BC_IFNOT_NE_I32,
+        [BC_IFNOT_LT_I32] = &&L_BC_IFNOT_LT_I32, [BC_IFNOT_GT_I32] = &&L_BC_IFNOT_GT_I32,
+        [BC_IFNOT_LE_I32] = &&L_BC_IFNOT_LE_I32, [BC_IFNOT_GE_I32] = &&L_BC_IFNOT_GE_I32,
+        [BC_IFNOT_EQ_F32] = &&L_BC_IFNOT_EQ_F32, [BC_IFNOT_NE_F32] = &&L_BC_IFNOT_NE_F32,
+        [BC_IFNOT_LT_F32] = &&L_BC_IFNOT_LT_F32, [BC_IFNOT_GT_F32] = &&L_BC_IFNOT_GT_F32,
+        [BC_IFNOT_LE_F32] = &&L_BC_IFNOT_LE_F32, [BC_IFNOT_GE_F32] = &&L_BC_IFNOT_GE_F32
+    };
+
+    // 直接线程化：每条指令预先换成处理程序地址，末尾追加一个停机项
+    const void **thread = (const void**)malloc((code_count + 1) * sizeof(void*));
+    for (int i = 0; i < code_count; i++) {
+        thread[i] = code[i].opcode < BC_OPCODE_COUNT && handlers[code[i].opcode] ?
+                    handlers[code[i].opcode] : &&L_unknown;
+    }
+    thread[code_count] = &&L_halt;
+
+    DISPATCH();
+#else
+    for (;;) {
+        if (pc >= code_count) goto L_halt;
+        instr = &code[pc];
+        COUNT();
+        switch (instr->opcode) {
+#endif
+
+    TARGET(BC_NOP)
+        NEXT();
+
+    TARGET(BC_MOVE)
+        *DST = *A;
+        NEXT();
+
+    TARGET(BC_LOAD_STR)
+        DST->str_val = strings + string_offsets[instr->src1];
+        NEXT();
+
+    // 整数运算
+    TARGET(BC_ADD_I32) DST->int_val = A->int_val + B->int_val; NEXT();
+    TARGET(BC_SUB_I32) DST->int_val = A->int_val - B->int_val; NEXT();
+    TARGET(BC_MUL_I32) DST->int_val = A->int_val * B->int_val; NEXT();
+    TARGET(BC_DIV_I32)
+        if (B->int_val != 0) {
+            DST->int_val = A->int_val / B->int_val;
+        } else {
+            fprintf(stderr, "Division by zero\n");
+            DST->int_val = 0;
+        }
+        NEXT();
+    TARGET(BC_EQ_I32) DST->int_val = A->int_val == B->int_val; NEXT();
+    TARGET(BC_NE_I32) DST->int_val = A->int_val != B->int_val; NEXT();
+    TARGET(BC_LT_I32) DST->int_val = A->int_val < B->int_val; NEXT();
+    TARGET(BC_GT_I32) DST->int_val = A->int_val > B->int_val; NEXT();
+    TARGET(BC_LE_I32) DST->int_val = A->int_val <= B->int_val; NEXT();
+    TARGET(BC_GE_I32) DST->int_val = A->int_val >= B->int_val; NEXT();
+
+    // 浮点运算
+    TARGET(BC_ADD_F32) DST->float_val = A->float_val + B->float_val; NEXT();
+    TARGET(BC_SUB_F32) DST->float_val = A->float_val - B->float_val; NEXT();
+    TARGET(BC_MUL_F32) DST->float_val = A->float_val * B->float_val; NEXT();
+    TARGET(BC_DIV_F32)
+        if (B->float_val != 0.0f) {
+            DST->float_val = A->float_val / B->float_val;
+        } else {
+            fprintf(stderr, "Division by zero\n");
+            DST->float_val = 0.0f;
+        }
+        NEXT();
+    TARGET(BC_EQ_F32) DST->int_val = fabs(A->float_val - B->float_val) < 1e-6; NEXT();
+    TARGET(BC_NE_F32) DST->int_val = fabs(A->float_val - B->float_val) >= 1e-6; NEXT();
+    TARGET(BC_LT_F32) DST->int_val = A->float_val < B->float_val; NEXT();
+    TARGET(BC_GT_F32) DST->int_val = A->float_val > B->float_val; NEXT();
+    TARGET(BC_LE_F32) DST->int_val = A->float_val <= B->float_val; NEXT();
+    TARGET(BC_GE_F32) DST->int_val = A->float_val >= B->float_val; NEXT();
+
+    TARGET(BC_CONVERT_INT)
+        DST->int_val = (int)A->float_val;
+        NEXT();
+
+    TARGET(BC_CONVERT_FLOAT)
+        DST->float_val = (float)A->int_val;
+        NEXT();
+
+    TARGET(BC_GOTO)
+        if (instr->dst >= 0) JUMP(instr->dst);
+        NEXT();
+
+    TARGET(BC_IF_TRUE)
+        if (A->int_val && instr->dst >= 0) JUMP(instr->dst);
+        NEXT();
+
+    TARGET(BC_IF_FALSE)
+        TRACE(TRACE_INTERP, TRACE_DEBUG, "pc %d: branch condition %d", pc, A->int_val);
+        if (!A->int_val && instr->dst >= 0) {
+            TRACE(TRACE_INTERP, TRACE_DEBUG, "pc %d: jump to %d", pc, instr->dst);
+            JUMP(instr->dst);
+        }
+        NEXT();
+
+    // 比较并跳转
+    TARGET(BC_IFNOT_EQ_I32) BRANCH_UNLESS(A->int_val == B->int_val);
+    TARGET(BC_IFNOT_NE_I32) BRANCH_UNLESS(A->int_val != B->int_val);
+    TARGET(BC_IFNOT_LT_I32) BRANCH_UNLESS(A->int_val < B->int_val);
+    TARGET(BC_IFNOT_GT_I32) BRANCH_UNLESS(A->int_val > B->int_val);
+    TARGET(BC_IFNOT_LE_I32) BRANCH_UNLESS(A->int_val <= B->int_val);
+    TARGET(BC_IFNOT_GE_I32) BRANCH_UNLESS(A->int_val >= B->int_val);
+    TARGET(BC_IFNOT_EQ_F32) BRANCH_UNLESS(fabs(A->float_val - B->float_val) < 1e-6);
+    TARGET(BC_IFNOT_NE_F32) BRANCH_UNLESS(fabs(A->float_val - B->float_val) >= 1e-6);
+    TARGET(BC_IFNOT_LT_F32) BRANCH_UNLESS(A->float_val < B->float_val);
+    TARGET(BC_IFNOT_GT_F32) BRANCH_UNLESS(A->float_val > B->float_val);
+    TARGET(BC_IFNOT_LE_F32) BRANCH_UNLESS(A->float_val <= B->float_val);
+    TARGET(BC_IFNOT_GE_F32) BRANCH_UNLESS(A->float_val >= B->float_val);
+
+    // 参数指令 - 类型在降级时确定，只在这里附上类型标记
+    TARGET(BC_PARAM_I32)
+        push_param(interp, create_int_value(A->int_val));
+        NEXT();
+
+    TARGET(BC_PARAM_F32)
+        push_param(interp, create_float_value(A->float_val));
+        NEXT();
+
+    TARGET(BC_PARAM_STR)
+        {
+            RuntimeValue param_value;
+            param_value.type = VAL_STRING;
+            param_value.data.str_val = A->str_val;
+            push_param(interp, param_value);
+        }
+        NEXT();
+
+    TARGET(BC_CALL)
+        // 函数调用处理
+        if (instr->aux == BUILTIN_PRINTF) {
+            // 实现简单的printf功能
+            execute_printf(interp);
+        }
+        clear_params(interp);
+        NEXT();
+
+    TARGET(BC_RETURN)
+        if (instr->src1 >= 0) {
+            interp->return_val = slot_to_value(interp, instr->src1);
+        }
+        interp->running = false;
+        goto L_halt;
+
+#if ENGINE_THREADED
+L_unknown:
+#else
+        default:
+#endif
+        fprintf(stderr, "Unsupported bytecode instruction: %d\n", instr->opcode);
+        NEXT();
+
+#if !ENGINE_THREADED
+        }
+    }
+#endif
+
+L_halt:
+#if ENGINE_PROFILED
+    profile->ticks[profile_pc] += profile_clock() - profile_last;
+#endif
+#if ENGINE_THREADED
+    free(thread);
+#endif
+    interp->pc = pc;
+    return executed;
+}
+
+#undef TARGET
+#undef DISPATCH
+#undef COUNT
+#undef NEXT
+#undef JUMP
+#undef BRANCH_UNLESS
+#undef DST
+#undef A
+#undef B
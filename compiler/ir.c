@@ -1,139 +1,144 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include "ir.h"
 #include "symbol_table.h"
 
+// 区域的第一块可容纳的指令数，之后每块翻倍，直到上限；
+// 块不太大时释放后还留在堆中，下一个翻译单元可以直接复用这些页
+#define IR_ARENA_FIRST_BLOCK 256
+#define IR_ARENA_MAX_BLOCK   8192
+
 // 初始化IR生成器
 IRGenerator* init_ir_generator(SymbolTable *symbol_table) {
     IRGenerator *gen = (IRGenerator*)malloc(sizeof(IRGenerator));
+    gen->arena = NULL;
     gen->instructions = NULL;
     gen->last_instr = NULL;
+    gen->instruction_count = 0;
     gen->temp_counter = 0;
     gen->label_counter = 0;
     gen->symbol_table = symbol_table;
-    gen->var_type_table = NULL;  // 初始化变量类型映射表
+    gen->current_line = 0;
+    gen->current_column = 0;
     return gen;
 }
 
-// 释放IR生成器
+// 释放IR生成器：指令都在区域中，逐块释放即可
 void free_ir_generator(IRGenerator *gen) {
-    IRInstruction *current = gen->instructions;
-    while (current) {
-        IRInstruction *next = current->next;
-        if (current->result) free_operand(current->result);
-        if (current->operand1) free_operand(current->operand1);
-        if (current->operand2) free_operand(current->operand2);
-        free(current);
-        current = next;
-    }
-    
-    // 释放变量类型映射表
-    VarTypeNode *var_current = gen->var_type_table;
-    while (var_current) {
-        VarTypeNode *var_next = var_current->next;
-        free(var_current->var_name);
-        free(var_current);
-        var_current = var_next;
+    IRArenaBlock *block = gen->arena;
+    while (block) {
+        IRArenaBlock *next = block->next;
+        free(block);
+        block = next;
     }
     
     free(gen);
 }
 
 // 创建临时变量操作数
-Operand* create_temp_operand(int temp_id, DataType type) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_TEMP;
-    operand->data_type = type;
-    operand->temp_id = temp_id;
+Operand create_temp_operand(int temp_id, DataType type) {
+    Operand operand = { OPERAND_TEMP, type };
+    operand.temp_id = temp_id;
     return operand;
 }
 
-// 创建变量操作数
-Operand* create_var_operand(const char *var_name, DataType type) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_VAR;
-    operand->data_type = type;
-    operand->var_name = strdup(var_name);
+// 创建变量操作数，var_name是驻留的名称，只保存指针
+Operand create_var_operand(const char *var_name, DataType type) {
+    Operand operand = { OPERAND_VAR, type };
+    operand.var_name = var_name;
     return operand;
 }
 
 // 创建整数常量操作数
-Operand* create_int_const_operand(int value) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_CONST;
-    operand->data_type = TYPE_INT;
-    operand->const_val.int_val = value;
+Operand create_int_const_operand(int value) {
+    Operand operand = { OPERAND_CONST, TYPE_INT };
+    operand.const_val.int_val = value;
     return operand;
 }
 
 // 创建浮点常量操作数
-Operand* create_float_const_operand(float value) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_CONST;
-    operand->data_type = TYPE_FLOAT;
-    operand->const_val.float_val = value;
+Operand create_float_const_operand(float value) {
+    Operand operand = { OPERAND_CONST, TYPE_FLOAT };
+    operand.const_val.float_val = value;
     return operand;
 }
 
 // 创建标签操作数
-Operand* create_label_operand(const char *label_name) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_LABEL;
-    operand->data_type = TYPE_UNKNOWN;
-    operand->label_name = strdup(label_name);
+Operand create_label_operand(int label_id) {
+    Operand operand = { OPERAND_LABEL, TYPE_UNKNOWN };
+    operand.label_id = label_id;
     return operand;
 }
 
-// 创建函数操作数
-Operand* create_func_operand(const char *func_name) {
-    Operand *operand = (Operand*)malloc(sizeof(Operand));
-    operand->type = OPERAND_FUNC;
-    operand->data_type = TYPE_UNKNOWN;
-    operand->func_name = strdup(func_name);
+// 创建函数操作数，func_name是驻留的名称
+Operand create_func_operand(const char *func_name) {
+    Operand operand = { OPERAND_FUNC, TYPE_UNKNOWN };
+    operand.func_name = func_name;
     return operand;
 }
 
-// 释放操作数
-void free_operand(Operand *operand) {
-    if (!operand) return;
-    
-    switch (operand->type) {
-        case OPERAND_VAR:
-            free(operand->var_name);
-            break;
-        case OPERAND_LABEL:
-            free(operand->label_name);
-            break;
-        case OPERAND_FUNC:
-            free(operand->func_name);
-            break;
-        default:
-            break;
+// 创建IR指令：当前块用完时分配一个新块
+IRInstruction* create_ir_instruction(IRGenerator *gen, IROpcode opcode) {
+    IRArenaBlock *block = gen->arena;
+    if (!block || block->used == block->capacity) {
+        uint32_t capacity = !block ? IR_ARENA_FIRST_BLOCK :
+                            block->capacity < IR_ARENA_MAX_BLOCK ? block->capacity * 2 : IR_ARENA_MAX_BLOCK;
+        IRArenaBlock *grown = (IRArenaBlock*)malloc(sizeof(IRArenaBlock) + capacity * sizeof(IRInstruction));
+        if (!grown) return NULL;
+        grown->next = block;
+        grown->used = 0;
+        grown->capacity = capacity;
+        gen->arena = block = grown;
     }
-    free(operand);
-}
-
-// 创建IR指令
-IRInstruction* create_ir_instruction(IROpcode opcode) {
-    IRInstruction *instr = (IRInstruction*)malloc(sizeof(IRInstruction));
+    
+    IRInstruction *instr = &block->instructions[block->used++];
+    memset(instr, 0, sizeof(IRInstruction));   // 操作数都为OPERAND_NONE
     instr->opcode = opcode;
-    instr->result = NULL;
-    instr->operand1 = NULL;
-    instr->operand2 = NULL;
-    instr->next = NULL;
     return instr;
 }
 
-// 添加指令到链表
+// 添加指令到链表末尾，没有位置的指令归属到正在生成的语句
 void append_instruction(IRGenerator *gen, IRInstruction *instr) {
-    if (!gen->instructions) {
-        gen->instructions = instr;
-        gen->last_instr = instr;
-    } else {
-        gen->last_instr->next = instr;
-        gen->last_instr = instr;
+    if (instr->line == 0) {
+        instr->line = gen->current_line;
+        instr->column = gen->current_column;
     }
+    insert_instruction_before(gen, NULL, instr);
+}
+
+// 在position之前插入
+void insert_instruction_before(IRGenerator *gen, IRInstruction *position, IRInstruction *instr) {
+    IRInstruction *prev = position ? position->prev : gen->last_instr;
+    instr->prev = prev;
+    instr->next = position;
+    if (prev) prev->next = instr;
+    else gen->instructions = instr;
+    if (position) position->prev = instr;
+    else gen->last_instr = instr;
+    gen->instruction_count++;
+}
+
+// 在position之后插入
+void insert_instruction_after(IRGenerator *gen, IRInstruction *position, IRInstruction *instr) {
+    insert_instruction_before(gen, position ? position->next : gen->instructions, instr);
+}
+
+// 摘下指令：前驱和后继直接相连
+void remove_instruction(IRGenerator *gen, IRInstruction *instr) {
+    if (instr->prev) instr->prev->next = instr->next;
+    else gen->instructions = instr->next;
+    if (instr->next) instr->next->prev = instr->prev;
+    else gen->last_instr = instr->prev;
+    instr->prev = NULL;
+    instr->next = NULL;
+    gen->instruction_count--;
+}
+
+void replace_instruction(IRGenerator *gen, IRInstruction *old_instr, IRInstruction *new_instr) {
+    insert_instruction_before(gen, old_instr, new_instr);
+    remove_instruction(gen, old_instr);
 }
 
 // 获取下一个临时变量ID
@@ -141,35 +146,26 @@ int get_next_temp(IRGenerator *gen) {
     return ++gen->temp_counter;
 }
 
-// 获取下一个标签
-char* get_next_label(IRGenerator *gen) {
-    char *label = (char*)malloc(16);
-    sprintf(label, "L%d", ++gen->label_counter);
-    return label;
+// 获取下一个标签编号
+int get_next_label(IRGenerator *gen) {
+    return ++gen->label_counter;
 }
 
-// 获取表达式类型 - 简化版本
-DataType get_expr_type(ASTNode *node, SymbolTable *symbol_table) {
-    switch (node->type) {
-        case EXPR_INT:
-            return TYPE_INT;
-        case EXPR_FLOAT:
-            return TYPE_FLOAT;
-        case EXPR_VAR:
-            // 简化：假设所有变量都是int类型
-            return TYPE_INT;
-        case EXPR_BINOP: {
-            DataType left_type = get_expr_type(node->left, symbol_table);
-            DataType right_type = get_expr_type(node->right, symbol_table);
-            // 如果有浮点数，结果为浮点数
-            if (left_type == TYPE_FLOAT || right_type == TYPE_FLOAT) {
-                return TYPE_FLOAT;
-            }
-            return TYPE_INT;
-        }
-        default:
-            return TYPE_UNKNOWN;
-    }
+// 获取表达式类型：语义分析已记录在AST上
+DataType get_expr_type(const AST *ast, NodeId node) {
+    if (node == AST_NONE || !ast->types) return TYPE_UNKNOWN;
+    return (DataType)ast->types[node];
+}
+
+// 变量、声明和赋值的类型；语义分析未能确定时按int处理
+static DataType annotated_var_type(const AST *ast, NodeId node) {
+    DataType type = get_expr_type(ast, node);
+    return type == TYPE_UNKNOWN ? TYPE_INT : type;
+}
+
+// 是否为比较运算符
+bool is_comparison_op(BinOpType op) {
+    return op >= OP_EQ && op <= OP_GE;
 }
 
 // 检查是否需要类型转换
@@ -177,285 +173,280 @@ bool need_type_conversion(DataType from, DataType to) {
     return from != to && from != TYPE_UNKNOWN && to != TYPE_UNKNOWN;
 }
 
-// 添加变量类型到映射表
-void add_var_type(IRGenerator *gen, const char *var_name, DataType type) {
-    if (!gen || !var_name) return;
-    
-    VarTypeNode *new_node = malloc(sizeof(VarTypeNode));
-    new_node->var_name = strdup(var_name);
-    new_node->type = type;
-    new_node->next = gen->var_type_table;
-    gen->var_type_table = new_node;
-}
+static const Operand no_operand = { OPERAND_NONE, TYPE_UNKNOWN };
 
-// 从映射表获取变量类型
-DataType get_var_type(IRGenerator *gen, const char *var_name) {
-    if (!gen || !var_name) return TYPE_INT;
-    
-    VarTypeNode *current = gen->var_type_table;
-    while (current) {
-        if (strcmp(current->var_name, var_name) == 0) {
-            return current->type;
-        }
-        current = current->next;
-    }
-    
-    return TYPE_INT;  // 默认返回int类型
+// 创建指令、填入操作数并追加到链表末尾；内存不足时不生成该指令，返回NULL
+static IRInstruction* append_new_instruction(IRGenerator *gen, IROpcode opcode, Operand result,
+                                             Operand operand1, Operand operand2) {
+    IRInstruction *instr = create_ir_instruction(gen, opcode);
+    if (!instr) return NULL;
+    instr->result = result;
+    instr->operand1 = operand1;
+    instr->operand2 = operand2;
+    append_instruction(gen, instr);
+    return instr;
 }
 
 // 生成类型转换
-Operand* generate_type_conversion(IRGenerator *gen, Operand *operand, DataType target_type) {
-    if (!need_type_conversion(operand->data_type, target_type)) {
+Operand generate_type_conversion(IRGenerator *gen, Operand operand, DataType target_type) {
+    if (!need_type_conversion(operand.data_type, target_type)) {
         return operand;
     }
     
-    int temp_id = get_next_temp(gen);
-    Operand *result = create_temp_operand(temp_id, target_type);
-    
-    IRInstruction *instr = create_ir_instruction(IR_CONVERT);
-    instr->result = result;
-    instr->operand1 = operand;
-    append_instruction(gen, instr);
+    // 常量直接换成目标类型的常量，不生成IR_CONVERT
+    if (operand.type == OPERAND_CONST) {
+        if (target_type == TYPE_FLOAT) {
+            return create_float_const_operand((float)operand.const_val.int_val);
+        }
+        return create_int_const_operand((int)operand.const_val.float_val);
+    }
     
+    Operand result = create_temp_operand(get_next_temp(gen), target_type);
+    append_new_instruction(gen, IR_CONVERT, result, operand, no_operand);
     return result;
 }
 
-// 生成表达式的中间代码
-Operand* generate_expr_ir(ASTNode *node, IRGenerator *gen) {
-    if (!node) {
-        return NULL;
+// 表达式中间代码生成用的操作数栈：后序遍历时每个子表达式压入自己的结果，二元运算弹出两个。
+// 栈较浅时使用内置数组，不分配内存
+#define EXPR_STACK_INLINE 32
+
+typedef struct {
+    IRGenerator *gen;
+    Operand inline_operands[EXPR_STACK_INLINE];
+    Operand *operands;
+    uint32_t count;
+    uint32_t capacity;
+} ExprWalk;
+
+static void push_operand(ExprWalk *walk, Operand operand) {
+    if (walk->count == walk->capacity) {
+        uint32_t capacity = walk->capacity * 2;
+        Operand *operands = walk->operands == walk->inline_operands
+                            ? (Operand*)malloc(capacity * sizeof(Operand))
+                            : (Operand*)realloc(walk->operands, capacity * sizeof(Operand));
+        if (!operands) return;
+        if (walk->operands == walk->inline_operands) memcpy(operands, walk->inline_operands, sizeof(walk->inline_operands));
+        walk->operands = operands;
+        walk->capacity = capacity;
     }
-    
-    switch (node->type) {
+    walk->operands[walk->count++] = operand;
+}
+
+static Operand pop_operand(ExprWalk *walk) {
+    return walk->count > 0 ? walk->operands[--walk->count] : no_operand;
+}
+
+// 生成CALL指令（参数的PARAM指令已生成），返回值存入新的临时变量
+static Operand append_call(IRGenerator *gen, const char *name) {
+    // 创建临时变量来存储返回值
+    Operand result_temp = create_temp_operand(get_next_temp(gen), TYPE_INT);
+    append_new_instruction(gen, IR_CALL, result_temp, create_func_operand(name), no_operand);
+    return result_temp;
+}
+
+// 进入二元运算的操作数和函数调用的参数
+static int expr_ir_pre(const AST *ast, ASTVisit *visit, void *data) {
+    (void)data;
+    NodeType kind = (NodeType)ast->kinds[visit->node];
+    return kind == EXPR_BINOP || kind == EXPR_CALL;
+}
+
+// 子表达式都已生成，其结果按从左到右的顺序在栈顶
+static Operand expr_node_ir(const AST *ast, NodeId node, ExprWalk *walk) {
+    IRGenerator *gen = walk->gen;
+    switch ((NodeType)ast->kinds[node]) {
         case EXPR_INT:
-            return create_int_const_operand(node->integer.value);
+            return create_int_const_operand(ast->payloads[node].integer.value);
             
         case EXPR_FLOAT:
-            return create_float_const_operand(node->floating.value);
+            return create_float_const_operand(ast->payloads[node].floating.value);
             
         case EXPR_VAR: {
-            // 从变量类型映射表中查找变量的实际类型
-            DataType var_type = get_var_type(gen, node->var.name);
-            
-            int temp_id = get_next_temp(gen);
-            Operand *result = create_temp_operand(temp_id, var_type);
-            Operand *var_operand = create_var_operand(node->var.name, var_type);
-            
-            IRInstruction *instr = create_ir_instruction(IR_LOAD);
-            instr->result = result;
-            instr->operand1 = var_operand;
-            append_instruction(gen, instr);
+            // 语义分析解析到的变量类型
+            DataType var_type = annotated_var_type(ast, node);
             
+            Operand result = create_temp_operand(get_next_temp(gen), var_type);
+            Operand var_operand = create_var_operand(ast->payloads[node].var.name, var_type);
+            append_new_instruction(gen, IR_LOAD, result, var_operand, no_operand);
             return result;
         }
         
         case EXPR_BINOP: {
-            Operand *left_operand = generate_expr_ir(node->left, gen);
-            Operand *right_operand = generate_expr_ir(node->right, gen);
+            Operand right_operand = pop_operand(walk);
+            Operand left_operand = pop_operand(walk);
             
-            // 确定结果类型
-            DataType result_type = TYPE_INT;
-            if (left_operand->data_type == TYPE_FLOAT || right_operand->data_type == TYPE_FLOAT) {
-                result_type = TYPE_FLOAT;
+            // 确定运算类型：有浮点数时两边都提升为浮点数
+            DataType operand_type = TYPE_INT;
+            if (left_operand.data_type == TYPE_FLOAT || right_operand.data_type == TYPE_FLOAT) {
+                operand_type = TYPE_FLOAT;
             }
+            // 比较运算的结果总是int
+            DataType result_type = is_comparison_op(ast->payloads[node].binop.op) ? TYPE_INT : operand_type;
             
             // 类型转换
-            if (need_type_conversion(left_operand->data_type, result_type)) {
-                left_operand = generate_type_conversion(gen, left_operand, result_type);
+            if (need_type_conversion(left_operand.data_type, operand_type)) {
+                left_operand = generate_type_conversion(gen, left_operand, operand_type);
             }
-            if (need_type_conversion(right_operand->data_type, result_type)) {
-                right_operand = generate_type_conversion(gen, right_operand, result_type);
+            if (need_type_conversion(right_operand.data_type, operand_type)) {
+                right_operand = generate_type_conversion(gen, right_operand, operand_type);
             }
             
-            int temp_id = get_next_temp(gen);
-            Operand *result = create_temp_operand(temp_id, result_type);
-            
-            IRInstruction *instr = create_ir_instruction(IR_BINOP);
-            instr->result = result;
-            instr->operand1 = left_operand;
-            instr->operand2 = right_operand;
-            instr->binop = node->binop.op;
-            append_instruction(gen, instr);
-            
+            Operand result = create_temp_operand(get_next_temp(gen), result_type);
+            IRInstruction *instr = append_new_instruction(gen, IR_BINOP, result, left_operand, right_operand);
+            if (instr) instr->binop = ast->payloads[node].binop.op;
             return result;
         }
         
-        case EXPR_CALL: {
-            // 函数调用表达式
-            return generate_call_expr_ir(node, gen);
-        }
+        case EXPR_CALL:
+            // 函数调用表达式：参数的PARAM指令已在访问参数时生成
+            return append_call(gen, ast->payloads[node].call.name);
         
         default:
-            return NULL;
+            return no_operand;
+    }
+}
+
+static void expr_ir_post(const AST *ast, ASTVisit *visit, void *data) {
+    ExprWalk *walk = (ExprWalk*)data;
+    Operand operand = expr_node_ir(ast, visit->node, walk);
+    
+    // 函数调用的参数：求值后立即生成PARAM指令，不压栈
+    if (visit->up && ast->kinds[visit->up->node] == EXPR_CALL) {
+        append_new_instruction(walk->gen, IR_PARAM, no_operand, operand, no_operand);
+    } else {
+        push_operand(walk, operand);
     }
 }
 
+// 生成表达式的中间代码，返回结果操作数（失败时为OPERAND_NONE）
+Operand generate_expr_ir(const AST *ast, NodeId node, IRGenerator *gen) {
+    if (node == AST_NONE) {
+        return no_operand;
+    }
+    
+    ExprWalk walk;
+    walk.gen = gen;
+    walk.operands = walk.inline_operands;
+    walk.count = 0;
+    walk.capacity = EXPR_STACK_INLINE;
+    ASTVisitor visitor = { expr_ir_pre, expr_ir_post };
+    Operand result = visit_ast(ast, node, &visitor, &walk) ? pop_operand(&walk) : no_operand;
+    if (walk.operands != walk.inline_operands) free(walk.operands);
+    return result;
+}
+
+// 生成变量存储：表达式结果按变量类型转换后存入变量
+static void generate_store_ir(const AST *ast, NodeId node, const char *name, IRGenerator *gen) {
+    Operand expr_operand = generate_expr_ir(ast, ast->lefts[node], gen);
+    
+    // 语义分析解析到的变量类型
+    DataType var_type = annotated_var_type(ast, node);
+    
+    // 类型转换 - 只有当真正需要时才转换
+    if (need_type_conversion(expr_operand.data_type, var_type)) {
+        expr_operand = generate_type_conversion(gen, expr_operand, var_type);
+    }
+    
+    append_new_instruction(gen, IR_STORE, create_var_operand(name, var_type), expr_operand, no_operand);
+}
+
 // 生成语句的中间代码
-void generate_stmt_ir(ASTNode *node, IRGenerator *gen) {
-    if (!node) return;
+void generate_stmt_ir(const AST *ast, NodeId node, IRGenerator *gen) {
+    if (node == AST_NONE) return;
+    
+    // 语句生成的指令归属到语句的源代码位置，生成完后恢复外层语句的位置
+    // （如while末尾的回跳仍归属到while所在行）
+    int saved_line = gen->current_line;
+    int saved_column = gen->current_column;
+    if (ast->kinds[node] != STMT_COMPOUND && ast->locations[node].line > 0) {
+        gen->current_line = ast->locations[node].line;
+        gen->current_column = ast->locations[node].column;
+    }
     
-    switch (node->type) {
+    switch ((NodeType)ast->kinds[node]) {
         case STMT_COMPOUND:
-            if (node->left) generate_stmt_ir(node->left, gen);
-            if (node->right) generate_stmt_ir(node->right, gen);
+            for (uint32_t i = 0; i < ast->payloads[node].block.stmt_count; i++) {
+                generate_stmt_ir(ast, AST_BLOCK_STMT(ast, node, i), gen);
+            }
             break;
             
         case STMT_DECL:
-            // 处理变量声明，记录类型到映射表
-            if (node->decl.name && node->decl.var_type) {
-                DataType var_type = TYPE_INT; // 默认为int
-                if (strcmp(node->decl.var_type, "float") == 0) {
-                    var_type = TYPE_FLOAT;
-                }
-                add_var_type(gen, node->decl.name, var_type);
-            }
+            // 只有声明没有初始化，不生成指令；变量类型已由语义分析记录在引用它的节点上
             break;
             
-        case STMT_DECL_ASSIGN: {
-            Operand *expr_operand = generate_expr_ir(node->left, gen);  // 修改为left
-            
-            // 从AST节点获取变量类型信息，而不是从符号表
-            DataType var_type = TYPE_INT; // 默认为int
-            if (node->decl.var_type) {
-                if (strcmp(node->decl.var_type, "float") == 0) {
-                    var_type = TYPE_FLOAT;
-                }
-            }
-            
-            // 记录变量类型到映射表
-            add_var_type(gen, node->decl.name, var_type);
-            
-            // 类型转换
-            if (need_type_conversion(expr_operand->data_type, var_type)) {
-                expr_operand = generate_type_conversion(gen, expr_operand, var_type);
-            }
-            
-            Operand *var_operand = create_var_operand(node->decl.name, var_type);
-            
-            IRInstruction *instr = create_ir_instruction(IR_STORE);
-            instr->result = var_operand;
-            instr->operand1 = expr_operand;
-            append_instruction(gen, instr);
+        case STMT_DECL_ASSIGN:
+            generate_store_ir(ast, node, ast->payloads[node].decl.name, gen);
             break;
-        }
         
-        case STMT_ASSIGN: {
-            Operand *expr_operand = generate_expr_ir(node->left, gen);  // 修改为left
-            
-            // 从变量类型映射表中查找变量的实际类型
-            DataType var_type = get_var_type(gen, node->assign.name);
-            
-            // 类型转换 - 只有当真正需要时才转换
-            if (need_type_conversion(expr_operand->data_type, var_type)) {
-                expr_operand = generate_type_conversion(gen, expr_operand, var_type);
-            }
-            
-            Operand *var_operand = create_var_operand(node->assign.name, var_type);
-            
-            IRInstruction *instr = create_ir_instruction(IR_STORE);
-            instr->result = var_operand;
-            instr->operand1 = expr_operand;
-            append_instruction(gen, instr);
+        case STMT_ASSIGN:
+            generate_store_ir(ast, node, ast->payloads[node].assign.name, gen);
             break;
-        }
         
         case STMT_IF: {
-            Operand *cond_operand = generate_expr_ir(node->if_stmt.cond, gen);
+            Operand cond_operand = generate_expr_ir(ast, ast->payloads[node].if_stmt.cond, gen);
             
-            char *else_label = get_next_label(gen);
-            char *end_label = get_next_label(gen);
+            Operand else_label = create_label_operand(get_next_label(gen));
+            Operand end_label = create_label_operand(get_next_label(gen));
             
             // 条件跳转到else分支
-            IRInstruction *if_false_instr = create_ir_instruction(IR_IF_FALSE_GOTO);
-            if_false_instr->operand1 = cond_operand;
-            if_false_instr->operand2 = create_label_operand(else_label);
-            append_instruction(gen, if_false_instr);
+            append_new_instruction(gen, IR_IF_FALSE_GOTO, no_operand, cond_operand, else_label);
             
             // then分支
-            if (node->left) generate_stmt_ir(node->left, gen);
+            if (ast->lefts[node] != AST_NONE) generate_stmt_ir(ast, ast->lefts[node], gen);
             
             // 跳转到结束
-            IRInstruction *goto_end_instr = create_ir_instruction(IR_GOTO);
-            goto_end_instr->operand1 = create_label_operand(end_label);
-            append_instruction(gen, goto_end_instr);
+            append_new_instruction(gen, IR_GOTO, no_operand, end_label, no_operand);
             
             // else标签
-            IRInstruction *else_label_instr = create_ir_instruction(IR_LABEL);
-            else_label_instr->operand1 = create_label_operand(else_label);
-            append_instruction(gen, else_label_instr);
+            append_new_instruction(gen, IR_LABEL, no_operand, else_label, no_operand);
             
             // else分支
-            if (node->right) generate_stmt_ir(node->right, gen);
+            if (ast->rights[node] != AST_NONE) generate_stmt_ir(ast, ast->rights[node], gen);
             
             // 结束标签
-            IRInstruction *end_label_instr = create_ir_instruction(IR_LABEL);
-            end_label_instr->operand1 = create_label_operand(end_label);
-            append_instruction(gen, end_label_instr);
-            
-            free(else_label);
-            free(end_label);
+            append_new_instruction(gen, IR_LABEL, no_operand, end_label, no_operand);
             break;
         }
         
         case STMT_WHILE: {
-            char *loop_label = get_next_label(gen);
-            char *end_label = get_next_label(gen);
+            Operand loop_label = create_label_operand(get_next_label(gen));
+            Operand end_label = create_label_operand(get_next_label(gen));
             
             // 循环开始标签
-            IRInstruction *loop_label_instr = create_ir_instruction(IR_LABEL);
-            loop_label_instr->operand1 = create_label_operand(loop_label);
-            append_instruction(gen, loop_label_instr);
+            append_new_instruction(gen, IR_LABEL, no_operand, loop_label, no_operand);
             
             // 条件判断
-            Operand *cond_operand = generate_expr_ir(node->while_stmt.cond, gen);
+            Operand cond_operand = generate_expr_ir(ast, ast->payloads[node].while_stmt.cond, gen);
             
             // 条件为假时跳出循环
-            IRInstruction *if_false_instr = create_ir_instruction(IR_IF_FALSE_GOTO);
-            if_false_instr->operand1 = cond_operand;
-            if_false_instr->operand2 = create_label_operand(end_label);
-            append_instruction(gen, if_false_instr);
+            append_new_instruction(gen, IR_IF_FALSE_GOTO, no_operand, cond_operand, end_label);
             
             // 循环体
-            if (node->left) generate_stmt_ir(node->left, gen);
+            if (ast->lefts[node] != AST_NONE) generate_stmt_ir(ast, ast->lefts[node], gen);
             
             // 跳回循环开始
-            IRInstruction *goto_loop_instr = create_ir_instruction(IR_GOTO);
-            goto_loop_instr->operand1 = create_label_operand(loop_label);
-            append_instruction(gen, goto_loop_instr);
+            append_new_instruction(gen, IR_GOTO, no_operand, loop_label, no_operand);
             
             // 循环结束标签
-            IRInstruction *end_label_instr = create_ir_instruction(IR_LABEL);
-            end_label_instr->operand1 = create_label_operand(end_label);
-            append_instruction(gen, end_label_instr);
-            
-            free(loop_label);
-            free(end_label);
+            append_new_instruction(gen, IR_LABEL, no_operand, end_label, no_operand);
             break;
         }
         
         case STMT_RETURN: {
-            if (node->left) {
-                Operand *return_operand = generate_expr_ir(node->left, gen);
-                
-                IRInstruction *instr = create_ir_instruction(IR_RETURN);
-                instr->operand1 = return_operand;
-                append_instruction(gen, instr);
-            } else {
-                IRInstruction *instr = create_ir_instruction(IR_RETURN);
-                append_instruction(gen, instr);
-            }
+            Operand return_operand = generate_expr_ir(ast, ast->lefts[node], gen);
+            append_new_instruction(gen, IR_RETURN, no_operand, return_operand, no_operand);
             break;
         }
         
         case STMT_CALL: {
             // 函数调用语句
-            generate_call_ir(node, gen);
+            generate_call_ir(ast, node, gen);
             break;
         }
         
         // 处理表达式语句（如函数调用表达式）
         case EXPR_CALL: {
-            generate_call_expr_ir(node, gen);
+            generate_call_expr_ir(ast, node, gen);
             break;
         }
         
@@ -464,106 +455,74 @@ void generate_stmt_ir(ASTNode *node, IRGenerator *gen) {
         case EXPR_INT:
         case EXPR_FLOAT: {
             // 对于其他表达式，我们只是生成代码但不保存结果
-            generate_expr_ir(node, gen);
+            generate_expr_ir(ast, node, gen);
             break;
         }
         
         default:
             break;
     }
+    
+    gen->current_line = saved_line;
+    gen->current_column = saved_column;
 }
 
 // 主中间代码生成函数
-void generate_ir(ASTNode *node, IRGenerator *gen) {
-    if (!node) return;
+void generate_ir(const AST *ast, NodeId node, IRGenerator *gen) {
+    if (node == AST_NONE) return;
     
-    switch (node->type) {
+    switch ((NodeType)ast->kinds[node]) {
         case FUNC_DEF: {
             // 函数开始
-            IRInstruction *func_begin = create_ir_instruction(IR_FUNC_BEGIN);
-            func_begin->operand1 = create_func_operand(node->func_def.name);
-            append_instruction(gen, func_begin);
+            gen->current_line = ast->locations[node].line;
+            gen->current_column = ast->locations[node].column;
+            append_new_instruction(gen, IR_FUNC_BEGIN, no_operand,
+                                   create_func_operand(ast->payloads[node].func_def.name), no_operand);
             
             // 函数体
-            if (node->left) generate_stmt_ir(node->left, gen);
+            if (ast->lefts[node] != AST_NONE) generate_stmt_ir(ast, ast->lefts[node], gen);
             
             // 函数结束
-            IRInstruction *func_end = create_ir_instruction(IR_FUNC_END);
-            append_instruction(gen, func_end);
+            append_new_instruction(gen, IR_FUNC_END, no_operand, no_operand, no_operand);
             break;
         }
         
         default:
-            generate_stmt_ir(node, gen);
+            generate_stmt_ir(ast, node, gen);
             break;
     }
 }
 
 // 生成函数调用的中间代码
-void generate_call_ir(ASTNode *node, IRGenerator *gen) {
-    if (!node || node->type != STMT_CALL) return;
+void generate_call_ir(const AST *ast, NodeId node, IRGenerator *gen) {
+    if (node == AST_NONE || ast->kinds[node] != STMT_CALL) return;
     
     // 为每个参数生成PARAM指令
-    for (int i = 0; i < node->call.arg_count; i++) {
-        if (node->call.args[i]) {
-            Operand *arg_operand = generate_expr_ir(node->call.args[i], gen);
-            
-            IRInstruction *param_instr = create_ir_instruction(IR_PARAM);
-            param_instr->operand1 = arg_operand;
-            append_instruction(gen, param_instr);
+    for (uint32_t i = 0; i < ast->payloads[node].call.arg_count; i++) {
+        if (AST_CALL_ARG(ast, node, i) != AST_NONE) {
+            Operand arg_operand = generate_expr_ir(ast, AST_CALL_ARG(ast, node, i), gen);
+            append_new_instruction(gen, IR_PARAM, no_operand, arg_operand, no_operand);
         }
     }
     
     // 生成CALL指令
-    IRInstruction *call_instr = create_ir_instruction(IR_CALL);
-    call_instr->operand1 = create_func_operand(node->call.name);
-    
     // 对于printf这样的函数，我们可能不需要保存返回值
     // 但为了完整性，我们创建一个临时变量来存储返回值
-    int temp_id = get_next_temp(gen);
-    Operand *result_temp = create_temp_operand(temp_id, TYPE_INT);
-    call_instr->result = result_temp;
-    
-    append_instruction(gen, call_instr);
+    append_call(gen, ast->payloads[node].call.name);
 }
 
 // 生成函数调用表达式的中间代码
-Operand* generate_call_expr_ir(ASTNode *node, IRGenerator *gen) {
-    if (!node || node->type != EXPR_CALL) return NULL;
-    
-    // 为每个参数生成PARAM指令
-    for (int i = 0; i < node->call.arg_count; i++) {
-        if (node->call.args[i]) {
-            Operand *arg_operand = generate_expr_ir(node->call.args[i], gen);
-            
-            IRInstruction *param_instr = create_ir_instruction(IR_PARAM);
-            param_instr->operand1 = arg_operand;
-            append_instruction(gen, param_instr);
-        }
-    }
-    
-    // 生成CALL指令
-    IRInstruction *call_instr = create_ir_instruction(IR_CALL);
-    call_instr->operand1 = create_func_operand(node->call.name);
-    
-    // 创建临时变量来存储返回值
-    int temp_id = get_next_temp(gen);
-    Operand *result_temp = create_temp_operand(temp_id, TYPE_INT);
-    call_instr->result = result_temp;
-    
-    append_instruction(gen, call_instr);
-    
-    return result_temp;
+Operand generate_call_expr_ir(const AST *ast, NodeId node, IRGenerator *gen) {
+    if (node == AST_NONE || ast->kinds[node] != EXPR_CALL) return no_operand;
+    return generate_expr_ir(ast, node, gen);
 }
 
 // 打印操作数
-void print_operand(Operand *operand) {
-    if (!operand) {
-        printf("NULL");
-        return;
-    }
-    
+void print_operand(const Operand *operand) {
     switch (operand->type) {
+        case OPERAND_NONE:
+            printf("NULL");
+            break;
         case OPERAND_TEMP:
             printf("t%d", operand->temp_id);
             break;
@@ -578,7 +537,7 @@ void print_operand(Operand *operand) {
             }
             break;
         case OPERAND_LABEL:
-            printf("%s", operand->label_name);
+            printf("L%d", operand->label_id);
             break;
         case OPERAND_FUNC:
             printf("%s", operand->func_name);
@@ -590,15 +549,15 @@ void print_operand(Operand *operand) {
 void print_instruction(IRInstruction *instr) {
     switch (instr->opcode) {
         case IR_ASSIGN:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_BINOP:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             switch (instr->binop) {
                 case OP_ADD: printf(" + "); break;
                 case OP_SUB: printf(" - "); break;
@@ -611,62 +570,62 @@ void print_instruction(IRInstruction *instr) {
                 case OP_LE: printf(" <= "); break;
                 case OP_GE: printf(" >= "); break;
             }
-            print_operand(instr->operand2);
+            print_operand(&instr->operand2);
             break;
             
         case IR_LOAD:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_STORE:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_LOAD_CONST:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_LABEL:
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             printf(":");
             break;
             
         case IR_GOTO:
             printf("goto ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_IF_GOTO:
             printf("if ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             printf(" goto ");
-            print_operand(instr->operand2);
+            print_operand(&instr->operand2);
             break;
             
         case IR_IF_FALSE_GOTO:
             printf("if !");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             printf(" goto ");
-            print_operand(instr->operand2);
+            print_operand(&instr->operand2);
             break;
             
         case IR_RETURN:
             printf("return");
-            if (instr->operand1) {
+            if (HAS_OPERAND(instr->operand1)) {
                 printf(" ");
-                print_operand(instr->operand1);
+                print_operand(&instr->operand1);
             }
             break;
             
         case IR_FUNC_BEGIN:
             printf("func_begin ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_FUNC_END:
@@ -674,25 +633,36 @@ void print_instruction(IRInstruction *instr) {
             break;
             
         case IR_CONVERT:
-            print_operand(instr->result);
+            print_operand(&instr->result);
             printf(" = (");
-            printf(instr->result->data_type == TYPE_INT ? "int" : "float");
+            printf(instr->result.data_type == TYPE_INT ? "int" : "float");
             printf(") ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_PARAM:
             printf("param ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
             break;
             
         case IR_CALL:
-            if (instr->result) {
-                print_operand(instr->result);
+            if (HAS_OPERAND(instr->result)) {
+                print_operand(&instr->result);
                 printf(" = ");
             }
             printf("call ");
-            print_operand(instr->operand1);
+            print_operand(&instr->operand1);
+            break;
+            
+        case IR_PHI:
+            print_operand(&instr->result);
+            printf(" = phi(");
+            for (int i = 0; i < instr->phi_arg_count; i++) {
+                if (i > 0) printf(", ");
+                print_operand(&instr->phi_args[i]);
+            }
+            printf(")  ; ");
+            print_operand(&instr->operand1);
             break;
             
         default:
@@ -715,3 +685,42 @@ void print_ir(IRGenerator *gen) {
     }
     printf("=========================\n");
 }
+
+bool init_ir_var_map(IRVarMap *map, size_t max_vars) {
+    size_t capacity = 16;
+    while (capacity < max_vars * 2) capacity *= 2;
+    map->keys = (const char**)calloc(capacity, sizeof(const char*));
+    map->ids = (int*)malloc(capacity * sizeof(int));
+    map->mask = capacity - 1;
+    map->count = 0;
+    return map->keys && map->ids;
+}
+
+void free_ir_var_map(IRVarMap *map) {
+    free(map->keys);
+    free(map->ids);
+}
+
+static size_t ir_var_slot(const IRVarMap *map, const char *name) {
+    size_t i = (size_t)(((uintptr_t)name >> 3) * 2654435761u) & map->mask;
+    while (map->keys[i] && map->keys[i] != name) i = (i + 1) & map->mask;
+    return i;
+}
+
+int ir_var_id(const IRVarMap *map, const char *name) {
+    size_t i = ir_var_slot(map, name);
+    return map->keys[i] ? map->ids[i] : -1;
+}
+
+int ir_var_intern(IRVarMap *map, const char *name) {
+    size_t i = ir_var_slot(map, name);
+    if (!map->keys[i]) {
+        map->keys[i] = name;
+        map->ids[i] = map->count++;
+    }
+    return map->ids[i];
+}
+
+bool is_ir_variable(const Operand *operand) {
+    return operand->type == OPERAND_VAR && operand->var_name && operand->var_name[0] != '"';
+}
@@ -4,13 +4,6 @@
 #include "ast.h"
 #include "symbol_table.h"
 
-// 变量类型映射节点
-typedef struct VarTypeNode {
-    char *var_name;
-    DataType type;
-    struct VarTypeNode *next;
-} VarTypeNode;
-
 // 中间代码指令类型
 typedef enum {
     IR_ASSIGN,      // 赋值：t1 = t2
@@ -27,11 +20,13 @@ typedef enum {
     IR_RETURN,      // 返回：return t1
     IR_FUNC_BEGIN,  // 函数开始：func_begin name
     IR_FUNC_END,    // 函数结束：func_end
-    IR_CONVERT      // 类型转换：t1 = (type) t2
+    IR_CONVERT,     // 类型转换：t1 = (type) t2
+    IR_PHI          // SSA合并：t1 = phi(t2, t3)，只在SSA形式中出现，见ssa.h
 } IROpcode;
 
 // 操作数类型
 typedef enum {
+    OPERAND_NONE,     // 无操作数（指令中未使用的位置）
     OPERAND_TEMP,     // 临时变量
     OPERAND_VAR,      // 变量
     OPERAND_CONST,    // 常量
@@ -39,84 +34,125 @@ typedef enum {
     OPERAND_FUNC      // 函数名
 } OperandType;
 
-// 操作数
+// 操作数：按值嵌在指令中，复制即赋值，不需要释放
 typedef struct {
     OperandType type;
     DataType data_type;  // 数据类型
     union {
         int temp_id;      // 临时变量ID
-        char *var_name;   // 变量名
+        const char *var_name; // 变量名（驻留的字符串，不复制、不释放）
         struct {
             union {
                 int int_val;
                 float float_val;
             };
         } const_val;      // 常量值
-        char *label_name; // 标签名
-        char *func_name;  // 函数名
+        int label_id;     // 标签编号，输出为L<编号>
+        const char *func_name; // 函数名（驻留的字符串）
     };
 } Operand;
 
-// 中间代码指令
+#define HAS_OPERAND(operand) ((operand).type != OPERAND_NONE)
+
+// 中间代码指令：从生成器的区域中分配，未使用的操作数为OPERAND_NONE
 typedef struct IRInstruction {
     IROpcode opcode;
-    Operand *result;    // 结果操作数
-    Operand *operand1;  // 第一个操作数
-    Operand *operand2;  // 第二个操作数
-    BinOpType binop;    // 二元运算符（用于IR_BINOP）
+    Operand result;     // 结果操作数
+    Operand operand1;   // 第一个操作数
+    Operand operand2;   // 第二个操作数
+    union {
+        BinOpType binop;    // 二元运算符（用于IR_BINOP）
+        int phi_arg_count;  // IR_PHI的参数个数，等于所在块的前驱数
+    };
+    Operand *phi_args;  // IR_PHI的参数，与所在块的前驱一一对应，存放在SSA形式中
+    int line;           // 源代码行号（0表示未知）
+    int column;         // 源代码列号
+    int id;             // 分析用的指令编号（如def-use链），由建立分析的函数填写，其他时候无意义
+    struct IRInstruction *prev;
     struct IRInstruction *next;
 } IRInstruction;
 
-// 中间代码生成器上下文
+// 指令区域：指令按块分配，每块是上一块的两倍，整个函数的IR随生成器一起释放；
+// 优化时移除的指令只是从链表中摘下，内存留在区域中
+typedef struct IRArenaBlock {
+    struct IRArenaBlock *next;
+    uint32_t used;
+    uint32_t capacity;
+    IRInstruction instructions[];
+} IRArenaBlock;
+
+// 中间代码生成器上下文（一个翻译单元只有一个函数，生成器即该函数的IR）
 typedef struct {
-    IRInstruction *instructions;  // 指令链表头
+    IRArenaBlock *arena;          // 当前分配的块，next指向之前的块
+    IRInstruction *instructions;  // 指令双向链表头
     IRInstruction *last_instr;    // 指令链表尾
+    int instruction_count;        // 链表中的指令数
     int temp_counter;             // 临时变量计数器
     int label_counter;            // 标签计数器
     SymbolTable *symbol_table;    // 符号表
-    VarTypeNode *var_type_table;  // 变量类型映射表
+    int current_line;             // 正在生成的语句所在行，新指令继承该位置
+    int current_column;
 } IRGenerator;
 
+// 变量名到编号的开放定址表，供分析按变量编号建立数组；名称是驻留的指针，按指针比较
+typedef struct {
+    const char **keys;
+    int *ids;
+    size_t mask;
+    int count;                    // 已分配的编号数，编号为0..count-1
+} IRVarMap;
+
+bool init_ir_var_map(IRVarMap *map, size_t max_vars);   // 最多容纳max_vars个变量，内存不足时返回false
+void free_ir_var_map(IRVarMap *map);
+int ir_var_id(const IRVarMap *map, const char *name);   // 不在表中时返回-1
+int ir_var_intern(IRVarMap *map, const char *name);     // 不在表中时分配下一个编号
+bool is_ir_variable(const Operand *operand);            // 变量操作数（字符串字面量也是OPERAND_VAR，但不是变量）
+
 // 函数声明
 IRGenerator* init_ir_generator(SymbolTable *symbol_table);
 void free_ir_generator(IRGenerator *gen);
 
-// 变量类型管理函数
-void add_var_type(IRGenerator *gen, const char *var_name, DataType type);
-DataType get_var_type(IRGenerator *gen, const char *var_name);
-
-// 操作数创建函数
-Operand* create_temp_operand(int temp_id, DataType type);
-Operand* create_var_operand(const char *var_name, DataType type);
-Operand* create_int_const_operand(int value);
-Operand* create_float_const_operand(float value);
-Operand* create_label_operand(const char *label_name);
-Operand* create_func_operand(const char *func_name);
-void free_operand(Operand *operand);
-
-// 指令创建函数
-IRInstruction* create_ir_instruction(IROpcode opcode);
-void append_instruction(IRGenerator *gen, IRInstruction *instr);
+// 操作数创建函数（返回值）
+Operand create_temp_operand(int temp_id, DataType type);
+Operand create_var_operand(const char *var_name, DataType type);
+Operand create_int_const_operand(int value);
+Operand create_float_const_operand(float value);
+Operand create_label_operand(int label_id);
+Operand create_func_operand(const char *func_name);
 
-// 中间代码生成主函数
-void generate_ir(ASTNode *node, IRGenerator *gen);
-Operand* generate_expr_ir(ASTNode *node, IRGenerator *gen);
-void generate_stmt_ir(ASTNode *node, IRGenerator *gen);
-void generate_call_ir(ASTNode *node, IRGenerator *gen);  // 函数调用代码生成
-Operand* generate_call_expr_ir(ASTNode *node, IRGenerator *gen);  // 函数调用表达式代码生成
+// 指令创建函数：从gen的区域中分配，内存不足时返回NULL
+IRInstruction* create_ir_instruction(IRGenerator *gen, IROpcode opcode);
+
+// 指令链表操作，都是O(1)：instr必须不在链表中（remove除外）；
+// position为NULL时insert_before追加到末尾，insert_after插入到开头
+void append_instruction(IRGenerator *gen, IRInstruction *instr);
+void insert_instruction_before(IRGenerator *gen, IRInstruction *position, IRInstruction *instr);
+void insert_instruction_after(IRGenerator *gen, IRInstruction *position, IRInstruction *instr);
+// 从链表中摘下指令（内存留在区域中），摘下后instr->prev和instr->next为NULL
+void remove_instruction(IRGenerator *gen, IRInstruction *instr);
+// 用new_instr替换old_instr的位置
+void replace_instruction(IRGenerator *gen, IRInstruction *old_instr, IRInstruction *new_instr);
+
+// 中间代码生成主函数：变量和表达式的类型取自语义分析记录在AST上的结果
+void generate_ir(const AST *ast, NodeId node, IRGenerator *gen);
+Operand generate_expr_ir(const AST *ast, NodeId node, IRGenerator *gen);
+void generate_stmt_ir(const AST *ast, NodeId node, IRGenerator *gen);
+void generate_call_ir(const AST *ast, NodeId node, IRGenerator *gen);  // 函数调用代码生成
+Operand generate_call_expr_ir(const AST *ast, NodeId node, IRGenerator *gen);  // 函数调用表达式代码生成
 
 // 辅助函数
 int get_next_temp(IRGenerator *gen);
-char* get_next_label(IRGenerator *gen);
-DataType get_expr_type(ASTNode *node, SymbolTable *symbol_table);
+int get_next_label(IRGenerator *gen);
+DataType get_expr_type(const AST *ast, NodeId node);
 
 // 打印函数
 void print_ir(IRGenerator *gen);
-void print_operand(Operand *operand);
+void print_operand(const Operand *operand);
 void print_instruction(IRInstruction *instr);
 
 // 类型转换相关
 bool need_type_conversion(DataType from, DataType to);
-Operand* generate_type_conversion(IRGenerator *gen, Operand *operand, DataType target_type);
+bool is_comparison_op(BinOpType op);
+Operand generate_type_conversion(IRGenerator *gen, Operand operand, DataType target_type);
 
 #endif
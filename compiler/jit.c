@@ -0,0 +1,586 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jit.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// 生成代码的寄存器约定：
+//   rbx  变量槽基址（SlotValue数组），每个槽8字节，操作数都是[rbx + slot*8]
+//   r12  解释器指针，调用参数栈和内置函数的辅助函数时作为第一个参数
+//   eax/xmm0/xmm1/ecx 每条指令内部的临时寄存器，指令之间不保留值
+// 进入时保存rbx和r12并预留40字节栈空间，满足16字节对齐和Win64的影子空间
+
+#define REG_AX 0
+#define REG_DX 2
+
+// 跳转目标回填：offset处的rel32指向字节码下标target
+typedef struct {
+    size_t offset;
+    int target;
+} JitFixup;
+
+// 汇编缓冲区
+typedef struct {
+    unsigned char *buf;
+    size_t size;
+    size_t capacity;
+    size_t *pc_offsets;         // 各字节码指令对应的机器码偏移（末尾一项为出口）
+    JitFixup *fixups;
+    int fixup_count;
+    int fixup_capacity;
+} JitAssembler;
+
+// ---------- 运行时辅助函数（由生成的代码调用） ----------
+
+static void jit_param(Interpreter *interp, int type, SlotValue *value) {
+    if (interp->param_count >= interp->max_params) return;
+
+    RuntimeValue param;
+    param.type = (ValueType)type;
+    switch (param.type) {
+        case VAL_FLOAT:  param.data.float_val = value->float_val; break;
+        case VAL_STRING: param.data.str_val = value->str_val; break;
+        default:         param.data.int_val = value->int_val; break;
+    }
+    interp->param_stack[interp->param_count++] = param;
+}
+
+static void jit_call_builtin(Interpreter *interp, int builtin) {
+    if (builtin == BUILTIN_PRINTF) {
+        execute_printf(interp);
+    }
+    interp->param_count = 0;
+}
+
+static void jit_return(Interpreter *interp, int type, SlotValue *value) {
+    interp->return_val.type = (ValueType)type;
+    if (type == VAL_FLOAT) {
+        interp->return_val.data.float_val = value->float_val;
+    } else if (type == VAL_STRING) {
+        interp->return_val.data.str_val = value->str_val;
+    } else {
+        interp->return_val.data.int_val = value->int_val;
+    }
+}
+
+static void jit_division_by_zero(void) {
+    fprintf(stderr, "Division by zero\n");
+}
+
+// ---------- 编码 ----------
+
+static void emit_byte(JitAssembler *as, unsigned char byte) {
+    if (as->size >= as->capacity) {
+        as->capacity = as->capacity ? as->capacity * 2 : 1024;
+        as->buf = (unsigned char*)realloc(as->buf, as->capacity);
+    }
+    as->buf[as->size++] = byte;
+}
+
+static void emit_bytes(JitAssembler *as, const unsigned char *bytes, int count) {
+    for (int i = 0; i < count; i++) emit_byte(as, bytes[i]);
+}
+
+static void emit_u32(JitAssembler *as, uint32_t value) {
+    for (int i = 0; i < 4; i++) emit_byte(as, (unsigned char)(value >> (8 * i)));
+}
+
+static void emit_u64(JitAssembler *as, uint64_t value) {
+    for (int i = 0; i < 8; i++) emit_byte(as, (unsigned char)(value >> (8 * i)));
+}
+
+static void patch_u32(JitAssembler *as, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; i++) as->buf[offset + i] = (unsigned char)(value >> (8 * i));
+}
+
+// 操作码字节后接 ModRM，内存操作数为[rbx + slot*8]（mod=10, rm=rbx）
+static void emit_slot_op(JitAssembler *as, const unsigned char *opcode, int opcode_len, int reg, int slot) {
+    emit_bytes(as, opcode, opcode_len);
+    emit_byte(as, (unsigned char)(0x80 | (reg << 3) | 3));
+    emit_u32(as, (uint32_t)(slot * (int)sizeof(SlotValue)));
+}
+
+#define SLOT_OP(as, reg, slot, ...) do { \
+        static const unsigned char op_[] = { __VA_ARGS__ }; \
+        emit_slot_op((as), op_, (int)sizeof(op_), (reg), (slot)); \
+    } while (0)
+
+#define BYTES(as, ...) do { \
+        static const unsigned char bytes_[] = { __VA_ARGS__ }; \
+        emit_bytes((as), bytes_, (int)sizeof(bytes_)); \
+    } while (0)
+
+static void load_i32(JitAssembler *as, int slot)  { SLOT_OP(as, REG_AX, slot, 0x8B); }        // mov eax, [slot]
+static void store_i32(JitAssembler *as, int slot) { SLOT_OP(as, REG_AX, slot, 0x89); }        // mov [slot], eax
+static void load_f32(JitAssembler *as, int slot)  { SLOT_OP(as, 0, slot, 0xF3, 0x0F, 0x10); } // movss xmm0, [slot]
+static void store_f32(JitAssembler *as, int slot) { SLOT_OP(as, 0, slot, 0xF3, 0x0F, 0x11); } // movss [slot], xmm0
+
+// 跳转到字节码下标target（rel32稍后回填）
+static void emit_jump(JitAssembler *as, const unsigned char *opcode, int opcode_len, int target) {
+    emit_bytes(as, opcode, opcode_len);
+    if (as->fixup_count >= as->fixup_capacity) {
+        as->fixup_capacity = as->fixup_capacity ? as->fixup_capacity * 2 : 32;
+        as->fixups = (JitFixup*)realloc(as->fixups, as->fixup_capacity * sizeof(JitFixup));
+    }
+    as->fixups[as->fixup_count].offset = as->size;
+    as->fixups[as->fixup_count].target = target;
+    as->fixup_count++;
+    emit_u32(as, 0);
+}
+
+#define JUMP_TO(as, target, ...) do { \
+        static const unsigned char op_[] = { __VA_ARGS__ }; \
+        emit_jump((as), op_, (int)sizeof(op_), (target)); \
+    } while (0)
+
+// 指令内部的短跳转：返回rel8位置，之后用bind_short绑定到当前位置
+static size_t emit_short_jump(JitAssembler *as, unsigned char opcode) {
+    emit_byte(as, opcode);
+    emit_byte(as, 0);
+    return as->size - 1;
+}
+
+static void bind_short(JitAssembler *as, size_t rel8) {
+    as->buf[rel8] = (unsigned char)(as->size - (rel8 + 1));
+}
+
+// 调用C函数：mov rax, imm64; call rax
+static void emit_call(JitAssembler *as, void (*fn)(void)) {
+    BYTES(as, 0x48, 0xB8);
+    emit_u64(as, (uint64_t)(uintptr_t)fn);
+    BYTES(as, 0xFF, 0xD0);
+}
+
+// 辅助函数的参数：第一个为解释器，第二个为整数，第三个为槽地址
+static void emit_arg_interp(JitAssembler *as) {
+#ifdef _WIN32
+    BYTES(as, 0x4C, 0x89, 0xE1);    // mov rcx, r12
+#else
+    BYTES(as, 0x4C, 0x89, 0xE7);    // mov rdi, r12
+#endif
+}
+
+static void emit_arg_int(JitAssembler *as, int value) {
+#ifdef _WIN32
+    emit_byte(as, 0xBA);            // mov edx, imm32
+#else
+    emit_byte(as, 0xBE);            // mov esi, imm32
+#endif
+    emit_u32(as, (uint32_t)value);
+}
+
+static void emit_arg_slot(JitAssembler *as, int slot) {
+#ifdef _WIN32
+    SLOT_OP(as, 0, slot, 0x4C, 0x8D);       // lea r8, [slot]
+#else
+    SLOT_OP(as, REG_DX, slot, 0x48, 0x8D);  // lea rdx, [slot]
+#endif
+}
+
+static void emit_prologue(JitAssembler *as) {
+    BYTES(as, 0x53);                        // push rbx
+    BYTES(as, 0x41, 0x54);                  // push r12
+    BYTES(as, 0x48, 0x83, 0xEC, 0x28);      // sub rsp, 40
+#ifdef _WIN32
+    BYTES(as, 0x48, 0x89, 0xCB);            // mov rbx, rcx
+    BYTES(as, 0x49, 0x89, 0xD4);            // mov r12, rdx
+#else
+    BYTES(as, 0x48, 0x89, 0xFB);            // mov rbx, rdi
+    BYTES(as, 0x49, 0x89, 0xF4);            // mov r12, rsi
+#endif
+}
+
+static void emit_epilogue(JitAssembler *as) {
+    BYTES(as, 0x48, 0x83, 0xC4, 0x28);      // add rsp, 40
+    BYTES(as, 0x41, 0x5C);                  // pop r12
+    BYTES(as, 0x5B);                        // pop rbx
+    BYTES(as, 0xC3);                        // ret
+}
+
+// 按BinOpType顺序排列的条件码（有符号整数比较）
+static const unsigned char int_setcc[] = { 0x94, 0x95, 0x9C, 0x9F, 0x9E, 0x9D };   // sete setne setl setg setle setge
+static const unsigned char int_jump_unless[] = { 0x85, 0x84, 0x8D, 0x8E, 0x8F, 0x8C }; // jne je jge jle jg jl
+
+// 浮点比较：ucomiss xmm0, [second]，lt/le交换操作数后用a/ae，使NaN时结果为假
+static void emit_float_compare(JitAssembler *as, int cmp, int a, int b) {
+    bool swap = cmp == OP_LT - OP_EQ || cmp == OP_LE - OP_EQ;
+    load_f32(as, swap ? b : a);
+    SLOT_OP(as, 0, swap ? a : b, 0x0F, 0x2E);   // ucomiss xmm0, [slot]
+}
+
+static void emit_int_arith(JitAssembler *as, int op, BCInstr *bc) {
+    switch (op) {
+        case OP_ADD:
+            load_i32(as, bc->src1);
+            SLOT_OP(as, REG_AX, bc->src2, 0x03);        // add eax, [b]
+            break;
+        case OP_SUB:
+            load_i32(as, bc->src1);
+            SLOT_OP(as, REG_AX, bc->src2, 0x2B);        // sub eax, [b]
+            break;
+        case OP_MUL:
+            load_i32(as, bc->src1);
+            SLOT_OP(as, REG_AX, bc->src2, 0x0F, 0xAF);  // imul eax, [b]
+            break;
+        case OP_DIV: {
+            // 除数为0时与解释器一致：报告错误并得到0
+            SLOT_OP(as, 7, bc->src2, 0x83);             // cmp dword [b], 0
+            emit_byte(as, 0x00);
+            size_t to_divide = emit_short_jump(as, 0x75);   // jne
+            emit_call(as, jit_division_by_zero);
+            BYTES(as, 0x31, 0xC0);                      // xor eax, eax
+            size_t to_store = emit_short_jump(as, 0xEB);    // jmp
+            bind_short(as, to_divide);
+            load_i32(as, bc->src1);
+            BYTES(as, 0x99);                            // cdq
+            SLOT_OP(as, 7, bc->src2, 0xF7);             // idiv dword [b]
+            bind_short(as, to_store);
+            break;
+        }
+        default: {
+            int cmp = op - OP_EQ;
+            load_i32(as, bc->src1);
+            SLOT_OP(as, REG_AX, bc->src2, 0x3B);        // cmp eax, [b]
+            emit_byte(as, 0x0F);
+            emit_byte(as, int_setcc[cmp]);
+            emit_byte(as, 0xC0);                        // setcc al
+            BYTES(as, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+            break;
+        }
+    }
+    store_i32(as, bc->dst);
+}
+
+static void emit_float_arith(JitAssembler *as, int op, BCInstr *bc) {
+    switch (op) {
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL: {
+            static const unsigned char ops[] = { 0x58, 0x5C, 0x59 };  // addss subss mulss
+            load_f32(as, bc->src1);
+            unsigned char opcode[] = { 0xF3, 0x0F, ops[op - OP_ADD] };
+            emit_slot_op(as, opcode, 3, 0, bc->src2);
+            store_f32(as, bc->dst);
+            break;
+        }
+        case OP_DIV: {
+            BYTES(as, 0x0F, 0x57, 0xC9);                // xorps xmm1, xmm1
+            SLOT_OP(as, 1, bc->src2, 0x0F, 0x2E);       // ucomiss xmm1, [b]
+            size_t unordered = emit_short_jump(as, 0x7A);   // jp（NaN不等于0）
+            size_t nonzero = emit_short_jump(as, 0x75);     // jne
+            emit_call(as, jit_division_by_zero);
+            BYTES(as, 0x0F, 0x57, 0xC0);                // xorps xmm0, xmm0
+            size_t to_store = emit_short_jump(as, 0xEB);
+            bind_short(as, unordered);
+            bind_short(as, nonzero);
+            load_f32(as, bc->src1);
+            SLOT_OP(as, 0, bc->src2, 0xF3, 0x0F, 0x5E); // divss xmm0, [b]
+            bind_short(as, to_store);
+            store_f32(as, bc->dst);
+            break;
+        }
+        default: {
+            int cmp = op - OP_EQ;
+            emit_float_compare(as, cmp, bc->src1, bc->src2);
+            switch (op) {
+                case OP_EQ:
+                    BYTES(as, 0x0F, 0x94, 0xC0);        // sete al
+                    BYTES(as, 0x0F, 0x9B, 0xC1);        // setnp cl
+                    BYTES(as, 0x20, 0xC8);              // and al, cl
+                    break;
+                case OP_NE:
+                    BYTES(as, 0x0F, 0x95, 0xC0);        // setne al
+                    BYTES(as, 0x0F, 0x9A, 0xC1);        // setp cl
+                    BYTES(as, 0x08, 0xC8);              // or al, cl
+                    break;
+                case OP_LT:
+                case OP_GT:
+                    BYTES(as, 0x0F, 0x97, 0xC0);        // seta al
+                    break;
+                default:
+                    BYTES(as, 0x0F, 0x93, 0xC0);        // setae al
+                    break;
+            }
+            BYTES(as, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+            store_i32(as, bc->dst);
+            break;
+        }
+    }
+}
+
+// 比较并跳转：条件不成立时跳到dst
+static void emit_branch_unless(JitAssembler *as, BCInstr *bc) {
+    if (bc->opcode <= BC_IFNOT_GE_I32) {
+        int cmp = bc->opcode - BC_IFNOT_EQ_I32;
+        load_i32(as, bc->src1);
+        SLOT_OP(as, REG_AX, bc->src2, 0x3B);            // cmp eax, [b]
+        unsigned char opcode[] = { 0x0F, int_jump_unless[cmp] };
+        emit_jump(as, opcode, 2, bc->dst);
+        return;
+    }
+
+    int cmp = bc->opcode - BC_IFNOT_EQ_F32;
+    emit_float_compare(as, cmp, bc->src1, bc->src2);
+    switch (cmp + OP_EQ) {
+        case OP_EQ:
+            JUMP_TO(as, bc->dst, 0x0F, 0x8A);           // jp
+            JUMP_TO(as, bc->dst, 0x0F, 0x85);           // jne
+            break;
+        case OP_NE: {
+            size_t unordered = emit_short_jump(as, 0x7A);   // jp跳过（NaN时a != b成立）
+            JUMP_TO(as, bc->dst, 0x0F, 0x84);           // je
+            bind_short(as, unordered);
+            break;
+        }
+        case OP_LT:
+        case OP_GT:
+            JUMP_TO(as, bc->dst, 0x0F, 0x86);           // jbe
+            break;
+        default:
+            JUMP_TO(as, bc->dst, 0x0F, 0x82);           // jb
+            break;
+    }
+}
+
+static bool emit_instruction(JitAssembler *as, BytecodeProgram *prog, BCInstr *bc) {
+    int op = bc->opcode;
+
+    if (op >= BC_ADD_I32 && op <= BC_GE_I32) {
+        emit_int_arith(as, op - BC_ADD_I32, bc);
+        return true;
+    }
+    if (op >= BC_ADD_F32 && op <= BC_GE_F32) {
+        emit_float_arith(as, op - BC_ADD_F32, bc);
+        return true;
+    }
+    if (op >= BC_IFNOT_FIRST && op <= BC_IFNOT_LAST) {
+        emit_branch_unless(as, bc);
+        return true;
+    }
+
+    switch (op) {
+        case BC_NOP:
+            return true;
+
+        case BC_MOVE:
+            SLOT_OP(as, REG_AX, bc->src1, 0x48, 0x8B);  // mov rax, [a]
+            SLOT_OP(as, REG_AX, bc->dst, 0x48, 0x89);   // mov [dst], rax
+            return true;
+
+        case BC_LOAD_STR:
+            BYTES(as, 0x48, 0xB8);                      // mov rax, imm64
+            emit_u64(as, (uint64_t)(uintptr_t)(prog->strings + prog->string_offsets[bc->src1]));
+            SLOT_OP(as, REG_AX, bc->dst, 0x48, 0x89);
+            return true;
+
+        case BC_CONVERT_INT:
+            SLOT_OP(as, REG_AX, bc->src1, 0xF3, 0x0F, 0x2C);   // cvttss2si eax, [a]
+            store_i32(as, bc->dst);
+            return true;
+
+        case BC_CONVERT_FLOAT:
+            SLOT_OP(as, 0, bc->src1, 0xF3, 0x0F, 0x2A);        // cvtsi2ss xmm0, dword [a]
+            store_f32(as, bc->dst);
+            return true;
+
+        case BC_GOTO:
+            if (bc->dst >= 0) JUMP_TO(as, bc->dst, 0xE9);
+            return true;
+
+        case BC_IF_TRUE:
+        case BC_IF_FALSE:
+            if (bc->dst >= 0) {
+                SLOT_OP(as, 7, bc->src1, 0x83);         // cmp dword [a], 0
+                emit_byte(as, 0x00);
+                if (op == BC_IF_TRUE) JUMP_TO(as, bc->dst, 0x0F, 0x85);
+                else JUMP_TO(as, bc->dst, 0x0F, 0x84);
+            }
+            return true;
+
+        case BC_PARAM_I32:
+        case BC_PARAM_F32:
+        case BC_PARAM_STR:
+            emit_arg_interp(as);
+            emit_arg_int(as, op == BC_PARAM_I32 ? VAL_INT : (op == BC_PARAM_F32 ? VAL_FLOAT : VAL_STRING));
+            emit_arg_slot(as, bc->src1);
+            emit_call(as, (void (*)(void))jit_param);
+            return true;
+
+        case BC_CALL:
+            emit_arg_interp(as);
+            emit_arg_int(as, bc->aux);
+            emit_call(as, (void (*)(void))jit_call_builtin);
+            return true;
+
+        case BC_RETURN:
+            if (bc->src1 >= 0) {
+                emit_arg_interp(as);
+                emit_arg_int(as, bc->aux);
+                emit_arg_slot(as, bc->src1);
+                emit_call(as, (void (*)(void))jit_return);
+            }
+            JUMP_TO(as, prog->code_count, 0xE9);
+            return true;
+
+        default:
+            fprintf(stderr, "JIT: unsupported bytecode instruction %d\n", op);
+            return false;
+    }
+}
+
+// ---------- 可执行内存与perf符号表 ----------
+
+static unsigned char* map_executable(const unsigned char *code, size_t code_size, size_t *mapped_size) {
+#ifdef _WIN32
+    unsigned char *memory = (unsigned char*)VirtualAlloc(NULL, code_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!memory) return NULL;
+    memcpy(memory, code, code_size);
+    DWORD old_protect;
+    if (!VirtualProtect(memory, code_size, PAGE_EXECUTE_READ, &old_protect)) {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        return NULL;
+    }
+    FlushInstructionCache(GetCurrentProcess(), memory, code_size);
+    *mapped_size = code_size;
+    return memory;
+#else
+    // 先写后改为只读可执行，任何时刻都不同时可写可执行
+    long page = sysconf(_SC_PAGESIZE);
+    size_t size = (code_size + page - 1) / page * page;
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+    memcpy(memory, code, code_size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return NULL;
+    }
+    *mapped_size = size;
+    return (unsigned char*)memory;
+#endif
+}
+
+// 写/tmp/perf-<pid>.map：同一源代码行的连续机器码作为一个符号，perf report可按行归属
+static void write_perf_map(JitCode *jit, JitAssembler *as, BytecodeProgram *prog) {
+#ifndef _WIN32
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid());
+    FILE *map = fopen(path, "a");
+    if (!map) return;
+
+    uintptr_t base = (uintptr_t)jit->memory;
+    fprintf(map, "%llx %llx jit:prologue\n", (unsigned long long)base,
+            (unsigned long long)as->pc_offsets[0]);
+    int pc = 0;
+    while (pc < prog->code_count) {
+        int end = pc + 1;
+        while (end < prog->code_count && prog->code[end].line == prog->code[pc].line) end++;
+        size_t start = as->pc_offsets[pc];
+        size_t stop = as->pc_offsets[end];
+        if (stop > start) {
+            fprintf(map, "%llx %llx jit:line %d\n", (unsigned long long)(base + start),
+                    (unsigned long long)(stop - start), prog->code[pc].line);
+        }
+        pc = end;
+    }
+    fprintf(map, "%llx %llx jit:epilogue\n", (unsigned long long)(base + as->pc_offsets[prog->code_count]),
+            (unsigned long long)(jit->code_size - as->pc_offsets[prog->code_count]));
+    fclose(map);
+#else
+    (void)jit;
+    (void)as;
+    (void)prog;
+#endif
+}
+
+// ---------- 对外接口 ----------
+
+JitCode* jit_compile(BytecodeProgram *prog) {
+    if (!prog) return NULL;
+#if !JIT_AVAILABLE
+    fprintf(stderr, "JIT: native code generation is only available on x86-64\n");
+    return NULL;
+#else
+    JitAssembler as;
+    memset(&as, 0, sizeof(as));
+    as.pc_offsets = (size_t*)malloc((prog->code_count + 1) * sizeof(size_t));
+
+    emit_prologue(&as);
+    bool ok = true;
+    for (int pc = 0; pc < prog->code_count && ok; pc++) {
+        as.pc_offsets[pc] = as.size;
+        ok = emit_instruction(&as, prog, &prog->code[pc]);
+    }
+    as.pc_offsets[prog->code_count] = as.size;
+    emit_epilogue(&as);
+
+    JitCode *jit = NULL;
+    if (ok) {
+        // 回填跳转：目标超出范围时跳到出口
+        for (int i = 0; i < as.fixup_count; i++) {
+            int target = as.fixups[i].target;
+            if (target < 0 || target > prog->code_count) target = prog->code_count;
+            int32_t rel = (int32_t)(as.pc_offsets[target] - (as.fixups[i].offset + 4));
+            patch_u32(&as, as.fixups[i].offset, (uint32_t)rel);
+        }
+
+        jit = (JitCode*)malloc(sizeof(JitCode));
+        jit->code_size = as.size;
+        jit->memory = map_executable(as.buf, as.size, &jit->size);
+        if (!jit->memory) {
+            fprintf(stderr, "JIT: cannot allocate executable memory\n");
+            free(jit);
+            jit = NULL;
+        } else {
+            jit->entry = (JitEntry)(void*)jit->memory;
+            write_perf_map(jit, &as, prog);
+            TRACE(TRACE_CODEGEN, TRACE_INFO, "jit: %d bytecode instructions -> %d bytes of x86-64",
+                  prog->code_count, (int)as.size);
+        }
+    }
+
+    free(as.buf);
+    free(as.pc_offsets);
+    free(as.fixups);
+    return jit;
+#endif
+}
+
+void free_jit_code(JitCode *jit) {
+    if (!jit) return;
+#ifdef _WIN32
+    VirtualFree(jit->memory, 0, MEM_RELEASE);
+#else
+    munmap(jit->memory, jit->size);
+#endif
+    free(jit);
+}
+
+void jit_execute(JitCode *jit, Interpreter *interp, BytecodeProgram *prog) {
+    if (!jit || !interp || !prog) return;
+
+    bind_frame(interp, prog);
+    interp->param_count = 0;
+    interp->running = true;
+    jit->entry(interp->slots, interp);
+    interp->running = false;
+}
+
+bool jit_run_bytecode(BytecodeProgram *prog) {
+    JitCode *jit = jit_compile(prog);
+    if (!jit) return false;
+
+    Interpreter *interp = init_interpreter();
+    if (interp) {
+        jit_execute(jit, interp, prog);
+        free_interpreter(interp);
+    }
+    free_jit_code(jit);
+    return true;
+}
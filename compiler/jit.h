@@ -0,0 +1,37 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "bytecode.h"
+#include "interpreter.h"
+
+// 仅x86-64下生成本机代码，其他平台jit_compile返回NULL，调用方退回解释执行
+#if defined(__x86_64__) || defined(_M_X64)
+#define JIT_AVAILABLE 1
+#else
+#define JIT_AVAILABLE 0
+#endif
+
+// 生成代码的入口：slots为解释器的变量槽（常量池已装入），interp用于参数栈和内置函数
+typedef void (*JitEntry)(SlotValue *slots, Interpreter *interp);
+
+// 编译后的本机代码
+typedef struct {
+    JitEntry entry;
+    unsigned char *memory;      // 可执行内存（只读+可执行）
+    size_t size;                // 映射大小
+    size_t code_size;           // 实际代码字节数
+} JitCode;
+
+// 把字节码编译为x86-64机器码，不支持的指令或平台返回NULL
+JitCode* jit_compile(BytecodeProgram *prog);
+void free_jit_code(JitCode *jit);
+
+// 在解释器的变量槽上执行已编译的代码
+void jit_execute(JitCode *jit, Interpreter *interp, BytecodeProgram *prog);
+
+// 编译并执行，失败时返回false（调用方应退回解释执行）
+bool jit_run_bytecode(BytecodeProgram *prog);
+
+#endif
@@ -9,6 +9,8 @@
 #define YY_FLEX_MINOR_VERSION 5
 
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
 
 
 /* cfront 1.2 defines "c_plusplus" instead of "__cplusplus" */
@@ -56,11 +58,7 @@
 #endif
 
 
-#ifdef YY_USE_PROTOS
 #define YY_PROTO(proto) proto
-#else
-#define YY_PROTO(proto) ()
-#endif
 
 /* Returned upon end-of-file. */
 #define YY_NULL 0
@@ -76,30 +74,42 @@
  * but we do it the disgusting crufty way forced on us by the ()-less
  * definition of BEGIN.
  */
-#define BEGIN yy_start = 1 + 2 *
+#define BEGIN yyg->yy_start = 1 + 2 *
 
 /* Translate the current start state into a value that can be later handed
  * to BEGIN to return to the state.  The YYSTATE alias is for lex
  * compatibility.
  */
-#define YY_START ((yy_start - 1) / 2)
+#define YY_START ((yyg->yy_start - 1) / 2)
 #define YYSTATE YY_START
 
 /* Action number for EOF rule of a given start state. */
 #define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
 
 /* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart( yyin )
+#define YY_NEW_FILE yyrestart( yyin, yyscanner )
 
 #define YY_END_OF_BUFFER_CHAR 0
 
 /* Size of default input buffer. */
 #define YY_BUF_SIZE 16384
 
+/* An opaque pointer. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/* For convenience, these vars (plus the bison vars far below)
+   are macros in the reentrant scanner. */
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 
-extern int yyleng;
-extern FILE *yyin, *yyout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -125,14 +135,14 @@ extern FILE *yyin, *yyout;
 	do \
 		{ \
 		/* Undo effects of setting up yytext. */ \
-		*yy_cp = yy_hold_char; \
+		*yy_cp = yyg->yy_hold_char; \
 		YY_RESTORE_YY_MORE_OFFSET \
-		yy_c_buf_p = yy_cp = yy_bp + n - YY_MORE_ADJ; \
+		yyg->yy_c_buf_p = yy_cp = yy_bp + n - YY_MORE_ADJ; \
 		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
 		} \
 	while ( 0 )
 
-#define unput(c) yyunput( c, yytext_ptr )
+#define unput(c) yyunput( c, yytext_ptr, yyscanner )
 
 /* The following is because we cannot portably get our hands on size_t
  * (without autoconf's help, which isn't available because we want
@@ -198,46 +208,27 @@ struct yy_buffer_state
 #define YY_BUFFER_EOF_PENDING 2
 	};
 
-static YY_BUFFER_STATE yy_current_buffer = 0;
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
  * "scanner state".
  */
-#define YY_CURRENT_BUFFER yy_current_buffer
-
-
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-
-
-int yyleng;
-
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 1;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+#define YY_CURRENT_BUFFER yyg->yy_current_buffer
 
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
 
-void yyrestart YY_PROTO(( FILE *input_file ));
+void yyrestart YY_PROTO(( FILE *input_file, yyscan_t yyscanner ));
 
-void yy_switch_to_buffer YY_PROTO(( YY_BUFFER_STATE new_buffer ));
-void yy_load_buffer_state YY_PROTO(( void ));
-YY_BUFFER_STATE yy_create_buffer YY_PROTO(( FILE *file, int size ));
-void yy_delete_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-void yy_init_buffer YY_PROTO(( YY_BUFFER_STATE b, FILE *file ));
-void yy_flush_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-#define YY_FLUSH_BUFFER yy_flush_buffer( yy_current_buffer )
+void yy_switch_to_buffer YY_PROTO(( YY_BUFFER_STATE new_buffer, yyscan_t yyscanner ));
+void yy_load_buffer_state YY_PROTO(( yyscan_t yyscanner ));
+YY_BUFFER_STATE yy_create_buffer YY_PROTO(( FILE *file, int size, yyscan_t yyscanner ));
+void yy_delete_buffer YY_PROTO(( YY_BUFFER_STATE b, yyscan_t yyscanner ));
+void yy_init_buffer YY_PROTO(( YY_BUFFER_STATE b, FILE *file, yyscan_t yyscanner ));
+void yy_flush_buffer YY_PROTO(( YY_BUFFER_STATE b, yyscan_t yyscanner ));
+#define YY_FLUSH_BUFFER yy_flush_buffer( yyg->yy_current_buffer, yyscanner )
 
-YY_BUFFER_STATE yy_scan_buffer YY_PROTO(( char *base, yy_size_t size ));
-YY_BUFFER_STATE yy_scan_string YY_PROTO(( yyconst char *yy_str ));
-YY_BUFFER_STATE yy_scan_bytes YY_PROTO(( yyconst char *bytes, int len ));
+YY_BUFFER_STATE yy_scan_buffer YY_PROTO(( char *base, yy_size_t size, yyscan_t yyscanner ));
+YY_BUFFER_STATE yy_scan_string YY_PROTO(( yyconst char *yy_str, yyscan_t yyscanner ));
+YY_BUFFER_STATE yy_scan_bytes YY_PROTO(( yyconst char *bytes, int len, yyscan_t yyscanner ));
 
 static void *yy_flex_alloc YY_PROTO(( yy_size_t ));
 static void *yy_flex_realloc YY_PROTO(( void *, yy_size_t ));
@@ -247,32 +238,30 @@ static void yy_flex_free YY_PROTO(( void * ));
 
 #define yy_set_interactive(is_interactive) \
 	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_is_interactive = is_interactive; \
+	if ( ! yyg->yy_current_buffer ) \
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE, yyscanner ); \
+	yyg->yy_current_buffer->yy_is_interactive = is_interactive; \
 	}
 
 #define yy_set_bol(at_bol) \
 	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_at_bol = at_bol; \
+	if ( ! yyg->yy_current_buffer ) \
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE, yyscanner ); \
+	yyg->yy_current_buffer->yy_at_bol = at_bol; \
 	}
 
-#define YY_AT_BOL() (yy_current_buffer->yy_at_bol)
+#define YY_AT_BOL() (yyg->yy_current_buffer->yy_at_bol)
 
 
 #define yywrap() 1
 #define YY_SKIP_YYWRAP
 typedef unsigned char YY_CHAR;
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
 typedef int yy_state_type;
-extern char *yytext;
 #define yytext_ptr yytext
 
-static yy_state_type yy_get_previous_state YY_PROTO(( void ));
-static yy_state_type yy_try_NUL_trans YY_PROTO(( yy_state_type current_state ));
-static int yy_get_next_buffer YY_PROTO(( void ));
+static yy_state_type yy_get_previous_state YY_PROTO(( yyscan_t yyscanner ));
+static yy_state_type yy_try_NUL_trans YY_PROTO(( yy_state_type current_state, yyscan_t yyscanner ));
+static int yy_get_next_buffer YY_PROTO(( yyscan_t yyscanner ));
 static void yy_fatal_error YY_PROTO(( yyconst char msg[] ));
 
 /* Done after the current pattern has been matched and before the
@@ -281,9 +270,9 @@ static void yy_fatal_error YY_PROTO(( yyconst char msg[] ));
 #define YY_DO_BEFORE_ACTION \
 	yytext_ptr = yy_bp; \
 	yyleng = (int) (yy_cp - yy_bp); \
-	yy_hold_char = *yy_cp; \
+	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
-	yy_c_buf_p = yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 
 #define YY_NUM_RULES 34
 #define YY_END_OF_BUFFER 35
@@ -398,9 +387,6 @@ static yyconst short int yy_chk[126] =
        70,   70,   70,   70,   70
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
 /* The intent behind this definition is that it'll catch
  * any uses of REJECT which flex missed.
  */
@@ -408,23 +394,89 @@ static char *yy_last_accepting_cpos;
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
 #line 1 "lexer.l"
 #define INITIAL 0
 #line 2 "lexer.l"
 #include "ast.h"        
 #include "parser.tab.h"  
+#include "driver.h"
 #include <string.h>  
 #include <stdlib.h>
 
-void yyerror(const char *s);
+// 跟踪行号和列号：yylloc的first_*为当前记号的起始位置，last_*为扫描位置
+#define YY_USER_ACTION \
+    yylloc->first_line = yylloc->last_line; \
+    yylloc->first_column = yylloc->last_column; \
+    yylloc->last_column += yyleng;
 
-// 跟踪行号和列号
-int yylineno = 1;
-int yycolumn = 1;
+// 标识符和字符串只记录在源文件中的位置，不复制yytext
+#define SET_SLICE() \
+    yylval->slice.offset = (int)(yytext - yyextra->source->data); \
+    yylval->slice.length = yyleng;
 #define YY_NO_INPUT 1
 #define YY_NO_UNPUT 1
-#line 428 "lex.yy.c"
+#line 419 "lex.yy.c"
+
+#ifndef YY_EXTRA_TYPE
+#define YY_EXTRA_TYPE struct CompilerContext *
+#endif
+
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+	{
+
+	/* User-defined. Not touched by flex. */
+	YY_EXTRA_TYPE yyextra_r;
+
+	/* The rest are the same as the globals declared in the non-reentrant scanner. */
+	FILE *yyin_r, *yyout_r;
+	YY_BUFFER_STATE yy_current_buffer;
+	char yy_hold_char;
+	int yy_n_chars;
+	int yyleng_r;
+	char *yy_c_buf_p;
+	int yy_init;
+	int yy_start;
+	int yy_did_buffer_switch_on_eof;
+	int yy_start_stack_ptr;
+	int yy_start_stack_depth;
+	int *yy_start_stack;
+	yy_state_type yy_last_accepting_state;
+	char* yy_last_accepting_cpos;
+
+	char *yytext_r;
+
+	YYSTYPE * yylval_r;
+
+	YYLTYPE * yylloc_r;
+
+	}; /* end struct yyguts_t */
+
+static int yy_init_globals YY_PROTO(( yyscan_t yyscanner ));
+
+    /* This must go here because YYSTYPE and YYLTYPE are included
+     * from bison output in section 1.*/
+    #    define yylval yyg->yylval_r
+    
+    #    define yylloc yyg->yylloc_r
+    
+int yylex_init YY_PROTO(( yyscan_t* scanner ));
+
+int yylex_init_extra YY_PROTO(( YY_EXTRA_TYPE user_defined, yyscan_t* scanner ));
+
+int yylex_destroy YY_PROTO(( yyscan_t yyscanner ));
+
+YY_EXTRA_TYPE yyget_extra YY_PROTO(( yyscan_t yyscanner ));
+
+void yyset_extra YY_PROTO(( YY_EXTRA_TYPE user_defined, yyscan_t yyscanner ));
+
+FILE *yyget_in YY_PROTO(( yyscan_t yyscanner ));
+
+void yyset_in YY_PROTO(( FILE * _in_str, yyscan_t yyscanner ));
+
+char *yyget_text YY_PROTO(( yyscan_t yyscanner ));
+
+int yyget_leng YY_PROTO(( yyscan_t yyscanner ));
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
@@ -439,7 +491,7 @@ extern int yywrap YY_PROTO(( void ));
 #endif
 
 #ifndef YY_NO_UNPUT
-static void yyunput YY_PROTO(( int c, char *buf_ptr ));
+static void yyunput YY_PROTO(( int c, char *buf_ptr, yyscan_t yyscanner ));
 #endif
 
 #ifndef yytext_ptr
@@ -452,24 +504,21 @@ static int yy_flex_strlen YY_PROTO(( yyconst char * ));
 
 #ifndef YY_NO_INPUT
 #ifdef __cplusplus
-static int yyinput YY_PROTO(( void ));
+static int yyinput YY_PROTO(( yyscan_t yyscanner ));
 #else
-static int input YY_PROTO(( void ));
+static int input YY_PROTO(( yyscan_t yyscanner ));
 #endif
 #endif
 
 #if YY_STACK_USED
-static int yy_start_stack_ptr = 0;
-static int yy_start_stack_depth = 0;
-static int *yy_start_stack = 0;
 #ifndef YY_NO_PUSH_STATE
-static void yy_push_state YY_PROTO(( int new_state ));
+static void yy_push_state YY_PROTO(( int new_state, yyscan_t yyscanner ));
 #endif
 #ifndef YY_NO_POP_STATE
-static void yy_pop_state YY_PROTO(( void ));
+static void yy_pop_state YY_PROTO(( yyscan_t yyscanner ));
 #endif
 #ifndef YY_NO_TOP_STATE
-static int yy_top_state YY_PROTO(( void ));
+static int yy_top_state YY_PROTO(( yyscan_t yyscanner ));
 #endif
 
 #else
@@ -512,7 +561,7 @@ YY_MALLOC_DECL
  */
 #ifndef YY_INPUT
 #define YY_INPUT(buf,result,max_size) \
-	if ( yy_current_buffer->yy_is_interactive ) \
+	if ( yyg->yy_current_buffer->yy_is_interactive ) \
 		{ \
 		int c = '*', n; \
 		for ( n = 0; n < max_size && \
@@ -551,7 +600,7 @@ YY_MALLOC_DECL
  * easily add parameters.
  */
 #ifndef YY_DECL
-#define YY_DECL int yylex YY_PROTO(( void ))
+#define YY_DECL int yylex YY_PROTO(( YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner ))
 #endif
 
 /* Code executed at the beginning of each rule, after yytext and yyleng
@@ -571,25 +620,25 @@ YY_MALLOC_DECL
 
 YY_DECL
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	register yy_state_type yy_current_state;
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
 
-#line 22 "lexer.l"
-
+	yylval = yylval_param;
 
-#line 582 "lex.yy.c"
+	yylloc = yylloc_param;
 
-	if ( yy_init )
+	if ( yyg->yy_init )
 		{
-		yy_init = 0;
+		yyg->yy_init = 0;
 
 #ifdef YY_USER_INIT
 		YY_USER_INIT;
 #endif
 
-		if ( ! yy_start )
-			yy_start = 1;	/* first start state */
+		if ( ! yyg->yy_start )
+			yyg->yy_start = 1;	/* first start state */
 
 		if ( ! yyin )
 			yyin = stdin;
@@ -597,34 +646,39 @@ YY_DECL
 		if ( ! yyout )
 			yyout = stdout;
 
-		if ( ! yy_current_buffer )
-			yy_current_buffer =
-				yy_create_buffer( yyin, YY_BUF_SIZE );
+		if ( ! yyg->yy_current_buffer )
+			yyg->yy_current_buffer =
+				yy_create_buffer( yyin, YY_BUF_SIZE, yyscanner );
 
-		yy_load_buffer_state();
+		yy_load_buffer_state( yyscanner );
 		}
 
+#line 33 "lexer.l"
+    // 每次调用返回一个记号（最后一次为文件结束），用于统计编译吞吐量
+    yyextra->token_count++;
+#line 660 "lex.yy.c"
+
 	while ( 1 )		/* loops until end-of-file is reached */
 		{
-		yy_cp = yy_c_buf_p;
+		yy_cp = yyg->yy_c_buf_p;
 
 		/* Support of yytext. */
-		*yy_cp = yy_hold_char;
+		*yy_cp = yyg->yy_hold_char;
 
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
 		yy_bp = yy_cp;
 
-		yy_current_state = yy_start;
+		yy_current_state = yyg->yy_start;
 yy_match:
 		do
 			{
 			register YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)];
 			if ( yy_accept[yy_current_state] )
 				{
-				yy_last_accepting_state = yy_current_state;
-				yy_last_accepting_cpos = yy_cp;
+				yyg->yy_last_accepting_state = yy_current_state;
+				yyg->yy_last_accepting_cpos = yy_cp;
 				}
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
@@ -641,8 +695,8 @@ yy_find_action:
 		yy_act = yy_accept[yy_current_state];
 		if ( yy_act == 0 )
 			{ /* have to back up */
-			yy_cp = yy_last_accepting_cpos;
-			yy_current_state = yy_last_accepting_state;
+			yy_cp = yyg->yy_last_accepting_cpos;
+			yy_current_state = yyg->yy_last_accepting_state;
 			yy_act = yy_accept[yy_current_state];
 			}
 
@@ -656,182 +710,182 @@ do_action:	/* This label is used only to access EOF actions. */
 	{ /* beginning of action switch */
 			case 0: /* must back up */
 			/* undo the effects of YY_DO_BEFORE_ACTION */
-			*yy_cp = yy_hold_char;
-			yy_cp = yy_last_accepting_cpos;
-			yy_current_state = yy_last_accepting_state;
+			*yy_cp = yyg->yy_hold_char;
+			yy_cp = yyg->yy_last_accepting_cpos;
+			yy_current_state = yyg->yy_last_accepting_state;
 			goto yy_find_action;
 
 case 1:
 YY_RULE_SETUP
-#line 24 "lexer.l"
-{ yycolumn += yyleng; return INT; }
+#line 37 "lexer.l"
+{ return INT; }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 25 "lexer.l"
-{ yycolumn += yyleng; return FLOAT; }
+#line 38 "lexer.l"
+{ return FLOAT; }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 26 "lexer.l"
-{ yycolumn += yyleng; return RETURN; }
+#line 39 "lexer.l"
+{ return RETURN; }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 27 "lexer.l"
-{ yycolumn += yyleng; return IF; }
+#line 40 "lexer.l"
+{ return IF; }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 28 "lexer.l"
-{ yycolumn += yyleng; return ELSE; }
+#line 41 "lexer.l"
+{ return ELSE; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 29 "lexer.l"
-{ yycolumn += yyleng; return WHILE; }
+#line 42 "lexer.l"
+{ return WHILE; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 30 "lexer.l"
-{ yycolumn += yyleng; yylval.str = _strdup(yytext); return PRINTF; }
+#line 43 "lexer.l"
+{ return PRINTF; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 31 "lexer.l"
-{ yycolumn += yyleng; return '{'; }
+#line 44 "lexer.l"
+{ return '{'; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 32 "lexer.l"
-{ yycolumn += yyleng; return '}'; }
+#line 45 "lexer.l"
+{ return '}'; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 33 "lexer.l"
-{ yycolumn += yyleng; return '('; }
+#line 46 "lexer.l"
+{ return '('; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 34 "lexer.l"
-{ yycolumn += yyleng; return ')'; }
+#line 47 "lexer.l"
+{ return ')'; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 35 "lexer.l"
-{ yycolumn += yyleng; return ';'; }
+#line 48 "lexer.l"
+{ return ';'; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 36 "lexer.l"
-{ yycolumn += yyleng; return ','; }
+#line 49 "lexer.l"
+{ return ','; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 37 "lexer.l"
-{ yycolumn += yyleng; return '='; }
+#line 50 "lexer.l"
+{ return '='; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 38 "lexer.l"
-{ yycolumn += yyleng; return '+'; }
+#line 51 "lexer.l"
+{ return '+'; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 39 "lexer.l"
-{ yycolumn += yyleng; return '-'; }
+#line 52 "lexer.l"
+{ return '-'; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 40 "lexer.l"
-{ yycolumn += yyleng; return '*'; }
+#line 53 "lexer.l"
+{ return '*'; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 41 "lexer.l"
-{ yycolumn += yyleng; return '/'; }
+#line 54 "lexer.l"
+{ return '/'; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 42 "lexer.l"
-{ yycolumn += yyleng; return EQ; }
+#line 55 "lexer.l"
+{ return EQ; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 43 "lexer.l"
-{ yycolumn += yyleng; return NE; }
+#line 56 "lexer.l"
+{ return NE; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 44 "lexer.l"
-{ yycolumn += yyleng; return '<'; }
+#line 57 "lexer.l"
+{ return '<'; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 45 "lexer.l"
-{ yycolumn += yyleng; return '>'; }
+#line 72 "lexer.l"
+{ return '>'; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 46 "lexer.l"
-{ yycolumn += yyleng; return LE; }
+#line 59 "lexer.l"
+{ return LE; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 47 "lexer.l"
-{ yycolumn += yyleng; return GE; }
+#line 60 "lexer.l"
+{ return GE; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 48 "lexer.l"
-{ yycolumn += yyleng; yylval.str = _strdup(yytext); return STRING; }
+#line 61 "lexer.l"
+{ SET_SLICE(); return STRING; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 49 "lexer.l"
-{ yycolumn += yyleng; yylval.str = _strdup(yytext); return IDENTIFIER; }
+#line 62 "lexer.l"
+{ SET_SLICE(); return IDENTIFIER; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 50 "lexer.l"
-{ yycolumn += yyleng; yylval.num = atoi(yytext); return INTEGER; }
+#line 63 "lexer.l"
+{ yylval->num = atoi(yytext); return INTEGER; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 51 "lexer.l"
-{ yycolumn += yyleng; yylval.fnum = atof(yytext); return FLOATING; }
+#line 64 "lexer.l"
+{ yylval->fnum = atof(yytext); return FLOATING; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 52 "lexer.l"
-{ yycolumn += yyleng; } /* 单行注释 */
+#line 65 "lexer.l"
+{ } /* 单行注释 */
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 53 "lexer.l"
-{ yycolumn += yyleng; } /* 多行注释 */
+#line 66 "lexer.l"
+{ } /* 多行注释 */
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 54 "lexer.l"
-{ yycolumn += yyleng; } /* 忽略空白 */
+#line 67 "lexer.l"
+{ } /* 忽略空白 */
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 55 "lexer.l"
-{ yylineno++; yycolumn = 1; } /* 换行处理 */
+#line 68 "lexer.l"
+{ yylloc->last_line++; yylloc->last_column = 1; } /* 换行处理 */
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 56 "lexer.l"
-{ yycolumn += yyleng; yyerror("非法字符"); }
+#line 69 "lexer.l"
+{ if (yytext[0] != '\r') yyerror(yylloc, yyscanner, yyextra, "非法字符"); } /* 源文件按二进制读入，忽略CRLF中的\r */
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 58 "lexer.l"
+#line 72 "lexer.l"
 ECHO;
 	YY_BREAK
-#line 835 "lex.yy.c"
+#line 889 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -841,86 +895,86 @@ case YY_STATE_EOF(INITIAL):
 		int yy_amount_of_matched_text = (int) (yy_cp - yytext_ptr) - 1;
 
 		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = yy_hold_char;
+		*yy_cp = yyg->yy_hold_char;
 		YY_RESTORE_YY_MORE_OFFSET
 
-		if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_NEW )
+		if ( yyg->yy_current_buffer->yy_buffer_status == YY_BUFFER_NEW )
 			{
 			/* We're scanning a new file or input source.  It's
 			 * possible that this happened because the user
 			 * just pointed yyin at a new source and called
 			 * yylex().  If so, then we have to assure
-			 * consistency between yy_current_buffer and our
+			 * consistency between yyg->yy_current_buffer and our
 			 * globals.  Here is the right place to do so, because
 			 * this is the first action (other than possibly a
 			 * back-up) that will match for the new input source.
 			 */
-			yy_n_chars = yy_current_buffer->yy_n_chars;
-			yy_current_buffer->yy_input_file = yyin;
-			yy_current_buffer->yy_buffer_status = YY_BUFFER_NORMAL;
+			yyg->yy_n_chars = yyg->yy_current_buffer->yy_n_chars;
+			yyg->yy_current_buffer->yy_input_file = yyin;
+			yyg->yy_current_buffer->yy_buffer_status = YY_BUFFER_NORMAL;
 			}
 
-		/* Note that here we test for yy_c_buf_p "<=" to the position
-		 * of the first EOB in the buffer, since yy_c_buf_p will
+		/* Note that here we test for yyg->yy_c_buf_p "<=" to the position
+		 * of the first EOB in the buffer, since yyg->yy_c_buf_p will
 		 * already have been incremented past the NUL character
 		 * (since all states make transitions on EOB to the
 		 * end-of-buffer state).  Contrast this with the test
 		 * in input().
 		 */
-		if ( yy_c_buf_p <= &yy_current_buffer->yy_ch_buf[yy_n_chars] )
+		if ( yyg->yy_c_buf_p <= &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] )
 			{ /* This was really a NUL. */
 			yy_state_type yy_next_state;
 
-			yy_c_buf_p = yytext_ptr + yy_amount_of_matched_text;
+			yyg->yy_c_buf_p = yytext_ptr + yy_amount_of_matched_text;
 
-			yy_current_state = yy_get_previous_state();
+			yy_current_state = yy_get_previous_state( yyscanner );
 
 			/* Okay, we're now positioned to make the NUL
 			 * transition.  We couldn't have
-			 * yy_get_previous_state() go ahead and do it
+			 * yy_get_previous_state( yyscanner ) go ahead and do it
 			 * for us because it doesn't know how to deal
 			 * with the possibility of jamming (and we don't
 			 * want to build jamming into it because then it
 			 * will run more slowly).
 			 */
 
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
+			yy_next_state = yy_try_NUL_trans( yy_current_state, yyscanner );
 
 			yy_bp = yytext_ptr + YY_MORE_ADJ;
 
 			if ( yy_next_state )
 				{
 				/* Consume the NUL. */
-				yy_cp = ++yy_c_buf_p;
+				yy_cp = ++yyg->yy_c_buf_p;
 				yy_current_state = yy_next_state;
 				goto yy_match;
 				}
 
 			else
 				{
-				yy_cp = yy_c_buf_p;
+				yy_cp = yyg->yy_c_buf_p;
 				goto yy_find_action;
 				}
 			}
 
-		else switch ( yy_get_next_buffer() )
+		else switch ( yy_get_next_buffer( yyscanner ) )
 			{
 			case EOB_ACT_END_OF_FILE:
 				{
-				yy_did_buffer_switch_on_eof = 0;
+				yyg->yy_did_buffer_switch_on_eof = 0;
 
 				if ( yywrap() )
 					{
 					/* Note: because we've taken care in
-					 * yy_get_next_buffer() to have set up
+					 * yy_get_next_buffer( yyscanner ) to have set up
 					 * yytext, we can now set up
-					 * yy_c_buf_p so that if some total
+					 * yyg->yy_c_buf_p so that if some total
 					 * hoser (like flex itself) wants to
 					 * call the scanner after we return the
 					 * YY_NULL, it'll still work - another
 					 * YY_NULL will get returned.
 					 */
-					yy_c_buf_p = yytext_ptr + YY_MORE_ADJ;
+					yyg->yy_c_buf_p = yytext_ptr + YY_MORE_ADJ;
 
 					yy_act = YY_STATE_EOF(YY_START);
 					goto do_action;
@@ -928,29 +982,29 @@ case YY_STATE_EOF(INITIAL):
 
 				else
 					{
-					if ( ! yy_did_buffer_switch_on_eof )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 					}
 				break;
 				}
 
 			case EOB_ACT_CONTINUE_SCAN:
-				yy_c_buf_p =
+				yyg->yy_c_buf_p =
 					yytext_ptr + yy_amount_of_matched_text;
 
-				yy_current_state = yy_get_previous_state();
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = yy_c_buf_p;
+				yy_cp = yyg->yy_c_buf_p;
 				yy_bp = yytext_ptr + YY_MORE_ADJ;
 				goto yy_match;
 
 			case EOB_ACT_LAST_MATCH:
-				yy_c_buf_p =
-				&yy_current_buffer->yy_ch_buf[yy_n_chars];
+				yyg->yy_c_buf_p =
+				&yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars];
 
-				yy_current_state = yy_get_previous_state();
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = yy_c_buf_p;
+				yy_cp = yyg->yy_c_buf_p;
 				yy_bp = yytext_ptr + YY_MORE_ADJ;
 				goto yy_find_action;
 			}
@@ -973,20 +1027,21 @@ case YY_STATE_EOF(INITIAL):
  *	EOB_ACT_END_OF_FILE - end of file
  */
 
-static int yy_get_next_buffer()
+static int yy_get_next_buffer( yyscan_t yyscanner )
 	{
-	register char *dest = yy_current_buffer->yy_ch_buf;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	register char *dest = yyg->yy_current_buffer->yy_ch_buf;
 	register char *source = yytext_ptr;
 	register int number_to_move, i;
 	int ret_val;
 
-	if ( yy_c_buf_p > &yy_current_buffer->yy_ch_buf[yy_n_chars + 1] )
+	if ( yyg->yy_c_buf_p > &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars + 1] )
 		YY_FATAL_ERROR(
 		"fatal flex scanner internal error--end of buffer missed" );
 
-	if ( yy_current_buffer->yy_fill_buffer == 0 )
+	if ( yyg->yy_current_buffer->yy_fill_buffer == 0 )
 		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( yy_c_buf_p - yytext_ptr - YY_MORE_ADJ == 1 )
+		if ( yyg->yy_c_buf_p - yytext_ptr - YY_MORE_ADJ == 1 )
 			{
 			/* We matched a single character, the EOB, so
 			 * treat this as a final EOF.
@@ -1006,21 +1061,21 @@ static int yy_get_next_buffer()
 	/* Try to read more data. */
 
 	/* First move last chars to start of buffer. */
-	number_to_move = (int) (yy_c_buf_p - yytext_ptr) - 1;
+	number_to_move = (int) (yyg->yy_c_buf_p - yytext_ptr) - 1;
 
 	for ( i = 0; i < number_to_move; ++i )
 		*(dest++) = *(source++);
 
-	if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_EOF_PENDING )
+	if ( yyg->yy_current_buffer->yy_buffer_status == YY_BUFFER_EOF_PENDING )
 		/* don't do the read, it's not guaranteed to return an EOF,
 		 * just force an EOF
 		 */
-		yy_current_buffer->yy_n_chars = yy_n_chars = 0;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars = 0;
 
 	else
 		{
 		int num_to_read =
-			yy_current_buffer->yy_buf_size - number_to_move - 1;
+			yyg->yy_current_buffer->yy_buf_size - number_to_move - 1;
 
 		while ( num_to_read <= 0 )
 			{ /* Not enough room in the buffer - grow it. */
@@ -1030,10 +1085,10 @@ static int yy_get_next_buffer()
 #else
 
 			/* just a shorter name for the current buffer */
-			YY_BUFFER_STATE b = yy_current_buffer;
+			YY_BUFFER_STATE b = yyg->yy_current_buffer;
 
 			int yy_c_buf_p_offset =
-				(int) (yy_c_buf_p - b->yy_ch_buf);
+				(int) (yyg->yy_c_buf_p - b->yy_ch_buf);
 
 			if ( b->yy_is_our_buffer )
 				{
@@ -1057,9 +1112,9 @@ static int yy_get_next_buffer()
 				YY_FATAL_ERROR(
 				"fatal error - scanner input buffer overflow" );
 
-			yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
+			yyg->yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
 
-			num_to_read = yy_current_buffer->yy_buf_size -
+			num_to_read = yyg->yy_current_buffer->yy_buf_size -
 						number_to_move - 1;
 #endif
 			}
@@ -1068,24 +1123,24 @@ static int yy_get_next_buffer()
 			num_to_read = YY_READ_BUF_SIZE;
 
 		/* Read in more data. */
-		YY_INPUT( (&yy_current_buffer->yy_ch_buf[number_to_move]),
-			yy_n_chars, num_to_read );
+		YY_INPUT( (&yyg->yy_current_buffer->yy_ch_buf[number_to_move]),
+			yyg->yy_n_chars, num_to_read );
 
-		yy_current_buffer->yy_n_chars = yy_n_chars;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	if ( yy_n_chars == 0 )
+	if ( yyg->yy_n_chars == 0 )
 		{
 		if ( number_to_move == YY_MORE_ADJ )
 			{
 			ret_val = EOB_ACT_END_OF_FILE;
-			yyrestart( yyin );
+			yyrestart( yyin, yyscanner );
 			}
 
 		else
 			{
 			ret_val = EOB_ACT_LAST_MATCH;
-			yy_current_buffer->yy_buffer_status =
+			yyg->yy_current_buffer->yy_buffer_status =
 				YY_BUFFER_EOF_PENDING;
 			}
 		}
@@ -1093,11 +1148,11 @@ static int yy_get_next_buffer()
 	else
 		ret_val = EOB_ACT_CONTINUE_SCAN;
 
-	yy_n_chars += number_to_move;
-	yy_current_buffer->yy_ch_buf[yy_n_chars] = YY_END_OF_BUFFER_CHAR;
-	yy_current_buffer->yy_ch_buf[yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_n_chars += number_to_move;
+	yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-	yytext_ptr = &yy_current_buffer->yy_ch_buf[0];
+	yytext_ptr = &yyg->yy_current_buffer->yy_ch_buf[0];
 
 	return ret_val;
 	}
@@ -1105,20 +1160,21 @@ static int yy_get_next_buffer()
 
 /* yy_get_previous_state - get the state just before the EOB char was reached */
 
-static yy_state_type yy_get_previous_state()
+static yy_state_type yy_get_previous_state( yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	register yy_state_type yy_current_state;
 	register char *yy_cp;
 
-	yy_current_state = yy_start;
+	yy_current_state = yyg->yy_start;
 
-	for ( yy_cp = yytext_ptr + YY_MORE_ADJ; yy_cp < yy_c_buf_p; ++yy_cp )
+	for ( yy_cp = yytext_ptr + YY_MORE_ADJ; yy_cp < yyg->yy_c_buf_p; ++yy_cp )
 		{
 		register YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
 		if ( yy_accept[yy_current_state] )
 			{
-			yy_last_accepting_state = yy_current_state;
-			yy_last_accepting_cpos = yy_cp;
+			yyg->yy_last_accepting_state = yy_current_state;
+			yyg->yy_last_accepting_cpos = yy_cp;
 			}
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
@@ -1139,21 +1195,17 @@ static yy_state_type yy_get_previous_state()
  *	next_state = yy_try_NUL_trans( current_state );
  */
 
-#ifdef YY_USE_PROTOS
-static yy_state_type yy_try_NUL_trans( yy_state_type yy_current_state )
-#else
-static yy_state_type yy_try_NUL_trans( yy_current_state )
-yy_state_type yy_current_state;
-#endif
+static yy_state_type yy_try_NUL_trans( yy_state_type yy_current_state, yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	register int yy_is_jam;
-	register char *yy_cp = yy_c_buf_p;
+	register char *yy_cp = yyg->yy_c_buf_p;
 
 	register YY_CHAR yy_c = 1;
 	if ( yy_accept[yy_current_state] )
 		{
-		yy_last_accepting_state = yy_current_state;
-		yy_last_accepting_cpos = yy_cp;
+		yyg->yy_last_accepting_state = yy_current_state;
+		yyg->yy_last_accepting_cpos = yy_cp;
 		}
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
@@ -1169,37 +1221,32 @@ yy_state_type yy_current_state;
 
 
 #ifndef YY_NO_UNPUT
-#ifdef YY_USE_PROTOS
-static void yyunput( int c, register char *yy_bp )
-#else
-static void yyunput( c, yy_bp )
-int c;
-register char *yy_bp;
-#endif
+static void yyunput( int c, register char *yy_bp, yyscan_t yyscanner )
 	{
-	register char *yy_cp = yy_c_buf_p;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	register char *yy_cp = yyg->yy_c_buf_p;
 
 	/* undo effects of setting up yytext */
-	*yy_cp = yy_hold_char;
+	*yy_cp = yyg->yy_hold_char;
 
-	if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
+	if ( yy_cp < yyg->yy_current_buffer->yy_ch_buf + 2 )
 		{ /* need to shift things up to make room */
 		/* +2 for EOB chars. */
-		register int number_to_move = yy_n_chars + 2;
-		register char *dest = &yy_current_buffer->yy_ch_buf[
-					yy_current_buffer->yy_buf_size + 2];
+		register int number_to_move = yyg->yy_n_chars + 2;
+		register char *dest = &yyg->yy_current_buffer->yy_ch_buf[
+					yyg->yy_current_buffer->yy_buf_size + 2];
 		register char *source =
-				&yy_current_buffer->yy_ch_buf[number_to_move];
+				&yyg->yy_current_buffer->yy_ch_buf[number_to_move];
 
-		while ( source > yy_current_buffer->yy_ch_buf )
+		while ( source > yyg->yy_current_buffer->yy_ch_buf )
 			*--dest = *--source;
 
 		yy_cp += (int) (dest - source);
 		yy_bp += (int) (dest - source);
-		yy_current_buffer->yy_n_chars =
-			yy_n_chars = yy_current_buffer->yy_buf_size;
+		yyg->yy_current_buffer->yy_n_chars =
+			yyg->yy_n_chars = yyg->yy_current_buffer->yy_buf_size;
 
-		if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
+		if ( yy_cp < yyg->yy_current_buffer->yy_ch_buf + 2 )
 			YY_FATAL_ERROR( "flex scanner push-back overflow" );
 		}
 
@@ -1207,38 +1254,39 @@ register char *yy_bp;
 
 
 	yytext_ptr = yy_bp;
-	yy_hold_char = *yy_cp;
-	yy_c_buf_p = yy_cp;
+	yyg->yy_hold_char = *yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 	}
 #endif	/* ifndef YY_NO_UNPUT */
 
 
 #ifdef __cplusplus
-static int yyinput()
+static int yyinput( yyscan_t yyscanner )
 #else
-static int input()
+static int input( yyscan_t yyscanner )
 #endif
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	int c;
 
-	*yy_c_buf_p = yy_hold_char;
+	*yyg->yy_c_buf_p = yyg->yy_hold_char;
 
-	if ( *yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
+	if ( *yyg->yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
 		{
-		/* yy_c_buf_p now points to the character we want to return.
+		/* yyg->yy_c_buf_p now points to the character we want to return.
 		 * If this occurs *before* the EOB characters, then it's a
 		 * valid NUL; if not, then we've hit the end of the buffer.
 		 */
-		if ( yy_c_buf_p < &yy_current_buffer->yy_ch_buf[yy_n_chars] )
+		if ( yyg->yy_c_buf_p < &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] )
 			/* This was really a NUL. */
-			*yy_c_buf_p = '\0';
+			*yyg->yy_c_buf_p = '\0';
 
 		else
 			{ /* need more input */
-			int offset = yy_c_buf_p - yytext_ptr;
-			++yy_c_buf_p;
+			int offset = yyg->yy_c_buf_p - yytext_ptr;
+			++yyg->yy_c_buf_p;
 
-			switch ( yy_get_next_buffer() )
+			switch ( yy_get_next_buffer( yyscanner ) )
 				{
 				case EOB_ACT_LAST_MATCH:
 					/* This happens because yy_g_n_b()
@@ -1252,7 +1300,7 @@ static int input()
 					 */
 
 					/* Reset buffer status. */
-					yyrestart( yyin );
+					yyrestart( yyin, yyscanner );
 
 					/* fall through */
 
@@ -1261,96 +1309,79 @@ static int input()
 					if ( yywrap() )
 						return EOF;
 
-					if ( ! yy_did_buffer_switch_on_eof )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 #ifdef __cplusplus
-					return yyinput();
+					return yyinput( yyscanner );
 #else
-					return input();
+					return input( yyscanner );
 #endif
 					}
 
 				case EOB_ACT_CONTINUE_SCAN:
-					yy_c_buf_p = yytext_ptr + offset;
+					yyg->yy_c_buf_p = yytext_ptr + offset;
 					break;
 				}
 			}
 		}
 
-	c = *(unsigned char *) yy_c_buf_p;	/* cast for 8-bit char's */
-	*yy_c_buf_p = '\0';	/* preserve yytext */
-	yy_hold_char = *++yy_c_buf_p;
+	c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+	*yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+	yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
 
 	return c;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yyrestart( FILE *input_file )
-#else
-void yyrestart( input_file )
-FILE *input_file;
-#endif
+void yyrestart( FILE *input_file, yyscan_t yyscanner )
 	{
-	if ( ! yy_current_buffer )
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE );
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( ! yyg->yy_current_buffer )
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE, yyscanner );
 
-	yy_init_buffer( yy_current_buffer, input_file );
-	yy_load_buffer_state();
+	yy_init_buffer( yyg->yy_current_buffer, input_file, yyscanner );
+	yy_load_buffer_state( yyscanner );
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_switch_to_buffer( YY_BUFFER_STATE new_buffer )
-#else
-void yy_switch_to_buffer( new_buffer )
-YY_BUFFER_STATE new_buffer;
-#endif
+void yy_switch_to_buffer( YY_BUFFER_STATE new_buffer, yyscan_t yyscanner )
 	{
-	if ( yy_current_buffer == new_buffer )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( yyg->yy_current_buffer == new_buffer )
 		return;
 
-	if ( yy_current_buffer )
+	if ( yyg->yy_current_buffer )
 		{
 		/* Flush out information for old buffer. */
-		*yy_c_buf_p = yy_hold_char;
-		yy_current_buffer->yy_buf_pos = yy_c_buf_p;
-		yy_current_buffer->yy_n_chars = yy_n_chars;
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		yyg->yy_current_buffer->yy_buf_pos = yyg->yy_c_buf_p;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	yy_current_buffer = new_buffer;
-	yy_load_buffer_state();
+	yyg->yy_current_buffer = new_buffer;
+	yy_load_buffer_state( yyscanner );
 
 	/* We don't actually know whether we did this switch during
 	 * EOF (yywrap()) processing, but the only time this flag
 	 * is looked at is after yywrap() is called, so it's safe
 	 * to go ahead and always set it.
 	 */
-	yy_did_buffer_switch_on_eof = 1;
+	yyg->yy_did_buffer_switch_on_eof = 1;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_load_buffer_state( void )
-#else
-void yy_load_buffer_state()
-#endif
+void yy_load_buffer_state( yyscan_t yyscanner )
 	{
-	yy_n_chars = yy_current_buffer->yy_n_chars;
-	yytext_ptr = yy_c_buf_p = yy_current_buffer->yy_buf_pos;
-	yyin = yy_current_buffer->yy_input_file;
-	yy_hold_char = *yy_c_buf_p;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyg->yy_n_chars = yyg->yy_current_buffer->yy_n_chars;
+	yytext_ptr = yyg->yy_c_buf_p = yyg->yy_current_buffer->yy_buf_pos;
+	yyin = yyg->yy_current_buffer->yy_input_file;
+	yyg->yy_hold_char = *yyg->yy_c_buf_p;
 	}
 
 
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_create_buffer( FILE *file, int size )
-#else
-YY_BUFFER_STATE yy_create_buffer( file, size )
-FILE *file;
-int size;
-#endif
+YY_BUFFER_STATE yy_create_buffer( FILE *file, int size, yyscan_t yyscanner )
 	{
 	YY_BUFFER_STATE b;
 
@@ -1369,24 +1400,20 @@ int size;
 
 	b->yy_is_our_buffer = 1;
 
-	yy_init_buffer( b, file );
+	yy_init_buffer( b, file, yyscanner );
 
 	return b;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_delete_buffer( YY_BUFFER_STATE b )
-#else
-void yy_delete_buffer( b )
-YY_BUFFER_STATE b;
-#endif
+void yy_delete_buffer( YY_BUFFER_STATE b, yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	if ( ! b )
 		return;
 
-	if ( b == yy_current_buffer )
-		yy_current_buffer = (YY_BUFFER_STATE) 0;
+	if ( b == yyg->yy_current_buffer )
+		yyg->yy_current_buffer = (YY_BUFFER_STATE) 0;
 
 	if ( b->yy_is_our_buffer )
 		yy_flex_free( (void *) b->yy_ch_buf );
@@ -1401,17 +1428,11 @@ extern int isatty YY_PROTO(( int ));
 #endif
 #endif
 
-#ifdef YY_USE_PROTOS
-void yy_init_buffer( YY_BUFFER_STATE b, FILE *file )
-#else
-void yy_init_buffer( b, file )
-YY_BUFFER_STATE b;
-FILE *file;
-#endif
+void yy_init_buffer( YY_BUFFER_STATE b, FILE *file, yyscan_t yyscanner )
 
 
 	{
-	yy_flush_buffer( b );
+	yy_flush_buffer( b, yyscanner );
 
 	b->yy_input_file = file;
 	b->yy_fill_buffer = 1;
@@ -1428,14 +1449,10 @@ FILE *file;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_flush_buffer( YY_BUFFER_STATE b )
-#else
-void yy_flush_buffer( b )
-YY_BUFFER_STATE b;
-#endif
+void yy_flush_buffer( YY_BUFFER_STATE b, yyscan_t yyscanner )
 
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	if ( ! b )
 		return;
 
@@ -1453,19 +1470,13 @@ YY_BUFFER_STATE b;
 	b->yy_at_bol = 1;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	if ( b == yy_current_buffer )
-		yy_load_buffer_state();
+	if ( b == yyg->yy_current_buffer )
+		yy_load_buffer_state( yyscanner );
 	}
 
 
 #ifndef YY_NO_SCAN_BUFFER
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_buffer( char *base, yy_size_t size )
-#else
-YY_BUFFER_STATE yy_scan_buffer( base, size )
-char *base;
-yy_size_t size;
-#endif
+YY_BUFFER_STATE yy_scan_buffer( char *base, yy_size_t size, yyscan_t yyscanner )
 	{
 	YY_BUFFER_STATE b;
 
@@ -1489,7 +1500,7 @@ yy_size_t size;
 	b->yy_fill_buffer = 0;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	yy_switch_to_buffer( b );
+	yy_switch_to_buffer( b, yyscanner );
 
 	return b;
 	}
@@ -1497,30 +1508,19 @@ yy_size_t size;
 
 
 #ifndef YY_NO_SCAN_STRING
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_string( yyconst char *yy_str )
-#else
-YY_BUFFER_STATE yy_scan_string( yy_str )
-yyconst char *yy_str;
-#endif
+YY_BUFFER_STATE yy_scan_string( yyconst char *yy_str, yyscan_t yyscanner )
 	{
 	int len;
 	for ( len = 0; yy_str[len]; ++len )
 		;
 
-	return yy_scan_bytes( yy_str, len );
+	return yy_scan_bytes( yy_str, len, yyscanner );
 	}
 #endif
 
 
 #ifndef YY_NO_SCAN_BYTES
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_bytes( yyconst char *bytes, int len )
-#else
-YY_BUFFER_STATE yy_scan_bytes( bytes, len )
-yyconst char *bytes;
-int len;
-#endif
+YY_BUFFER_STATE yy_scan_bytes( yyconst char *bytes, int len, yyscan_t yyscanner )
 	{
 	YY_BUFFER_STATE b;
 	char *buf;
@@ -1538,7 +1538,7 @@ int len;
 
 	buf[len] = buf[len+1] = YY_END_OF_BUFFER_CHAR;
 
-	b = yy_scan_buffer( buf, n );
+	b = yy_scan_buffer( buf, n, yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
 
@@ -1553,33 +1553,29 @@ int len;
 
 
 #ifndef YY_NO_PUSH_STATE
-#ifdef YY_USE_PROTOS
-static void yy_push_state( int new_state )
-#else
-static void yy_push_state( new_state )
-int new_state;
-#endif
+static void yy_push_state( int new_state, yyscan_t yyscanner )
 	{
-	if ( yy_start_stack_ptr >= yy_start_stack_depth )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( yyg->yy_start_stack_ptr >= yyg->yy_start_stack_depth )
 		{
 		yy_size_t new_size;
 
-		yy_start_stack_depth += YY_START_STACK_INCR;
-		new_size = yy_start_stack_depth * sizeof( int );
+		yyg->yy_start_stack_depth += YY_START_STACK_INCR;
+		new_size = yyg->yy_start_stack_depth * sizeof( int );
 
-		if ( ! yy_start_stack )
-			yy_start_stack = (int *) yy_flex_alloc( new_size );
+		if ( ! yyg->yy_start_stack )
+			yyg->yy_start_stack = (int *) yy_flex_alloc( new_size );
 
 		else
-			yy_start_stack = (int *) yy_flex_realloc(
-					(void *) yy_start_stack, new_size );
+			yyg->yy_start_stack = (int *) yy_flex_realloc(
+					(void *) yyg->yy_start_stack, new_size );
 
-		if ( ! yy_start_stack )
+		if ( ! yyg->yy_start_stack )
 			YY_FATAL_ERROR(
 			"out of memory expanding start-condition stack" );
 		}
 
-	yy_start_stack[yy_start_stack_ptr++] = YY_START;
+	yyg->yy_start_stack[yyg->yy_start_stack_ptr++] = YY_START;
 
 	BEGIN(new_state);
 	}
@@ -1587,20 +1583,22 @@ int new_state;
 
 
 #ifndef YY_NO_POP_STATE
-static void yy_pop_state()
+static void yy_pop_state( yyscan_t yyscanner )
 	{
-	if ( --yy_start_stack_ptr < 0 )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( --yyg->yy_start_stack_ptr < 0 )
 		YY_FATAL_ERROR( "start-condition stack underflow" );
 
-	BEGIN(yy_start_stack[yy_start_stack_ptr]);
+	BEGIN(yyg->yy_start_stack[yyg->yy_start_stack_ptr]);
 	}
 #endif
 
 
 #ifndef YY_NO_TOP_STATE
-static int yy_top_state()
+static int yy_top_state( yyscan_t yyscanner )
 	{
-	return yy_start_stack[yy_start_stack_ptr - 1];
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyg->yy_start_stack[yyg->yy_start_stack_ptr - 1];
 	}
 #endif
 
@@ -1608,12 +1606,7 @@ static int yy_top_state()
 #define YY_EXIT_FAILURE 2
 #endif
 
-#ifdef YY_USE_PROTOS
 static void yy_fatal_error( yyconst char msg[] )
-#else
-static void yy_fatal_error( msg )
-char msg[];
-#endif
 	{
 	(void) fprintf( stderr, "%s\n", msg );
 	exit( YY_EXIT_FAILURE );
@@ -1628,10 +1621,10 @@ char msg[];
 	do \
 		{ \
 		/* Undo effects of setting up yytext. */ \
-		yytext[yyleng] = yy_hold_char; \
-		yy_c_buf_p = yytext + n; \
-		yy_hold_char = *yy_c_buf_p; \
-		*yy_c_buf_p = '\0'; \
+		yytext[yyleng] = yyg->yy_hold_char; \
+		yyg->yy_c_buf_p = yytext + n; \
+		yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+		*yyg->yy_c_buf_p = '\0'; \
 		yyleng = n; \
 		} \
 	while ( 0 )
@@ -1640,14 +1633,7 @@ char msg[];
 /* Internal utility routines. */
 
 #ifndef yytext_ptr
-#ifdef YY_USE_PROTOS
 static void yy_flex_strncpy( char *s1, yyconst char *s2, int n )
-#else
-static void yy_flex_strncpy( s1, s2, n )
-char *s1;
-yyconst char *s2;
-int n;
-#endif
 	{
 	register int i;
 	for ( i = 0; i < n; ++i )
@@ -1656,12 +1642,7 @@ int n;
 #endif
 
 #ifdef YY_NEED_STRLEN
-#ifdef YY_USE_PROTOS
 static int yy_flex_strlen( yyconst char *s )
-#else
-static int yy_flex_strlen( s )
-yyconst char *s;
-#endif
 	{
 	register int n;
 	for ( n = 0; s[n]; ++n )
@@ -1672,23 +1653,12 @@ yyconst char *s;
 #endif
 
 
-#ifdef YY_USE_PROTOS
 static void *yy_flex_alloc( yy_size_t size )
-#else
-static void *yy_flex_alloc( size )
-yy_size_t size;
-#endif
 	{
 	return (void *) malloc( size );
 	}
 
-#ifdef YY_USE_PROTOS
 static void *yy_flex_realloc( void *ptr, yy_size_t size )
-#else
-static void *yy_flex_realloc( ptr, size )
-void *ptr;
-yy_size_t size;
-#endif
 	{
 	/* The cast to (char *) in the following accommodates both
 	 * implementations that use char* generic pointers, and those
@@ -1700,21 +1670,138 @@ yy_size_t size;
 	return (void *) realloc( (char *) ptr, size );
 	}
 
-#ifdef YY_USE_PROTOS
 static void yy_flex_free( void *ptr )
-#else
-static void yy_flex_free( ptr )
-void *ptr;
-#endif
 	{
 	free( ptr );
 	}
 
-#if YY_MAIN
-int main()
+/* Accessor methods (get/set functions) to struct members. */
+
+YY_EXTRA_TYPE yyget_extra( yyscan_t yyscanner )
 	{
-	yylex();
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyextra;
+	}
+
+void yyset_extra( YY_EXTRA_TYPE user_defined, yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyextra = user_defined ;
+	}
+
+FILE *yyget_in( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyin;
+	}
+
+void yyset_in( FILE * _in_str, yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyin = _in_str ;
+	}
+
+char *yyget_text( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yytext;
+	}
+
+int yyget_leng( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyleng;
+	}
+
+/* User-visible API */
+
+/* yylex_init is special because it creates the scanner itself, so it is
+ * the ONLY reentrant function that doesn't take the scanner as the last argument.
+ * That's why we explicitly handle the declaration, instead of using our macros.
+ */
+int yylex_init( yyscan_t* ptr_yy_globals )
+	{
+	return yylex_init_extra( (YY_EXTRA_TYPE) 0, ptr_yy_globals );
+	}
+
+/* yylex_init_extra has the same functionality as yylex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own declaration).
+ * The user defined value in the first argument will be available to yy_flex_alloc in
+ * the yyextra field.
+ */
+int yylex_init_extra( YY_EXTRA_TYPE yy_user_defined, yyscan_t* ptr_yy_globals )
+	{
+	if ( ptr_yy_globals == NULL )
+		{
+		errno = EINVAL;
+		return 1;
+		}
+
+	*ptr_yy_globals = (yyscan_t) yy_flex_alloc( sizeof( struct yyguts_t ) );
+
+	if ( *ptr_yy_globals == NULL )
+		{
+		errno = ENOMEM;
+		return 1;
+		}
+
+	/* By setting to 0xAA, we expose bugs in yy_init_globals. Leave at 0x00 for releases. */
+	memset( *ptr_yy_globals, 0x00, sizeof( struct yyguts_t ) );
+
+	yy_init_globals( *ptr_yy_globals );
+
+	yyset_extra( yy_user_defined, *ptr_yy_globals );
+
 	return 0;
 	}
-#endif
-#line 58 "lexer.l"
+
+static int yy_init_globals( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	/* Initialization is the same as for the non-reentrant scanner.
+	 * This function is called from yylex_destroy(), so don't allocate here.
+	 */
+
+	yyg->yy_current_buffer = (YY_BUFFER_STATE) 0;
+	yyg->yy_c_buf_p = (char *) 0;
+	yyg->yy_init = 1;
+	yyg->yy_start = 0;
+
+	yyg->yy_start_stack_ptr = 0;
+	yyg->yy_start_stack_depth = 0;
+	yyg->yy_start_stack = (int *) 0;
+
+	yyin = (FILE *) 0;
+	yyout = (FILE *) 0;
+
+	/* For future reference: Set errno on error, since we are called by
+	 * yylex_init()
+	 */
+	return 0;
+	}
+
+/* yylex_destroy is for both reentrant and non-reentrant scanners. */
+int yylex_destroy( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	/* Pop the buffer stack, destroying each element. */
+	yy_delete_buffer( yyg->yy_current_buffer, yyscanner );
+	yyg->yy_current_buffer = (YY_BUFFER_STATE) 0;
+
+	/* Destroy the start condition stack. */
+	yy_flex_free( yyg->yy_start_stack );
+	yyg->yy_start_stack = (int *) 0;
+
+	/* Reset the globals. This is important in a non-reentrant scanner so the next time
+	 * yylex() is called, initialization will occur. */
+	yy_init_globals( yyscanner );
+
+	/* Destroy the main struct (reentrant only). */
+	yy_flex_free( yyscanner );
+	yyscanner = NULL;
+	return 0;
+	}
+#line 72 "lexer.l"
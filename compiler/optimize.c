@@ -3,6 +3,9 @@
 #include <string.h>
 #include <math.h>
 #include "optimize.h"
+#include "cfg.h"
+#include "defuse.h"
+#include "trace.h"
 
 // 初始化优化器
 Optimizer* init_optimizer(IRGenerator *ir_gen, int optimization_level) {
@@ -12,6 +15,7 @@ Optimizer* init_optimizer(IRGenerator *ir_gen, int optimization_level) {
     opt->eliminated_instructions = 0;
     opt->folded_constants = 0;
     opt->propagated_constants = 0;
+    opt->verbose = true;
     
     // 根据优化级别设置启用的优化
     set_optimization_level(opt, optimization_level);
@@ -35,9 +39,9 @@ void set_optimization_level(Optimizer *opt, int level) {
         case 3: // -O3: 最高优化 (暂时禁用)
             // opt->optimizations_enabled[OPT_COMMON_SUBEXPRESSION] = true;
             // fallthrough
-        case 2: // -O2: 高优化 (暂时只启用常量折叠)
+        case 2: // -O2: 高优化 (常量折叠和死代码消除)
             // opt->optimizations_enabled[OPT_COPY_PROPAGATION] = true;
-            // opt->optimizations_enabled[OPT_DEAD_CODE_ELIMINATION] = true;
+            opt->optimizations_enabled[OPT_DEAD_CODE_ELIMINATION] = true;
             // fallthrough
         case 1: // -O1: 基本优化 (只启用常量折叠)
             opt->optimizations_enabled[OPT_CONSTANT_FOLDING] = true;
@@ -52,16 +56,18 @@ void set_optimization_level(Optimizer *opt, int level) {
 
 // 主优化函数
 void optimize_ir(Optimizer *opt) {
-    printf("\n=== Start Optimization (Level %d) ===\n", opt->optimization_level);
+    if (opt->verbose) {
+        printf("\n=== Start Optimization (Level %d) ===\n", opt->optimization_level);
+    }
     
     if (opt->optimization_level == 0) {
-        printf("Optimization disabled\n");
+        if (opt->verbose) printf("Optimization disabled\n");
         return;
     }
     
     // 检查是否有指令可以优化
     if (!opt->ir_gen || !opt->ir_gen->instructions) {
-        printf("No instructions to optimize\n");
+        if (opt->verbose) printf("No instructions to optimize\n");
         return;
     }
     
@@ -71,40 +77,34 @@ void optimize_ir(Optimizer *opt) {
     
     while (changed && pass <= 3) { // 减少到最多3遍，避免过度优化
         changed = false;
-        printf("Optimization pass %d:\n", pass);
-        fflush(stdout); // 确保输出立即显示
+        TRACE(TRACE_OPT, TRACE_INFO, "optimization pass %d", pass);
         
         int old_eliminated = opt->eliminated_instructions;
         int old_folded = opt->folded_constants;
         int old_propagated = opt->propagated_constants;
         
         if (opt->optimizations_enabled[OPT_CONSTANT_FOLDING]) {
-            printf("  Running constant folding...\n");
-            fflush(stdout);
+            TRACE(TRACE_OPT, TRACE_DEBUG, "  running constant folding");
             constant_folding(opt);
         }
         
         if (opt->optimizations_enabled[OPT_CONSTANT_PROPAGATION]) {
-            printf("  Running constant propagation...\n");
-            fflush(stdout);
+            TRACE(TRACE_OPT, TRACE_DEBUG, "  running constant propagation");
             constant_propagation(opt);
         }
         
         if (opt->optimizations_enabled[OPT_ALGEBRAIC_SIMPLIFICATION]) {
-            printf("  Running algebraic simplification...\n");
-            fflush(stdout);
+            TRACE(TRACE_OPT, TRACE_DEBUG, "  running algebraic simplification");
             algebraic_simplification(opt);
         }
         
         if (opt->optimizations_enabled[OPT_COPY_PROPAGATION]) {
-            printf("  Running copy propagation...\n");
-            fflush(stdout);
+            TRACE(TRACE_OPT, TRACE_DEBUG, "  running copy propagation");
             copy_propagation(opt);
         }
         
         if (opt->optimizations_enabled[OPT_DEAD_CODE_ELIMINATION]) {
-            printf("  Running dead code elimination...\n");
-            fflush(stdout);
+            TRACE(TRACE_OPT, TRACE_DEBUG, "  running dead code elimination");
             dead_code_elimination(opt);
         }
         
@@ -122,28 +122,38 @@ void optimize_ir(Optimizer *opt) {
         pass++;
     }
     
-    print_optimization_stats(opt);
+    if (opt->verbose) {
+        print_optimization_stats(opt);
+    }
 }
 
 // 常量折叠
 void constant_folding(Optimizer *opt) {
+    // 常量表只在一个基本块内有效，每进入一个块就清空
+    CFG *cfg = build_cfg(opt->ir_gen);
+    if (!cfg) return;
     ConstantTable *table = init_constant_table();
     IRInstruction *instr = opt->ir_gen->instructions;
+    int block = 0;
     
     while (instr) {
         IRInstruction *next = instr->next;
+        if (block < cfg->block_count && instr == cfg->blocks[block].first) {
+            clear_constant_table(table);
+            block++;
+        }
         
         switch (instr->opcode) {
             case IR_LOAD_CONST:
-                if (instr->operand1 && instr->operand1->type == OPERAND_CONST && instr->result) {
+                if (instr->operand1.type == OPERAND_CONST && HAS_OPERAND(instr->result)) {
                     ConstantValue value;
-                    if (instr->operand1->data_type == TYPE_INT) {
-                        value = create_int_constant(instr->operand1->const_val.int_val);
+                    if (instr->operand1.data_type == TYPE_INT) {
+                        value = create_int_constant(instr->operand1.const_val.int_val);
                     } else {
-                        value = create_float_constant(instr->operand1->const_val.float_val);
+                        value = create_float_constant(instr->operand1.const_val.float_val);
                     }
-                    if (instr->result->type == OPERAND_TEMP) {
-                        add_constant(table, instr->result->temp_id, value);
+                    if (instr->result.type == OPERAND_TEMP) {
+                        add_constant(table, instr->result.temp_id, value);
                     }
                 }
                 break;
@@ -152,29 +162,27 @@ void constant_folding(Optimizer *opt) {
                 break;
                 
             case IR_BINOP: {
-                if (is_constant_operand(instr->operand1, table) && 
-                    is_constant_operand(instr->operand2, table)) {
+                if (is_constant_operand(&instr->operand1, table) && 
+                    is_constant_operand(&instr->operand2, table)) {
                     
-                    ConstantValue left = get_operand_constant(instr->operand1, table);
-                    ConstantValue right = get_operand_constant(instr->operand2, table);
+                    ConstantValue left = get_operand_constant(&instr->operand1, table);
+                    ConstantValue right = get_operand_constant(&instr->operand2, table);
                     
                     if (can_evaluate_binop(instr->binop, left, right)) {
                         ConstantValue result = evaluate_binop(instr->binop, left, right);
                         
                         // 替换指令为常量加载
                         instr->opcode = IR_LOAD_CONST;
-                        free_operand(instr->operand1);
-                        free_operand(instr->operand2);
                         
                         if (result.type == TYPE_INT) {
                             instr->operand1 = create_int_const_operand(result.value.int_val);
                         } else {
                             instr->operand1 = create_float_const_operand(result.value.float_val);
                         }
-                        instr->operand2 = NULL;
+                        instr->operand2.type = OPERAND_NONE;
                         
-                        if (instr->result->type == OPERAND_TEMP) {
-                            add_constant(table, instr->result->temp_id, result);
+                        if (instr->result.type == OPERAND_TEMP) {
+                            add_constant(table, instr->result.temp_id, result);
                         }
                         
                         opt->folded_constants++;
@@ -184,13 +192,13 @@ void constant_folding(Optimizer *opt) {
             }
             
             case IR_CONVERT: {
-                if (is_constant_operand(instr->operand1, table)) {
-                    ConstantValue value = get_operand_constant(instr->operand1, table);
+                if (is_constant_operand(&instr->operand1, table)) {
+                    ConstantValue value = get_operand_constant(&instr->operand1, table);
                     ConstantValue converted;
                     
-                    if (instr->result->data_type == TYPE_INT && value.type == TYPE_FLOAT) {
+                    if (instr->result.data_type == TYPE_INT && value.type == TYPE_FLOAT) {
                         converted = create_int_constant((int)value.value.float_val);
-                    } else if (instr->result->data_type == TYPE_FLOAT && value.type == TYPE_INT) {
+                    } else if (instr->result.data_type == TYPE_FLOAT && value.type == TYPE_INT) {
                         converted = create_float_constant((float)value.value.int_val);
                     } else {
                         converted = value;
@@ -198,7 +206,6 @@ void constant_folding(Optimizer *opt) {
                     
                     // 替换为常量加载
                     instr->opcode = IR_LOAD_CONST;
-                    free_operand(instr->operand1);
                     
                     if (converted.type == TYPE_INT) {
                         instr->operand1 = create_int_const_operand(converted.value.int_val);
@@ -206,8 +213,8 @@ void constant_folding(Optimizer *opt) {
                         instr->operand1 = create_float_const_operand(converted.value.float_val);
                     }
                     
-                    if (instr->result->type == OPERAND_TEMP) {
-                        add_constant(table, instr->result->temp_id, converted);
+                    if (instr->result.type == OPERAND_TEMP) {
+                        add_constant(table, instr->result.temp_id, converted);
                     }
                     
                     opt->folded_constants++;
@@ -223,45 +230,54 @@ void constant_folding(Optimizer *opt) {
     }
     
     free_constant_table(table);
+    free_cfg(cfg);
 }
 
 // 常量传播
 void constant_propagation(Optimizer *opt) {
+    // 变量在其他前驱块中可能被赋了别的值，常量表只在一个基本块内有效
+    CFG *cfg = build_cfg(opt->ir_gen);
+    if (!cfg) return;
     ConstantTable *table = init_constant_table();
     IRInstruction *instr = opt->ir_gen->instructions;
+    int block = 0;
     
     while (instr) {
+        if (block < cfg->block_count && instr == cfg->blocks[block].first) {
+            clear_constant_table(table);
+            block++;
+        }
         // 更新常量表
         switch (instr->opcode) {
             case IR_LOAD_CONST:
-                if (instr->result && instr->result->type == OPERAND_TEMP && 
-                    instr->operand1 && instr->operand1->type == OPERAND_CONST) {
+                if (instr->result.type == OPERAND_TEMP && 
+                    instr->operand1.type == OPERAND_CONST) {
                     ConstantValue value;
-                    if (instr->operand1->data_type == TYPE_INT) {
-                        value = create_int_constant(instr->operand1->const_val.int_val);
+                    if (instr->operand1.data_type == TYPE_INT) {
+                        value = create_int_constant(instr->operand1.const_val.int_val);
                     } else {
-                        value = create_float_constant(instr->operand1->const_val.float_val);
+                        value = create_float_constant(instr->operand1.const_val.float_val);
                     }
-                    add_constant(table, instr->result->temp_id, value);
+                    add_constant(table, instr->result.temp_id, value);
                 }
                 break;
                 
             case IR_STORE:
-                if (instr->operand1 && instr->operand1->type == OPERAND_TEMP && 
-                    instr->result && instr->result->type == OPERAND_VAR) {
-                    ConstantValue *value = lookup_temp_constant(table, instr->operand1->temp_id);
+                if (instr->operand1.type == OPERAND_TEMP && 
+                    instr->result.type == OPERAND_VAR) {
+                    ConstantValue *value = lookup_temp_constant(table, instr->operand1.temp_id);
                     if (value && value->is_constant) {
-                        add_var_constant(table, instr->result->var_name, *value);
+                        add_var_constant(table, instr->result.var_name, *value);
                     } else {
-                        remove_var_constant(table, instr->result->var_name);
+                        remove_var_constant(table, instr->result.var_name);
                     }
                 }
                 break;
                 
             default:
                 // 如果指令修改了某个临时变量，从常量表中移除
-                if (instr->result && instr->result->type == OPERAND_TEMP) {
-                    remove_temp_constant(table, instr->result->temp_id);
+                if (instr->result.type == OPERAND_TEMP) {
+                    remove_temp_constant(table, instr->result.temp_id);
                 }
                 break;
         }
@@ -269,10 +285,9 @@ void constant_propagation(Optimizer *opt) {
         // 传播常量
         bool changed = false;
         
-        if (instr->operand1 && instr->operand1->type == OPERAND_TEMP) {
-            ConstantValue *value = lookup_temp_constant(table, instr->operand1->temp_id);
+        if (instr->operand1.type == OPERAND_TEMP) {
+            ConstantValue *value = lookup_temp_constant(table, instr->operand1.temp_id);
             if (value && value->is_constant) {
-                free_operand(instr->operand1);
                 if (value->type == TYPE_INT) {
                     instr->operand1 = create_int_const_operand(value->value.int_val);
                 } else {
@@ -282,10 +297,9 @@ void constant_propagation(Optimizer *opt) {
             }
         }
         
-        if (instr->operand2 && instr->operand2->type == OPERAND_TEMP) {
-            ConstantValue *value = lookup_temp_constant(table, instr->operand2->temp_id);
+        if (instr->operand2.type == OPERAND_TEMP) {
+            ConstantValue *value = lookup_temp_constant(table, instr->operand2.temp_id);
             if (value && value->is_constant) {
-                free_operand(instr->operand2);
                 if (value->type == TYPE_INT) {
                     instr->operand2 = create_int_const_operand(value->value.int_val);
                 } else {
@@ -303,6 +317,7 @@ void constant_propagation(Optimizer *opt) {
     }
     
     free_constant_table(table);
+    free_cfg(cfg);
 }
 
 // 代数简化
@@ -314,8 +329,8 @@ void algebraic_simplification(Optimizer *opt) {
         IRInstruction *next = instr->next;
         
         if (instr->opcode == IR_BINOP) {
-            ConstantValue left_const = get_operand_constant(instr->operand1, table);
-            ConstantValue right_const = get_operand_constant(instr->operand2, table);
+            ConstantValue left_const = get_operand_constant(&instr->operand1, table);
+            ConstantValue right_const = get_operand_constant(&instr->operand2, table);
             
             bool simplified = false;
             
@@ -325,8 +340,7 @@ void algebraic_simplification(Optimizer *opt) {
                 
                 // 替换为简单赋值
                 instr->opcode = IR_ASSIGN;
-                free_operand(instr->operand2);
-                instr->operand2 = NULL;
+                instr->operand2.type = OPERAND_NONE;
                 simplified = true;
             }
             // 0 + x = x
@@ -334,9 +348,8 @@ void algebraic_simplification(Optimizer *opt) {
                      left_const.is_constant && is_zero_const_value(left_const)) {
                 
                 instr->opcode = IR_ASSIGN;
-                free_operand(instr->operand1);
                 instr->operand1 = instr->operand2;
-                instr->operand2 = NULL;
+                instr->operand2.type = OPERAND_NONE;
                 simplified = true;
             }
             // x * 1 = x, x / 1 = x
@@ -344,8 +357,7 @@ void algebraic_simplification(Optimizer *opt) {
                      right_const.is_constant && is_one_const_value(right_const)) {
                 
                 instr->opcode = IR_ASSIGN;
-                free_operand(instr->operand2);
-                instr->operand2 = NULL;
+                instr->operand2.type = OPERAND_NONE;
                 simplified = true;
             }
             // 1 * x = x
@@ -353,9 +365,8 @@ void algebraic_simplification(Optimizer *opt) {
                      left_const.is_constant && is_one_const_value(left_const)) {
                 
                 instr->opcode = IR_ASSIGN;
-                free_operand(instr->operand1);
                 instr->operand1 = instr->operand2;
-                instr->operand2 = NULL;
+                instr->operand2.type = OPERAND_NONE;
                 simplified = true;
             }
             // x * 0 = 0, 0 * x = 0
@@ -364,10 +375,8 @@ void algebraic_simplification(Optimizer *opt) {
                       (right_const.is_constant && is_zero_const_value(right_const)))) {
                 
                 instr->opcode = IR_LOAD_CONST;
-                free_operand(instr->operand1);
-                free_operand(instr->operand2);
                 instr->operand1 = create_int_const_operand(0);
-                instr->operand2 = NULL;
+                instr->operand2.type = OPERAND_NONE;
                 simplified = true;
             }
             
@@ -382,57 +391,175 @@ void algebraic_simplification(Optimizer *opt) {
     free_constant_table(table);
 }
 
-// 死代码消除
+// 必须保留的指令：控制流、调用和参数，以及除数可能为0的除法（运行时报错）
+static bool is_dce_root(const IRInstruction *instr) {
+    switch (instr->opcode) {
+        case IR_ASSIGN:
+        case IR_LOAD:
+        case IR_STORE:
+        case IR_LOAD_CONST:
+        case IR_CONVERT:
+        case IR_PHI:
+            return false;
+        case IR_BINOP:
+            if (instr->binop != OP_DIV) return false;
+            return instr->operand2.type != OPERAND_CONST ||
+                   (instr->operand2.data_type == TYPE_INT ? instr->operand2.const_val.int_val == 0
+                                                          : instr->operand2.const_val.float_val == 0.0f);
+        default:
+            return true;
+    }
+}
+
+// 块内倒序扫描：stored[v] == b表示块b中之后对v的第一次访问是赋值，这时当前的赋值在被读取之前就被覆盖
+static void find_overwritten_stores(const CFG *cfg, const DefUse *du, bool *overwritten, int *stored) {
+    for (int v = 0; v < du->vars.count; v++) stored[v] = -1;
+    for (int b = 0; b < cfg->block_count; b++) {
+        const BasicBlock *block = &cfg->blocks[b];
+        for (IRInstruction *instr = block->last; ; instr = instr->prev) {
+            if (is_ir_variable(&instr->result)) {
+                int v = ir_var_id(&du->vars, instr->result.var_name);
+                if (stored[v] == b) overwritten[instr->id] = true;
+                else stored[v] = b;
+            }
+            if (is_ir_variable(&instr->operand1)) stored[ir_var_id(&du->vars, instr->operand1.var_name)] = -1;
+            if (is_ir_variable(&instr->operand2)) stored[ir_var_id(&du->vars, instr->operand2.var_name)] = -1;
+            if (instr == block->first) break;
+        }
+    }
+}
+
+typedef struct {
+    const DefUse *du;
+    const bool *overwritten;
+    bool *live;                 // 按指令编号
+    bool *temp_live;            // 值已被标记为活跃，它的定义都已入队
+    bool *var_live;
+    int *worklist;
+    int count;
+} LivenessMarker;
+
+static void mark_live(LivenessMarker *m, int id) {
+    if (m->live[id]) return;
+    m->live[id] = true;
+    m->worklist[m->count++] = id;
+}
+
+// 一个活跃指令读取的值：它的所有定义都活跃（变量在块内被覆盖的赋值除外）；每个值只展开一次
+static void mark_operand_defs(LivenessMarker *m, const Operand *operand) {
+    const DefUse *du = m->du;
+    if (operand->type == OPERAND_TEMP) {
+        int t = operand->temp_id;
+        if (t < 0 || t >= du->temp_count || m->temp_live[t]) return;
+        m->temp_live[t] = true;
+        for (int i = du->temp_def_start[t]; i < du->temp_def_start[t + 1]; i++) mark_live(m, du->temp_defs[i]);
+    } else if (is_ir_variable(operand)) {
+        int v = ir_var_id(&du->vars, operand->var_name);
+        if (m->var_live[v]) return;
+        m->var_live[v] = true;
+        for (int i = du->var_def_start[v]; i < du->var_def_start[v + 1]; i++) {
+            if (!m->overwritten[du->var_defs[i]]) mark_live(m, du->var_defs[i]);
+        }
+    }
+}
+
+// 死代码消除：从必须保留的指令出发沿def-use链标记活跃指令，删除其余的，整体O(N)。
+// 没有活跃读取的变量，它的赋值连同只为赋值计算的临时变量一起删除
 void dead_code_elimination(Optimizer *opt) {
-    IRInstruction *instr = opt->ir_gen->instructions;
-    
-    while (instr) {
-        IRInstruction *next = instr->next;
-        
-        if (is_dead_instruction(instr, opt->ir_gen)) {
-            remove_instruction(opt->ir_gen, instr);
-            opt->eliminated_instructions++;
+    IRGenerator *gen = opt->ir_gen;
+    DefUse *du = build_def_use(gen);
+    CFG *cfg = du ? build_cfg(gen) : NULL;
+    if (!cfg) {
+        free_def_use(du);
+        return;
+    }
+    int n = du->instr_count;
+    bool *overwritten = (bool*)calloc((size_t)n + 1, sizeof(bool));
+    int *stored = (int*)malloc(((size_t)du->vars.count + 1) * sizeof(int));
+    LivenessMarker m = {
+        du, overwritten,
+        (bool*)calloc((size_t)n + 1, sizeof(bool)),
+        (bool*)calloc((size_t)du->temp_count + 1, sizeof(bool)),
+        (bool*)calloc((size_t)du->vars.count + 1, sizeof(bool)),
+        (int*)malloc(((size_t)n + 1) * sizeof(int)),
+        0
+    };
+
+    if (overwritten && stored && m.live && m.temp_live && m.var_live && m.worklist) {
+        find_overwritten_stores(cfg, du, overwritten, stored);
+        for (int id = 0; id < n; id++) {
+            if (is_dce_root(du->instrs[id])) mark_live(&m, id);
+        }
+        while (m.count > 0) {
+            const IRInstruction *instr = du->instrs[m.worklist[--m.count]];
+            mark_operand_defs(&m, &instr->operand1);
+            mark_operand_defs(&m, &instr->operand2);
+            if (instr->opcode == IR_PHI) {
+                for (int i = 0; i < instr->phi_arg_count; i++) mark_operand_defs(&m, &instr->phi_args[i]);
+            }
+        }
+        for (int id = 0; id < n; id++) {
+            if (!m.live[id]) {
+                remove_instruction(gen, du->instrs[id]);
+                opt->eliminated_instructions++;
+            }
         }
-        
-        instr = next;
     }
+
+    free(overwritten);
+    free(stored);
+    free(m.live);
+    free(m.temp_live);
+    free(m.var_live);
+    free(m.worklist);
+    free_cfg(cfg);
+    free_def_use(du);
 }
 
 // 复制传播
 void copy_propagation(Optimizer *opt) {
+    // 替换只进行到当前基本块结束：后面的块可能从别的路径到达
+    CFG *cfg = build_cfg(opt->ir_gen);
+    if (!cfg) return;
     IRInstruction *instr = opt->ir_gen->instructions;
+    IRInstruction *block_end = NULL;
+    int block = 0;
     
     while (instr) {
+        if (block < cfg->block_count && instr == cfg->blocks[block].first) {
+            block_end = cfg->blocks[block].last->next;
+            block++;
+        }
         // 查找形如 t1 = t2 的赋值
         if (instr->opcode == IR_ASSIGN && 
-            instr->result->type == OPERAND_TEMP &&
-            instr->operand1->type == OPERAND_TEMP) {
+            instr->result.type == OPERAND_TEMP &&
+            instr->operand1.type == OPERAND_TEMP) {
             
-            int target_temp = instr->result->temp_id;
-            int source_temp = instr->operand1->temp_id;
+            int target_temp = instr->result.temp_id;
+            int source_temp = instr->operand1.temp_id;
             
             // 在后续指令中替换对target_temp的使用
             IRInstruction *current = instr->next;
             bool can_eliminate = true;
             
-            while (current && can_eliminate) {
+            while (current != block_end && can_eliminate) {
                 // 检查source_temp是否被重新定义
-                if (current->result && current->result->type == OPERAND_TEMP &&
-                    current->result->temp_id == source_temp) {
+                if (current->result.type == OPERAND_TEMP &&
+                    current->result.temp_id == source_temp) {
                     can_eliminate = false;
                     break;
                 }
                 
                 // 替换对target_temp的使用
-                if (current->operand1 && current->operand1->type == OPERAND_TEMP &&
-                    current->operand1->temp_id == target_temp) {
-                    current->operand1->temp_id = source_temp;
+                if (current->operand1.type == OPERAND_TEMP &&
+                    current->operand1.temp_id == target_temp) {
+                    current->operand1.temp_id = source_temp;
                     opt->propagated_constants++;
                 }
                 
-                if (current->operand2 && current->operand2->type == OPERAND_TEMP &&
-                    current->operand2->temp_id == target_temp) {
-                    current->operand2->temp_id = source_temp;
+                if (current->operand2.type == OPERAND_TEMP &&
+                    current->operand2.temp_id == target_temp) {
+                    current->operand2.temp_id = source_temp;
                     opt->propagated_constants++;
                 }
                 
@@ -442,6 +569,7 @@ void copy_propagation(Optimizer *opt) {
         
         instr = instr->next;
     }
+    free_cfg(cfg);
 }
 
 // 公共子表达式消除 (简化版本)
@@ -455,15 +583,13 @@ void common_subexpression_elimination(Optimizer *opt) {
         // 检查两个连续的二元运算指令是否相同
         if (instr->opcode == IR_BINOP && next->opcode == IR_BINOP &&
             instr->binop == next->binop &&
-            operands_equal(instr->operand1, next->operand1) &&
-            operands_equal(instr->operand2, next->operand2)) {
+            operands_equal(&instr->operand1, &next->operand1) &&
+            operands_equal(&instr->operand2, &next->operand2)) {
             
             // 将第二个指令替换为赋值
             next->opcode = IR_ASSIGN;
-            free_operand(next->operand1);
-            free_operand(next->operand2);
-            next->operand1 = copy_operand(instr->result);
-            next->operand2 = NULL;
+            next->operand1 = instr->result;
+            next->operand2.type = OPERAND_NONE;
             
             opt->eliminated_instructions++;
         }
@@ -479,14 +605,18 @@ ConstantTable* init_constant_table() {
     return table;
 }
 
-void free_constant_table(ConstantTable *table) {
+void clear_constant_table(ConstantTable *table) {
     ConstantEntry *entry = table->entries;
     while (entry) {
         ConstantEntry *next = entry->next;
-        if (entry->var_name) free(entry->var_name);
         free(entry);
         entry = next;
     }
+    table->entries = NULL;
+}
+
+void free_constant_table(ConstantTable *table) {
+    clear_constant_table(table);
     free(table);
 }
 
@@ -502,7 +632,7 @@ void add_constant(ConstantTable *table, int temp_id, ConstantValue value) {
 void add_var_constant(ConstantTable *table, const char *var_name, ConstantValue value) {
     ConstantEntry *entry = (ConstantEntry*)malloc(sizeof(ConstantEntry));
     entry->temp_id = -1;
-    entry->var_name = strdup(var_name);
+    entry->var_name = var_name;
     entry->constant = value;
     entry->next = table->entries;
     table->entries = entry;
@@ -522,7 +652,7 @@ ConstantValue* lookup_temp_constant(ConstantTable *table, int temp_id) {
 ConstantValue* lookup_var_constant(ConstantTable *table, const char *var_name) {
     ConstantEntry *entry = table->entries;
     while (entry) {
-        if (entry->var_name && strcmp(entry->var_name, var_name) == 0) {
+        if (entry->var_name == var_name) {
             return &entry->constant;
         }
         entry = entry->next;
@@ -554,7 +684,7 @@ ConstantValue create_unknown_constant() {
     return constant;
 }
 
-bool is_constant_operand(Operand *operand, ConstantTable *table) {
+bool is_constant_operand(const Operand *operand, ConstantTable *table) {
     if (operand->type == OPERAND_CONST) {
         return true;
     }
@@ -569,7 +699,7 @@ bool is_constant_operand(Operand *operand, ConstantTable *table) {
     return false;
 }
 
-ConstantValue get_operand_constant(Operand *operand, ConstantTable *table) {
+ConstantValue get_operand_constant(const Operand *operand, ConstantTable *table) {
     if (operand->type == OPERAND_CONST) {
         if (operand->data_type == TYPE_INT) {
             return create_int_constant(operand->const_val.int_val);
@@ -675,12 +805,12 @@ bool is_one_const_value(ConstantValue value) {
 
 bool is_dead_instruction(IRInstruction *instr, IRGenerator *gen) {
     // 简化的死代码检测：检查结果是否被使用
-    if (!instr->result || has_side_effects(instr)) {
+    if (!HAS_OPERAND(instr->result) || has_side_effects(instr)) {
         return false;
     }
     
-    if (instr->result->type == OPERAND_TEMP) {
-        return !is_temp_used(instr->result->temp_id, instr->next);
+    if (instr->result.type == OPERAND_TEMP) {
+        return !is_temp_used(instr->result.temp_id, instr->next);
     }
     
     return false;
@@ -707,16 +837,16 @@ bool is_temp_used(int temp_id, IRInstruction *start_instr) {
     IRInstruction *instr = start_instr;
     
     while (instr) {
-        if ((instr->operand1 && instr->operand1->type == OPERAND_TEMP && 
-             instr->operand1->temp_id == temp_id) ||
-            (instr->operand2 && instr->operand2->type == OPERAND_TEMP && 
-             instr->operand2->temp_id == temp_id)) {
+        if ((instr->operand1.type == OPERAND_TEMP && 
+             instr->operand1.temp_id == temp_id) ||
+            (instr->operand2.type == OPERAND_TEMP && 
+             instr->operand2.temp_id == temp_id)) {
             return true;
         }
         
         // 如果临时变量被重新定义，则停止搜索
-        if (instr->result && instr->result->type == OPERAND_TEMP && 
-            instr->result->temp_id == temp_id) {
+        if (instr->result.type == OPERAND_TEMP && 
+            instr->result.temp_id == temp_id) {
             return false;
         }
         
@@ -726,7 +856,7 @@ bool is_temp_used(int temp_id, IRInstruction *start_instr) {
     return false;
 }
 
-bool operands_equal(Operand *op1, Operand *op2) {
+bool operands_equal(const Operand *op1, const Operand *op2) {
     if (!op1 || !op2 || op1->type != op2->type) {
         return false;
     }
@@ -735,7 +865,7 @@ bool operands_equal(Operand *op1, Operand *op2) {
         case OPERAND_TEMP:
             return op1->temp_id == op2->temp_id;
         case OPERAND_VAR:
-            return strcmp(op1->var_name, op2->var_name) == 0;
+            return op1->var_name == op2->var_name;
         case OPERAND_CONST:
             if (op1->data_type != op2->data_type) return false;
             if (op1->data_type == TYPE_INT) {
@@ -748,29 +878,6 @@ bool operands_equal(Operand *op1, Operand *op2) {
     }
 }
 
-Operand* copy_operand(Operand *operand) {
-    if (!operand) return NULL;
-    
-    switch (operand->type) {
-        case OPERAND_TEMP:
-            return create_temp_operand(operand->temp_id, operand->data_type);
-        case OPERAND_VAR:
-            return create_var_operand(operand->var_name, operand->data_type);
-        case OPERAND_CONST:
-            if (operand->data_type == TYPE_INT) {
-                return create_int_const_operand(operand->const_val.int_val);
-            } else {
-                return create_float_const_operand(operand->const_val.float_val);
-            }
-        case OPERAND_LABEL:
-            return create_label_operand(operand->label_name);
-        case OPERAND_FUNC:
-            return create_func_operand(operand->func_name);
-        default:
-            return NULL;
-    }
-}
-
 void remove_temp_constant(ConstantTable *table, int temp_id) {
     ConstantEntry **entry = &table->entries;
     while (*entry) {
@@ -787,10 +894,9 @@ void remove_temp_constant(ConstantTable *table, int temp_id) {
 void remove_var_constant(ConstantTable *table, const char *var_name) {
     ConstantEntry **entry = &table->entries;
     while (*entry) {
-        if ((*entry)->var_name && strcmp((*entry)->var_name, var_name) == 0) {
+        if ((*entry)->var_name == var_name) {
             ConstantEntry *to_remove = *entry;
             *entry = (*entry)->next;
-            free(to_remove->var_name);
             free(to_remove);
             return;
         }
@@ -798,35 +904,6 @@ void remove_var_constant(ConstantTable *table, const char *var_name) {
     }
 }
 
-void remove_instruction(IRGenerator *gen, IRInstruction *instr) {
-    // 这里需要实现从链表中移除指令的逻辑
-    // 简化实现，实际应该更完善
-    if (gen->instructions == instr) {
-        gen->instructions = instr->next;
-    } else {
-        IRInstruction *prev = gen->instructions;
-        while (prev && prev->next != instr) {
-            prev = prev->next;
-        }
-        if (prev) {
-            prev->next = instr->next;
-        }
-    }
-    
-    if (gen->last_instr == instr) {
-        gen->last_instr = gen->instructions;
-        while (gen->last_instr && gen->last_instr->next) {
-            gen->last_instr = gen->last_instr->next;
-        }
-    }
-    
-    // 释放指令
-    if (instr->result) free_operand(instr->result);
-    if (instr->operand1) free_operand(instr->operand1);
-    if (instr->operand2) free_operand(instr->operand2);
-    free(instr);
-}
-
 void print_optimization_stats(Optimizer *opt) {
     printf("Optimization Statistics:\n");
     printf("  Eliminated instructions: %d\n", opt->eliminated_instructions);
@@ -21,6 +21,7 @@ typedef struct {
     int eliminated_instructions;   // 消除的指令数
     int folded_constants;         // 折叠的常量数
     int propagated_constants;     // 传播的常量数
+    bool verbose;                 // 打印优化过程和统计信息
 } Optimizer;
 
 // 常量值结构
@@ -36,7 +37,7 @@ typedef struct {
 // 常量表项
 typedef struct ConstantEntry {
     int temp_id;
-    char *var_name;
+    const char *var_name;       // 驻留的变量名，按指针比较
     ConstantValue constant;
     struct ConstantEntry *next;
 } ConstantEntry;
@@ -64,6 +65,7 @@ void common_subexpression_elimination(Optimizer *opt);
 // 常量表管理
 ConstantTable* init_constant_table();
 void free_constant_table(ConstantTable *table);
+void clear_constant_table(ConstantTable *table);    // 删除全部表项，表本身保留
 void add_constant(ConstantTable *table, int temp_id, ConstantValue value);
 void add_var_constant(ConstantTable *table, const char *var_name, ConstantValue value);
 ConstantValue* lookup_temp_constant(ConstantTable *table, int temp_id);
@@ -75,8 +77,8 @@ void remove_var_constant(ConstantTable *table, const char *var_name);
 ConstantValue create_int_constant(int value);
 ConstantValue create_float_constant(float value);
 ConstantValue create_unknown_constant();
-bool is_constant_operand(Operand *operand, ConstantTable *table);
-ConstantValue get_operand_constant(Operand *operand, ConstantTable *table);
+bool is_constant_operand(const Operand *operand, ConstantTable *table);
+ConstantValue get_operand_constant(const Operand *operand, ConstantTable *table);
 
 // 常量运算
 ConstantValue evaluate_binop(BinOpType op, ConstantValue left, ConstantValue right);
@@ -94,11 +96,6 @@ bool has_side_effects(IRInstruction *instr);
 bool is_temp_used(int temp_id, IRInstruction *start_instr);
 bool is_var_used(const char *var_name, IRInstruction *start_instr);
 
-// 指令操作
-void remove_instruction(IRGenerator *gen, IRInstruction *instr);
-IRInstruction* get_previous_instruction(IRGenerator *gen, IRInstruction *instr);
-void replace_operand_in_instruction(IRInstruction *instr, Operand *old_operand, Operand *new_operand);
-
 // 优化统计和报告
 void print_optimization_stats(Optimizer *opt);
 void set_optimization_level(Optimizer *opt, int level);
@@ -106,8 +103,7 @@ void enable_optimization(Optimizer *opt, OptimizationType type);
 void disable_optimization(Optimizer *opt, OptimizationType type);
 
 // 辅助函数
-bool operands_equal(Operand *op1, Operand *op2);
-Operand* copy_operand(Operand *operand);
+bool operands_equal(const Operand *op1, const Operand *op2);
 bool is_comparison_op(BinOpType op);
 bool is_commutative_op(BinOpType op);
 
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -60,147 +63,191 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
 
 
-/* Copy the first part of user declarations.  */
 
-/* Line 189 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "parser.y"
 
 #include "ast.h"
-#include "semantic.h"
-#include "ir.h"
-#include "optimize.h"
-#include "codegen.h"
-#include "interpreter.h"
+#include "driver.h"
+#include "bench.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
-extern FILE *yyin;
-extern int yylineno;
-extern int yycolumn;
-void yyerror(const char *s);
-int yylex(void);
-
-ASTNode *root = NULL;
-SemanticContext *semantic_context = NULL;
-IRGenerator *ir_generator = NULL;
-Optimizer *optimizer = NULL;
-CodeGenerator *code_generator = NULL;
-Interpreter *interpreter = NULL;
-
-
-/* Line 189 of yacc.c  */
-#line 99 "parser.tab.c"
-
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INT = 258,
-     FLOAT = 259,
-     RETURN = 260,
-     IF = 261,
-     ELSE = 262,
-     WHILE = 263,
-     PRINTF = 264,
-     INTEGER = 265,
-     FLOATING = 266,
-     IDENTIFIER = 267,
-     STRING = 268,
-     EQ = 269,
-     NE = 270,
-     LE = 271,
-     GE = 272,
-     LOWER_THAN_ELSE = 273
-   };
-#endif
+// 用规则的起始位置（第一个记号）标记新建的AST节点
+#define LOCATE(node, loc) set_ast_location(ctx->ast, (node), (loc).first_line, (loc).first_column)
+// 把节点追加到当前语句列表或参数列表
+#define PUSH(node) do { if (!push_node_list(ctx->ast, (node))) YYNOMEM; } while (0)
+// 驻留记号切片的文本：相同的名称得到相同的指针，之后各阶段不再复制名称
+#define TOKEN_NAME(slice) intern_name(ctx->names, ctx->source->data + (slice).offset, (size_t)(slice).length)
 
+#line 89 "parser.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT = 3,                        /* INT  */
+  YYSYMBOL_FLOAT = 4,                      /* FLOAT  */
+  YYSYMBOL_RETURN = 5,                     /* RETURN  */
+  YYSYMBOL_IF = 6,                         /* IF  */
+  YYSYMBOL_ELSE = 7,                       /* ELSE  */
+  YYSYMBOL_WHILE = 8,                      /* WHILE  */
+  YYSYMBOL_PRINTF = 9,                     /* PRINTF  */
+  YYSYMBOL_INTEGER = 10,                   /* INTEGER  */
+  YYSYMBOL_FLOATING = 11,                  /* FLOATING  */
+  YYSYMBOL_IDENTIFIER = 12,                /* IDENTIFIER  */
+  YYSYMBOL_STRING = 13,                    /* STRING  */
+  YYSYMBOL_EQ = 14,                        /* EQ  */
+  YYSYMBOL_NE = 15,                        /* NE  */
+  YYSYMBOL_16_ = 16,                       /* '<'  */
+  YYSYMBOL_17_ = 17,                       /* '>'  */
+  YYSYMBOL_LE = 18,                        /* LE  */
+  YYSYMBOL_GE = 19,                        /* GE  */
+  YYSYMBOL_LOWER_THAN_ELSE = 20,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_21_ = 21,                       /* '+'  */
+  YYSYMBOL_22_ = 22,                       /* '-'  */
+  YYSYMBOL_23_ = 23,                       /* '*'  */
+  YYSYMBOL_24_ = 24,                       /* '/'  */
+  YYSYMBOL_25_ = 25,                       /* '('  */
+  YYSYMBOL_26_ = 26,                       /* ')'  */
+  YYSYMBOL_27_ = 27,                       /* '{'  */
+  YYSYMBOL_28_ = 28,                       /* '}'  */
+  YYSYMBOL_29_ = 29,                       /* ';'  */
+  YYSYMBOL_30_ = 30,                       /* '='  */
+  YYSYMBOL_31_ = 31,                       /* ','  */
+  YYSYMBOL_YYACCEPT = 32,                  /* $accept  */
+  YYSYMBOL_program = 33,                   /* program  */
+  YYSYMBOL_func_def = 34,                  /* func_def  */
+  YYSYMBOL_stmt_list = 35,                 /* stmt_list  */
+  YYSYMBOL_stmt = 36,                      /* stmt  */
+  YYSYMBOL_decl = 37,                      /* decl  */
+  YYSYMBOL_assignment = 38,                /* assignment  */
+  YYSYMBOL_if_stmt = 39,                   /* if_stmt  */
+  YYSYMBOL_while_stmt = 40,                /* while_stmt  */
+  YYSYMBOL_expr = 41,                      /* expr  */
+  YYSYMBOL_call_stmt = 42,                 /* call_stmt  */
+  YYSYMBOL_arg_list = 43                   /* arg_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Line 214 of yacc.c  */
-#line 26 "parser.y"
-
-    int num;
-    float fnum;
-    char *str;
-    ASTNode *node;
 
 
 
-/* Line 214 of yacc.c  */
-#line 162 "parser.tab.c"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
-
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 264 of yacc.c  */
-#line 174 "parser.tab.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -208,55 +255,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -273,11 +371,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -285,8 +383,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -300,88 +398,92 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
-      + YYSTACK_GAP_MAXIMUM)
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  5
 /* YYLAST -- Last index in YYTABLE.  */
@@ -393,18 +495,23 @@ union yyalloc
 #define YYNNTS  12
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  41
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  87
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   273
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -437,120 +544,57 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     5,    13,    16,    18,    21,    24,    27,
-      29,    31,    34,    38,    42,    45,    50,    53,    58,    62,
-      68,    76,    82,    86,    90,    94,    98,   102,   106,   110,
-     114,   118,   122,   124,   126,   128,   132,   137,   139,   141,
-     145,   149
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      33,     0,    -1,    34,    -1,     3,    12,    25,    26,    27,
-      35,    28,    -1,    35,    36,    -1,    36,    -1,    37,    29,
-      -1,    38,    29,    -1,    41,    29,    -1,    39,    -1,    40,
-      -1,    42,    29,    -1,     5,    41,    29,    -1,    27,    35,
-      28,    -1,     3,    12,    -1,     3,    12,    30,    41,    -1,
-       4,    12,    -1,     4,    12,    30,    41,    -1,    12,    30,
-      41,    -1,     6,    25,    41,    26,    36,    -1,     6,    25,
-      41,    26,    36,     7,    36,    -1,     8,    25,    41,    26,
-      36,    -1,    41,    21,    41,    -1,    41,    22,    41,    -1,
-      41,    23,    41,    -1,    41,    24,    41,    -1,    41,    14,
-      41,    -1,    41,    15,    41,    -1,    41,    16,    41,    -1,
-      41,    17,    41,    -1,    41,    18,    41,    -1,    41,    19,
-      41,    -1,    12,    -1,    10,    -1,    11,    -1,    25,    41,
-      26,    -1,     9,    25,    43,    26,    -1,    13,    -1,    41,
-      -1,    43,    31,    13,    -1,    43,    31,    41,    -1,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    50,    50,   114,   118,   119,   121,   122,   123,   124,
-     125,   126,   127,   128,   130,   131,   132,   133,   135,   137,
-     138,   140,   142,   143,   144,   145,   146,   147,   148,   149,
-     150,   151,   152,   153,   154,   155,   157,   190,   191,   192,
-     193,   194
+       0,    74,    74,    78,    86,    87,    89,    90,    91,    92,
+      93,    94,    95,    96,    98,    99,   100,   101,   103,   105,
+     106,   108,   110,   111,   112,   113,   114,   115,   116,   117,
+     118,   119,   120,   121,   122,   123,   125,   130,   131,   132,
+     133,   134
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INT", "FLOAT", "RETURN", "IF", "ELSE",
-  "WHILE", "PRINTF", "INTEGER", "FLOATING", "IDENTIFIER", "STRING", "EQ",
-  "NE", "'<'", "'>'", "LE", "GE", "LOWER_THAN_ELSE", "'+'", "'-'", "'*'",
-  "'/'", "'('", "')'", "'{'", "'}'", "';'", "'='", "','", "$accept",
-  "program", "func_def", "stmt_list", "stmt", "decl", "assignment",
-  "if_stmt", "while_stmt", "expr", "call_stmt", "arg_list", 0
+  "\"end of file\"", "error", "\"invalid token\"", "INT", "FLOAT",
+  "RETURN", "IF", "ELSE", "WHILE", "PRINTF", "INTEGER", "FLOATING",
+  "IDENTIFIER", "STRING", "EQ", "NE", "'<'", "'>'", "LE", "GE",
+  "LOWER_THAN_ELSE", "'+'", "'-'", "'*'", "'/'", "'('", "')'", "'{'",
+  "'}'", "';'", "'='", "','", "$accept", "program", "func_def",
+  "stmt_list", "stmt", "decl", "assignment", "if_stmt", "while_stmt",
+  "expr", "call_stmt", "arg_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,    60,    62,   271,   272,
-     273,    43,    45,    42,    47,    40,    41,   123,   125,    59,
-      61,    44
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    32,    33,    34,    35,    35,    36,    36,    36,    36,
-      36,    36,    36,    36,    37,    37,    37,    37,    38,    39,
-      39,    40,    41,    41,    41,    41,    41,    41,    41,    41,
-      41,    41,    41,    41,    41,    41,    42,    43,    43,    43,
-      43,    43
-};
+#define YYPACT_NINF (-20)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     7,     2,     1,     2,     2,     2,     1,
-       1,     2,     3,     3,     2,     4,     2,     4,     3,     5,
-       7,     5,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     1,     1,     1,     3,     4,     1,     1,     3,
-       3,     0
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     2,     0,     1,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    33,    34,    32,     0,     0,
-       0,     5,     0,     0,     9,    10,     0,     0,    14,    16,
-      32,     0,     0,     0,    41,     0,     0,     0,     3,     4,
-       6,     7,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     8,    11,     0,     0,    12,     0,     0,    37,
-      38,     0,    18,    35,    13,    26,    27,    28,    29,    30,
-      31,    22,    23,    24,    25,    15,    17,     0,     0,    36,
-       0,    19,    21,    39,    40,     0,    20
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     2,     3,    20,    21,    22,    23,    24,    25,    26,
-      27,    61
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -20
 static const yytype_int16 yypact[] =
 {
       -1,     1,    26,   -20,     5,   -20,    15,    29,    69,    30,
@@ -564,6 +608,22 @@ static const yytype_int16 yypact[] =
       51,   122,   -20,   -20,   143,    69,   -20
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     2,     0,     1,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    33,    34,    32,     0,     0,
+       0,     5,     0,     0,     9,    10,     0,     0,    14,    16,
+      32,     0,     0,     0,    41,     0,     0,     0,     3,     4,
+       6,     7,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     8,    11,     0,     0,    12,     0,     0,    37,
+      38,     0,    18,    35,    13,    26,    27,    28,    29,    30,
+      31,    22,    23,    24,    25,    15,    17,     0,     0,    36,
+       0,    19,    21,    39,    40,     0,    20
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
@@ -571,12 +631,17 @@ static const yytype_int8 yypgoto[] =
      -20,   -20
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     2,     3,    20,    21,    22,    23,    24,    25,    26,
+      27,    61
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       31,    39,     1,     9,    10,    11,    12,    36,    13,    14,
       15,    16,    17,     4,    15,    16,    30,    59,    39,    50,
@@ -620,9 +685,9 @@ static const yytype_int8 yycheck[] =
       18,    19,    -1,    21,    22,    23,    24
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,    33,    34,    12,     0,    25,    26,    27,     3,
        4,     5,     6,     8,     9,    10,    11,    12,    25,    27,
@@ -635,95 +700,87 @@ static const yytype_uint8 yystos[] =
       31,    36,    36,    13,    41,     7,    36
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    32,    33,    34,    35,    35,    36,    36,    36,    36,
+      36,    36,    36,    36,    37,    37,    37,    37,    38,    39,
+      39,    40,    41,    41,    41,    41,    41,    41,    41,    41,
+      41,    41,    41,    41,    41,    41,    42,    43,    43,    43,
+      43,    43
+};
 
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     7,     2,     1,     2,     2,     2,     1,
+       1,     2,     3,     3,     2,     4,     2,     4,     3,     5,
+       7,     5,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     1,     1,     1,     3,     4,     1,     1,     3,
+       3,     0
+};
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
 
-#define YYFAIL		goto yyerrlab
+enum { YYENOMEM = -2 };
 
-#define YYRECOVERING()  (!!yyerrstatus)
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
-#define YYTERROR	1
-#define YYERRCODE	256
+#define YYRECOVERING()  (!!yyerrstatus)
 
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, scanner, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
 
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
 #endif
 
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -733,80 +790,120 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  if (!yyvaluep)
-    return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
     {
-      default:
-	break;
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
     }
+  return res;
 }
 
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, scanner, ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, struct CompilerContext *ctx)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (ctx);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, struct CompilerContext *ctx)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -814,16 +911,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -834,63 +923,57 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, yyscan_t scanner, struct CompilerContext *ctx)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner, ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, ctx); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -905,476 +988,252 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, yyscan_t scanner, struct CompilerContext *ctx)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
+/*----------.
+| yyparse.  |
+`----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
+yyparse (yyscan_t scanner, struct CompilerContext *ctx)
 {
+/* Lookahead token kind.  */
+int yychar;
 
 
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    YYSIZE_T yystacksize;
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
+  YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
+  yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1389,8 +1248,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -1402,13 +1261,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1423,14 +1283,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1439,478 +1299,332 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
-#line 50 "parser.y"
-    { 
-            root = (yyvsp[(1) - (1)].node); 
-            printf("Syntax analysis successful!\n");
-            print_ast(root, 0);
-            export_ast_to_dot(root, "ast.dot");
-            
-            // system("dot -Tpng -Gcharset=latin1 ast.dot -o ast.png"); 
-            printf("AST DOT file generated: ast.dot\n");
-            
-            semantic_context = init_semantic();
-            if (semantic_context) {
-                bool sem_ok = analyze_semantics(root, semantic_context);
-                if (sem_ok) {
-                    printf("Semantic analysis passed!\n");
-                    
-                    printf("\n=== INTERMEDIATE CODE GENERATION ===\n");
-                    ir_generator = init_ir_generator(semantic_context->symbol_table);
-                    if (ir_generator) {
-                        generate_ir(root, ir_generator);
-                        print_ir(ir_generator);
-                        
-                        printf("\n=== CODE OPTIMIZATION ===\n");
-                        optimizer = init_optimizer(ir_generator, 2);
-                        if (optimizer) {
-                            optimize_ir(optimizer);
-                            printf("Optimized intermediate code:\n");
-                            print_ir(ir_generator);
-                            
-                            printf("\n=== TARGET CODE GENERATION ===\n");
-                            
-                            code_generator = init_code_generator(TARGET_PSEUDO, "output.s");
-                            if (code_generator) {
-                                generate_target_code(ir_generator, code_generator);
-                                printf("Pseudo assembly code generated: output.s\n");
-                                free_code_generator(code_generator);
-                            }
-                            
-                            code_generator = init_code_generator(TARGET_C_CODE, "output.c");
-                            if (code_generator) {
-                                generate_target_code(ir_generator, code_generator);
-                                printf("C code generated: output.c\n");
-                                free_code_generator(code_generator);
-                            }
-
-                            
-                            // ���ӽ�����ִ��
-                            printf("\n=== PROGRAM INTERPRETATION ===\n");
-                            interpreter = init_interpreter();
-                            if (interpreter) {
-                                execute_ir(interpreter, ir_generator);
-                                free_interpreter(interpreter);
-                            }
-                            
-                            free_optimizer(optimizer);
-                        }
-                        
-                        free_ir_generator(ir_generator);
-                    }
-                } else {
-                    printf("Semantic analysis failed!\n");
-                }
-            }
-          ;}
+  case 2: /* program: func_def  */
+#line 74 "parser.y"
+                   { 
+            ctx->root = (yyvsp[0].node); 
+          }
+#line 1314 "parser.tab.c"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
-#line 114 "parser.y"
-    {
-            (yyval.node) = create_func_def("int", (yyvsp[(2) - (7)].str), (yyvsp[(6) - (7)].node));
-          ;}
+  case 3: /* func_def: INT IDENTIFIER '(' ')' '{' stmt_list '}'  */
+#line 78 "parser.y"
+                                                    {
+            NodeId body = create_block(ctx->ast, (yyvsp[-1].list));
+            LOCATE(body, (yylsp[-2]));
+            (yyval.node) = create_func_def(ctx->ast, "int", TOKEN_NAME((yyvsp[-5].slice)), body);
+            LOCATE((yyval.node), (yyloc));
+          }
+#line 1325 "parser.tab.c"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
-#line 118 "parser.y"
-    { (yyval.node) = create_compound_stmt((yyvsp[(1) - (2)].node), (yyvsp[(2) - (2)].node)); ;}
+  case 4: /* stmt_list: stmt_list stmt  */
+#line 86 "parser.y"
+                           { (yyval.list) = (yyvsp[-1].list); PUSH((yyvsp[0].node)); }
+#line 1331 "parser.tab.c"
     break;
 
-  case 5:
-
-/* Line 1455 of yacc.c  */
-#line 119 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); ;}
+  case 5: /* stmt_list: stmt  */
+#line 87 "parser.y"
+                          { (yyval.list) = begin_node_list(ctx->ast); PUSH((yyvsp[0].node)); }
+#line 1337 "parser.tab.c"
     break;
 
-  case 6:
-
-/* Line 1455 of yacc.c  */
-#line 121 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (2)].node); ;}
+  case 6: /* stmt: decl ';'  */
+#line 89 "parser.y"
+                        { (yyval.node) = (yyvsp[-1].node); }
+#line 1343 "parser.tab.c"
     break;
 
-  case 7:
-
-/* Line 1455 of yacc.c  */
-#line 122 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (2)].node); ;}
+  case 7: /* stmt: assignment ';'  */
+#line 90 "parser.y"
+                        { (yyval.node) = (yyvsp[-1].node); }
+#line 1349 "parser.tab.c"
     break;
 
-  case 8:
-
-/* Line 1455 of yacc.c  */
-#line 123 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (2)].node); ;}
+  case 8: /* stmt: expr ';'  */
+#line 91 "parser.y"
+                        { (yyval.node) = (yyvsp[-1].node); }
+#line 1355 "parser.tab.c"
     break;
 
-  case 9:
-
-/* Line 1455 of yacc.c  */
-#line 124 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); ;}
+  case 9: /* stmt: if_stmt  */
+#line 92 "parser.y"
+                        { (yyval.node) = (yyvsp[0].node); }
+#line 1361 "parser.tab.c"
     break;
 
-  case 10:
-
-/* Line 1455 of yacc.c  */
-#line 125 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); ;}
+  case 10: /* stmt: while_stmt  */
+#line 93 "parser.y"
+                        { (yyval.node) = (yyvsp[0].node); }
+#line 1367 "parser.tab.c"
     break;
 
-  case 11:
-
-/* Line 1455 of yacc.c  */
-#line 126 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (2)].node); ;}
+  case 11: /* stmt: call_stmt ';'  */
+#line 94 "parser.y"
+                        { (yyval.node) = (yyvsp[-1].node); }
+#line 1373 "parser.tab.c"
     break;
 
-  case 12:
-
-/* Line 1455 of yacc.c  */
-#line 127 "parser.y"
-    { (yyval.node) = create_return_stmt((yyvsp[(2) - (3)].node)); ;}
+  case 12: /* stmt: RETURN expr ';'  */
+#line 95 "parser.y"
+                        { (yyval.node) = create_return_stmt(ctx->ast, (yyvsp[-1].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1379 "parser.tab.c"
     break;
 
-  case 13:
-
-/* Line 1455 of yacc.c  */
-#line 128 "parser.y"
-    { (yyval.node) = (yyvsp[(2) - (3)].node); ;}
+  case 13: /* stmt: '{' stmt_list '}'  */
+#line 96 "parser.y"
+                         { (yyval.node) = create_block(ctx->ast, (yyvsp[-1].list)); LOCATE((yyval.node), (yyloc)); }
+#line 1385 "parser.tab.c"
     break;
 
-  case 14:
-
-/* Line 1455 of yacc.c  */
-#line 130 "parser.y"
-    { (yyval.node) = create_decl("int", (yyvsp[(2) - (2)].str)); ;}
+  case 14: /* decl: INT IDENTIFIER  */
+#line 98 "parser.y"
+                           { (yyval.node) = create_decl(ctx->ast, "int", TOKEN_NAME((yyvsp[0].slice))); LOCATE((yyval.node), (yyloc)); }
+#line 1391 "parser.tab.c"
     break;
 
-  case 15:
-
-/* Line 1455 of yacc.c  */
-#line 131 "parser.y"
-    { (yyval.node) = create_decl_assign("int", (yyvsp[(2) - (4)].str), (yyvsp[(4) - (4)].node)); ;}
+  case 15: /* decl: INT IDENTIFIER '=' expr  */
+#line 99 "parser.y"
+                               { (yyval.node) = create_decl_assign(ctx->ast, "int", TOKEN_NAME((yyvsp[-2].slice)), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1397 "parser.tab.c"
     break;
 
-  case 16:
-
-/* Line 1455 of yacc.c  */
-#line 132 "parser.y"
-    { (yyval.node) = create_decl("float", (yyvsp[(2) - (2)].str)); ;}
+  case 16: /* decl: FLOAT IDENTIFIER  */
+#line 100 "parser.y"
+                           { (yyval.node) = create_decl(ctx->ast, "float", TOKEN_NAME((yyvsp[0].slice))); LOCATE((yyval.node), (yyloc)); }
+#line 1403 "parser.tab.c"
     break;
 
-  case 17:
-
-/* Line 1455 of yacc.c  */
-#line 133 "parser.y"
-    { (yyval.node) = create_decl_assign("float", (yyvsp[(2) - (4)].str), (yyvsp[(4) - (4)].node)); ;}
+  case 17: /* decl: FLOAT IDENTIFIER '=' expr  */
+#line 101 "parser.y"
+                                 { (yyval.node) = create_decl_assign(ctx->ast, "float", TOKEN_NAME((yyvsp[-2].slice)), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1409 "parser.tab.c"
     break;
 
-  case 18:
-
-/* Line 1455 of yacc.c  */
-#line 135 "parser.y"
-    { (yyval.node) = create_assign((yyvsp[(1) - (3)].str), (yyvsp[(3) - (3)].node)); ;}
+  case 18: /* assignment: IDENTIFIER '=' expr  */
+#line 103 "parser.y"
+                                 { (yyval.node) = create_assign(ctx->ast, TOKEN_NAME((yyvsp[-2].slice)), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1415 "parser.tab.c"
     break;
 
-  case 19:
-
-/* Line 1455 of yacc.c  */
-#line 137 "parser.y"
-    { (yyval.node) = create_if((yyvsp[(3) - (5)].node), (yyvsp[(5) - (5)].node), NULL); ;}
+  case 19: /* if_stmt: IF '(' expr ')' stmt  */
+#line 105 "parser.y"
+                                                     { (yyval.node) = create_if(ctx->ast, (yyvsp[-2].node), (yyvsp[0].node), AST_NONE); LOCATE((yyval.node), (yyloc)); }
+#line 1421 "parser.tab.c"
     break;
 
-  case 20:
-
-/* Line 1455 of yacc.c  */
-#line 138 "parser.y"
-    { (yyval.node) = create_if((yyvsp[(3) - (7)].node), (yyvsp[(5) - (7)].node), (yyvsp[(7) - (7)].node)); ;}
+  case 20: /* if_stmt: IF '(' expr ')' stmt ELSE stmt  */
+#line 106 "parser.y"
+                                         { (yyval.node) = create_if(ctx->ast, (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1427 "parser.tab.c"
     break;
 
-  case 21:
-
-/* Line 1455 of yacc.c  */
-#line 140 "parser.y"
-    { (yyval.node) = create_while((yyvsp[(3) - (5)].node), (yyvsp[(5) - (5)].node)); ;}
+  case 21: /* while_stmt: WHILE '(' expr ')' stmt  */
+#line 108 "parser.y"
+                                     { (yyval.node) = create_while(ctx->ast, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1433 "parser.tab.c"
     break;
 
-  case 22:
-
-/* Line 1455 of yacc.c  */
-#line 142 "parser.y"
-    { (yyval.node) = create_binop(OP_ADD, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 22: /* expr: expr '+' expr  */
+#line 110 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_ADD, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1439 "parser.tab.c"
     break;
 
-  case 23:
-
-/* Line 1455 of yacc.c  */
-#line 143 "parser.y"
-    { (yyval.node) = create_binop(OP_SUB, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 23: /* expr: expr '-' expr  */
+#line 111 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_SUB, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1445 "parser.tab.c"
     break;
 
-  case 24:
-
-/* Line 1455 of yacc.c  */
-#line 144 "parser.y"
-    { (yyval.node) = create_binop(OP_MUL, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 24: /* expr: expr '*' expr  */
+#line 112 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_MUL, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1451 "parser.tab.c"
     break;
 
-  case 25:
-
-/* Line 1455 of yacc.c  */
-#line 145 "parser.y"
-    { (yyval.node) = create_binop(OP_DIV, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 25: /* expr: expr '/' expr  */
+#line 113 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_DIV, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1457 "parser.tab.c"
     break;
 
-  case 26:
-
-/* Line 1455 of yacc.c  */
-#line 146 "parser.y"
-    { (yyval.node) = create_binop(OP_EQ, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 26: /* expr: expr EQ expr  */
+#line 114 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_EQ, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1463 "parser.tab.c"
     break;
 
-  case 27:
-
-/* Line 1455 of yacc.c  */
-#line 147 "parser.y"
-    { (yyval.node) = create_binop(OP_NE, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 27: /* expr: expr NE expr  */
+#line 115 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_NE, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1469 "parser.tab.c"
     break;
 
-  case 28:
-
-/* Line 1455 of yacc.c  */
-#line 148 "parser.y"
-    { (yyval.node) = create_binop(OP_LT, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 28: /* expr: expr '<' expr  */
+#line 116 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_LT, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1475 "parser.tab.c"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
-#line 149 "parser.y"
-    { (yyval.node) = create_binop(OP_GT, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 29: /* expr: expr '>' expr  */
+#line 117 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_GT, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1481 "parser.tab.c"
     break;
 
-  case 30:
-
-/* Line 1455 of yacc.c  */
-#line 150 "parser.y"
-    { (yyval.node) = create_binop(OP_LE, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 30: /* expr: expr LE expr  */
+#line 118 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_LE, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1487 "parser.tab.c"
     break;
 
-  case 31:
-
-/* Line 1455 of yacc.c  */
-#line 151 "parser.y"
-    { (yyval.node) = create_binop(OP_GE, (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 31: /* expr: expr GE expr  */
+#line 119 "parser.y"
+                      { (yyval.node) = create_binop(ctx->ast, OP_GE, (yyvsp[-2].node), (yyvsp[0].node)); LOCATE((yyval.node), (yyloc)); }
+#line 1493 "parser.tab.c"
     break;
 
-  case 32:
-
-/* Line 1455 of yacc.c  */
-#line 152 "parser.y"
-    { (yyval.node) = create_var((yyvsp[(1) - (1)].str)); ;}
+  case 32: /* expr: IDENTIFIER  */
+#line 120 "parser.y"
+                     { (yyval.node) = create_var(ctx->ast, TOKEN_NAME((yyvsp[0].slice))); LOCATE((yyval.node), (yyloc)); }
+#line 1499 "parser.tab.c"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
-#line 153 "parser.y"
-    { (yyval.node) = create_int((yyvsp[(1) - (1)].num)); ;}
+  case 33: /* expr: INTEGER  */
+#line 121 "parser.y"
+                     { (yyval.node) = create_int(ctx->ast, (yyvsp[0].num)); LOCATE((yyval.node), (yyloc)); }
+#line 1505 "parser.tab.c"
     break;
 
-  case 34:
-
-/* Line 1455 of yacc.c  */
-#line 154 "parser.y"
-    { (yyval.node) = create_float((yyvsp[(1) - (1)].fnum)); ;}
+  case 34: /* expr: FLOATING  */
+#line 122 "parser.y"
+                     { (yyval.node) = create_float(ctx->ast, (yyvsp[0].fnum)); LOCATE((yyval.node), (yyloc)); }
+#line 1511 "parser.tab.c"
     break;
 
-  case 35:
-
-/* Line 1455 of yacc.c  */
-#line 155 "parser.y"
-    { (yyval.node) = (yyvsp[(2) - (3)].node); ;}
+  case 35: /* expr: '(' expr ')'  */
+#line 123 "parser.y"
+                     { (yyval.node) = (yyvsp[-1].node); }
+#line 1517 "parser.tab.c"
     break;
 
-  case 36:
-
-/* Line 1455 of yacc.c  */
-#line 157 "parser.y"
-    { 
-            // �����������
-            int arg_count = 0;
-            ASTNode *curr = (yyvsp[(3) - (4)].node);
-            while (curr) {
-                arg_count++;
-                if (curr->type == STMT_COMPOUND) {
-                    curr = curr->right;
-                } else {
-                    break;
-                }
-            }
-            
-            // ������������
-            ASTNode **args = NULL;
-            if (arg_count > 0) {
-                args = malloc(sizeof(ASTNode*) * arg_count);
-                curr = (yyvsp[(3) - (4)].node);
-                for (int i = 0; i < arg_count; i++) {
-                    if (curr->type == STMT_COMPOUND) {
-                        args[i] = curr->left;
-                        curr = curr->right;
-                    } else {
-                        args[i] = curr;
-                        break;
-                    }
-                }
-            }
-            
-            (yyval.node) = create_call("printf", args, arg_count); 
-            set_ast_location((yyval.node), yylineno, yycolumn);
-          ;}
+  case 36: /* call_stmt: PRINTF '(' arg_list ')'  */
+#line 125 "parser.y"
+                                    { 
+            (yyval.node) = create_call(ctx->ast, intern_cstr(ctx->names, "printf"), (yyvsp[-1].list)); 
+            LOCATE((yyval.node), (yyloc));
+          }
+#line 1526 "parser.tab.c"
     break;
 
-  case 37:
-
-/* Line 1455 of yacc.c  */
-#line 190 "parser.y"
-    { (yyval.node) = create_var((yyvsp[(1) - (1)].str)); ;}
+  case 37: /* arg_list: STRING  */
+#line 130 "parser.y"
+                            { (yyval.list) = begin_node_list(ctx->ast); NodeId arg = create_var(ctx->ast, TOKEN_NAME((yyvsp[0].slice))); LOCATE(arg, (yylsp[0])); PUSH(arg); }
+#line 1532 "parser.tab.c"
     break;
 
-  case 38:
-
-/* Line 1455 of yacc.c  */
-#line 191 "parser.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); ;}
+  case 38: /* arg_list: expr  */
+#line 131 "parser.y"
+                            { (yyval.list) = begin_node_list(ctx->ast); PUSH((yyvsp[0].node)); }
+#line 1538 "parser.tab.c"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
-#line 192 "parser.y"
-    { (yyval.node) = create_compound_stmt((yyvsp[(1) - (3)].node), create_var((yyvsp[(3) - (3)].str))); ;}
+  case 39: /* arg_list: arg_list ',' STRING  */
+#line 132 "parser.y"
+                               { (yyval.list) = (yyvsp[-2].list); NodeId arg = create_var(ctx->ast, TOKEN_NAME((yyvsp[0].slice))); LOCATE(arg, (yylsp[0])); PUSH(arg); }
+#line 1544 "parser.tab.c"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
-#line 193 "parser.y"
-    { (yyval.node) = create_compound_stmt((yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node)); ;}
+  case 40: /* arg_list: arg_list ',' expr  */
+#line 133 "parser.y"
+                             { (yyval.list) = (yyvsp[-2].list); PUSH((yyvsp[0].node)); }
+#line 1550 "parser.tab.c"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
-#line 194 "parser.y"
-    { (yyval.node) = NULL; ;}
+  case 41: /* arg_list: %empty  */
+#line 134 "parser.y"
+                             { (yyval.list) = begin_node_list(ctx->ast); }
+#line 1556 "parser.tab.c"
     break;
 
 
+#line 1560 "parser.tab.c"
 
-/* Line 1455 of yacc.c  */
-#line 1825 "parser.tab.c"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
+  *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
+      yyerror (&yylloc, scanner, ctx, YY_("syntax error"));
     }
 
-
-
+  yyerror_range[1] = yylloc;
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, scanner, ctx);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -1922,14 +1636,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1942,39 +1655,45 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
-
+        YYABORT;
 
+      yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1985,90 +1704,247 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, scanner, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, scanner, ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+
+  return yyresult;
 }
 
+#line 136 "parser.y"
 
 
-/* Line 1675 of yacc.c  */
-#line 196 "parser.y"
+void yyerror(YYLTYPE *loc, yyscan_t scanner, struct CompilerContext *ctx, const char *s) {
+    (void)scanner;
+    ctx->syntax_errors++;
+    fprintf(stderr, "Syntax Error at line %d, column %d: %s\n", loc->first_line, loc->first_column, s);
+}
 
+// 目录或@列表文件
+static bool is_batch_input(const char *input) {
+    struct stat st;
+    return input[0] == '@' || (stat(input, &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR);
+}
 
-void yyerror(const char *s) {
-    fprintf(stderr, "Syntax Error at line %d, column %d: %s\n", yylineno, yycolumn, s);
+// 解析--emit=的值：逗号分隔的c、pseudo、bytecode
+static bool parse_emit_list(const char *list, unsigned *emit) {
+    while (*list) {
+        size_t len = strcspn(list, ",");
+        if (len == 1 && strncmp(list, "c", len) == 0) {
+            *emit |= EMIT_C;
+        } else if (len == 6 && strncmp(list, "pseudo", len) == 0) {
+            *emit |= EMIT_PSEUDO;
+        } else if (len == 8 && strncmp(list, "bytecode", len) == 0) {
+            *emit |= EMIT_BYTECODE;
+        } else {
+            fprintf(stderr, "Unknown --emit target: %.*s\n", (int)len, list);
+            return false;
+        }
+        list += len;
+        if (*list == ',') list++;
+    }
+    return true;
 }
 
 int main(int argc, char **argv) {
-    if (argc > 1) {
-        fopen_s(&yyin, argv[1], "r");
-        if (!yyin) {
-            perror("Cannot open file");
-            return 1;
+    // 解析选项：--bench=dispatch|fusion|jit|parallel|stages|ast|symtab|ir|ssa，--trace=<类别>[=<级别>],...，--trace-sink=text|ring[:N]，
+    // --profile[=<file>]，--jit，-j<N>/--jobs=<N>；输入为多个文件、目录或@<列表文件>时批量编译。
+    // 阶段选择：-fsyntax-only，--emit-ir，--dump-cfg，--dump-ssa，--emit=c|pseudo|bytecode，--dump-ast=dot，--run，-O0..-O3，-ftime-report；
+    // 给出任何一个阶段选择选项（-O和-ftime-report除外）时不再打印各阶段结果，只运行和生成所选的部分
+    CompilerOptions options;
+    init_compiler_options(&options);
+    bool select_stages = false;
+    bool run = false;
+    unsigned emit = 0;
+    const char **inputs = (const char**)malloc(sizeof(const char*) * (argc > 1 ? argc : 1));
+    int input_count = 0;
+    int jobs = 0;
+    init_trace();
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--trace=", 8) == 0) {
+            if (!trace_configure(argv[i] + 8)) return 1;
+        } else if (strncmp(argv[i], "--trace-sink=", 13) == 0) {
+            if (!trace_set_sink(argv[i] + 13)) return 1;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            options.jit_mode = true;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            options.profile_output = "profile.folded";
+        } else if (strncmp(argv[i], "--profile=", 10) == 0) {
+            options.profile_output = argv[i] + 10;
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0 || strncmp(argv[i], "-j", 2) == 0) {
+            jobs = atoi(argv[i] + (argv[i][1] == 'j' ? 2 : 7));
+        } else if (strncmp(argv[i], "--bench=", 8) == 0) {
+            options.bench_mode = argv[i] + 8;
+            if (strcmp(options.bench_mode, "dispatch") != 0 && strcmp(options.bench_mode, "fusion") != 0 &&
+                strcmp(options.bench_mode, "jit") != 0 && strcmp(options.bench_mode, "parallel") != 0 &&
+                strcmp(options.bench_mode, "stages") != 0 && strcmp(options.bench_mode, "ast") != 0 &&
+                strcmp(options.bench_mode, "symtab") != 0 && strcmp(options.bench_mode, "ir") != 0 &&
+                strcmp(options.bench_mode, "ssa") != 0) {
+                fprintf(stderr, "Unknown benchmark: %s\n", options.bench_mode);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-fsyntax-only") == 0) {
+            options.syntax_only = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--emit-ir") == 0) {
+            options.emit_ir = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--dump-cfg") == 0) {
+            options.dump_cfg = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--dump-ssa") == 0) {
+            options.dump_ssa = true;
+            select_stages = true;
+        } else if (strncmp(argv[i], "--emit=", 7) == 0) {
+            if (!parse_emit_list(argv[i] + 7, &emit)) return 1;
+            select_stages = true;
+        } else if (strncmp(argv[i], "--dump-ast=", 11) == 0) {
+            if (strcmp(argv[i] + 11, "dot") != 0) {
+                fprintf(stderr, "Unknown AST dump format: %s\n", argv[i] + 11);
+                return 1;
+            }
+            emit |= EMIT_AST_DOT;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--run") == 0) {
+            run = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "-ftime-report") == 0) {
+            options.time_report = true;
+        } else if (strncmp(argv[i], "-O", 2) == 0) {
+            if (argv[i][2] < '0' || argv[i][2] > '3' || argv[i][3] != '\0') {
+                fprintf(stderr, "Unknown optimization level: %s\n", argv[i]);
+                return 1;
+            }
+            options.opt_level = argv[i][2] - '0';
+        } else {
+            inputs[input_count++] = argv[i];
         }
     }
     
-    printf("=== COMPILER FRONTEND ===\n");
-    printf("Start compilation...\n");
-    
-    yyparse();
-    
-    if (root) {
-        free_ast(root);
-    }
-    
-    if (semantic_context) {
-        free_semantic(semantic_context);
+    if (select_stages) {
+        // 基准测试需要执行字节码
+        options.verbose = false;
+        options.execute = run || options.bench_mode != NULL;
+        options.emit = emit;
     }
-    
-    if (interpreter) {
-        free_interpreter(interpreter);
+
+    int status = 0;
+    if (options.bench_mode && strcmp(options.bench_mode, "stages") == 0) {
+        // 每跳过一个阶段节省的编译时间
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=stages requires one source file\n");
+            status = 1;
+        } else {
+            run_stage_benchmark(inputs[0], options.opt_level);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ast") == 0) {
+        // AST内存布局对比
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ast requires one source file\n");
+            status = 1;
+        } else {
+            run_ast_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ir") == 0) {
+        // IR指令的分配方式对比
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ir requires one source file\n");
+            status = 1;
+        } else {
+            run_ir_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ssa") == 0) {
+        // 控制流图、SSA构造和退出SSA的耗时
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ssa requires one source file\n");
+            status = 1;
+        } else {
+            run_ssa_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "symtab") == 0) {
+        // 符号表查找和作用域退出，不需要源文件
+        run_symtab_benchmark();
+    } else if (options.bench_mode && strcmp(options.bench_mode, "parallel") == 0) {
+        // 多线程编译吞吐量基准测试
+        if (input_count == 0) {
+            fprintf(stderr, "--bench=parallel requires a source file\n");
+            status = 1;
+        } else {
+            run_parallel_benchmark(inputs, input_count, jobs);
+        }
+    } else if (input_count > 1 || (input_count == 1 && is_batch_input(inputs[0]))) {
+        // 批量编译：多个文件、目录或@列表文件，每个文件生成以其文件名为前缀的产物，不执行
+        options.verbose = false;
+        options.execute = false;
+        status = compile_batch(inputs, input_count, &options, jobs) > 0;
+    } else if (input_count == 1 && strlen(inputs[0]) > 4 &&
+               strcmp(inputs[0] + strlen(inputs[0]) - 4, ".cbc") == 0) {
+        status = run_bytecode_file(inputs[0], &options);
+    } else {
+        if (options.verbose) {
+            printf("=== COMPILER FRONTEND ===\n");
+            printf("Start compilation...\n");
+        }
+        
+        CompilerContext *ctx = init_compiler_context(input_count ? inputs[0] : NULL, &options);
+        if (ctx) {
+            set_artifact_paths(ctx, NULL);
+            // 详细模式保持原来的行为：失败时也返回0
+            if (!compile_translation_unit(ctx) && !options.verbose) status = 1;
+            if (options.time_report) print_stage_times(ctx->stage_ns);
+            free_compiler_context(ctx);
+        }
+        
+        if (options.verbose) {
+            printf("\n=== COMPILATION COMPLETED ===\n");
+        }
+        fflush(stdout);
     }
     
-    if (argc > 1) fclose(yyin);
-    
-    printf("\n=== COMPILATION COMPLETED ===\n");
-    return 0;
+    free(inputs);
+    free_trace();
+    return status;
 }
-
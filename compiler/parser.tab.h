@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,60 +27,117 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INT = 258,
-     FLOAT = 259,
-     RETURN = 260,
-     IF = 261,
-     ELSE = 262,
-     WHILE = 263,
-     PRINTF = 264,
-     INTEGER = 265,
-     FLOATING = 266,
-     IDENTIFIER = 267,
-     STRING = 268,
-     EQ = 269,
-     NE = 270,
-     LE = 271,
-     GE = 272,
-     LOWER_THAN_ELSE = 273
-   };
+#ifndef YY_YY_PARSER_TAB_H_INCLUDED
+# define YY_YY_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 26 "parser.y"
+
+#include <stdio.h>
+#include "ast.h"
+#include "source.h"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+struct CompilerContext;
 
+#line 62 "parser.tab.h"
 
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT = 258,                     /* INT  */
+    FLOAT = 259,                   /* FLOAT  */
+    RETURN = 260,                  /* RETURN  */
+    IF = 261,                      /* IF  */
+    ELSE = 262,                    /* ELSE  */
+    WHILE = 263,                   /* WHILE  */
+    PRINTF = 264,                  /* PRINTF  */
+    INTEGER = 265,                 /* INTEGER  */
+    FLOATING = 266,                /* FLOATING  */
+    IDENTIFIER = 267,              /* IDENTIFIER  */
+    STRING = 268,                  /* STRING  */
+    EQ = 269,                      /* EQ  */
+    NE = 270,                      /* NE  */
+    LE = 271,                      /* LE  */
+    GE = 272,                      /* GE  */
+    LOWER_THAN_ELSE = 273          /* LOWER_THAN_ELSE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 1676 of yacc.c  */
-#line 26 "parser.y"
+#line 39 "parser.y"
 
     int num;
     float fnum;
-    char *str;
-    ASTNode *node;
+    SourceSlice slice;
+    NodeId node;
+    uint32_t list;      // 语句列表或参数列表在AST pending栈中的起点
 
+#line 105 "parser.tab.h"
 
-
-/* Line 1676 of yacc.c  */
-#line 79 "parser.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
+/* Location type.  */
+#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define YYLTYPE_IS_DECLARED 1
+# define YYLTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+int yyparse (yyscan_t scanner, struct CompilerContext *ctx);
+
+/* "%code provides" blocks.  */
+#line 63 "parser.y"
+
+// 可重入扫描器接口（lex.yy.c）
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner);
+int yylex_init_extra(struct CompilerContext *user_defined, yyscan_t *scanner);
+struct yy_buffer_state *yy_scan_buffer(char *base, unsigned int size, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+void yyerror(YYLTYPE *loc, yyscan_t scanner, struct CompilerContext *ctx, const char *s);
 
+#line 142 "parser.tab.h"
 
+#endif /* !YY_YY_PARSER_TAB_H_INCLUDED  */
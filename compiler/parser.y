@@ -1,39 +1,53 @@
 %{
 #include "ast.h"
-#include "semantic.h"
-#include "ir.h"
-#include "optimize.h"
-#include "codegen.h"
-#include "interpreter.h"
+#include "driver.h"
+#include "bench.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
-extern FILE *yyin;
-extern int yylineno;
-extern int yycolumn;
-void yyerror(const char *s);
-int yylex(void);
-
-ASTNode *root = NULL;
-SemanticContext *semantic_context = NULL;
-IRGenerator *ir_generator = NULL;
-Optimizer *optimizer = NULL;
-CodeGenerator *code_generator = NULL;
-Interpreter *interpreter = NULL;
+// 用规则的起始位置（第一个记号）标记新建的AST节点
+#define LOCATE(node, loc) set_ast_location(ctx->ast, (node), (loc).first_line, (loc).first_column)
+// 把节点追加到当前语句列表或参数列表
+#define PUSH(node) do { if (!push_node_list(ctx->ast, (node))) YYNOMEM; } while (0)
+// 驻留记号切片的文本：相同的名称得到相同的指针，之后各阶段不再复制名称
+#define TOKEN_NAME(slice) intern_name(ctx->names, ctx->source->data + (slice).offset, (size_t)(slice).length)
 %}
 
+// 纯语法分析器 + 可重入词法分析器：所有状态都在yyparse的局部变量、扫描器句柄和编译上下文中，
+// 不同线程可以同时分析不同的文件
+%define api.pure full
+%locations
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {struct CompilerContext *ctx}
+
+%code requires {
+#include <stdio.h>
+#include "ast.h"
+#include "source.h"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+struct CompilerContext;
+}
+
 %union {
     int num;
     float fnum;
-    char *str;
-    ASTNode *node;
+    SourceSlice slice;
+    NodeId node;
+    uint32_t list;      // 语句列表或参数列表在AST pending栈中的起点
 }
 
 %token INT FLOAT RETURN IF ELSE WHILE PRINTF
 %token <num> INTEGER
 %token <fnum> FLOATING
-%token <str> IDENTIFIER STRING
+%token <slice> IDENTIFIER STRING
 %token EQ NE '<' '>' LE GE
 
 %nonassoc LOWER_THAN_ELSE
@@ -43,80 +57,34 @@ Interpreter *interpreter = NULL;
 %left '+' '-'
 %left '*' '/'
 
-%type <node> program stmt stmt_list expr decl assignment if_stmt while_stmt func_def call_stmt arg_list
+%type <node> program stmt expr decl assignment if_stmt while_stmt func_def call_stmt
+%type <list> stmt_list arg_list
+
+%code provides {
+// 可重入扫描器接口（lex.yy.c）
+int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner);
+int yylex_init_extra(struct CompilerContext *user_defined, yyscan_t *scanner);
+struct yy_buffer_state *yy_scan_buffer(char *base, unsigned int size, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+void yyerror(YYLTYPE *loc, yyscan_t scanner, struct CompilerContext *ctx, const char *s);
+}
 
 %%
 
 program : func_def { 
-            root = $1; 
-            printf("Syntax analysis successful!\n");
-            print_ast(root, 0);
-            export_ast_to_dot(root, "ast.dot");
-            
-            // system("dot -Tpng -Gcharset=latin1 ast.dot -o ast.png"); 
-            printf("AST DOT file generated: ast.dot\n");
-            
-            semantic_context = init_semantic();
-            if (semantic_context) {
-                bool sem_ok = analyze_semantics(root, semantic_context);
-                if (sem_ok) {
-                    printf("Semantic analysis passed!\n");
-                    
-                    printf("\n=== INTERMEDIATE CODE GENERATION ===\n");
-                    ir_generator = init_ir_generator(semantic_context->symbol_table);
-                    if (ir_generator) {
-                        generate_ir(root, ir_generator);
-                        print_ir(ir_generator);
-                        
-                        printf("\n=== CODE OPTIMIZATION ===\n");
-                        optimizer = init_optimizer(ir_generator, 2);
-                        if (optimizer) {
-                            optimize_ir(optimizer);
-                            printf("Optimized intermediate code:\n");
-                            print_ir(ir_generator);
-                            
-                            printf("\n=== TARGET CODE GENERATION ===\n");
-                            
-                            code_generator = init_code_generator(TARGET_PSEUDO, "output.s");
-                            if (code_generator) {
-                                generate_target_code(ir_generator, code_generator);
-                                printf("Pseudo assembly code generated: output.s\n");
-                                free_code_generator(code_generator);
-                            }
-                            
-                            code_generator = init_code_generator(TARGET_C_CODE, "output.c");
-                            if (code_generator) {
-                                generate_target_code(ir_generator, code_generator);
-                                printf("C code generated: output.c\n");
-                                free_code_generator(code_generator);
-                            }
-
-                            
-                            // ���ӽ�����ִ��
-                            printf("\n=== PROGRAM INTERPRETATION ===\n");
-                            interpreter = init_interpreter();
-                            if (interpreter) {
-                                execute_ir(interpreter, ir_generator);
-                                free_interpreter(interpreter);
-                            }
-                            
-                            free_optimizer(optimizer);
-                        }
-                        
-                        free_ir_generator(ir_generator);
-                    }
-                } else {
-                    printf("Semantic analysis failed!\n");
-                }
-            }
+            ctx->root = $1; 
           }
 
 func_def : INT IDENTIFIER '(' ')' '{' stmt_list '}' {
-            $$ = create_func_def("int", $2, $6);
+            NodeId body = create_block(ctx->ast, $6);
+            LOCATE(body, @5);
+            $$ = create_func_def(ctx->ast, "int", TOKEN_NAME($2), body);
+            LOCATE($$, @$);
           }
 
-stmt_list : stmt_list stmt { $$ = create_compound_stmt($1, $2); }
-          | stmt          { $$ = $1; }
+// 语句依次压入pending，语句块结束时整段移入AST，不产生嵌套的复合节点
+stmt_list : stmt_list stmt { $$ = $1; PUSH($2); }
+          | stmt          { $$ = begin_node_list(ctx->ast); PUSH($1); }
 
 stmt : decl ';'         { $$ = $1; }
      | assignment ';'   { $$ = $1; }
@@ -124,109 +92,237 @@ stmt : decl ';'         { $$ = $1; }
      | if_stmt          { $$ = $1; }
      | while_stmt       { $$ = $1; }
      | call_stmt ';'    { $$ = $1; }
-     | RETURN expr ';'  { $$ = create_return_stmt($2); }
-     | '{' stmt_list '}' { $$ = $2; }
-
-decl : INT IDENTIFIER      { $$ = create_decl("int", $2); }
-     | INT IDENTIFIER '=' expr { $$ = create_decl_assign("int", $2, $4); }
-     | FLOAT IDENTIFIER    { $$ = create_decl("float", $2); }
-     | FLOAT IDENTIFIER '=' expr { $$ = create_decl_assign("float", $2, $4); }
-
-assignment : IDENTIFIER '=' expr { $$ = create_assign($1, $3); }
-
-if_stmt : IF '(' expr ')' stmt %prec LOWER_THAN_ELSE { $$ = create_if($3, $5, NULL); }
-        | IF '(' expr ')' stmt ELSE stmt { $$ = create_if($3, $5, $7); }
-
-while_stmt : WHILE '(' expr ')' stmt { $$ = create_while($3, $5); }
-
-expr : expr '+' expr  { $$ = create_binop(OP_ADD, $1, $3); }
-     | expr '-' expr  { $$ = create_binop(OP_SUB, $1, $3); }
-     | expr '*' expr  { $$ = create_binop(OP_MUL, $1, $3); }
-     | expr '/' expr  { $$ = create_binop(OP_DIV, $1, $3); }
-     | expr EQ expr   { $$ = create_binop(OP_EQ, $1, $3); }
-     | expr NE expr   { $$ = create_binop(OP_NE, $1, $3); }
-     | expr '<' expr  { $$ = create_binop(OP_LT, $1, $3); }
-     | expr '>' expr  { $$ = create_binop(OP_GT, $1, $3); }
-     | expr LE expr   { $$ = create_binop(OP_LE, $1, $3); }
-     | expr GE expr   { $$ = create_binop(OP_GE, $1, $3); }
-     | IDENTIFIER    { $$ = create_var($1); }
-     | INTEGER       { $$ = create_int($1); }
-     | FLOATING      { $$ = create_float($1); }
+     | RETURN expr ';'  { $$ = create_return_stmt(ctx->ast, $2); LOCATE($$, @$); }
+     | '{' stmt_list '}' { $$ = create_block(ctx->ast, $2); LOCATE($$, @$); }
+
+decl : INT IDENTIFIER      { $$ = create_decl(ctx->ast, "int", TOKEN_NAME($2)); LOCATE($$, @$); }
+     | INT IDENTIFIER '=' expr { $$ = create_decl_assign(ctx->ast, "int", TOKEN_NAME($2), $4); LOCATE($$, @$); }
+     | FLOAT IDENTIFIER    { $$ = create_decl(ctx->ast, "float", TOKEN_NAME($2)); LOCATE($$, @$); }
+     | FLOAT IDENTIFIER '=' expr { $$ = create_decl_assign(ctx->ast, "float", TOKEN_NAME($2), $4); LOCATE($$, @$); }
+
+assignment : IDENTIFIER '=' expr { $$ = create_assign(ctx->ast, TOKEN_NAME($1), $3); LOCATE($$, @$); }
+
+if_stmt : IF '(' expr ')' stmt %prec LOWER_THAN_ELSE { $$ = create_if(ctx->ast, $3, $5, AST_NONE); LOCATE($$, @$); }
+        | IF '(' expr ')' stmt ELSE stmt { $$ = create_if(ctx->ast, $3, $5, $7); LOCATE($$, @$); }
+
+while_stmt : WHILE '(' expr ')' stmt { $$ = create_while(ctx->ast, $3, $5); LOCATE($$, @$); }
+
+expr : expr '+' expr  { $$ = create_binop(ctx->ast, OP_ADD, $1, $3); LOCATE($$, @$); }
+     | expr '-' expr  { $$ = create_binop(ctx->ast, OP_SUB, $1, $3); LOCATE($$, @$); }
+     | expr '*' expr  { $$ = create_binop(ctx->ast, OP_MUL, $1, $3); LOCATE($$, @$); }
+     | expr '/' expr  { $$ = create_binop(ctx->ast, OP_DIV, $1, $3); LOCATE($$, @$); }
+     | expr EQ expr   { $$ = create_binop(ctx->ast, OP_EQ, $1, $3); LOCATE($$, @$); }
+     | expr NE expr   { $$ = create_binop(ctx->ast, OP_NE, $1, $3); LOCATE($$, @$); }
+     | expr '<' expr  { $$ = create_binop(ctx->ast, OP_LT, $1, $3); LOCATE($$, @$); }
+     | expr '>' expr  { $$ = create_binop(ctx->ast, OP_GT, $1, $3); LOCATE($$, @$); }
+     | expr LE expr   { $$ = create_binop(ctx->ast, OP_LE, $1, $3); LOCATE($$, @$); }
+     | expr GE expr   { $$ = create_binop(ctx->ast, OP_GE, $1, $3); LOCATE($$, @$); }
+     | IDENTIFIER    { $$ = create_var(ctx->ast, TOKEN_NAME($1)); LOCATE($$, @$); }
+     | INTEGER       { $$ = create_int(ctx->ast, $1); LOCATE($$, @$); }
+     | FLOATING      { $$ = create_float(ctx->ast, $1); LOCATE($$, @$); }
      | '(' expr ')'  { $$ = $2; }
 
 call_stmt : PRINTF '(' arg_list ')' { 
-            // �����������
-            int arg_count = 0;
-            ASTNode *curr = $3;
-            while (curr) {
-                arg_count++;
-                if (curr->type == STMT_COMPOUND) {
-                    curr = curr->right;
-                } else {
-                    break;
-                }
-            }
-            
-            // ������������
-            ASTNode **args = NULL;
-            if (arg_count > 0) {
-                args = malloc(sizeof(ASTNode*) * arg_count);
-                curr = $3;
-                for (int i = 0; i < arg_count; i++) {
-                    if (curr->type == STMT_COMPOUND) {
-                        args[i] = curr->left;
-                        curr = curr->right;
-                    } else {
-                        args[i] = curr;
-                        break;
-                    }
-                }
-            }
-            
-            $$ = create_call("printf", args, arg_count); 
-            set_ast_location($$, yylineno, yycolumn);
+            $$ = create_call(ctx->ast, intern_cstr(ctx->names, "printf"), $3); 
+            LOCATE($$, @$);
           }
 
-arg_list : STRING           { $$ = create_var($1); }
-         | expr             { $$ = $1; }
-         | arg_list ',' STRING { $$ = create_compound_stmt($1, create_var($3)); }
-         | arg_list ',' expr { $$ = create_compound_stmt($1, $3); }
-         | /* empty */       { $$ = NULL; }
+arg_list : STRING           { $$ = begin_node_list(ctx->ast); NodeId arg = create_var(ctx->ast, TOKEN_NAME($1)); LOCATE(arg, @1); PUSH(arg); }
+         | expr             { $$ = begin_node_list(ctx->ast); PUSH($1); }
+         | arg_list ',' STRING { $$ = $1; NodeId arg = create_var(ctx->ast, TOKEN_NAME($3)); LOCATE(arg, @3); PUSH(arg); }
+         | arg_list ',' expr { $$ = $1; PUSH($3); }
+         | /* empty */       { $$ = begin_node_list(ctx->ast); }
 
 %%
 
-void yyerror(const char *s) {
-    fprintf(stderr, "Syntax Error at line %d, column %d: %s\n", yylineno, yycolumn, s);
+void yyerror(YYLTYPE *loc, yyscan_t scanner, struct CompilerContext *ctx, const char *s) {
+    (void)scanner;
+    ctx->syntax_errors++;
+    fprintf(stderr, "Syntax Error at line %d, column %d: %s\n", loc->first_line, loc->first_column, s);
 }
 
-int main(int argc, char **argv) {
-    if (argc > 1) {
-        fopen_s(&yyin, argv[1], "r");
-        if (!yyin) {
-            perror("Cannot open file");
-            return 1;
+// 目录或@列表文件
+static bool is_batch_input(const char *input) {
+    struct stat st;
+    return input[0] == '@' || (stat(input, &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR);
+}
+
+// 解析--emit=的值：逗号分隔的c、pseudo、bytecode
+static bool parse_emit_list(const char *list, unsigned *emit) {
+    while (*list) {
+        size_t len = strcspn(list, ",");
+        if (len == 1 && strncmp(list, "c", len) == 0) {
+            *emit |= EMIT_C;
+        } else if (len == 6 && strncmp(list, "pseudo", len) == 0) {
+            *emit |= EMIT_PSEUDO;
+        } else if (len == 8 && strncmp(list, "bytecode", len) == 0) {
+            *emit |= EMIT_BYTECODE;
+        } else {
+            fprintf(stderr, "Unknown --emit target: %.*s\n", (int)len, list);
+            return false;
         }
+        list += len;
+        if (*list == ',') list++;
     }
-    
-    printf("=== COMPILER FRONTEND ===\n");
-    printf("Start compilation...\n");
-    
-    yyparse();
-    
-    if (root) {
-        free_ast(root);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    // 解析选项：--bench=dispatch|fusion|jit|parallel|stages|ast|symtab|ir|ssa，--trace=<类别>[=<级别>],...，--trace-sink=text|ring[:N]，
+    // --profile[=<file>]，--jit，-j<N>/--jobs=<N>；输入为多个文件、目录或@<列表文件>时批量编译。
+    // 阶段选择：-fsyntax-only，--emit-ir，--dump-cfg，--dump-ssa，--emit=c|pseudo|bytecode，--dump-ast=dot，--run，-O0..-O3，-ftime-report；
+    // 给出任何一个阶段选择选项（-O和-ftime-report除外）时不再打印各阶段结果，只运行和生成所选的部分
+    CompilerOptions options;
+    init_compiler_options(&options);
+    bool select_stages = false;
+    bool run = false;
+    unsigned emit = 0;
+    const char **inputs = (const char**)malloc(sizeof(const char*) * (argc > 1 ? argc : 1));
+    int input_count = 0;
+    int jobs = 0;
+    init_trace();
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--trace=", 8) == 0) {
+            if (!trace_configure(argv[i] + 8)) return 1;
+        } else if (strncmp(argv[i], "--trace-sink=", 13) == 0) {
+            if (!trace_set_sink(argv[i] + 13)) return 1;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            options.jit_mode = true;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            options.profile_output = "profile.folded";
+        } else if (strncmp(argv[i], "--profile=", 10) == 0) {
+            options.profile_output = argv[i] + 10;
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0 || strncmp(argv[i], "-j", 2) == 0) {
+            jobs = atoi(argv[i] + (argv[i][1] == 'j' ? 2 : 7));
+        } else if (strncmp(argv[i], "--bench=", 8) == 0) {
+            options.bench_mode = argv[i] + 8;
+            if (strcmp(options.bench_mode, "dispatch") != 0 && strcmp(options.bench_mode, "fusion") != 0 &&
+                strcmp(options.bench_mode, "jit") != 0 && strcmp(options.bench_mode, "parallel") != 0 &&
+                strcmp(options.bench_mode, "stages") != 0 && strcmp(options.bench_mode, "ast") != 0 &&
+                strcmp(options.bench_mode, "symtab") != 0 && strcmp(options.bench_mode, "ir") != 0 &&
+                strcmp(options.bench_mode, "ssa") != 0) {
+                fprintf(stderr, "Unknown benchmark: %s\n", options.bench_mode);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-fsyntax-only") == 0) {
+            options.syntax_only = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--emit-ir") == 0) {
+            options.emit_ir = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--dump-cfg") == 0) {
+            options.dump_cfg = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--dump-ssa") == 0) {
+            options.dump_ssa = true;
+            select_stages = true;
+        } else if (strncmp(argv[i], "--emit=", 7) == 0) {
+            if (!parse_emit_list(argv[i] + 7, &emit)) return 1;
+            select_stages = true;
+        } else if (strncmp(argv[i], "--dump-ast=", 11) == 0) {
+            if (strcmp(argv[i] + 11, "dot") != 0) {
+                fprintf(stderr, "Unknown AST dump format: %s\n", argv[i] + 11);
+                return 1;
+            }
+            emit |= EMIT_AST_DOT;
+            select_stages = true;
+        } else if (strcmp(argv[i], "--run") == 0) {
+            run = true;
+            select_stages = true;
+        } else if (strcmp(argv[i], "-ftime-report") == 0) {
+            options.time_report = true;
+        } else if (strncmp(argv[i], "-O", 2) == 0) {
+            if (argv[i][2] < '0' || argv[i][2] > '3' || argv[i][3] != '\0') {
+                fprintf(stderr, "Unknown optimization level: %s\n", argv[i]);
+                return 1;
+            }
+            options.opt_level = argv[i][2] - '0';
+        } else {
+            inputs[input_count++] = argv[i];
+        }
     }
     
-    if (semantic_context) {
-        free_semantic(semantic_context);
+    if (select_stages) {
+        // 基准测试需要执行字节码
+        options.verbose = false;
+        options.execute = run || options.bench_mode != NULL;
+        options.emit = emit;
     }
-    
-    if (interpreter) {
-        free_interpreter(interpreter);
+
+    int status = 0;
+    if (options.bench_mode && strcmp(options.bench_mode, "stages") == 0) {
+        // 每跳过一个阶段节省的编译时间
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=stages requires one source file\n");
+            status = 1;
+        } else {
+            run_stage_benchmark(inputs[0], options.opt_level);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ast") == 0) {
+        // AST内存布局对比
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ast requires one source file\n");
+            status = 1;
+        } else {
+            run_ast_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ir") == 0) {
+        // IR指令的分配方式对比
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ir requires one source file\n");
+            status = 1;
+        } else {
+            run_ir_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "ssa") == 0) {
+        // 控制流图、SSA构造和退出SSA的耗时
+        if (input_count != 1) {
+            fprintf(stderr, "--bench=ssa requires one source file\n");
+            status = 1;
+        } else {
+            run_ssa_benchmark(inputs[0]);
+        }
+    } else if (options.bench_mode && strcmp(options.bench_mode, "symtab") == 0) {
+        // 符号表查找和作用域退出，不需要源文件
+        run_symtab_benchmark();
+    } else if (options.bench_mode && strcmp(options.bench_mode, "parallel") == 0) {
+        // 多线程编译吞吐量基准测试
+        if (input_count == 0) {
+            fprintf(stderr, "--bench=parallel requires a source file\n");
+            status = 1;
+        } else {
+            run_parallel_benchmark(inputs, input_count, jobs);
+        }
+    } else if (input_count > 1 || (input_count == 1 && is_batch_input(inputs[0]))) {
+        // 批量编译：多个文件、目录或@列表文件，每个文件生成以其文件名为前缀的产物，不执行
+        options.verbose = false;
+        options.execute = false;
+        status = compile_batch(inputs, input_count, &options, jobs) > 0;
+    } else if (input_count == 1 && strlen(inputs[0]) > 4 &&
+               strcmp(inputs[0] + strlen(inputs[0]) - 4, ".cbc") == 0) {
+        status = run_bytecode_file(inputs[0], &options);
+    } else {
+        if (options.verbose) {
+            printf("=== COMPILER FRONTEND ===\n");
+            printf("Start compilation...\n");
+        }
+        
+        CompilerContext *ctx = init_compiler_context(input_count ? inputs[0] : NULL, &options);
+        if (ctx) {
+            set_artifact_paths(ctx, NULL);
+            // 详细模式保持原来的行为：失败时也返回0
+            if (!compile_translation_unit(ctx) && !options.verbose) status = 1;
+            if (options.time_report) print_stage_times(ctx->stage_ns);
+            free_compiler_context(ctx);
+        }
+        
+        if (options.verbose) {
+            printf("\n=== COMPILATION COMPLETED ===\n");
+        }
+        fflush(stdout);
     }
     
-    if (argc > 1) fclose(yyin);
-    
-    printf("\n=== COMPILATION COMPLETED ===\n");
-    return 0;
+    free(inputs);
+    free_trace();
+    return status;
 }
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "profile.h"
+
+#define PROFILE_TOP_INSTRUCTIONS 10
+#define PROFILE_CALIBRATE_ROUNDS 1000
+
+// 循环：由向后跳转确定的字节码区间[head, tail]
+typedef struct {
+    int head;
+    int tail;
+    int line;                       // 循环头（条件判断）所在行
+    unsigned long long iterations;  // 回跳次数
+    unsigned long long instructions;
+    unsigned long long ticks;
+} ProfileLoop;
+
+// 折叠后的一个调用栈
+typedef struct {
+    char *stack;
+    unsigned long long ticks;
+} FoldedStack;
+
+// 估计两次连续计时之间的最小间隔
+static unsigned long long calibrate_overhead(void) {
+    unsigned long long best = ~0ULL;
+    for (int i = 0; i < PROFILE_CALIBRATE_ROUNDS; i++) {
+        unsigned long long start = profile_clock();
+        unsigned long long end = profile_clock();
+        if (end - start < best) best = end - start;
+    }
+    return best;
+}
+
+Profile* init_profile(BytecodeProgram *prog) {
+    if (!prog) return NULL;
+
+    Profile *profile = (Profile*)malloc(sizeof(Profile));
+    if (!profile) return NULL;
+
+    profile->code_count = prog->code_count;
+    profile->code = (BCInstr*)malloc((prog->code_count + 1) * sizeof(BCInstr));
+    memcpy(profile->code, prog->code, prog->code_count * sizeof(BCInstr));
+    profile->counts = (unsigned long long*)calloc(prog->code_count + 1, sizeof(unsigned long long));
+    profile->ticks = (unsigned long long*)calloc(prog->code_count + 1, sizeof(unsigned long long));
+    profile->overhead = calibrate_overhead();
+    return profile;
+}
+
+void free_profile(Profile *profile) {
+    if (!profile) return;
+    free(profile->code);
+    free(profile->counts);
+    free(profile->ticks);
+    free(profile);
+}
+
+// 扣除计时开销后的耗时
+static unsigned long long net_ticks(Profile *profile, int pc) {
+    unsigned long long cost = profile->counts[pc] * profile->overhead;
+    return profile->ticks[pc] > cost ? profile->ticks[pc] - cost : 0;
+}
+
+static double percent(unsigned long long part, unsigned long long total) {
+    return total ? 100.0 * part / total : 0.0;
+}
+
+// 读入源文件并按行切分，lines[i]为第i行（从1开始）
+static char* load_source_lines(const char *path, char ***lines, int *line_count) {
+    *lines = NULL;
+    *line_count = 0;
+    if (!path) return NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char *text = (char*)malloc(size + 1);
+    size_t read = fread(text, 1, size, file);
+    fclose(file);
+    text[read] = '\0';
+
+    int count = 1;
+    for (size_t i = 0; i < read; i++) {
+        if (text[i] == '\n') count++;
+    }
+    *lines = (char**)malloc((count + 1) * sizeof(char*));
+    (*lines)[0] = NULL;
+
+    int line = 1;
+    char *start = text;
+    for (char *p = text; ; p++) {
+        if (*p == '\n' || *p == '\0') {
+            bool end = *p == '\0';
+            char *trim = p;
+            while (trim > start && (trim[-1] == '\r' || trim[-1] == ' ' || trim[-1] == '\t')) trim--;
+            *trim = '\0';
+            while (*start == ' ' || *start == '\t') start++;
+            (*lines)[line++] = start;
+            if (end) break;
+            start = p + 1;
+        }
+    }
+    *line_count = line - 1;
+    return text;
+}
+
+// 收集循环：每条向后跳转确定一个循环，按外层在前排序
+static int compare_loops(const void *a, const void *b) {
+    const ProfileLoop *x = (const ProfileLoop*)a;
+    const ProfileLoop *y = (const ProfileLoop*)b;
+    if (x->head != y->head) return x->head - y->head;
+    return y->tail - x->tail;
+}
+
+static ProfileLoop* find_loops(Profile *profile, int *loop_count) {
+    ProfileLoop *loops = NULL;
+    int count = 0;
+
+    for (int pc = 0; pc < profile->code_count; pc++) {
+        BCInstr *bc = &profile->code[pc];
+        if (!BC_IS_BRANCH(bc->opcode) || bc->dst < 0 || bc->dst > pc) continue;
+
+        loops = (ProfileLoop*)realloc(loops, (count + 1) * sizeof(ProfileLoop));
+        ProfileLoop *loop = &loops[count++];
+        loop->head = bc->dst;
+        loop->tail = pc;
+        loop->line = profile->code[bc->dst].line;
+        loop->iterations = profile->counts[pc];
+        loop->instructions = 0;
+        loop->ticks = 0;
+        for (int i = loop->head; i <= loop->tail; i++) {
+            loop->instructions += profile->counts[i];
+            loop->ticks += net_ticks(profile, i);
+        }
+    }
+
+    if (count > 1) qsort(loops, count, sizeof(ProfileLoop), compare_loops);
+    *loop_count = count;
+    return loops;
+}
+
+static int compare_by_ticks_desc(unsigned long long a, unsigned long long b) {
+    return a < b ? 1 : (a > b ? -1 : 0);
+}
+
+static Profile *sort_profile;   // qsort比较函数使用
+
+static int compare_pc(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    int order = compare_by_ticks_desc(net_ticks(sort_profile, x), net_ticks(sort_profile, y));
+    return order ? order : x - y;
+}
+
+typedef struct {
+    int line;
+    unsigned long long instructions;
+    unsigned long long ticks;
+} ProfileLine;
+
+static int compare_lines(const void *a, const void *b) {
+    const ProfileLine *x = (const ProfileLine*)a;
+    const ProfileLine *y = (const ProfileLine*)b;
+    int order = compare_by_ticks_desc(x->ticks, y->ticks);
+    return order ? order : x->line - y->line;
+}
+
+void print_profile_report(Profile *profile, const char *source_path, FILE *out) {
+    if (!profile) return;
+
+    unsigned long long total_instructions = 0;
+    unsigned long long total_ticks = 0;
+    int max_line = 0;
+    for (int pc = 0; pc < profile->code_count; pc++) {
+        total_instructions += profile->counts[pc];
+        total_ticks += net_ticks(profile, pc);
+        if (profile->code[pc].line > max_line) max_line = profile->code[pc].line;
+    }
+
+    char **source_lines;
+    int source_line_count;
+    char *source_text = load_source_lines(source_path, &source_lines, &source_line_count);
+
+    fprintf(out, "\n=== Execution Profile ===\n");
+    fprintf(out, "Executed instructions: %llu\n", total_instructions);
+    fprintf(out, "Total time: %llu %s (timer overhead %llu %s per instruction subtracted)\n",
+            total_ticks, PROFILE_CLOCK_UNIT, profile->overhead, PROFILE_CLOCK_UNIT);
+
+    // 按源代码行汇总（行号0为无法归属的指令）
+    ProfileLine *lines = (ProfileLine*)calloc(max_line + 1, sizeof(ProfileLine));
+    for (int line = 0; line <= max_line; line++) lines[line].line = line;
+    for (int pc = 0; pc < profile->code_count; pc++) {
+        ProfileLine *entry = &lines[profile->code[pc].line];
+        entry->instructions += profile->counts[pc];
+        entry->ticks += net_ticks(profile, pc);
+    }
+    qsort(lines, max_line + 1, sizeof(ProfileLine), compare_lines);
+
+    fprintf(out, "\nHot lines:\n");
+    fprintf(out, "%6s %14s %16s %7s  %s\n", "line", "instructions", PROFILE_CLOCK_UNIT, "%", "source");
+    for (int i = 0; i <= max_line; i++) {
+        ProfileLine *entry = &lines[i];
+        if (entry->instructions == 0) continue;
+        const char *text = entry->line > 0 && entry->line <= source_line_count ? source_lines[entry->line] : "";
+        if (entry->line > 0) {
+            fprintf(out, "%6d %14llu %16llu %6.1f%%  %s\n",
+                    entry->line, entry->instructions, entry->ticks, percent(entry->ticks, total_ticks), text);
+        } else {
+            fprintf(out, "%6s %14llu %16llu %6.1f%%\n",
+                    "?", entry->instructions, entry->ticks, percent(entry->ticks, total_ticks));
+        }
+    }
+    free(lines);
+
+    // 按循环汇总（外层循环的数据包含内层循环）
+    int loop_count;
+    ProfileLoop *loops = find_loops(profile, &loop_count);
+    if (loop_count > 0) {
+        fprintf(out, "\nLoops:\n");
+        fprintf(out, "%6s %12s %14s %16s %7s  %s\n", "line", "iterations", "instructions", PROFILE_CLOCK_UNIT, "%", "source");
+        for (int i = 0; i < loop_count; i++) {
+            ProfileLoop *loop = &loops[i];
+            int depth = 0;
+            for (int j = 0; j < i; j++) {
+                if (loops[j].head <= loop->head && loop->tail <= loops[j].tail) depth++;
+            }
+            const char *text = loop->line > 0 && loop->line <= source_line_count ? source_lines[loop->line] : "";
+            fprintf(out, "%6d %12llu %14llu %16llu %6.1f%%  %*s%s\n",
+                    loop->line, loop->iterations, loop->instructions, loop->ticks,
+                    percent(loop->ticks, total_ticks), depth * 2, "", text);
+        }
+    }
+    free(loops);
+
+    // 最热的字节码指令
+    int *order = (int*)malloc((profile->code_count + 1) * sizeof(int));
+    for (int pc = 0; pc < profile->code_count; pc++) order[pc] = pc;
+    sort_profile = profile;
+    qsort(order, profile->code_count, sizeof(int), compare_pc);
+
+    fprintf(out, "\nHot instructions:\n");
+    fprintf(out, "%6s %6s %-14s %14s %16s %7s\n", "pc", "line", "opcode", "count", PROFILE_CLOCK_UNIT, "%");
+    for (int i = 0; i < profile->code_count && i < PROFILE_TOP_INSTRUCTIONS; i++) {
+        int pc = order[i];
+        if (profile->counts[pc] == 0) break;
+        fprintf(out, "%6d %6d %-14s %14llu %16llu %6.1f%%\n",
+                pc, profile->code[pc].line, bytecode_opcode_name(profile->code[pc].opcode),
+                profile->counts[pc], net_ticks(profile, pc), percent(net_ticks(profile, pc), total_ticks));
+    }
+    fprintf(out, "=========================\n");
+
+    free(order);
+    free(source_lines);
+    free(source_text);
+}
+
+static int compare_folded(const void *a, const void *b) {
+    return strcmp(((const FoldedStack*)a)->stack, ((const FoldedStack*)b)->stack);
+}
+
+bool write_folded_stacks(Profile *profile, const char *root, const char *filename) {
+    if (!profile || !filename) return false;
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot create profile output: %s\n", filename);
+        return false;
+    }
+
+    // 根帧只保留文件名
+    for (const char *p = root; *p; p++) {
+        if (*p == '/' || *p == '\\') root = p + 1;
+    }
+
+    int loop_count;
+    ProfileLoop *loops = find_loops(profile, &loop_count);
+
+    // 每条执行过的指令生成一个栈：root;loop:N;...;line:M
+    FoldedStack *stacks = (FoldedStack*)malloc((profile->code_count + 1) * sizeof(FoldedStack));
+    int stack_count = 0;
+    for (int pc = 0; pc < profile->code_count; pc++) {
+        unsigned long long ticks = net_ticks(profile, pc);
+        if (profile->counts[pc] == 0 || ticks == 0) continue;
+
+        size_t capacity = strlen(root) + 32 * (loop_count + 1) + 1;
+        char *stack = (char*)malloc(capacity);
+        size_t length = snprintf(stack, capacity, "%s", root);
+        for (int i = 0; i < loop_count; i++) {
+            if (loops[i].head <= pc && pc <= loops[i].tail) {
+                length += snprintf(stack + length, capacity - length, ";loop:%d", loops[i].line);
+            }
+        }
+        if (profile->code[pc].line > 0) {
+            snprintf(stack + length, capacity - length, ";line:%d", profile->code[pc].line);
+        } else {
+            snprintf(stack + length, capacity - length, ";line:?");
+        }
+
+        stacks[stack_count].stack = stack;
+        stacks[stack_count].ticks = ticks;
+        stack_count++;
+    }
+
+    // 合并相同的栈
+    qsort(stacks, stack_count, sizeof(FoldedStack), compare_folded);
+    for (int i = 0; i < stack_count; ) {
+        unsigned long long ticks = 0;
+        int j = i;
+        while (j < stack_count && strcmp(stacks[j].stack, stacks[i].stack) == 0) {
+            ticks += stacks[j].ticks;
+            j++;
+        }
+        fprintf(file, "%s %llu\n", stacks[i].stack, ticks);
+        for (int k = i; k < j; k++) free(stacks[k].stack);
+        i = j;
+    }
+
+    free(stacks);
+    free(loops);
+    fclose(file);
+    return true;
+}
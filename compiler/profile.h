@@ -0,0 +1,40 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "bytecode.h"
+
+// 计时源：x86下读取时间戳计数器（周期），其他平台退回单调时钟（纳秒）
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILE_CLOCK_UNIT "cycles"
+static inline unsigned long long profile_clock(void) { return __rdtsc(); }
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PROFILE_CLOCK_UNIT "cycles"
+static inline unsigned long long profile_clock(void) { return __rdtsc(); }
+#else
+#include "bench.h"
+#define PROFILE_CLOCK_UNIT "ns"
+static inline unsigned long long profile_clock(void) { return (unsigned long long)bench_now_ns(); }
+#endif
+
+// 执行剖析数据：按字节码指令统计执行次数和耗时，通过指令的行号归属到源代码
+typedef struct Profile {
+    BCInstr *code;                  // 指令副本（字节码释放后仍可生成报告）
+    int code_count;
+    unsigned long long *counts;     // 各指令执行次数（末尾多一项哨兵）
+    unsigned long long *ticks;      // 各指令累计耗时
+    unsigned long long overhead;    // 单次计时本身的开销，报告时扣除
+} Profile;
+
+Profile* init_profile(BytecodeProgram *prog);
+void free_profile(Profile *profile);
+
+// 按源代码行和循环汇总的文本报告（source_path非NULL时附带源代码）
+void print_profile_report(Profile *profile, const char *source_path, FILE *out);
+// 输出folded stack格式（root;loop:3;line:5 <耗时>），可直接交给flamegraph.pl
+bool write_folded_stacks(Profile *profile, const char *root, const char *filename);
+
+#endif
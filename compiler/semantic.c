@@ -10,6 +10,7 @@ SemanticContext* init_semantic() {
         context->symbol_table = init_symbol_table();
         context->current_func_type = TYPE_UNKNOWN;
         context->error_count = 0;
+        context->verbose = true;
     }
     return context;
 }
@@ -88,11 +89,51 @@ void report_semantic_error_with_location(SemanticErrorType error, const char *me
     fprintf(stderr, "Semantic Error at line %d, column %d: %s - %s\n", line, column, error_type, message);
 }
 
-// Expression type checking
-DataType check_expr_type(ASTNode *node, SemanticContext *context) {
-    if (!node) return TYPE_UNKNOWN;
-    
-    switch (node->type) {
+// 表达式类型检查用的类型栈：后序遍历时每个子表达式压入自己的类型，二元运算弹出两个
+#define EXPR_TYPE_INLINE 32
+
+typedef struct {
+    SemanticContext *context;
+    AST *ast;                   // 回调拿到的是const AST*，类型和符号编号通过这里写回
+    DataType inline_types[EXPR_TYPE_INLINE];
+    DataType *types;
+    uint32_t count;
+    uint32_t capacity;
+} ExprTypeWalk;
+
+static void push_expr_type(ExprTypeWalk *walk, DataType type) {
+    if (walk->count == walk->capacity) {
+        uint32_t capacity = walk->capacity * 2;
+        DataType *types = walk->types == walk->inline_types
+                          ? (DataType*)malloc(capacity * sizeof(DataType))
+                          : (DataType*)realloc(walk->types, capacity * sizeof(DataType));
+        if (!types) return;
+        if (walk->types == walk->inline_types) memcpy(types, walk->inline_types, sizeof(walk->inline_types));
+        walk->types = types;
+        walk->capacity = capacity;
+    }
+    walk->types[walk->count++] = type;
+}
+
+static DataType pop_expr_type(ExprTypeWalk *walk) {
+    return walk->count > 0 ? walk->types[--walk->count] : TYPE_UNKNOWN;
+}
+
+// 进入二元运算的操作数和函数调用的参数
+static int expr_type_pre(const AST *ast, ASTVisit *visit, void *data) {
+    (void)data;
+    NodeType kind = (NodeType)ast->kinds[visit->node];
+    return kind == EXPR_BINOP || kind == EXPR_CALL || kind == STMT_CALL;
+}
+
+// printf的格式字符串也是EXPR_VAR节点，名称带引号，不需要解析
+static bool is_string_literal(const char *name) {
+    return name[0] == '"';
+}
+
+static DataType expr_node_type(const AST *ast, NodeId node, ExprTypeWalk *walk) {
+    SemanticContext *context = walk->context;
+    switch ((NodeType)ast->kinds[node]) {
         case EXPR_INT:
             return TYPE_INT;
             
@@ -100,22 +141,26 @@ DataType check_expr_type(ASTNode *node, SemanticContext *context) {
             return TYPE_FLOAT;
             
         case EXPR_VAR: {
-            // 查找变量
-            SymbolEntry *entry = lookup_symbol(context->symbol_table, node->var.name);
+            if (is_string_literal(ast->payloads[node].var.name)) {
+                return TYPE_INT;
+            }
+            // 查找变量，记录解析到的符号
+            SymbolEntry *entry = lookup_symbol(context->symbol_table, ast->payloads[node].var.name);
             if (!entry) {
                 char error_msg[100];
-                sprintf(error_msg, "'%s'", node->var.name);
-                report_semantic_error_with_location(SEM_UNDECLARED_VAR, error_msg, node->line_number, node->column);
+                sprintf(error_msg, "'%s'", ast->payloads[node].var.name);
+                report_semantic_error_with_location(SEM_UNDECLARED_VAR, error_msg, ast->locations[node].line, ast->locations[node].column);
                 context->error_count++;
                 return TYPE_UNKNOWN;
             }
+            walk->ast->symbols[node] = entry->id;
             return entry->type;
         }
         
         case EXPR_BINOP: {
-            // Recursively search parameters
-            DataType left_type = check_expr_type(node->left, context);
-            DataType right_type = check_expr_type(node->right, context);
+            // 两个操作数的类型已由后序遍历压栈
+            DataType right_type = pop_expr_type(walk);
+            DataType left_type = pop_expr_type(walk);
             
             // ���ͼ����Լ��
             if (left_type == TYPE_UNKNOWN || right_type == TYPE_UNKNOWN) {
@@ -123,22 +168,22 @@ DataType check_expr_type(ASTNode *node, SemanticContext *context) {
             }
             
             // Check division by zero
-            if (node->binop.op == OP_DIV) {
-                if (node->right->type == EXPR_INT && node->right->integer.value == 0) {
+            if (ast->payloads[node].binop.op == OP_DIV) {
+                if (ast->kinds[ast->rights[node]] == EXPR_INT && ast->payloads[ast->rights[node]].integer.value == 0) {
                     report_semantic_error_with_location(SEM_DIVISION_BY_ZERO, "Integer division by zero", 
-                                                       node->line_number, node->column);
+                                                       ast->locations[node].line, ast->locations[node].column);
                     context->error_count++;
                     return TYPE_UNKNOWN;
-                } else if (node->right->type == EXPR_FLOAT && node->right->floating.value == 0.0) {
+                } else if (ast->kinds[ast->rights[node]] == EXPR_FLOAT && ast->payloads[ast->rights[node]].floating.value == 0.0) {
                     report_semantic_error_with_location(SEM_DIVISION_BY_ZERO, "Float division by zero", 
-                                                       node->line_number, node->column);
+                                                       ast->locations[node].line, ast->locations[node].column);
                     context->error_count++;
                     return TYPE_UNKNOWN;
                 }
             }
             
             // ���Ƚ�����������ͼ�����
-            if (node->binop.op >= OP_EQ && node->binop.op <= OP_GE) {
+            if (ast->payloads[node].binop.op >= OP_EQ && ast->payloads[node].binop.op <= OP_GE) {
                 if (!check_type_compatible(left_type, right_type) && 
                     !check_type_compatible(right_type, left_type)) {
                     char error_msg[200];
@@ -156,28 +201,30 @@ DataType check_expr_type(ASTNode *node, SemanticContext *context) {
         
         case EXPR_CALL: {
             // 函数调用表达式
-            if (strcmp(node->call.name, "printf") == 0) {
+            if (strcmp(ast->payloads[node].call.name, "printf") == 0) {
                 // printf 函数特殊处理
-                if (node->call.arg_count < 1) {
+                if (ast->payloads[node].call.arg_count < 1) {
                     report_semantic_error_with_location(SEM_INVALID_OPERATION, 
                                                        "printf requires at least one argument", 
-                                                       node->line_number, node->column);
+                                                       ast->locations[node].line, ast->locations[node].column);
                     context->error_count++;
                     return TYPE_UNKNOWN;
                 }
                 
                 // 检查第一个参数是否为字符串字面量（在这里简化处理）
-                printf("INFO: printf function call detected at line %d, column %d\n", 
-                       node->line_number, node->column);
+                if (context->verbose) {
+                    printf("INFO: printf function call detected at line %d, column %d\n", 
+                           ast->locations[node].line, ast->locations[node].column);
+                }
                 
                 // printf 返回 int 类型（打印的字符数）
                 return TYPE_INT;
             } else {
                 // 其他函数调用
                 char error_msg[100];
-                sprintf(error_msg, "Function '%s' not declared", node->call.name);
+                sprintf(error_msg, "Function '%s' not declared", ast->payloads[node].call.name);
                 report_semantic_error_with_location(SEM_FUNCTION_NOT_DECLARED, error_msg, 
-                                                   node->line_number, node->column);
+                                                   ast->locations[node].line, ast->locations[node].column);
                 context->error_count++;
                 return TYPE_UNKNOWN;
             }
@@ -188,6 +235,33 @@ DataType check_expr_type(ASTNode *node, SemanticContext *context) {
     }
 }
 
+// 每个表达式节点的类型都记录到AST上；函数调用的参数不参与调用本身的类型，不压栈
+static void expr_type_post(const AST *ast, ASTVisit *visit, void *data) {
+    ExprTypeWalk *walk = (ExprTypeWalk*)data;
+    DataType type = expr_node_type(ast, visit->node, walk);
+    walk->ast->types[visit->node] = (uint8_t)type;
+    NodeType parent = visit->up ? (NodeType)ast->kinds[visit->up->node] : STMT_COMPOUND;
+    if (parent != EXPR_CALL && parent != STMT_CALL) {
+        push_expr_type(walk, type);
+    }
+}
+
+// Expression type checking
+DataType check_expr_type(AST *ast, NodeId node, SemanticContext *context) {
+    if (node == AST_NONE) return TYPE_UNKNOWN;
+
+    ExprTypeWalk walk;
+    walk.context = context;
+    walk.ast = ast;
+    walk.types = walk.inline_types;
+    walk.count = 0;
+    walk.capacity = EXPR_TYPE_INLINE;
+    ASTVisitor visitor = { expr_type_pre, expr_type_post };
+    DataType type = visit_ast(ast, node, &visitor, &walk) ? pop_expr_type(&walk) : TYPE_UNKNOWN;
+    if (walk.types != walk.inline_types) free(walk.types);
+    return type;
+}
+
 // �ƶϱ�������
 DataType infer_var_type(const char *type_name) {
     if (!type_name) return TYPE_UNKNOWN;
@@ -235,13 +309,13 @@ bool is_relational_op(BinOpType op) {
 }
 
 // ��鳣������ʽ��ֵ
-bool is_zero_constant(ASTNode *node) {
-    if (!node) return false;
+bool is_zero_constant(const AST *ast, NodeId node) {
+    if (node == AST_NONE) return false;
     
-    if (node->type == EXPR_INT) {
-        return node->integer.value == 0;
-    } else if (node->type == EXPR_FLOAT) {
-        return node->floating.value == 0.0;
+    if (ast->kinds[node] == EXPR_INT) {
+        return ast->payloads[node].integer.value == 0;
+    } else if (ast->kinds[node] == EXPR_FLOAT) {
+        return ast->payloads[node].floating.value == 0.0;
     }
     
     return false;
@@ -254,22 +328,32 @@ void type_conversion_warning(DataType from_type, DataType to_type, const char *c
     }
 }
 
+// 声明变量并在声明节点上记录其类型和符号编号
+static bool declare_variable(AST *ast, NodeId node, SemanticContext *context, const char *name, DataType type) {
+    if (!add_symbol(context->symbol_table, name, SYM_VARIABLE, type)) return false;
+    ast->types[node] = (uint8_t)type;
+    ast->symbols[node] = lookup_symbol(context->symbol_table, name)->id;
+    return true;
+}
+
 // ������
-bool check_stmt(ASTNode *node, SemanticContext *context) {
-    if (!node) return true;
+bool check_stmt(AST *ast, NodeId node, SemanticContext *context) {
+    if (node == AST_NONE) return true;
     
-    switch(node->type) {
+    switch((NodeType)ast->kinds[node]) {
         case STMT_COMPOUND: {
-            // ��Ϊ������䴴����������ֻ�����������
-            bool left_result = check_stmt(node->left, context);
-            bool right_result = check_stmt(node->right, context);
-            return left_result && right_result;
+            // 语句块不创建新的作用域，依次检查其中的每条语句（出错后继续检查）
+            bool result = true;
+            for (uint32_t i = 0; i < ast->payloads[node].block.stmt_count; i++) {
+                if (!check_stmt(ast, AST_BLOCK_STMT(ast, node, i), context)) result = false;
+            }
+            return result;
         }
         
         case STMT_DECL: {
             // ������������
-            const char *var_name = node->decl.name;
-            const char *type_str = node->decl.var_type;
+            const char *var_name = ast->payloads[node].decl.name;
+            const char *type_str = ast->payloads[node].decl.var_type;
             
             // ���������ַ���ȷ����������
             DataType var_type = infer_var_type(type_str);
@@ -290,13 +374,13 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
                 return false;
             }
             
-            return add_symbol(context->symbol_table, var_name, SYM_VARIABLE, var_type);
+            return declare_variable(ast, node, context, var_name, var_type);
         }
         
         case STMT_DECL_ASSIGN: {
             // ��������ʼֵ�ı�������
-            const char *var_name = node->decl.name;
-            const char *type_str = node->decl.var_type;
+            const char *var_name = ast->payloads[node].decl.name;
+            const char *type_str = ast->payloads[node].decl.var_type;
             
             // ȷ����������
             DataType var_type = infer_var_type(type_str);
@@ -309,7 +393,7 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
             }
             
             // ����ʼֵ����ʽ����
-            DataType expr_type = check_expr_type(node->left, context);
+            DataType expr_type = check_expr_type(ast, ast->lefts[node], context);
             
             // ���ұ����Ƿ��Ѵ���
             if (lookup_symbol_current_scope(context->symbol_table, var_name)) {
@@ -330,12 +414,12 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
                 return false;
             }
             
-            return add_symbol(context->symbol_table, var_name, SYM_VARIABLE, var_type);
+            return declare_variable(ast, node, context, var_name, var_type);
         }
         
         case STMT_ASSIGN: {
             // ������ֵ���
-            const char *var_name = node->assign.name;
+            const char *var_name = ast->payloads[node].assign.name;
             SymbolEntry *entry = lookup_symbol(context->symbol_table, var_name);
             
             if (!entry) {
@@ -345,9 +429,11 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
                 context->error_count++;
                 return false;
             }
+            ast->types[node] = (uint8_t)entry->type;
+            ast->symbols[node] = entry->id;
             
             // ����Ҳ����ʽ����
-            DataType expr_type = check_expr_type(node->left, context);
+            DataType expr_type = check_expr_type(ast, ast->lefts[node], context);
             
             // ���ͼ����Լ��
             if (!check_type_compatible(entry->type, expr_type)) {
@@ -364,7 +450,7 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
         
         case STMT_RETURN: {
             // �����������
-            DataType expr_type = check_expr_type(node->left, context);
+            DataType expr_type = check_expr_type(ast, ast->lefts[node], context);
             
             // ��鷵��ֵ�����뺯������һ���ԣ�ʹ����ǿ�����ͼ����Լ��
             if (context->current_func_type != TYPE_UNKNOWN && 
@@ -383,15 +469,16 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
             return true;
         }
         
-        case STMT_CALL: {
-            // 函数调用语句
-            check_expr_type(node, context);  // 复用表达式类型检查中的函数调用逻辑
+        case STMT_CALL:
+        case EXPR_CALL: {
+            // 函数调用语句（语法分析器为printf语句创建的是EXPR_CALL节点），同时解析参数中的变量
+            check_expr_type(ast, node, context);  // 复用表达式类型检查中的函数调用逻辑
             return true;
         }
         
         case STMT_IF: {
             // ����if���
-            DataType cond_type = check_expr_type(node->if_stmt.cond, context);
+            DataType cond_type = check_expr_type(ast, ast->payloads[node].if_stmt.cond, context);
             
             // �����������ʽ����
             if (cond_type != TYPE_INT && cond_type != TYPE_FLOAT && cond_type != TYPE_UNKNOWN) {
@@ -402,14 +489,14 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
             
             // ���then��֧
             enter_scope(context->symbol_table);
-            bool then_result = check_stmt(node->left, context);
+            bool then_result = check_stmt(ast, ast->lefts[node], context);
             leave_scope(context->symbol_table);
             
             // ���else��֧
             bool else_result = true;
-            if (node->right) {
+            if (ast->rights[node] != AST_NONE) {
                 enter_scope(context->symbol_table);
-                else_result = check_stmt(node->right, context);
+                else_result = check_stmt(ast, ast->rights[node], context);
                 leave_scope(context->symbol_table);
             }
             
@@ -418,7 +505,7 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
         
         case STMT_WHILE: {
             // ����while���
-            DataType cond_type = check_expr_type(node->while_stmt.cond, context);
+            DataType cond_type = check_expr_type(ast, ast->payloads[node].while_stmt.cond, context);
             
             // �����������ʽ����
             if (cond_type != TYPE_INT && cond_type != TYPE_FLOAT && cond_type != TYPE_UNKNOWN) {
@@ -429,7 +516,7 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
             
             // ���ѭ����
             enter_scope(context->symbol_table);
-            bool body_result = check_stmt(node->left, context);
+            bool body_result = check_stmt(ast, ast->lefts[node], context);
             leave_scope(context->symbol_table);
             
             return body_result;
@@ -437,8 +524,8 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
         
         case FUNC_DEF: {
             // ������������
-            const char *func_name = node->func_def.name;
-            const char *ret_type_str = node->func_def.ret_type;
+            const char *func_name = ast->payloads[node].func_def.name;
+            const char *ret_type_str = ast->payloads[node].func_def.ret_type;
             
             DataType ret_type = infer_var_type(ret_type_str);
             if (ret_type == TYPE_UNKNOWN) {
@@ -470,7 +557,7 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
             
             // �����崴����������
             enter_scope(context->symbol_table);
-            bool body_result = check_stmt(node->left, context);
+            bool body_result = check_stmt(ast, ast->lefts[node], context);
             leave_scope(context->symbol_table);
             
             // �ָ�֮ǰ�ĺ�������
@@ -485,19 +572,31 @@ bool check_stmt(ASTNode *node, SemanticContext *context) {
 }
 
 // Analyze AST for semantic correctness
-bool analyze_semantics(ASTNode *root, SemanticContext *context) {
-    if (!root || !context) {
+bool analyze_semantics(AST *ast, NodeId root, SemanticContext *context) {
+    if (!ast || root == AST_NONE || !context) {
         printf("Semantic analysis failed: invalid input parameters\n");
         return false;
     }
     
-    printf("==================== BEGIN SEMANTIC ANALYSIS ====================\n");
+    if (context->verbose) {
+        printf("==================== BEGIN SEMANTIC ANALYSIS ====================\n");
+    }
     
     // Reset error count
     context->error_count = 0;
     
+    // 类型和符号编号记录在AST上，供中间代码生成直接读取
+    if (!alloc_ast_annotations(ast)) {
+        printf("Semantic analysis failed: out of memory\n");
+        return false;
+    }
+    
     // Recursively analyze AST
-    check_stmt(root, context);
+    check_stmt(ast, root, context);
+    
+    if (!context->verbose) {
+        return (context->error_count == 0);
+    }
     
     printf("==================== END SEMANTIC ANALYSIS ====================\n");
     
@@ -21,26 +21,28 @@ typedef struct {
     SymbolTable *symbol_table;  // Symbol table
     DataType current_func_type;  // Current function return type
     int error_count;            // Error count
+    bool verbose;               // Print progress, INFO messages and the symbol table
 } SemanticContext;
 
 // Semantic analysis interface functions
+// analyze_semantics records each expression's type and each variable reference's symbol id on the AST
 SemanticContext* init_semantic();
 void free_semantic(SemanticContext *context);
-bool analyze_semantics(ASTNode *root, SemanticContext *context);
+bool analyze_semantics(AST *ast, NodeId root, SemanticContext *context);
 // Report semantic errors with location
 void report_semantic_error(SemanticErrorType error, const char *message);
 void report_semantic_error_with_location(SemanticErrorType error, const char *message, int line, int column);
 
 // Type checking functions
-DataType check_expr_type(ASTNode *node, SemanticContext *context);
+DataType check_expr_type(AST *ast, NodeId node, SemanticContext *context);
 bool check_type_compatible(DataType target_type, DataType expr_type);
-bool check_stmt(ASTNode *node, SemanticContext *context);
+bool check_stmt(AST *ast, NodeId node, SemanticContext *context);
 
 // Helper functions
 DataType infer_var_type(const char *type_name);
 bool is_arithmetic_op(BinOpType op);
 bool is_relational_op(BinOpType op);
-bool is_zero_constant(ASTNode *node);
+bool is_zero_constant(const AST *ast, NodeId node);
 void type_conversion_warning(DataType from_type, DataType to_type, const char *context_msg);
 
 #endif
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include "source.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static SourceBuffer* alloc_source_buffer(void) {
+    return (SourceBuffer*)calloc(1, sizeof(SourceBuffer));
+}
+
+SourceBuffer* read_source_stream(FILE *in) {
+    SourceBuffer *source = alloc_source_buffer();
+    if (!source) return NULL;
+
+    size_t capacity = 4096;
+    source->data = (char*)malloc(capacity);
+    while (source->data) {
+        source->size += fread(source->data + source->size, 1, capacity - source->size - 2, in);
+        if (source->size < capacity - 2) {
+            break;
+        }
+        capacity *= 2;
+        char *data = (char*)realloc(source->data, capacity);
+        if (!data) {
+            free(source->data);
+        }
+        source->data = data;
+    }
+    if (!source->data || ferror(in)) {
+        free(source->data);
+        free(source);
+        return NULL;
+    }
+    source->data[source->size] = '\0';
+    source->data[source->size + 1] = '\0';
+    return source;
+}
+
+#ifndef _WIN32
+// 先保留足够的匿名页（内容为0），再把文件映射到开头：文件末尾之后至少有两个'\0'，
+// 即使文件长度正好是页大小的整数倍。映射为私有可写，因为扫描器会临时在记号末尾写'\0'，
+// 只有被写到的页才会复制
+static SourceBuffer* map_source_file(int fd, size_t size) {
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) page = 4096;
+    size_t mapped_size = (size + 2 + (size_t)page - 1) / (size_t)page * (size_t)page;
+
+    void *base = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+    if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, mapped_size);
+        return NULL;
+    }
+
+    SourceBuffer *source = alloc_source_buffer();
+    if (!source) {
+        munmap(base, mapped_size);
+        return NULL;
+    }
+    source->data = (char*)base;
+    source->size = size;
+    source->mapped_size = mapped_size;
+    return source;
+}
+#endif
+
+SourceBuffer* open_source_file(const char *path) {
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+    struct stat st;
+    SourceBuffer *source = NULL;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        source = map_source_file(fd, (size_t)st.st_size);
+    }
+    close(fd);
+    if (source) {
+        return source;
+    }
+#endif
+
+    // Windows的映射视图不能超出文件长度，无法在末尾补'\0'；空文件和管道等也直接读入内存
+    FILE *in = NULL;
+    fopen_s(&in, path, "rb");
+    if (!in) {
+        perror(path);
+        return NULL;
+    }
+    SourceBuffer *buffer = read_source_stream(in);
+    fclose(in);
+    return buffer;
+}
+
+void free_source_buffer(SourceBuffer *source) {
+    if (!source) return;
+#ifndef _WIN32
+    if (source->mapped_size) {
+        munmap(source->data, source->mapped_size);
+    } else
+#endif
+    {
+        free(source->data);
+    }
+    free(source);
+}
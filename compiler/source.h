@@ -0,0 +1,26 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// 整个源文件的内容，扫描器直接在其中原地扫描（yy_scan_buffer）
+typedef struct {
+    char *data;                 // 源文件内容，末尾有两个'\0'（yy_scan_buffer要求）
+    size_t size;                // 不含末尾'\0'的长度
+    size_t mapped_size;         // 映射长度，0表示data由malloc分配
+} SourceBuffer;
+
+// 记号在源文件中的位置，语法分析器用它驻留名称
+typedef struct {
+    int offset;
+    int length;
+} SourceSlice;
+
+// 映射源文件（不支持映射时整个读入内存），失败时返回NULL
+SourceBuffer* open_source_file(const char *path);
+// 读入整个流，用于标准输入
+SourceBuffer* read_source_stream(FILE *in);
+void free_source_buffer(SourceBuffer *source);
+
+#endif
@@ -0,0 +1,604 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssa.h"
+
+// 支配边界，按块连续存放：块b的支配边界为df[df_start[b]]..df[df_start[b + 1] - 1]
+typedef struct {
+    int *df_start;
+    int *df;
+} DominanceFrontiers;
+
+// 对每个有多个前驱的汇合块b，从每个前驱沿支配树向上走到b的直接支配块，途经的块的支配边界都含b
+// （Cooper, Harvey, Kennedy）。第一遍计数，第二遍填入；stamp防止同一块重复加入
+static bool compute_frontiers(const CFG *cfg, DominanceFrontiers *frontiers) {
+    int count = cfg->block_count;
+    frontiers->df_start = (int*)calloc((size_t)count + 1, sizeof(int));
+    int *stamp = (int*)malloc((size_t)count * sizeof(int));
+    int *fill = (int*)malloc((size_t)count * sizeof(int));
+    frontiers->df = NULL;
+    if (!frontiers->df_start || !stamp || !fill) {
+        free(stamp);
+        free(fill);
+        return false;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int b = 0; b < count; b++) stamp[b] = -1;
+        for (int b = 0; b < count; b++) {
+            const BasicBlock *block = &cfg->blocks[b];
+            if (block->pred_count < 2 || block->rpo < 0) continue;
+            for (int p = 0; p < block->pred_count; p++) {
+                int runner = block->preds[p];
+                if (cfg->blocks[runner].rpo < 0) continue;
+                while (runner != block->idom && runner >= 0) {
+                    if (stamp[runner] != b) {
+                        stamp[runner] = b;
+                        if (pass == 0) frontiers->df_start[runner + 1]++;
+                        else frontiers->df[fill[runner]++] = b;
+                    }
+                    runner = cfg->blocks[runner].idom;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int b = 0; b < count; b++) frontiers->df_start[b + 1] += frontiers->df_start[b];
+            for (int b = 0; b < count; b++) fill[b] = frontiers->df_start[b];
+            frontiers->df = (int*)malloc(((size_t)frontiers->df_start[count] + 1) * sizeof(int));
+            if (!frontiers->df) break;
+        }
+    }
+    free(stamp);
+    free(fill);
+    return frontiers->df != NULL;
+}
+
+static void free_frontiers(DominanceFrontiers *frontiers) {
+    free(frontiers->df_start);
+    free(frontiers->df);
+}
+
+// 构造过程中的变量信息，按变量编号索引
+typedef struct {
+    IRVarMap map;
+    const char **names;     // 构造成功后交给SSAForm
+    DataType *types;
+    bool *global;           // 在某个块中赋值之前就被读取，值来自其他块
+    bool *pinned;           // 出现在IR_LOAD和IR_STORE以外的位置，保持为变量不改写
+    int *stored_in;         // 最近一次赋值所在的块
+    int *def_head;          // 赋值所在块的链表：def_block/def_next，每块只记一次
+    int *def_block;
+    int *def_next;
+    int count;
+    int def_count;
+    int store_count;
+} VarInfo;
+
+static void free_var_info(VarInfo *vars) {
+    free_ir_var_map(&vars->map);
+    free(vars->types);
+    free(vars->global);
+    free(vars->pinned);
+    free(vars->stored_in);
+    free(vars->def_head);
+    free(vars->def_block);
+    free(vars->def_next);
+}
+
+static int intern_var(VarInfo *vars, const Operand *operand) {
+    int v = ir_var_intern(&vars->map, operand->var_name);
+    if (v < vars->count) return v;
+    vars->count++;
+    vars->names[v] = operand->var_name;
+    vars->types[v] = operand->data_type;
+    vars->stored_in[v] = -1;
+    vars->def_head[v] = -1;
+    return v;
+}
+
+// 收集变量、每个变量的赋值块，以及哪些变量跨块活跃
+static bool scan_variables(const CFG *cfg, IRGenerator *gen, VarInfo *vars) {
+    size_t occurrences = 0;
+    for (IRInstruction *instr = gen->instructions; instr; instr = instr->next) {
+        occurrences += is_ir_variable(&instr->result) + is_ir_variable(&instr->operand1) + is_ir_variable(&instr->operand2);
+    }
+    memset(vars, 0, sizeof(*vars));
+    bool ok = init_ir_var_map(&vars->map, occurrences);
+    size_t n = occurrences + 1;
+    vars->names = (const char**)malloc(n * sizeof(const char*));
+    vars->types = (DataType*)malloc(n * sizeof(DataType));
+    vars->global = (bool*)calloc(n, sizeof(bool));
+    vars->pinned = (bool*)calloc(n, sizeof(bool));
+    vars->stored_in = (int*)malloc(n * sizeof(int));
+    vars->def_head = (int*)malloc(n * sizeof(int));
+    vars->def_block = (int*)malloc(n * sizeof(int));
+    vars->def_next = (int*)malloc(n * sizeof(int));
+    if (!ok || !vars->names || !vars->types || !vars->global || !vars->pinned || !vars->stored_in ||
+        !vars->def_head || !vars->def_block || !vars->def_next) {
+        return false;
+    }
+
+    for (int b = 0; b < cfg->block_count; b++) {
+        const BasicBlock *block = &cfg->blocks[b];
+        for (IRInstruction *instr = block->first; ; instr = instr->next) {
+            if (instr->opcode == IR_LOAD && is_ir_variable(&instr->operand1)) {
+                int v = intern_var(vars, &instr->operand1);
+                if (vars->stored_in[v] != b) vars->global[v] = true;
+            } else if (instr->opcode == IR_STORE && is_ir_variable(&instr->result)) {
+                int v = intern_var(vars, &instr->result);
+                vars->store_count++;
+                if (vars->stored_in[v] != b && block->rpo >= 0) {
+                    vars->def_block[vars->def_count] = b;
+                    vars->def_next[vars->def_count] = vars->def_head[v];
+                    vars->def_head[v] = vars->def_count++;
+                }
+                vars->stored_in[v] = b;
+                if (is_ir_variable(&instr->operand1)) vars->pinned[intern_var(vars, &instr->operand1)] = true;
+            } else {
+                const Operand *slots[3] = { &instr->result, &instr->operand1, &instr->operand2 };
+                for (int i = 0; i < 3; i++) {
+                    if (is_ir_variable(slots[i])) vars->pinned[intern_var(vars, slots[i])] = true;
+                }
+            }
+            if (instr == block->last) break;
+        }
+    }
+    return true;
+}
+
+typedef struct {
+    int block;
+    int var;
+} PhiSite;
+
+// 对每个跨块活跃的变量，从它的赋值块出发沿支配边界迭代放置phi（Cytron等）；
+// 返回phi位置数组（未按块排序），内存不足时返回NULL
+static PhiSite* place_phis(const CFG *cfg, const DominanceFrontiers *frontiers, VarInfo *vars,
+                           int *site_count, int *global_count) {
+    int count = cfg->block_count;
+    int *has_phi = (int*)malloc((size_t)count * sizeof(int));
+    int *on_list = (int*)malloc((size_t)count * sizeof(int));
+    int *worklist = (int*)malloc((size_t)count * sizeof(int));
+    int capacity = 64;
+    PhiSite *sites = (PhiSite*)malloc((size_t)capacity * sizeof(PhiSite));
+    *site_count = 0;
+    *global_count = 0;
+    bool ok = has_phi && on_list && worklist && sites;
+    for (int b = 0; ok && b < count; b++) has_phi[b] = on_list[b] = -1;
+
+    for (int v = 0; ok && v < vars->count; v++) {
+        if (!vars->global[v] || vars->pinned[v]) continue;
+        (*global_count)++;
+        int n = 0;
+        for (int d = vars->def_head[v]; d >= 0; d = vars->def_next[d]) {
+            on_list[vars->def_block[d]] = v;
+            worklist[n++] = vars->def_block[d];
+        }
+        while (ok && n > 0) {
+            int x = worklist[--n];
+            for (int i = frontiers->df_start[x]; ok && i < frontiers->df_start[x + 1]; i++) {
+                int y = frontiers->df[i];
+                if (has_phi[y] == v) continue;
+                has_phi[y] = v;
+                if (*site_count == capacity) {
+                    capacity *= 2;
+                    PhiSite *grown = (PhiSite*)realloc(sites, (size_t)capacity * sizeof(PhiSite));
+                    if (!grown) {
+                        ok = false;
+                        break;
+                    }
+                    sites = grown;
+                }
+                sites[(*site_count)++] = (PhiSite){ y, v };
+                if (on_list[y] != v) {
+                    on_list[y] = v;
+                    worklist[n++] = y;
+                }
+            }
+        }
+    }
+    free(has_phi);
+    free(on_list);
+    free(worklist);
+    if (!ok) {
+        free(sites);
+        return NULL;
+    }
+    return sites;
+}
+
+// 重命名时记录被覆盖的版本，离开块时按相反顺序恢复
+typedef struct {
+    int var;
+    Operand previous;
+} VersionUndo;
+
+typedef struct {
+    IRGenerator *gen;
+    SSAForm *ssa;
+    const VarInfo *vars;
+    const int *phi_vars;    // 与ssa->phis对应的变量编号
+    Operand *current;       // 每个变量的当前版本，尚未赋值时为OPERAND_NONE
+    VersionUndo *undo;
+    int undo_count;
+    int *stack;             // 支配树遍历栈，每帧为块编号、下一个要访问的子节点和进入时的撤销日志长度
+} Renamer;
+
+static void define_version(Renamer *rn, int v, Operand version) {
+    rn->undo[rn->undo_count++] = (VersionUndo){ v, rn->current[v] };
+    rn->current[v] = version;
+}
+
+static void rename_block(Renamer *rn, int b) {
+    const CFG *cfg = rn->ssa->cfg;
+    const BasicBlock *block = &cfg->blocks[b];
+    for (IRInstruction *instr = block->first; ; instr = instr->next) {
+        if (instr->opcode == IR_PHI) {
+            int v = ir_var_id(&rn->vars->map, instr->operand1.var_name);
+            instr->result = create_temp_operand(get_next_temp(rn->gen), rn->vars->types[v]);
+            define_version(rn, v, instr->result);
+        } else if (instr->opcode == IR_LOAD && is_ir_variable(&instr->operand1)) {
+            int v = ir_var_id(&rn->vars->map, instr->operand1.var_name);
+            if (!rn->vars->pinned[v] && HAS_OPERAND(rn->current[v])) {
+                instr->opcode = IR_ASSIGN;
+                instr->operand1 = rn->current[v];
+                rn->ssa->renamed_loads++;
+            }
+        } else if (instr->opcode == IR_STORE && is_ir_variable(&instr->result)) {
+            int v = ir_var_id(&rn->vars->map, instr->result.var_name);
+            if (!rn->vars->pinned[v]) {
+                instr->result = create_temp_operand(get_next_temp(rn->gen), instr->result.data_type);
+                instr->opcode = instr->operand1.type == OPERAND_CONST ? IR_LOAD_CONST :
+                                instr->operand1.type == OPERAND_VAR ? IR_LOAD : IR_ASSIGN;
+                define_version(rn, v, instr->result);
+                rn->ssa->renamed_stores++;
+            }
+        }
+        if (instr == block->last) break;
+    }
+
+    // 本块末尾的版本就是后继块phi中对应本块的参数；从未赋值的变量保留原变量作参数
+    for (int i = 0; i < block->succ_count; i++) {
+        int s = block->succs[i];
+        const BasicBlock *succ = &cfg->blocks[s];
+        int j = 0;
+        while (succ->preds[j] != b) j++;
+        for (int k = rn->ssa->block_phis[s]; k < rn->ssa->block_phis[s + 1]; k++) {
+            Operand version = rn->current[rn->phi_vars[k]];
+            if (HAS_OPERAND(version)) rn->ssa->phis[k]->phi_args[j] = version;
+        }
+    }
+}
+
+// 沿支配树非递归先序重命名：块内新定义的版本只对它支配的块可见
+static void rename_variables(Renamer *rn) {
+    const CFG *cfg = rn->ssa->cfg;
+    int *stack = rn->stack;
+    int depth = 1;
+    stack[0] = 0;
+    stack[1] = cfg->blocks[0].dom_first_child;
+    stack[2] = 0;
+    rename_block(rn, 0);
+    while (depth > 0) {
+        int *frame = &stack[(depth - 1) * 3];
+        int child = frame[1];
+        if (child >= 0) {
+            frame[1] = cfg->blocks[child].dom_next_sibling;
+            int *next = &stack[depth * 3];
+            next[0] = child;
+            next[1] = cfg->blocks[child].dom_first_child;
+            next[2] = rn->undo_count;
+            rename_block(rn, child);
+            depth++;
+        } else {
+            while (rn->undo_count > frame[2]) {
+                VersionUndo *undo = &rn->undo[--rn->undo_count];
+                rn->current[undo->var] = undo->previous;
+            }
+            depth--;
+        }
+    }
+}
+
+// 按块排列phi，创建phi指令并插在块首的标签之后；失败时IR尚未修改
+static bool create_phis(IRGenerator *gen, SSAForm *ssa, const VarInfo *vars,
+                        const PhiSite *sites, int site_count, int *phi_vars) {
+    const CFG *cfg = ssa->cfg;
+    int *fill = (int*)malloc(((size_t)cfg->block_count + 1) * sizeof(int));
+    ssa->block_phis = (int*)calloc((size_t)cfg->block_count + 1, sizeof(int));
+    ssa->phis = (IRInstruction**)malloc(((size_t)site_count + 1) * sizeof(IRInstruction*));
+    if (!fill || !ssa->block_phis || !ssa->phis) {
+        free(fill);
+        return false;
+    }
+    for (int i = 0; i < site_count; i++) ssa->block_phis[sites[i].block + 1]++;
+    for (int b = 0; b < cfg->block_count; b++) ssa->block_phis[b + 1] += ssa->block_phis[b];
+    memcpy(fill, ssa->block_phis, (size_t)cfg->block_count * sizeof(int));
+    for (int i = 0; i < site_count; i++) {
+        int k = fill[sites[i].block]++;
+        phi_vars[k] = sites[i].var;
+        ssa->phi_arg_count += cfg->blocks[sites[i].block].pred_count;
+    }
+    free(fill);
+
+    ssa->phi_args = (Operand*)malloc(((size_t)ssa->phi_arg_count + 1) * sizeof(Operand));
+    if (!ssa->phi_args) return false;
+    for (int k = 0; k < site_count; k++) {
+        ssa->phis[k] = create_ir_instruction(gen, IR_PHI);
+        if (!ssa->phis[k]) return false;
+    }
+    ssa->phi_count = site_count;
+
+    Operand *args = ssa->phi_args;
+    for (int b = 0; b < cfg->block_count; b++) {
+        BasicBlock *block = &cfg->blocks[b];
+        IRInstruction *position = block->first;
+        for (int k = ssa->block_phis[b]; k < ssa->block_phis[b + 1]; k++) {
+            IRInstruction *phi = ssa->phis[k];
+            int v = phi_vars[k];
+            phi->operand1 = create_var_operand(vars->names[v], vars->types[v]);
+            phi->phi_arg_count = block->pred_count;
+            phi->phi_args = args;
+            for (int j = 0; j < block->pred_count; j++) args[j] = phi->operand1;
+            args += block->pred_count;
+            phi->line = block->first->line;
+            phi->column = block->first->column;
+
+            // 汇合块都是跳转目标，以标签开头
+            if (position->opcode == IR_LABEL) {
+                insert_instruction_after(gen, position, phi);
+                if (block->last == position) block->last = phi;
+            } else {
+                insert_instruction_before(gen, position, phi);
+                if (position == block->first) block->first = phi;
+            }
+            position = phi;
+            block->instruction_count++;
+        }
+    }
+    return true;
+}
+
+SSAForm* construct_ssa(IRGenerator *gen) {
+    SSAForm *ssa = (SSAForm*)calloc(1, sizeof(SSAForm));
+    if (!ssa) return NULL;
+    ssa->cfg = build_cfg(gen);
+    if (!ssa->cfg) {
+        free(ssa);
+        return NULL;
+    }
+    const CFG *cfg = ssa->cfg;
+    if (cfg->block_count == 0) {
+        ssa->block_phis = (int*)calloc(1, sizeof(int));
+        if (!ssa->block_phis) {
+            free_ssa(ssa);
+            return NULL;
+        }
+        return ssa;
+    }
+
+    VarInfo vars;
+    DominanceFrontiers frontiers = { NULL, NULL };
+    PhiSite *sites = NULL;
+    int site_count = 0;
+    int *phi_vars = NULL;
+    Renamer rn = { gen, ssa, &vars, NULL, NULL, NULL, 0, NULL };
+
+    bool ok = scan_variables(cfg, gen, &vars) && compute_frontiers(cfg, &frontiers);
+    if (ok) {
+        sites = place_phis(cfg, &frontiers, &vars, &site_count, &ssa->global_count);
+        ok = sites != NULL;
+    }
+    if (ok) {
+        phi_vars = (int*)malloc(((size_t)site_count + 1) * sizeof(int));
+        rn.current = (Operand*)calloc((size_t)vars.count + 1, sizeof(Operand));
+        rn.undo = (VersionUndo*)malloc(((size_t)site_count + vars.store_count + 1) * sizeof(VersionUndo));
+        rn.stack = (int*)malloc((size_t)cfg->block_count * 3 * sizeof(int));
+        ok = phi_vars && rn.current && rn.undo && rn.stack;
+    }
+    // 到这里为止IR没有被修改
+    if (ok) ok = create_phis(gen, ssa, &vars, sites, site_count, phi_vars);
+    if (ok) {
+        rn.phi_vars = phi_vars;
+        rename_variables(&rn);
+    }
+
+    free_frontiers(&frontiers);
+    free(sites);
+    free(phi_vars);
+    free(rn.current);
+    free(rn.undo);
+    free(rn.stack);
+    free_var_info(&vars);
+    ssa->vars = vars.names;
+    ssa->var_count = vars.count;
+    if (!ok) {
+        free_ssa(ssa);
+        return NULL;
+    }
+    return ssa;
+}
+
+// 退出SSA时插入的指令预先从区域中分配好，分配失败时IR保持不变
+typedef struct {
+    IRInstruction **items;
+    int used;
+} InstructionPool;
+
+static IRInstruction* take_instruction(InstructionPool *pool, IROpcode opcode, const IRInstruction *origin) {
+    IRInstruction *instr = pool->items[pool->used++];
+    instr->opcode = opcode;
+    instr->line = origin->line;
+    instr->column = origin->column;
+    return instr;
+}
+
+// 插入位置：before非NULL时插在它之前，否则插在after之后并后移after，保持插入顺序
+typedef struct {
+    IRGenerator *gen;
+    IRInstruction *before;
+    IRInstruction *after;
+} InsertPoint;
+
+static void insert_at(InsertPoint *at, IRInstruction *instr) {
+    if (at->before) {
+        insert_instruction_before(at->gen, at->before, instr);
+    } else {
+        insert_instruction_after(at->gen, at->after, instr);
+        at->after = instr;
+    }
+}
+
+static void insert_copy(InsertPoint *at, InstructionPool *pool, Operand dst, Operand src, const IRInstruction *origin) {
+    IROpcode opcode = src.type == OPERAND_VAR ? IR_LOAD : src.type == OPERAND_CONST ? IR_LOAD_CONST : IR_ASSIGN;
+    IRInstruction *copy = take_instruction(pool, opcode, origin);
+    copy->result = dst;
+    copy->operand1 = src;
+    insert_at(at, copy);
+}
+
+static bool same_temp(const Operand *a, const Operand *b) {
+    return a->type == OPERAND_TEMP && b->type == OPERAND_TEMP && a->temp_id == b->temp_id;
+}
+
+// 块b第j个前驱边上需要的复制条数。phi在块入口同时取值：若某个参数是同一块另一个phi的结果，
+// 顺序复制会读到已被覆盖的值，这时（parallel）先把所有参数复制到新的临时变量再逐个写入
+static int count_edge_copies(const SSAForm *ssa, const int *phi_block, int temp_limit, int b, int j, bool *parallel) {
+    int copies = 0;
+    *parallel = false;
+    for (int k = ssa->block_phis[b]; k < ssa->block_phis[b + 1]; k++) {
+        const Operand *src = &ssa->phis[k]->phi_args[j];
+        if (same_temp(src, &ssa->phis[k]->result)) continue;
+        copies++;
+        if (src->type == OPERAND_TEMP && src->temp_id <= temp_limit && phi_block[src->temp_id] == b) {
+            *parallel = true;
+        }
+    }
+    return *parallel ? copies * 2 : copies;
+}
+
+static void insert_edge_copies(IRGenerator *gen, SSAForm *ssa, InstructionPool *pool, bool parallel,
+                               int b, int j, InsertPoint *at) {
+    int first = ssa->block_phis[b], end = ssa->block_phis[b + 1];
+    for (int k = first; k < end; k++) {
+        IRInstruction *phi = ssa->phis[k];
+        Operand *src = &phi->phi_args[j];
+        if (same_temp(src, &phi->result)) continue;
+        if (parallel) {
+            Operand staged = create_temp_operand(get_next_temp(gen), phi->result.data_type);
+            insert_copy(at, pool, staged, *src, phi);
+            *src = staged;
+        } else {
+            insert_copy(at, pool, phi->result, *src, phi);
+        }
+    }
+    if (!parallel) return;
+    for (int k = first; k < end; k++) {
+        IRInstruction *phi = ssa->phis[k];
+        if (!same_temp(&phi->phi_args[j], &phi->result)) {
+            insert_copy(at, pool, phi->result, phi->phi_args[j], phi);
+        }
+    }
+}
+
+// 前驱的条件跳转跳到b的关键边（b有phi，所以有多个前驱）
+static bool is_critical_jump_edge(const BasicBlock *pred, int b) {
+    return pred->succ_count == 2 && pred->succs[1] != b;
+}
+
+bool destruct_ssa(IRGenerator *gen, SSAForm *ssa) {
+    const CFG *cfg = ssa->cfg;
+    int temp_limit = gen->temp_counter;
+    int *phi_block = (int*)malloc(((size_t)temp_limit + 1) * sizeof(int));
+    if (!phi_block) return false;
+
+    // phi结果所在的块，用于判断一条边上的复制是否需要并行语义
+    for (int t = 0; t <= temp_limit; t++) phi_block[t] = -1;
+    for (int b = 0; b < cfg->block_count; b++) {
+        for (int k = ssa->block_phis[b]; k < ssa->block_phis[b + 1]; k++) {
+            if (ssa->phis[k]->result.type == OPERAND_TEMP) phi_block[ssa->phis[k]->result.temp_id] = b;
+        }
+    }
+
+    // 先数出要插入的指令（复制，以及拆分跳转关键边的标签和goto）并全部分配
+    int needed = 0;
+    for (int b = 0; b < cfg->block_count; b++) {
+        if (ssa->block_phis[b] == ssa->block_phis[b + 1]) continue;
+        const BasicBlock *block = &cfg->blocks[b];
+        for (int j = 0; j < block->pred_count; j++) {
+            bool parallel;
+            needed += count_edge_copies(ssa, phi_block, temp_limit, b, j, &parallel);
+            if (is_critical_jump_edge(&cfg->blocks[block->preds[j]], b)) needed += 2;
+        }
+    }
+    InstructionPool pool = { (IRInstruction**)malloc(((size_t)needed + 1) * sizeof(IRInstruction*)), 0 };
+    bool ok = pool.items != NULL;
+    for (int i = 0; ok && i < needed; i++) {
+        pool.items[i] = create_ir_instruction(gen, IR_ASSIGN);
+        ok = pool.items[i] != NULL;
+    }
+    if (!ok) {
+        free(pool.items);
+        free(phi_block);
+        return false;
+    }
+
+    for (int b = 0; b < cfg->block_count; b++) {
+        if (ssa->block_phis[b] == ssa->block_phis[b + 1]) continue;
+        const BasicBlock *block = &cfg->blocks[b];
+        for (int j = 0; j < block->pred_count; j++) {
+            const BasicBlock *pred = &cfg->blocks[block->preds[j]];
+            IRInstruction *last = pred->last;
+            InsertPoint at = { gen, NULL, NULL };
+            if (pred->succ_count == 2 && pred->succs[1] == b) {
+                // 条件跳转不成立的边是关键边：复制紧跟在跳转之后，成为只能顺序到达的新块
+                at.after = last;
+            } else if (is_critical_jump_edge(pred, b)) {
+                // 条件跳转成立的边是关键边：在函数末尾新建 "Ln: 复制; goto 原目标"，跳转改为跳到Ln
+                IRInstruction *label = take_instruction(&pool, IR_LABEL, last);
+                IRInstruction *jump = take_instruction(&pool, IR_GOTO, last);
+                label->operand1 = create_label_operand(get_next_label(gen));
+                jump->operand1 = block->first->operand1;
+                if (gen->last_instr && gen->last_instr->opcode == IR_FUNC_END) {
+                    insert_instruction_before(gen, gen->last_instr, label);
+                } else {
+                    append_instruction(gen, label);
+                }
+                insert_instruction_after(gen, label, jump);
+                last->operand2 = label->operand1;
+                at.before = jump;
+            } else if (last->opcode == IR_GOTO || last->opcode == IR_IF_GOTO || last->opcode == IR_IF_FALSE_GOTO) {
+                at.before = last;
+            } else {
+                at.after = last;
+            }
+            bool parallel;
+            count_edge_copies(ssa, phi_block, temp_limit, b, j, &parallel);
+            insert_edge_copies(gen, ssa, &pool, parallel, b, j, &at);
+        }
+    }
+
+    for (int k = 0; k < ssa->phi_count; k++) {
+        remove_instruction(gen, ssa->phis[k]);
+    }
+    free(pool.items);
+    free(phi_block);
+    return true;
+}
+
+void free_ssa(SSAForm *ssa) {
+    if (!ssa) return;
+    free_cfg(ssa->cfg);
+    free(ssa->vars);
+    free(ssa->phis);
+    free(ssa->block_phis);
+    free(ssa->phi_args);
+    free(ssa);
+}
+
+void print_ssa_stats(const SSAForm *ssa) {
+    printf("SSA: %d variables (%d live across blocks), %d phis with %d arguments, "
+           "%d stores and %d loads renamed\n",
+           ssa->var_count, ssa->global_count, ssa->phi_count, ssa->phi_arg_count,
+           ssa->renamed_stores, ssa->renamed_loads);
+}
@@ -0,0 +1,34 @@
+#ifndef SSA_H
+#define SSA_H
+
+#include <stdbool.h>
+#include "cfg.h"
+
+// SSA形式：变量（IR_STORE和IR_LOAD中的OPERAND_VAR，字符串字面量除外）的每次赋值都改写为
+// 对一个新临时变量的赋值，读取变量改写为复制当前版本；多个版本在汇合点（支配边界）由IR_PHI合并。
+// 只为跨块活跃的变量放置phi（semi-pruned）。在赋值之前读取的变量仍然读取原变量
+typedef struct {
+    CFG *cfg;                   // 构造时建立；phi插在块首的标签之后，块的首尾指令保持有效
+    const char **vars;          // 变量编号 -> 驻留的变量名
+    int var_count;
+    int global_count;           // 跨块活跃、需要phi的变量数
+    IRInstruction **phis;       // 全部phi，同一块的phi相邻
+    int *block_phis;            // 块b的phi为phis[block_phis[b]]..phis[block_phis[b + 1] - 1]
+    int phi_count;
+    Operand *phi_args;          // 全部phi的参数
+    int phi_arg_count;
+    int renamed_stores;         // 改写为新版本的赋值数
+    int renamed_loads;          // 改写为复制当前版本的读取数
+} SSAForm;
+
+// 把gen中的函数转换为SSA形式，内存不足时返回NULL且不修改IR
+SSAForm* construct_ssa(IRGenerator *gen);
+
+// 退出SSA：在前驱块末尾插入复制代替phi（关键边先拆分，同一条边上的复制按并行语义排列），
+// 然后删除全部phi。内存不足时返回false且IR仍为SSA形式；之后ssa只能释放
+bool destruct_ssa(IRGenerator *gen, SSAForm *ssa);
+void free_ssa(SSAForm *ssa);
+
+void print_ssa_stats(const SSAForm *ssa);
+
+#endif
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "superinstr.h"
+
+// 融合上下文
+typedef struct {
+    BytecodeProgram *prog;
+    bool *is_target;         // 该位置是否为跳转目标
+    bool *deleted;           // 该指令是否已被融合掉
+    int *use_count;          // 每个槽被读取的次数
+    int *def_count;          // 每个槽被写入的次数
+} Fusion;
+
+// 是否写入dst槽
+static bool writes_dst(BCInstr *bc) {
+    switch (bc->opcode) {
+        case BC_MOVE:
+        case BC_LOAD_STR:
+        case BC_CONVERT_INT:
+        case BC_CONVERT_FLOAT:
+        case BC_CALL:
+            return bc->dst >= 0;
+        default:
+            return bc->opcode >= BC_I32_FIRST && bc->opcode <= BC_F32_LAST;
+    }
+}
+
+// 结果可以直接改写到其他槽的指令（纯计算，无副作用）
+static bool is_pure_producer(BCInstr *bc) {
+    return bc->opcode != BC_CALL && writes_dst(bc);
+}
+
+// src1是否为槽下标（LOAD_STR的src1是字符串下标）
+static bool reads_src1(BCInstr *bc) {
+    return bc->src1 >= 0 && bc->opcode != BC_LOAD_STR;
+}
+
+// 只被写一次、读一次的匿名槽（临时变量），可以安全消去
+static bool is_single_use_temp(Fusion *fs, int slot) {
+    BytecodeProgram *prog = fs->prog;
+    return slot >= 0 && slot < prog->slot_count &&
+           prog->slot_name_offsets[slot] == CBC_NO_NAME &&
+           fs->def_count[slot] == 1 && fs->use_count[slot] == 1;
+}
+
+// 统计读写次数并标记跳转目标
+static void analyze(Fusion *fs) {
+    BytecodeProgram *prog = fs->prog;
+    int frame_size = prog->slot_count + prog->const_count;
+
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *bc = &prog->code[pc];
+        if (BC_IS_BRANCH(bc->opcode)) {
+            if (bc->dst >= 0 && bc->dst <= prog->code_count) fs->is_target[bc->dst] = true;
+        } else if (writes_dst(bc) && bc->dst < frame_size) {
+            fs->def_count[bc->dst]++;
+        }
+        if (reads_src1(bc) && bc->src1 < frame_size) fs->use_count[bc->src1]++;
+        if (bc->src2 >= 0 && bc->src2 < frame_size) fs->use_count[bc->src2]++;
+    }
+}
+
+// 下一条未删除的指令，不存在返回-1
+static int next_live(Fusion *fs, int pc) {
+    for (pc++; pc < fs->prog->code_count; pc++) {
+        if (!fs->deleted[pc]) return pc;
+    }
+    return -1;
+}
+
+// binop-store：t = a op b; v = t  =>  v = a op b
+static void forward_stores(Fusion *fs, FusionStats *stats) {
+    BytecodeProgram *prog = fs->prog;
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *producer = &prog->code[pc];
+        if (fs->deleted[pc] || !is_pure_producer(producer) || !is_single_use_temp(fs, producer->dst)) {
+            continue;
+        }
+
+        int next = next_live(fs, pc);
+        if (next < 0 || fs->is_target[next]) continue;
+
+        BCInstr *store = &prog->code[next];
+        if (store->opcode != BC_MOVE || store->src1 != producer->dst) continue;
+
+        producer->dst = store->dst;
+        fs->deleted[next] = true;
+        stats->stores_forwarded++;
+    }
+}
+
+// load-binop / load-load-binop / load-const-binop：
+// t = x; ... y = t op z  =>  y = x op z
+// 要求在同一基本块内，且中间没有写x的指令
+static void forward_loads(Fusion *fs, FusionStats *stats) {
+    BytecodeProgram *prog = fs->prog;
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *load = &prog->code[pc];
+        if (fs->deleted[pc] || load->opcode != BC_MOVE || !is_single_use_temp(fs, load->dst)) {
+            continue;
+        }
+
+        for (int use = next_live(fs, pc); use >= 0; use = next_live(fs, use)) {
+            BCInstr *bc = &prog->code[use];
+            if (fs->is_target[use]) break;
+
+            if (reads_src1(bc) && bc->src1 == load->dst) {
+                bc->src1 = load->src1;
+            } else if (bc->src2 == load->dst) {
+                bc->src2 = load->src1;
+            } else {
+                // 中间指令改写了源槽或离开基本块时放弃
+                if ((writes_dst(bc) && bc->dst == load->src1) || BC_IS_BRANCH(bc->opcode) ||
+                    bc->opcode == BC_RETURN) {
+                    break;
+                }
+                continue;
+            }
+
+            fs->deleted[pc] = true;
+            stats->loads_forwarded++;
+            break;
+        }
+    }
+}
+
+// compare-and-branch：t = a < b; if !t goto L  =>  if !(a < b) goto L
+static void fuse_compare_branches(Fusion *fs, FusionStats *stats) {
+    BytecodeProgram *prog = fs->prog;
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        BCInstr *cmp = &prog->code[pc];
+        if (fs->deleted[pc] || !is_single_use_temp(fs, cmp->dst)) continue;
+
+        BCOpcode fused;
+        if (cmp->opcode >= BC_EQ_I32 && cmp->opcode <= BC_GE_I32) {
+            fused = (BCOpcode)(BC_IFNOT_EQ_I32 + (cmp->opcode - BC_EQ_I32));
+        } else if (cmp->opcode >= BC_EQ_F32 && cmp->opcode <= BC_GE_F32) {
+            fused = (BCOpcode)(BC_IFNOT_EQ_F32 + (cmp->opcode - BC_EQ_F32));
+        } else {
+            continue;
+        }
+
+        int next = next_live(fs, pc);
+        if (next < 0 || fs->is_target[next]) continue;
+
+        BCInstr *branch = &prog->code[next];
+        if (branch->opcode != BC_IF_FALSE || branch->src1 != cmp->dst) continue;
+
+        cmp->opcode = (uint8_t)fused;
+        cmp->dst = branch->dst;
+        fs->deleted[next] = true;
+        stats->compare_branches++;
+    }
+}
+
+// 删除已融合的指令并重定位跳转目标
+static void compact(Fusion *fs) {
+    BytecodeProgram *prog = fs->prog;
+    int *new_index = (int*)malloc((prog->code_count + 1) * sizeof(int));
+
+    // 被删除的指令映射到其后第一条保留的指令
+    int count = 0;
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        new_index[pc] = count;
+        if (!fs->deleted[pc]) count++;
+    }
+    new_index[prog->code_count] = count;
+
+    int out = 0;
+    for (int pc = 0; pc < prog->code_count; pc++) {
+        if (fs->deleted[pc]) continue;
+        BCInstr bc = prog->code[pc];
+        if (BC_IS_BRANCH(bc.opcode) && bc.dst >= 0 && bc.dst <= prog->code_count) {
+            bc.dst = new_index[bc.dst];
+        }
+        prog->code[out++] = bc;
+    }
+    prog->code_count = out;
+
+    free(new_index);
+}
+
+// 在字节码上识别常见指令序列并融合为单条指令
+void fuse_superinstructions(BytecodeProgram *prog, FusionStats *stats) {
+    memset(stats, 0, sizeof(FusionStats));
+    if (!prog) return;
+
+    int frame_size = prog->slot_count + prog->const_count;
+    Fusion fs;
+    fs.prog = prog;
+    fs.is_target = (bool*)calloc(prog->code_count + 1, sizeof(bool));
+    fs.deleted = (bool*)calloc(prog->code_count + 1, sizeof(bool));
+    fs.use_count = (int*)calloc(frame_size + 1, sizeof(int));
+    fs.def_count = (int*)calloc(frame_size + 1, sizeof(int));
+
+    stats->before = prog->code_count;
+    analyze(&fs);
+
+    // 先合并结果写回，再转发装载，最后合并比较与跳转
+    forward_stores(&fs, stats);
+    forward_loads(&fs, stats);
+    fuse_compare_branches(&fs, stats);
+    compact(&fs);
+    stats->after = prog->code_count;
+
+    free(fs.is_target);
+    free(fs.deleted);
+    free(fs.use_count);
+    free(fs.def_count);
+}
+
+// 打印融合统计
+void print_fusion_stats(FusionStats *stats) {
+    printf("Superinstruction fusion: %d -> %d instructions\n", stats->before, stats->after);
+    printf("  Loads forwarded: %d\n", stats->loads_forwarded);
+    printf("  Stores forwarded: %d\n", stats->stores_forwarded);
+    printf("  Compare-and-branch fused: %d\n", stats->compare_branches);
+    printf("  Static dispatches saved: %d\n", stats->before - stats->after);
+}
@@ -0,0 +1,19 @@
+#ifndef SUPERINSTR_H
+#define SUPERINSTR_H
+
+#include "bytecode.h"
+
+// 融合统计
+typedef struct {
+    int loads_forwarded;     // load-binop：临时变量的装载并入使用它的指令
+    int stores_forwarded;    // binop-store：运算结果直接写入目标变量
+    int compare_branches;    // compare-and-branch：比较与条件跳转合并
+    int before;              // 融合前指令数
+    int after;               // 融合后指令数
+} FusionStats;
+
+// 在字节码上识别常见指令序列并融合为单条指令，原地修改程序
+void fuse_superinstructions(BytecodeProgram *prog, FusionStats *stats);
+void print_fusion_stats(FusionStats *stats);
+
+#endif
@@ -1,15 +1,59 @@
 #include "symbol_table.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// ʼλ֮
+#define SYMBOL_INITIAL_SLOTS 64
+
+// Ѿפֱɢָ루Fibonacciɢȡλ
+static unsigned int slot_index(const SymbolTable *table, const char *name) {
+    unsigned long long h = (unsigned long long)(size_t)name * 0x9E3779B97F4A7C15ULL;
+    return (unsigned int)(h >> 32) & (table->slot_capacity - 1);
+}
+
+// ڵĲλʱӦĿղλ
+static SymbolSlot* find_slot(const SymbolTable *table, const char *name) {
+    unsigned int mask = table->slot_capacity - 1;
+    unsigned int i = slot_index(table, name);
+    while (table->slots[i].name && table->slots[i].name != name) {
+        i = (i + 1) & mask;
+    }
+    return &table->slots[i];
+}
+
+static bool grow_slots(SymbolTable *table) {
+    SymbolSlot *old_slots = table->slots;
+    unsigned int old_capacity = table->slot_capacity;
+    SymbolSlot *slots = (SymbolSlot*)calloc(old_capacity * 2, sizeof(SymbolSlot));
+    if (!slots) return false;
+
+    table->slots = slots;
+    table->slot_capacity = old_capacity * 2;
+    for (unsigned int i = 0; i < old_capacity; i++) {
+        if (old_slots[i].name) *find_slot(table, old_slots[i].name) = old_slots[i];
+    }
+    free(old_slots);
+    return true;
+}
+
+static SymbolEntry* entry_at(const SymbolTable *table, unsigned int index) {
+    return &table->chunks[index / SYMBOL_CHUNK_SIZE][index % SYMBOL_CHUNK_SIZE];
+}
+
 // ʼű
 SymbolTable* init_symbol_table() {
-    SymbolTable *table = (SymbolTable*)malloc(sizeof(SymbolTable));
-    if (table) {
-        table->head = NULL;
-        table->current_scope = 0;  // ȫ0ʼ
+    SymbolTable *table = (SymbolTable*)calloc(1, sizeof(SymbolTable));
+    if (!table) return NULL;
+
+    table->slots = (SymbolSlot*)calloc(SYMBOL_INITIAL_SLOTS, sizeof(SymbolSlot));
+    if (!table->slots) {
+        free(table);
+        return NULL;
     }
+    table->slot_capacity = SYMBOL_INITIAL_SLOTS;
+    table->current_scope = 0;  // ȫ0ʼ
     return table;
 }
 
@@ -17,13 +61,11 @@ SymbolTable* init_symbol_table() {
 void free_symbol_table(SymbolTable *table) {
     if (!table) return;
 
-    SymbolEntry *current = table->head;
-    while (current) {
-        SymbolEntry *next = current->next;
-        free(current->name);
-        free(current);
-        current = next;
+    for (unsigned int i = 0; i < table->chunk_count; i++) {
+        free(table->chunks[i]);
     }
+    free(table->chunks);
+    free(table->slots);
     free(table);
 }
 
@@ -31,7 +73,7 @@ void free_symbol_table(SymbolTable *table) {
 void enter_scope(SymbolTable *table) {
     if (table) {
         table->current_scope++;
-        printf("Enter scope: %d\n", table->current_scope);
+        TRACE(TRACE_SYMTAB, TRACE_DEBUG, "enter scope %d", table->current_scope);
     }
 }
 
@@ -39,34 +81,18 @@ void enter_scope(SymbolTable *table) {
 void leave_scope(SymbolTable *table) {
     if (!table || table->current_scope <= 0) return;
     
-    // Delete all symbols in current scope
-    SymbolEntry *current = table->head;
-    SymbolEntry *prev = NULL;
-    
-    while (current) {
-        if (current->scope_level == table->current_scope) {
-            // Delete this symbol
-            SymbolEntry *to_delete = current;
-            
-            if (prev) {
-                prev->next = current->next;
-                current = current->next;
-            } else {
-                table->head = current->next;
-                current = table->head;
-            }
-            
-            printf("Delete symbol: %s (scope: %d)\n", to_delete->name, to_delete->scope_level);
-            free(to_delete->name);
-            free(to_delete);
-        } else {
-            prev = current;
-            current = current->next;
-        }
+    // ķŶڳջָڱε
+    while (table->entry_count > 0) {
+        SymbolEntry *entry = entry_at(table, table->entry_count - 1);
+        if (entry->scope_level != table->current_scope) break;
+
+        find_slot(table, entry->name)->entry = entry->shadowed;
+        table->entry_count--;
+        TRACE(TRACE_SYMTAB, TRACE_DEBUG, "delete symbol %s (scope %d)", entry->name, entry->scope_level);
     }
     
     table->current_scope--;
-    printf("Leave scope, current scope: %d\n", table->current_scope);
+    TRACE(TRACE_SYMTAB, TRACE_DEBUG, "leave scope, current scope %d", table->current_scope);
 }
 
 // ӷŵű
@@ -79,59 +105,64 @@ bool add_symbol(SymbolTable *table, const char *name, SymbolKind kind, DataType
         return false;
     }
     
-    // ·ű
-    SymbolEntry *entry = (SymbolEntry*)malloc(sizeof(SymbolEntry));
-    if (!entry) return false;
+    // ջĿʱ׷һ飬еķŲƶ
+    if (table->entry_count == table->chunk_count * SYMBOL_CHUNK_SIZE) {
+        SymbolEntry **chunks = (SymbolEntry**)realloc(table->chunks, (table->chunk_count + 1) * sizeof(SymbolEntry*));
+        if (!chunks) return false;
+        table->chunks = chunks;
+        table->chunks[table->chunk_count] = (SymbolEntry*)malloc(SYMBOL_CHUNK_SIZE * sizeof(SymbolEntry));
+        if (!table->chunks[table->chunk_count]) return false;
+        table->chunk_count++;
+    }
     
-    entry->name = _strdup(name);
+    // ռһλװӳ1/2ʱ
+    SymbolSlot *slot = find_slot(table, name);
+    if (!slot->name) {
+        if ((table->name_count + 1) * 2 > table->slot_capacity) {
+            if (!grow_slots(table)) return false;
+            slot = find_slot(table, name);
+        }
+        slot->name = name;
+        slot->entry = NULL;
+        table->name_count++;
+    }
+    
+    // ѹ볷ջΪڲķ
+    SymbolEntry *entry = entry_at(table, table->entry_count++);
+    entry->name = name;
     entry->kind = kind;
     entry->type = type;
     entry->scope_level = table->current_scope;
+    entry->id = ++table->symbol_count;
+    entry->shadowed = slot->entry;
+    slot->entry = entry;
     
-    // Insert to symbol table head
-    entry->next = table->head;
-    table->head = entry;
-    
-    printf("Add symbol: %s, type: %s, scope: %d\n", 
-           name, data_type_to_str(type), table->current_scope);
+    TRACE(TRACE_SYMTAB, TRACE_INFO, "add symbol %s, type %s, scope %d",
+          name, data_type_to_str(type), table->current_scope);
     
     return true;
 }
 
-// ڷűвҷţ
+// ڷűвҷţ򣩣λڲͬ
 SymbolEntry* lookup_symbol(SymbolTable *table, const char *name) {
     if (!table || !name) return NULL;
     
-    SymbolEntry *current = table->head;
-    
-    while (current) {
-        if (strcmp(current->name, name) == 0) {
-            return current; // ҵ
-        }
-        current = current->next;
-    }
-    
-    return NULL; // δҵ
+    return find_slot(table, name)->entry;
 }
 
 // ڵǰвҷ
 SymbolEntry* lookup_symbol_current_scope(SymbolTable *table, const char *name) {
     if (!table || !name) return NULL;
     
-    SymbolEntry *current = table->head;
-    
-    while (current) {
-        if (current->scope_level == table->current_scope && 
-            strcmp(current->name, name) == 0) {
-            return current;
-        }
-        current = current->next;
+    SymbolEntry *entry = find_slot(table, name)->entry;
+    if (entry && entry->scope_level == table->current_scope) {
+        return entry;
     }
     
     return NULL;
 }
 
-// ӡű
+// ӡűݣķſʼ
 void print_symbol_table(SymbolTable *table) {
     if (!table) return;
     
@@ -139,16 +170,13 @@ void print_symbol_table(SymbolTable *table) {
     printf("%-15s %-10s %-10s %s\n", "Name", "Kind", "Type", "Scope");
     printf("--------------------------------------------\n");
     
-    SymbolEntry *current = table->head;
-    
-    while (current) {
+    for (unsigned int i = table->entry_count; i > 0; i--) {
+        SymbolEntry *current = entry_at(table, i - 1);
         printf("%-15s %-10s %-10s %d\n", 
                current->name,
                current->kind == SYM_VARIABLE ? "Variable" : "Function",
                data_type_to_str(current->type),
                current->scope_level);
-        
-        current = current->next;
     }
     
     printf("==================\n\n");
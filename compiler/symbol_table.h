@@ -3,6 +3,9 @@
 
 #include <stdbool.h>
 
+// ջÿķ
+#define SYMBOL_CHUNK_SIZE 256
+
 // 
 typedef enum {
     SYM_VARIABLE,  // 
@@ -18,16 +21,32 @@ typedef enum {
 
 // ű
 typedef struct SymbolEntry {
-    char *name;             // 
+    const char *name;       // פַָȽϣ
     SymbolKind kind;        // ࣨ
     DataType type;          // 
     int scope_level;        // 򼶱
-    struct SymbolEntry *next;  // һ
+    unsigned int id;        // űţÿһ±ţ1ʼ뿪Ҳ
+    struct SymbolEntry *shadowed;  // ڱεͬţ뿪ʱָ
 } SymbolEntry;
 
-// ű
+// ϣһλƷƳentryΪƵǰɼڲţΪNULL
+typedef struct {
+    const char *name;
+    SymbolEntry *entry;
+} SymbolSlot;
+
+// űָ뿪ŶַĹϣϰ˳еĳջ
+// ֻһλ뿪ʱջķţֻ漰Щ
 typedef struct {
-    SymbolEntry *head;      // űͷָ
+    SymbolSlot *slots;      // Ϊ2ݣװӲ1/2
+    unsigned int slot_capacity;
+    unsigned int name_count;    // ռõĲλ
+
+    SymbolEntry **chunks;   // ջichunks[i / SYMBOL_CHUNK_SIZE]Уַջƶ
+    unsigned int chunk_count;
+    unsigned int entry_count;
+    unsigned int symbol_count;  // ѷķű
+
     int current_scope;      // ǰ򼶱
 } SymbolTable;
 
@@ -36,6 +55,7 @@ SymbolTable* init_symbol_table();
 void free_symbol_table(SymbolTable *table);
 void enter_scope(SymbolTable *table);
 void leave_scope(SymbolTable *table);
+// ƱԱ뵥ԪפʱֻȽָ
 bool add_symbol(SymbolTable *table, const char *name, SymbolKind kind, DataType type);
 SymbolEntry* lookup_symbol(SymbolTable *table, const char *name);
 SymbolEntry* lookup_symbol_current_scope(SymbolTable *table, const char *name);
@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "threadpool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE thread_t;
+typedef CRITICAL_SECTION mutex_t;
+typedef CONDITION_VARIABLE cond_t;
+#define mutex_init(m)       InitializeCriticalSection(m)
+#define mutex_destroy(m)    DeleteCriticalSection(m)
+#define mutex_lock(m)       EnterCriticalSection(m)
+#define mutex_unlock(m)     LeaveCriticalSection(m)
+#define cond_init(c)        InitializeConditionVariable(c)
+#define cond_destroy(c)     ((void)(c))
+#define cond_wait(c, m)     SleepConditionVariableCS(c, m, INFINITE)
+#define cond_signal(c)      WakeConditionVariable(c)
+#define cond_broadcast(c)   WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t thread_t;
+typedef pthread_mutex_t mutex_t;
+typedef pthread_cond_t cond_t;
+#define mutex_init(m)       pthread_mutex_init(m, NULL)
+#define mutex_destroy(m)    pthread_mutex_destroy(m)
+#define mutex_lock(m)       pthread_mutex_lock(m)
+#define mutex_unlock(m)     pthread_mutex_unlock(m)
+#define cond_init(c)        pthread_cond_init(c, NULL)
+#define cond_destroy(c)     pthread_cond_destroy(c)
+#define cond_wait(c, m)     pthread_cond_wait(c, m)
+#define cond_signal(c)      pthread_cond_signal(c)
+#define cond_broadcast(c)   pthread_cond_broadcast(c)
+#endif
+
+// 计数器的原子操作（顺序一致，休眠/唤醒的判断依赖这一点）
+#if defined(_MSC_VER)
+#define atomic_add(p, v)    (InterlockedExchangeAdd((volatile LONG*)(p), (v)) + (v))
+#define atomic_get(p)       InterlockedCompareExchange((volatile LONG*)(p), 0, 0)
+#else
+#define atomic_add(p, v)    __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define atomic_get(p)       __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#endif
+
+typedef struct {
+    ThreadTask task;
+    void *arg;
+} PoolTask;
+
+// 每个工作线程一个双端队列：所有者从尾部取（后进先出），其他线程从头部窃取（先进先出）
+typedef struct {
+    mutex_t lock;
+    PoolTask *tasks;            // 环形数组，容量为2的幂
+    int capacity;
+    int head;
+    int count;
+} WorkQueue;
+
+typedef struct {
+    ThreadPool *pool;
+    int index;
+} Worker;
+
+struct ThreadPool {
+    thread_t *threads;
+    Worker *workers;
+    WorkQueue *queues;
+    int thread_count;
+    int started;                // 已启动的线程数
+    int next_queue;             // 外部提交的任务轮流放入各队列
+
+    volatile long queued;       // 所有队列中的任务数
+    volatile long pending;      // 已提交但未完成的任务数
+    volatile long sleeping;     // 正在等待任务的线程数
+    volatile long steals;       // 累计窃取次数
+
+    mutex_t lock;               // 只用于休眠和唤醒
+    cond_t task_ready;
+    cond_t all_done;
+    bool shutdown;
+};
+
+static bool init_work_queue(WorkQueue *queue) {
+    queue->capacity = 64;
+    queue->head = 0;
+    queue->count = 0;
+    queue->tasks = (PoolTask*)malloc(sizeof(PoolTask) * queue->capacity);
+    mutex_init(&queue->lock);
+    return queue->tasks != NULL;
+}
+
+static void free_work_queue(WorkQueue *queue) {
+    mutex_destroy(&queue->lock);
+    free(queue->tasks);
+}
+
+static bool push_task(WorkQueue *queue, PoolTask task) {
+    mutex_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        // 扩容时把环形数组展开到新数组的开头
+        int capacity = queue->capacity * 2;
+        PoolTask *tasks = (PoolTask*)malloc(sizeof(PoolTask) * capacity);
+        if (!tasks) {
+            mutex_unlock(&queue->lock);
+            return false;
+        }
+        for (int i = 0; i < queue->count; i++) {
+            tasks[i] = queue->tasks[(queue->head + i) & (queue->capacity - 1)];
+        }
+        free(queue->tasks);
+        queue->tasks = tasks;
+        queue->capacity = capacity;
+        queue->head = 0;
+    }
+    queue->tasks[(queue->head + queue->count) & (queue->capacity - 1)] = task;
+    queue->count++;
+    mutex_unlock(&queue->lock);
+    return true;
+}
+
+// 所有者取最新的任务
+static bool pop_task(WorkQueue *queue, PoolTask *task) {
+    bool found = false;
+    mutex_lock(&queue->lock);
+    if (queue->count > 0) {
+        queue->count--;
+        *task = queue->tasks[(queue->head + queue->count) & (queue->capacity - 1)];
+        found = true;
+    }
+    mutex_unlock(&queue->lock);
+    return found;
+}
+
+// 窃取者取最早的任务
+static bool steal_task(WorkQueue *queue, PoolTask *task) {
+    bool found = false;
+    mutex_lock(&queue->lock);
+    if (queue->count > 0) {
+        *task = queue->tasks[queue->head];
+        queue->head = (queue->head + 1) & (queue->capacity - 1);
+        queue->count--;
+        found = true;
+    }
+    mutex_unlock(&queue->lock);
+    return found;
+}
+
+// 先取自己队列中的任务，为空时依次从其他线程的队列窃取
+static bool take_task(ThreadPool *pool, int self, PoolTask *task) {
+    if (pop_task(&pool->queues[self], task)) {
+        return true;
+    }
+    for (int i = 1; i < pool->thread_count; i++) {
+        int victim = (self + i) % pool->thread_count;
+        if (steal_task(&pool->queues[victim], task)) {
+            atomic_add(&pool->steals, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID param)
+#else
+static void* worker_main(void *param)
+#endif
+{
+    Worker *worker = (Worker*)param;
+    ThreadPool *pool = worker->pool;
+
+    while (true) {
+        PoolTask task;
+        if (take_task(pool, worker->index, &task)) {
+            atomic_add(&pool->queued, -1);
+            task.task(task.arg);
+            if (atomic_add(&pool->pending, -1) == 0) {
+                mutex_lock(&pool->lock);
+                cond_broadcast(&pool->all_done);
+                mutex_unlock(&pool->lock);
+            }
+            continue;
+        }
+
+        // 所有队列都空了：先登记为休眠再检查，与提交方的“先入队再检查休眠数”配合，不会丢失唤醒
+        mutex_lock(&pool->lock);
+        atomic_add(&pool->sleeping, 1);
+        while (atomic_get(&pool->queued) == 0 && !pool->shutdown) {
+            cond_wait(&pool->task_ready, &pool->lock);
+        }
+        atomic_add(&pool->sleeping, -1);
+        bool done = pool->shutdown && atomic_get(&pool->queued) == 0;
+        mutex_unlock(&pool->lock);
+        if (done) break;
+    }
+    return 0;
+}
+
+static bool start_thread(thread_t *thread, Worker *worker) {
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, worker_main, worker, 0, NULL);
+    return *thread != NULL;
+#else
+    return pthread_create(thread, NULL, worker_main, worker) == 0;
+#endif
+}
+
+static void join_thread(thread_t thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+int cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+ThreadPool* init_thread_pool(int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = cpu_count();
+    }
+
+    ThreadPool *pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+
+    pool->threads = (thread_t*)malloc(sizeof(thread_t) * thread_count);
+    pool->workers = (Worker*)malloc(sizeof(Worker) * thread_count);
+    pool->queues = (WorkQueue*)calloc(thread_count, sizeof(WorkQueue));
+    if (!pool->threads || !pool->workers || !pool->queues) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool->queues);
+        free(pool);
+        return NULL;
+    }
+
+    mutex_init(&pool->lock);
+    cond_init(&pool->task_ready);
+    cond_init(&pool->all_done);
+
+    // 队列先全部建好，工作线程一启动就可能去窃取
+    for (int i = 0; i < thread_count; i++) {
+        if (!init_work_queue(&pool->queues[i])) {
+            pool->thread_count = i + 1;
+            free_thread_pool(pool);
+            return NULL;
+        }
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+    }
+    pool->thread_count = thread_count;
+
+    for (int i = 0; i < thread_count; i++) {
+        if (!start_thread(&pool->threads[i], &pool->workers[i])) {
+            // 部分线程启动失败时整体失败，已启动的线程随即退出
+            fprintf(stderr, "Cannot start worker thread %d\n", i);
+            pool->started = i;
+            free_thread_pool(pool);
+            return NULL;
+        }
+    }
+    pool->started = thread_count;
+    return pool;
+}
+
+void free_thread_pool(ThreadPool *pool) {
+    if (!pool) return;
+
+    mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    cond_broadcast(&pool->task_ready);
+    mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->started; i++) {
+        join_thread(pool->threads[i]);
+    }
+
+    cond_destroy(&pool->task_ready);
+    cond_destroy(&pool->all_done);
+    mutex_destroy(&pool->lock);
+    for (int i = 0; i < pool->thread_count; i++) {
+        free_work_queue(&pool->queues[i]);
+    }
+    free(pool->queues);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool);
+}
+
+bool thread_pool_submit(ThreadPool *pool, ThreadTask task, void *arg) {
+    PoolTask entry = { task, arg };
+    int index = pool->next_queue;
+    pool->next_queue = (index + 1) % pool->thread_count;
+
+    atomic_add(&pool->pending, 1);
+    atomic_add(&pool->queued, 1);
+    if (!push_task(&pool->queues[index], entry)) {
+        atomic_add(&pool->queued, -1);
+        atomic_add(&pool->pending, -1);
+        return false;
+    }
+
+    if (atomic_get(&pool->sleeping) > 0) {
+        mutex_lock(&pool->lock);
+        cond_signal(&pool->task_ready);
+        mutex_unlock(&pool->lock);
+    }
+    return true;
+}
+
+void thread_pool_wait(ThreadPool *pool) {
+    mutex_lock(&pool->lock);
+    while (atomic_get(&pool->pending) > 0) {
+        cond_wait(&pool->all_done, &pool->lock);
+    }
+    mutex_unlock(&pool->lock);
+}
+
+int thread_pool_size(ThreadPool *pool) {
+    return pool->thread_count;
+}
+
+long thread_pool_steals(ThreadPool *pool) {
+    return atomic_get(&pool->steals);
+}
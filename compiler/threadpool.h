@@ -0,0 +1,23 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdbool.h>
+
+// 线程池任务：在某个工作线程上调用task(arg)
+typedef void (*ThreadTask)(void *arg);
+
+// 固定数量工作线程，每个线程一个任务队列；自己的队列为空时从其他线程的队列窃取任务
+typedef struct ThreadPool ThreadPool;
+
+ThreadPool* init_thread_pool(int thread_count);
+void free_thread_pool(ThreadPool *pool);     // 等待队列中的任务完成后结束工作线程
+
+bool thread_pool_submit(ThreadPool *pool, ThreadTask task, void *arg);
+void thread_pool_wait(ThreadPool *pool);     // 等待已提交的任务全部完成
+int thread_pool_size(ThreadPool *pool);
+long thread_pool_steals(ThreadPool *pool);  // 累计从其他线程队列窃取的任务数
+
+// 可用的处理器核数
+int cpu_count(void);
+
+#endif
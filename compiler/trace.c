@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "trace.h"
+#include "bench.h"
+
+#define TRACE_MAX_ARGS      4
+#define TRACE_TEXT_SIZE     32
+#define TRACE_RING_DEFAULT  4096
+
+// 环形缓冲区中的定长记录：只保存格式串指针和原始参数，不做格式化
+typedef union {
+    long long i;
+    double f;
+    const void *p;
+    int text_offset;            // %s：字符串在text中的偏移（已复制）
+} TraceArg;
+
+typedef struct {
+    long long time_ns;
+    const char *fmt;            // 格式串常量
+    uint8_t category;
+    uint8_t level;
+    uint8_t arg_count;
+    uint8_t reserved;
+    TraceArg args[TRACE_MAX_ARGS];
+    char text[TRACE_TEXT_SIZE]; // %s参数的副本（超长截断）
+} TraceRecord;
+
+uint8_t trace_levels[TRACE_CATEGORY_COUNT];
+
+static TraceSink trace_sink = TRACE_SINK_TEXT;
+static TraceRecord *ring = NULL;
+static unsigned ring_capacity = 0;   // 2的幂
+static unsigned long long ring_next = 0;   // 已写入的记录总数
+static long long trace_start_ns = 0;
+
+#if defined(_MSC_VER)
+#include <windows.h>
+static unsigned long long trace_ring_claim(void) {
+    return (unsigned long long)InterlockedIncrement64((volatile LONG64*)&ring_next) - 1;
+}
+#else
+static unsigned long long trace_ring_claim(void) {
+    return __atomic_fetch_add(&ring_next, 1, __ATOMIC_RELAXED);
+}
+#endif
+
+static const char *category_names[TRACE_CATEGORY_COUNT] = {
+    "interp", "symtab", "opt", "codegen"
+};
+
+const char* trace_category_name(TraceCategory cat) {
+    return cat < TRACE_CATEGORY_COUNT ? category_names[cat] : "?";
+}
+
+// 解析一个格式说明符，返回说明符之后的位置，conv为转换字符
+static const char* scan_conversion(const char *p, char *conv) {
+    p++;  // '%'
+    while (*p && strchr("-+ #0123456789.*lhzjt", *p)) p++;
+    *conv = *p;
+    return *p ? p + 1 : p;
+}
+
+static bool has_long(const char *start, const char *end) {
+    for (const char *q = start; q < end; q++) {
+        if (*q == 'l' || *q == 'j' || *q == 'z' || *q == 't') return true;
+    }
+    return false;
+}
+
+// 按格式串取出参数存入记录（与printf的参数提升规则一致）
+static void capture_args(TraceRecord *rec, const char *fmt, va_list ap) {
+    int text_used = 0;
+    const char *p = fmt;
+    rec->arg_count = 0;
+
+    while (*p && rec->arg_count < TRACE_MAX_ARGS) {
+        if (*p != '%') { p++; continue; }
+        if (p[1] == '%') { p += 2; continue; }
+
+        char conv;
+        const char *start = p;
+        p = scan_conversion(p, &conv);
+        TraceArg *arg = &rec->args[rec->arg_count++];
+        bool is_long = has_long(start, p);
+
+        switch (conv) {
+            case 'd': case 'i': case 'c':
+                arg->i = is_long ? va_arg(ap, long long) : va_arg(ap, int);
+                break;
+            case 'u': case 'x': case 'X': case 'o':
+                arg->i = is_long ? (long long)va_arg(ap, unsigned long long) : (long long)va_arg(ap, unsigned);
+                break;
+            case 'f': case 'F': case 'g': case 'G': case 'e': case 'E':
+                arg->f = va_arg(ap, double);
+                break;
+            case 's': {
+                const char *s = va_arg(ap, const char*);
+                if (!s) s = "(null)";
+                size_t room = TRACE_TEXT_SIZE - text_used;
+                size_t len = strlen(s);
+                if (room == 0) {
+                    arg->text_offset = TRACE_TEXT_SIZE - 1;
+                    break;
+                }
+                if (len >= room) len = room - 1;
+                memcpy(rec->text + text_used, s, len);
+                rec->text[text_used + len] = '\0';
+                arg->text_offset = text_used;
+                text_used += (int)len + 1;
+                break;
+            }
+            default:
+                arg->p = va_arg(ap, const void*);
+                break;
+        }
+    }
+}
+
+// 用记录中保存的参数重新格式化
+static void format_record(FILE *out, const TraceRecord *rec) {
+    const char *p = rec->fmt;
+    int index = 0;
+    char spec[32];
+
+    while (*p) {
+        if (*p != '%') { fputc(*p++, out); continue; }
+        if (p[1] == '%') { fputc('%', out); p += 2; continue; }
+
+        char conv;
+        const char *start = p;
+        p = scan_conversion(p, &conv);
+        if (index >= rec->arg_count || (size_t)(p - start) >= sizeof(spec)) {
+            fwrite(start, 1, p - start, out);
+            continue;
+        }
+
+        const TraceArg *arg = &rec->args[index++];
+        bool is_long = has_long(start, p);
+        memcpy(spec, start, p - start);
+        spec[p - start] = '\0';
+
+        switch (conv) {
+            case 'd': case 'i': case 'c':
+            case 'u': case 'x': case 'X': case 'o':
+                if (is_long) fprintf(out, spec, arg->i);
+                else fprintf(out, spec, (int)arg->i);
+                break;
+            case 'f': case 'F': case 'g': case 'G': case 'e': case 'E':
+                fprintf(out, spec, arg->f);
+                break;
+            case 's':
+                fprintf(out, spec, rec->text + arg->text_offset);
+                break;
+            default:
+                fprintf(out, spec, arg->p);
+                break;
+        }
+    }
+}
+
+void trace_emit(TraceCategory cat, TraceLevel level, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+
+    if (trace_sink == TRACE_SINK_RING && ring) {
+        // 多个编译线程可能同时写入：原子地领取一个槽位
+        TraceRecord *rec = &ring[trace_ring_claim() & (ring_capacity - 1)];
+        rec->time_ns = bench_now_ns() - trace_start_ns;
+        rec->fmt = fmt;
+        rec->category = (uint8_t)cat;
+        rec->level = (uint8_t)level;
+        capture_args(rec, fmt, ap);
+    } else {
+        fprintf(stderr, "[%s] ", trace_category_name(cat));
+        vfprintf(stderr, fmt, ap);
+        fputc('\n', stderr);
+    }
+
+    va_end(ap);
+}
+
+void trace_dump(FILE *out) {
+    if (!ring || ring_next == 0) return;
+
+    unsigned long long first = ring_next > ring_capacity ? ring_next - ring_capacity : 0;
+    fprintf(out, "=== Trace ring: %llu events, showing last %llu ===\n",
+            ring_next, ring_next - first);
+    for (unsigned long long i = first; i < ring_next; i++) {
+        const TraceRecord *rec = &ring[i & (ring_capacity - 1)];
+        fprintf(out, "%12.3f us [%s] ", rec->time_ns / 1000.0,
+                trace_category_name((TraceCategory)rec->category));
+        format_record(out, rec);
+        fputc('\n', out);
+    }
+}
+
+static int parse_level(const char *s, size_t len) {
+    if (len == 0) return TRACE_DEBUG;
+    if (len == 3 && strncmp(s, "off", 3) == 0) return TRACE_OFF;
+    if (len == 4 && strncmp(s, "info", 4) == 0) return TRACE_INFO;
+    if (len == 5 && strncmp(s, "debug", 5) == 0) return TRACE_DEBUG;
+    if (len == 1 && s[0] >= '0' && s[0] <= '2') return s[0] - '0';
+    return -1;
+}
+
+bool trace_configure(const char *spec) {
+    const char *p = spec;
+
+    while (*p) {
+        const char *end = strchr(p, ',');
+        if (!end) end = p + strlen(p);
+
+        const char *eq = memchr(p, '=', end - p);
+        const char *name_end = eq ? eq : end;
+        size_t name_len = name_end - p;
+        int level = eq ? parse_level(eq + 1, end - eq - 1) : TRACE_DEBUG;
+        if (level < 0) {
+            fprintf(stderr, "Unknown trace level in '%.*s'\n", (int)(end - p), p);
+            return false;
+        }
+
+        bool matched = false;
+        for (int cat = 0; cat < TRACE_CATEGORY_COUNT; cat++) {
+            if ((name_len == 3 && strncmp(p, "all", 3) == 0) ||
+                (strlen(category_names[cat]) == name_len && strncmp(p, category_names[cat], name_len) == 0)) {
+                trace_levels[cat] = (uint8_t)level;
+                matched = true;
+            }
+        }
+        if (!matched && name_len > 0) {
+            fprintf(stderr, "Unknown trace category '%.*s'\n", (int)name_len, p);
+            return false;
+        }
+
+        p = *end ? end + 1 : end;
+    }
+    return true;
+}
+
+bool trace_set_sink(const char *spec) {
+    if (strcmp(spec, "text") == 0) {
+        trace_sink = TRACE_SINK_TEXT;
+        return true;
+    }
+    if (strncmp(spec, "ring", 4) != 0 || (spec[4] != '\0' && spec[4] != ':')) {
+        fprintf(stderr, "Unknown trace sink: %s\n", spec);
+        return false;
+    }
+
+    // 容量向上取整到2的幂，下标用掩码回绕
+    long requested = spec[4] == ':' ? strtol(spec + 5, NULL, 10) : TRACE_RING_DEFAULT;
+    if (requested <= 0) requested = TRACE_RING_DEFAULT;
+    unsigned capacity = 1;
+    while (capacity < (unsigned long)requested && capacity < (1u << 24)) capacity <<= 1;
+
+    TraceRecord *buffer = (TraceRecord*)calloc(capacity, sizeof(TraceRecord));
+    if (!buffer) {
+        fprintf(stderr, "Cannot allocate trace ring of %u records\n", capacity);
+        return false;
+    }
+    free(ring);
+    ring = buffer;
+    ring_capacity = capacity;
+    ring_next = 0;
+    trace_sink = TRACE_SINK_RING;
+    return true;
+}
+
+void init_trace(void) {
+    trace_start_ns = bench_now_ns();
+
+    const char *spec = getenv("COMPILER_TRACE");
+    if (spec) trace_configure(spec);
+
+    const char *sink = getenv("COMPILER_TRACE_SINK");
+    if (sink) trace_set_sink(sink);
+}
+
+void free_trace(void) {
+    trace_dump(stderr);
+    free(ring);
+    ring = NULL;
+    ring_capacity = 0;
+    ring_next = 0;
+    trace_sink = TRACE_SINK_TEXT;
+}
@@ -0,0 +1,67 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 跟踪类别
+typedef enum {
+    TRACE_INTERP,       // 解释器与字节码降级
+    TRACE_SYMTAB,       // 符号表作用域与符号
+    TRACE_OPT,          // 优化器各遍
+    TRACE_CODEGEN,      // 目标代码生成
+    TRACE_CATEGORY_COUNT
+} TraceCategory;
+
+// 跟踪级别：类别的当前级别不低于事件级别时才记录
+typedef enum {
+    TRACE_OFF,
+    TRACE_INFO,
+    TRACE_DEBUG
+} TraceLevel;
+
+// 输出目标
+typedef enum {
+    TRACE_SINK_TEXT,    // 立即格式化输出到stderr
+    TRACE_SINK_RING     // 写入定长二进制环形缓冲区，退出时再格式化
+} TraceSink;
+
+// 各类别的当前级别（运行时可调整，默认全部关闭）
+extern uint8_t trace_levels[TRACE_CATEGORY_COUNT];
+
+// 关闭时每个跟踪点只剩一次全局字节读取和一个预测为不跳转的分支；
+// 编译时定义TRACE_DISABLED则完全去掉跟踪点
+#if defined(__GNUC__)
+#define TRACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define TRACE_UNLIKELY(x) (x)
+#endif
+
+#ifdef TRACE_DISABLED
+#define TRACE_ON(cat, level) 0
+#define TRACE(cat, level, ...) ((void)0)
+#else
+#define TRACE_ON(cat, level) TRACE_UNLIKELY(trace_levels[cat] >= (level))
+#define TRACE(cat, level, ...) \
+    do { if (TRACE_ON(cat, level)) trace_emit((cat), (level), __VA_ARGS__); } while (0)
+#endif
+
+// 从环境变量COMPILER_TRACE / COMPILER_TRACE_SINK读取初始配置
+void init_trace(void);
+// 输出环形缓冲区中剩余的记录并释放
+void free_trace(void);
+
+// 解析跟踪配置，如 "interp=debug,opt" 或 "all=info"（省略级别时为debug）
+bool trace_configure(const char *spec);
+// 选择输出目标，ring可带容量，如 "ring:4096"
+bool trace_set_sink(const char *spec);
+
+// 记录一条事件（fmt须为字符串常量，仅支持%d %i %u %x %c %s %f %g %p及l修饰）
+void trace_emit(TraceCategory cat, TraceLevel level, const char *fmt, ...);
+// 按时间顺序格式化输出环形缓冲区中的记录
+void trace_dump(FILE *out);
+
+const char* trace_category_name(TraceCategory cat);
+
+#endif